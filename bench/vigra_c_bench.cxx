@@ -0,0 +1,1372 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+/**
+ * @file
+ * @brief Benchmark harness for the C API of vigra_c
+ *
+ * Each exported function is called through the C API on synthetic images of
+ * several sizes (512x512, 2048x2048 and 8192x8192 by default). The results
+ * are written as JSON, with the throughput in Mpix/s and, for memory-bound
+ * functions like the conversions, in GB/s. Benchmarks with the suffix _scalar
+ * run on the scalar code path, i.e. with VIGRA's convolution, for comparison
+ * with the vectorized and cache-blocked convolution on wide images. The HDF5
+ * functions are only benchmarked, if vigra_c supports HDF5 (see vigra_has_hdf5_c).
+ *
+ * Usage: vigra_c_bench [options]
+ *  --sizes 512,2048,8192   Image sizes (square) to benchmark.
+ *  --filter <text>         Only run benchmarks, whose name contains the text.
+ *  --min-time <seconds>    Minimal measuring time per benchmark (default: 0.5).
+ *  --max-iterations <n>    Maximal number of iterations per benchmark (default: 1000).
+ *  --threads <n>           Number of threads (see vigra_set_num_threads_c).
+ *  --dispatch <path>       CPU dispatch path (see vigra_set_cpu_dispatch_c).
+ *  --tmpdir <dir>          Directory for the image files of the impex benchmarks.
+ *  --full                  Also run the slow benchmarks on images larger than 2048x2048.
+ *  --out <file>            Write the JSON to a file instead of stdout.
+ *  --list                  Only list the names of the benchmarks.
+ *  --help                  Print the usage.
+ */
+
+#include "vigra_c.h"
+#include "vigra_houghtransform_c.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * The images sizes, up to which the slow benchmarks are run by default.
+ */
+static const int max_slow_size = 2048;
+
+/**
+ * The number of sample positions per axis of the spline image view benchmarks.
+ */
+static const int spline_samples = 256;
+
+/**
+ * The input and output buffers of all benchmarks for one image size.
+ * The inputs are deterministic synthetic images.
+ */
+struct Fixture
+{
+    Fixture(const int size, const std::string & tmpdir)
+    : width(size),
+      height(size),
+      pixels(std::size_t(size)*size),
+      sink(0),
+      siv(nullptr),
+      siv_address(0),
+      siv_order(0)
+    {
+        gray.resize(pixels);
+        gray2.resize(pixels);
+        binary.resize(pixels);
+        regions.resize(pixels);
+        seeds.resize(pixels, 0.0f);
+        
+        unsigned int rnd = 12345;
+        
+        for(int y=0; y<height; ++y)
+        {
+            for(int x=0; x<width; ++x)
+            {
+                std::size_t i = std::size_t(y)*width + x;
+                rnd = rnd*1664525u + 1013904223u;
+                float noise = (rnd >> 8) / float(1 << 24) * 20.0f - 10.0f;
+                
+                gray[i]    = 127.5f + 100.0f*std::sin(x*0.05f)*std::cos(y*0.07f) + noise;
+                gray2[i]   = 1.0f + std::fmod(x*0.37f + y*0.91f, 254.0f);
+                binary[i]  = ((x/16 + y/16) % 3 == 0) ? 1.0f : 0.0f;
+                regions[i] = float((y/32)*((width+31)/32) + x/32 + 1);
+                
+                if(x % 32 == 16 && y % 32 == 16)
+                {
+                    seeds[i] = regions[i];
+                }
+            }
+        }
+        max_label = int(regions.back());
+        
+        for(int b=0; b<6; ++b)
+        {
+            out[b].resize(pixels);
+        }
+        padded.resize(std::size_t(width+64)*(height+64));
+        crackedges.resize(std::size_t(2*width-1)*(2*height-1));
+        features.resize(34*std::size_t(max_label+1));
+        argb.resize(4*pixels);
+        labels.resize(pixels);
+        nearest.resize(pixels);
+        region_labels.assign(regions.begin(), regions.end());
+        seed_labels.resize(pixels);
+        crack_labels.resize(crackedges.size());
+        
+        u8.resize(pixels);
+        u8_2.resize(pixels);
+        u8_binary.resize(pixels);
+        u16.resize(pixels);
+        u16_2.resize(pixels);
+        u16_binary.resize(pixels);
+        
+        for(std::size_t i=0; i<pixels; ++i)
+        {
+            u8[i]         = (UInt8PixelType)std::min(std::max(gray[i], 0.0f), 255.0f);
+            u8_2[i]       = (UInt8PixelType)gray2[i];
+            u8_binary[i]  = (UInt8PixelType)binary[i];
+            u16[i]        = (UInt16PixelType)(u8[i]*257);
+            u16_2[i]      = (UInt16PixelType)(u8_2[i]*257);
+            u16_binary[i] = (UInt16PixelType)binary[i];
+        }
+        u8_out.resize(4*pixels);
+        u16_out.resize(4*pixels);
+        
+        std::ostringstream prefix;
+        prefix << tmpdir << "/vigra_c_bench_" << width << "x" << height;
+        
+        gray_file         = prefix.str() + "_gray.tif";
+        rgb_file          = prefix.str() + "_rgb.tif";
+        rgba_file         = prefix.str() + "_rgba.tif";
+        uint8_gray_file   = prefix.str() + "_uint8_gray.png";
+        uint8_rgba_file   = prefix.str() + "_uint8_rgba.png";
+        uint16_gray_file  = prefix.str() + "_uint16_gray.tif";
+        uint16_rgba_file  = prefix.str() + "_uint16_rgba.tif";
+        out_file          = prefix.str() + "_out.tif";
+        out_png           = prefix.str() + "_out.png";
+        wisdom_file       = prefix.str() + "_fftw.wisdom";
+        hdf5_file         = prefix.str() + "_gray.h5";
+        hdf5_out_file     = prefix.str() + "_out.h5";
+        
+        vigra_exportgrayimage_c(in(), width, height, gray_file.c_str(), false);
+        vigra_exportrgbimage_c(in(), in2(), in(), width, height, rgb_file.c_str(), false);
+        vigra_exportrgbaimage_c(in(), in2(), in(), in2(), width, height, rgba_file.c_str(), false);
+        vigra_exportgrayimage_uint8_c(&u8[0], width, height, uint8_gray_file.c_str());
+        vigra_exportrgbaimage_uint8_c(&u8[0], &u8_2[0], &u8[0], &u8_2[0], width, height, uint8_rgba_file.c_str());
+        vigra_exportgrayimage_uint16_c(&u16[0], width, height, uint16_gray_file.c_str());
+        vigra_exportrgbaimage_uint16_c(&u16[0], &u16_2[0], &u16[0], &u16_2[0], width, height, uint16_rgba_file.c_str());
+#ifdef HAS_HDF5
+        if(vigra_has_hdf5_c())
+        {
+            int shape[2] = { width, height };
+            vigra_hdf5_exportarray_c(&gray[0], shape, 2, hdf5_file.c_str(), "gray");
+        }
+#endif
+    }
+    
+    ~Fixture()
+    {
+        releaseSplineViews();
+        
+        const std::string * files[] = { &gray_file, &rgb_file, &rgba_file,
+                                         &uint8_gray_file, &uint8_rgba_file,
+                                         &uint16_gray_file, &uint16_rgba_file,
+                                         &out_file, &out_png, &wisdom_file,
+                                         &hdf5_file, &hdf5_out_file };
+        for(const std::string * file : files)
+        {
+            std::remove(file->c_str());
+        }
+    }
+    
+    /**
+     * Returns a spline image view of the given order of the gray image. Only the
+     * views of one order are kept at once, to limit the memory consumption.
+     */
+    void * splineView(const int order)
+    {
+        selectSplineOrder(order);
+        return siv;
+    }
+    
+    /**
+     * Returns the address of a spline image view of the given order of the gray image.
+     */
+    unsigned long splineAddress(const int order)
+    {
+        selectSplineOrder(order);
+        return siv_address;
+    }
+    
+    void selectSplineOrder(const int order)
+    {
+        if(order == siv_order)
+        {
+            return;
+        }
+        releaseSplineViews();
+        
+        switch(order)
+        {
+            case 1:
+                siv = vigra_create_splineimageview1_c(in(), width, height);
+                siv_address = vigra_create_splineimageview1_address_c(in(), width, height);
+                break;
+            case 2:
+                siv = vigra_create_splineimageview2_c(in(), width, height);
+                siv_address = vigra_create_splineimageview2_address_c(in(), width, height);
+                break;
+            case 3:
+                siv = vigra_create_splineimageview3_c(in(), width, height);
+                siv_address = vigra_create_splineimageview3_address_c(in(), width, height);
+                break;
+            case 4:
+                siv = vigra_create_splineimageview4_c(in(), width, height);
+                siv_address = vigra_create_splineimageview4_address_c(in(), width, height);
+                break;
+            case 5:
+                siv = vigra_create_splineimageview5_c(in(), width, height);
+                siv_address = vigra_create_splineimageview5_address_c(in(), width, height);
+                break;
+        }
+        siv_order = order;
+    }
+    
+    void releaseSplineViews()
+    {
+        switch(siv_order)
+        {
+            case 1:
+                vigra_delete_splineimageview1_c(siv);
+                vigra_delete_splineimageview1_by_address_c(siv_address);
+                break;
+            case 2:
+                vigra_delete_splineimageview2_c(siv);
+                vigra_delete_splineimageview2_by_address_c(siv_address);
+                break;
+            case 3:
+                vigra_delete_splineimageview3_c(siv);
+                vigra_delete_splineimageview3_by_address_c(siv_address);
+                break;
+            case 4:
+                vigra_delete_splineimageview4_c(siv);
+                vigra_delete_splineimageview4_by_address_c(siv_address);
+                break;
+            case 5:
+                vigra_delete_splineimageview5_c(siv);
+                vigra_delete_splineimageview5_by_address_c(siv_address);
+                break;
+        }
+        siv_order = 0;
+    }
+    
+    const PixelType * in() const { return &gray[0]; }
+    const PixelType * in2() const { return &gray2[0]; }
+    PixelType * o(const int b) { return &out[b][0]; }
+    
+    UInt8PixelType * u8o(const int b) { return &u8_out[b*pixels]; }
+    UInt16PixelType * u16o(const int b) { return &u16_out[b*pixels]; }
+    
+    int width, height;
+    std::size_t pixels;
+    
+    std::vector<PixelType> gray, gray2, binary, regions, seeds, out[6], padded, crackedges, features, scalespace;
+    std::vector<char> argb;
+    std::vector<LabelType> labels, region_labels, seed_labels, crack_labels;
+    std::vector<int> nearest;
+    std::vector<UInt8PixelType> u8, u8_2, u8_binary, u8_out;
+    std::vector<UInt16PixelType> u16, u16_2, u16_binary, u16_out;
+    int max_label;
+    
+    std::string gray_file, rgb_file, rgba_file,
+                uint8_gray_file, uint8_rgba_file, uint16_gray_file, uint16_rgba_file,
+                out_file, out_png, wisdom_file, hdf5_file, hdf5_out_file;
+    
+    /** Accumulates the results of the scalar functions, so that they are not optimized away. */
+    double sink;
+    
+    void * siv;
+    unsigned long siv_address;
+    int siv_order;
+};
+
+/**
+ * The unit, in which the work of one call of a benchmarked function is counted.
+ */
+enum WorkUnit
+{
+    PIXELS,     // all pixels of the image
+    SAMPLES,    // spline_samples^2 sample positions
+    CALLS       // one call (Mpix/s is not reported)
+};
+
+/**
+ * One benchmark of an exported function.
+ */
+struct Benchmark
+{
+    std::string name;
+    WorkUnit unit;
+    
+    /** The bytes read and written per pixel, or 0 if no GB/s should be reported. */
+    int bytes_per_pixel;
+    
+    /** Slow benchmarks are only run up to max_slow_size by default. */
+    bool slow;
+    
+    std::function<int(Fixture &)> run;
+};
+
+/**
+ * The registry of all benchmarks.
+ */
+static std::vector<Benchmark> & benchmarks()
+{
+    static std::vector<Benchmark> list;
+    return list;
+}
+
+static void add(const std::string & name, WorkUnit unit, int bytes_per_pixel, bool slow,
+                std::function<int(Fixture &)> run)
+{
+    Benchmark b = { name, unit, bytes_per_pixel, slow, run };
+    benchmarks().push_back(b);
+}
+
+/**
+ * Macros to register the benchmark of an exported function, which is called
+ * by means of the given expression. The fixture is accessible as f.
+ */
+#define BENCH(name, ...)                                                                  \
+    add(#name, PIXELS, 0, false, [](Fixture & f){ return __VA_ARGS__; })
+#define BENCH_BYTES(name, bytes, ...)                                                     \
+    add(#name, PIXELS, bytes, false, [](Fixture & f){ return __VA_ARGS__; })
+#define BENCH_SLOW(name, ...)                                                             \
+    add(#name, PIXELS, 0, true, [](Fixture & f){ return __VA_ARGS__; })
+#define BENCH_CALL(name, ...)                                                             \
+    add(#name, CALLS, 0, false, [](Fixture & f){ return __VA_ARGS__; })
+#define BENCH_ASYNC(name, ...)                                                            \
+    add(#name, PIXELS, 0, false, [](Fixture & f){ return vigra_job_wait_c(__VA_ARGS__); })
+
+/**
+ * Affine matrix of a rotation by 10 degrees around the image center.
+ */
+static std::vector<double> affineMatrix(const Fixture & f)
+{
+    const double a = 10.0*3.14159265358979323846/180.0, c = std::cos(a), s = std::sin(a);
+    const double cx = f.width/2.0, cy = f.height/2.0;
+    
+    double m[9] = { c, -s, cx - c*cx + s*cy,
+                    s,  c, cy - s*cx - c*cy,
+                    0,  0, 1 };
+    return std::vector<double>(m, m+9);
+}
+
+static const double kernel_3x3[9] = { 1/16., 2/16., 1/16.,  2/16., 4/16., 2/16.,  1/16., 2/16., 1/16. };
+static const double kernel_9[9]   = { 1/25., 2/25., 3/25., 4/25., 5/25., 4/25., 3/25., 2/25., 1/25. };
+
+/**
+ * Normalized disc of the given radius, which is not separable.
+ */
+static std::vector<double> discKernel(const int radius)
+{
+    const int size = 2*radius + 1;
+    std::vector<double> kernel(size*size, 0.0);
+    double sum = 0.0;
+    for(int y=-radius; y<=radius; ++y)
+    {
+        for(int x=-radius; x<=radius; ++x)
+        {
+            if(x*x + y*y <= radius*radius)
+            {
+                kernel[(y+radius)*size + x+radius] = 1.0;
+                sum += 1.0;
+            }
+        }
+    }
+    for(double & value : kernel)
+    {
+        value /= sum;
+    }
+    return kernel;
+}
+
+static const std::vector<double> kernel_61x61 = discKernel(30);
+static const std::vector<double> box_61x61(61*61, 1.0/(61*61));
+static const std::vector<double> box_25(25, 1.0/25);
+
+/**
+ * Runs a benchmark call on the scalar code path, i.e. with VIGRA's convolution,
+ * and restores the selected code path afterwards.
+ */
+template <class FUNCTOR>
+static int onScalarPath(FUNCTOR f)
+{
+    int path = vigra_cpu_dispatch_c();
+    vigra_set_cpu_dispatch_c(0);
+    int result = f();
+    vigra_set_cpu_dispatch_c(path);
+    return result;
+}
+static const double deriv_3[3]    = { 0.5, 0.0, -0.5 };
+static const double smooth_3[3]   = { 0.25, 0.5, 0.25 };
+
+static void registerConvertBenchmarks()
+{
+    BENCH_BYTES(convert_grayband_to_argb, 4+4,
+                vigra_convert_grayband_to_argb_c(f.in(), &f.argb[0], f.width, f.height));
+    BENCH_BYTES(convert_rgbbands_to_argb, 12+4,
+                vigra_convert_rgbbands_to_argb_c(f.in(), f.in2(), f.in(), &f.argb[0], f.width, f.height));
+    BENCH_BYTES(convert_rgbabands_to_argb, 16+4,
+                vigra_convert_rgbabands_to_argb_c(f.in(), f.in2(), f.in(), f.in2(), &f.argb[0], f.width, f.height));
+    BENCH_BYTES(convert_argb_to_grayband, 4+4,
+                vigra_convert_argb_to_grayband_c(&f.argb[0], f.o(0), f.width, f.height));
+    BENCH_BYTES(convert_argb_to_rgbbands, 4+12,
+                vigra_convert_argb_to_rgbbands_c(&f.argb[0], f.o(0), f.o(1), f.o(2), f.width, f.height));
+    BENCH_BYTES(convert_argb_to_rgbabands, 4+16,
+                vigra_convert_argb_to_rgbabands_c(&f.argb[0], f.o(0), f.o(1), f.o(2), f.o(3), f.width, f.height));
+    
+    BENCH_BYTES(copy_double_array, 16,
+                vigra_copy_double_array_c((const double*)f.in(), (double*)f.o(0), int(f.pixels/2)));
+    BENCH_BYTES(copy_float_array, 8,
+                vigra_copy_float_array_c(f.in(), f.o(0), int(f.pixels)));
+    BENCH_BYTES(copy_int_array, 8,
+                vigra_copy_int_array_c((const int*)f.in(), (int*)f.o(0), int(f.pixels)));
+    BENCH_BYTES(copy_uint8_array, 2,
+                vigra_copy_uint8_array_c(&f.u8[0], f.u8o(0), int(f.pixels)));
+    BENCH_BYTES(init_double_array, 8,
+                vigra_init_double_array_c((double*)f.o(0), int(f.pixels/2), 1.0));
+    BENCH_BYTES(init_float_array, 4,
+                vigra_init_float_array_c(f.o(0), int(f.pixels), 1.0f));
+    BENCH_BYTES(init_int_array, 4,
+                vigra_init_int_array_c((int*)f.o(0), int(f.pixels), 1));
+    BENCH_BYTES(init_uint8_array, 1,
+                vigra_init_uint8_array_c(f.u8o(0), int(f.pixels), 1));
+}
+
+static void registerControlBenchmarks()
+{
+    BENCH_CALL(cpu_features, vigra_cpu_features_c() < 0);
+    BENCH_CALL(cpu_dispatch, vigra_cpu_dispatch_c() < 0);
+    BENCH_CALL(set_cpu_dispatch, vigra_set_cpu_dispatch_c(vigra_cpu_dispatch_c()));
+    BENCH_CALL(get_num_threads, vigra_get_num_threads_c() < 1);
+    BENCH_CALL(set_num_threads, vigra_set_num_threads_c(vigra_get_num_threads_c()));
+    BENCH_CALL(has_hdf5, vigra_has_hdf5_c() < 0);
+    BENCH_CALL(stats_enabled, vigra_stats_enabled_c() < 0);
+    BENCH_CALL(stats_snapshot, vigra_stats_snapshot_c(nullptr, 0) < -1);
+    BENCH_CALL(stats_reset, vigra_stats_reset_c() < 0);
+    BENCH_CALL(arena_trim, vigra_arena_trim_c());
+    BENCH_CALL(fft_set_planner_effort, vigra_fft_set_planner_effort_c(0));
+    BENCH_CALL(fft_export_import_wisdom,
+               vigra_fft_export_wisdom_c(f.wisdom_file.c_str()) ||
+               vigra_fft_import_wisdom_c(f.wisdom_file.c_str()));
+    BENCH_CALL(job_poll_cancel_wait,
+               [](Fixture & f)
+               {
+                   void * job = vigra_gaussiansmoothing_async_c(f.in(), f.o(0), 64, 64, 1.0f);
+                   vigra_job_poll_c(job);
+                   vigra_job_cancel_c(job);
+                   return vigra_job_wait_c(job) > 0;
+               }(f));
+}
+
+static void registerFilterBenchmarks()
+{
+    BENCH(convolveimage,
+          vigra_convolveimage_c(f.in(), kernel_3x3, f.o(0), f.width, f.height, 3, 3, 3));
+    BENCH(convolveimage_61x61,
+          vigra_convolveimage_c(f.in(), kernel_61x61.data(), f.o(0), f.width, f.height, 61, 61, 3));
+    BENCH_SLOW(convolveimage_61x61_spatial,
+               vigra_set_fft_convolution_threshold_c(-1) ||
+               vigra_convolveimage_c(f.in(), kernel_61x61.data(), f.o(0), f.width, f.height, 61, 61, 3) ||
+               vigra_set_fft_convolution_threshold_c(121));
+    BENCH(convolveimage_61x61_box,
+          vigra_convolveimage_c(f.in(), box_61x61.data(), f.o(0), f.width, f.height, 61, 61, 3));
+    BENCH(convolveimage_lowrank_61x61,
+          vigra_convolveimage_lowrank_c(f.in(), kernel_61x61.data(), f.o(0), f.width, f.height, 61, 61, 3, 8, 0.05f));
+    BENCH(separableconvolveimage,
+          vigra_separableconvolveimage_c(f.in(), kernel_9, kernel_9, f.o(0), f.width, f.height, 9, 9, 3));
+    BENCH(separableconvolveimage_25,
+          vigra_separableconvolveimage_c(f.in(), box_25.data(), box_25.data(), f.o(0), f.width, f.height, 25, 25, 3));
+    BENCH(separableconvolveimage_25_scalar,
+          onScalarPath([&]()
+                       {
+                           return vigra_separableconvolveimage_c(f.in(), box_25.data(), box_25.data(), f.o(0),
+                                                                 f.width, f.height, 25, 25, 3);
+                       }));
+    BENCH(gaussiangradient,
+          vigra_gaussiangradient_c(f.in(), f.o(0), f.o(1), f.width, f.height, 2.0f));
+    BENCH(gaussiangradientmagnitude,
+          vigra_gaussiangradientmagnitude_c(f.in(), f.o(0), f.width, f.height, 2.0f));
+    BENCH(gaussiansmoothing,
+          vigra_gaussiansmoothing_c(f.in(), f.o(0), f.width, f.height, 2.0f));
+    BENCH(gaussiansmoothing_scalar,
+          onScalarPath([&]()
+                       {
+                           return vigra_gaussiansmoothing_c(f.in(), f.o(0), f.width, f.height, 2.0f);
+                       }));
+    BENCH(gaussiansmoothing_sigma50,
+          vigra_gaussiansmoothing_c(f.in(), f.o(0), f.width, f.height, 50.0f));
+    BENCH(recursivegaussiansmoothing_sigma50,
+          vigra_recursivegaussiansmoothing_c(f.in(), f.o(0), f.width, f.height, 50.0f));
+    BENCH(gaussiangradient_sigma50_recursive,
+          vigra_set_recursive_gaussian_threshold_c(10.0f) ||
+          vigra_gaussiangradient_c(f.in(), f.o(0), f.o(1), f.width, f.height, 50.0f) ||
+          vigra_set_recursive_gaussian_threshold_c(-1.0f));
+    BENCH(gaussianscalespace,
+          [](Fixture & f)
+          {
+              long long offsets[4*3 + 1];
+              int widths[4], heights[4];
+              vigra_gaussianscalespace_layout_c(f.width, f.height, 4, 3, offsets, widths, heights);
+              f.scalespace.resize(offsets[4*3]);
+              return vigra_gaussianscalespace_c(f.in(), f.scalespace.data(), f.width, f.height, 4, 3, 1.6f, 0.5f);
+          }(f));
+    BENCH(gaussiansmoothing_bands,
+          [](Fixture & f)
+          {
+              const PixelType * in[3]  = { f.in(), f.in2(), f.in() };
+              const PixelType * out[3] = { f.o(0), f.o(1), f.o(2) };
+              return vigra_gaussiansmoothing_bands_c(in, out, 3, f.width, f.height, 2.0f);
+          }(f));
+    BENCH(gaussiangradient_bands,
+          [](Fixture & f)
+          {
+              const PixelType * in[2]  = { f.in(), f.in2() };
+              const PixelType * gx[2]  = { f.o(0), f.o(1) };
+              const PixelType * gy[2]  = { f.o(2), f.o(3) };
+              return vigra_gaussiangradient_bands_c(in, gx, gy, 2, f.width, f.height, 2.0f);
+          }(f));
+    BENCH(laplacianofgaussian,
+          vigra_laplacianofgaussian_c(f.in(), f.o(0), f.width, f.height, 2.0f));
+    BENCH(hessianmatrixofgaussian,
+          vigra_hessianmatrixofgaussian_c(f.in(), f.o(0), f.o(1), f.o(2), f.width, f.height, 2.0f));
+    BENCH(gaussianderivatives,
+          [](Fixture & f)
+          {
+              const PixelType * out[7] = { f.o(0), f.o(1), f.o(2), f.o(3), f.o(4), f.o(5), nullptr };
+              return vigra_gaussianderivatives_c(f.in(), out, f.width, f.height, 2.0f, 63);
+          }(f));
+    BENCH(gaussiansharpening,
+          vigra_gaussiansharpening_c(f.in(), f.o(0), f.width, f.height, 0.5f, 2.0f));
+    BENCH(simplesharpening,
+          vigra_simplesharpening_c(f.in(), f.o(0), f.width, f.height, 0.5f));
+    BENCH(medianfilter,
+          vigra_medianfilter_c(f.in(), f.o(0), f.width, f.height, 5, 5, 3));
+    BENCH(medianfilter_31x31,
+          vigra_medianfilter_c(f.in(), f.o(0), f.width, f.height, 31, 31, 3));
+    BENCH_SLOW(medianfilter_31x31_vigra,
+               vigra_set_median_histogram_threshold_c(-1) ||
+               vigra_medianfilter_c(f.in(), f.o(0), f.width, f.height, 31, 31, 3) ||
+               vigra_set_median_histogram_threshold_c(225));
+    BENCH_SLOW(nonlineardiffusion,
+               vigra_nonlineardiffusion_c(f.in(), f.o(0), f.width, f.height, 10.0f, 2.0f));
+    BENCH_SLOW(shockfilter,
+               vigra_shockfilter_c(f.in(), f.o(0), f.width, f.height, 1.0f, 2.0f, 0.3f, 2));
+    BENCH_SLOW(nonlocalmean,
+               vigra_nonlocalmean_c(f.in(), f.o(0), f.width, f.height, 1, 5.0f, 0.95f, 0.5f, 0.00001f,
+                                    2.0f, 5, 2, 1.0f, 2, 1, 0, false));
+    
+    BENCH_ASYNC(convolveimage_async,
+                vigra_convolveimage_async_c(f.in(), kernel_3x3, f.o(0), f.width, f.height, 3, 3, 3));
+    BENCH_ASYNC(separableconvolveimage_async,
+                vigra_separableconvolveimage_async_c(f.in(), kernel_9, kernel_9, f.o(0), f.width, f.height, 9, 9, 3));
+    BENCH_ASYNC(gaussiangradient_async,
+                vigra_gaussiangradient_async_c(f.in(), f.o(0), f.o(1), f.width, f.height, 2.0f));
+    BENCH_ASYNC(gaussiangradientmagnitude_async,
+                vigra_gaussiangradientmagnitude_async_c(f.in(), f.o(0), f.width, f.height, 2.0f));
+    BENCH_ASYNC(gaussiansmoothing_async,
+                vigra_gaussiansmoothing_async_c(f.in(), f.o(0), f.width, f.height, 2.0f));
+    BENCH_ASYNC(laplacianofgaussian_async,
+                vigra_laplacianofgaussian_async_c(f.in(), f.o(0), f.width, f.height, 2.0f));
+    BENCH_ASYNC(hessianmatrixofgaussian_async,
+                vigra_hessianmatrixofgaussian_async_c(f.in(), f.o(0), f.o(1), f.o(2), f.width, f.height, 2.0f));
+    BENCH_ASYNC(medianfilter_async,
+                vigra_medianfilter_async_c(f.in(), f.o(0), f.width, f.height, 5, 5, 3));
+    BENCH_ASYNC(nonlineardiffusion_async,
+                vigra_nonlineardiffusion_async_c(f.in(), f.o(0), f.width, f.height, 10.0f, 2.0f));
+}
+
+/**
+ * Macros to register the benchmarks of the arithmetic functions for one pixel type.
+ */
+#define ARITHMETIC_BENCHMARKS(suffix, type, in1, in2, out, low, upp)                      \
+    BENCH_BYTES(clipimage##suffix, 2*sizeof(type),                                        \
+                vigra_clipimage##suffix##_c(in1, out, f.width, f.height, low, upp));      \
+    BENCH_BYTES(imageplusimage##suffix, 3*sizeof(type),                                   \
+                vigra_imageplusimage##suffix##_c(in1, in2, out, f.width, f.height));      \
+    BENCH_BYTES(imageminusimage##suffix, 3*sizeof(type),                                  \
+                vigra_imageminusimage##suffix##_c(in1, in2, out, f.width, f.height));     \
+    BENCH_BYTES(imagemultimage##suffix, 3*sizeof(type),                                   \
+                vigra_imagemultimage##suffix##_c(in1, in2, out, f.width, f.height));      \
+    BENCH_BYTES(imagedivideimage##suffix, 3*sizeof(type),                                 \
+                vigra_imagedivideimage##suffix##_c(in1, in2, out, f.width, f.height));    \
+    BENCH_BYTES(imagepowimage##suffix, 3*sizeof(type),                                    \
+                vigra_imagepowimage##suffix##_c(in1, in2, out, f.width, f.height));       \
+    BENCH_BYTES(imageplusvalue##suffix, 2*sizeof(type),                                   \
+                vigra_imageplusvalue##suffix##_c(in1, out, 3.0f, f.width, f.height));     \
+    BENCH_BYTES(imageminusvalue##suffix, 2*sizeof(type),                                  \
+                vigra_imageminusvalue##suffix##_c(in1, out, 3.0f, f.width, f.height));    \
+    BENCH_BYTES(imagemultvalue##suffix, 2*sizeof(type),                                   \
+                vigra_imagemultvalue##suffix##_c(in1, out, 3.0f, f.width, f.height));     \
+    BENCH_BYTES(imagedividevalue##suffix, 2*sizeof(type),                                 \
+                vigra_imagedividevalue##suffix##_c(in1, out, 3.0f, f.width, f.height));   \
+    BENCH_BYTES(imagepowvalue##suffix, 2*sizeof(type),                                    \
+                vigra_imagepowvalue##suffix##_c(in1, out, 0.5f, f.width, f.height))
+
+static void registerImgprocBenchmarks()
+{
+    BENCH(resizeimage,
+          vigra_resizeimage_c(f.in(), f.o(0), f.width, f.height, f.width/2, f.height/2, 1));
+    BENCH(rotateimage,
+          vigra_rotateimage_c(f.in(), f.o(0), f.width, f.height, 10.0f, 1));
+    BENCH(affinewarpimage,
+          vigra_affinewarpimage_c(f.in(), &affineMatrix(f)[0], f.o(0), f.width, f.height, 1));
+    BENCH(resizeimage_bands,
+          [](Fixture & f)
+          {
+              const PixelType * in[3]  = { f.in(), f.in2(), f.in() };
+              const PixelType * out[3] = { f.o(0), f.o(1), f.o(2) };
+              return vigra_resizeimage_bands_c(in, out, 3, f.width, f.height, f.width/2, f.height/2, 1);
+          }(f));
+    BENCH(rotateimage_bands,
+          [](Fixture & f)
+          {
+              const PixelType * in[3]  = { f.in(), f.in2(), f.in() };
+              const PixelType * out[3] = { f.o(0), f.o(1), f.o(2) };
+              return vigra_rotateimage_bands_c(in, out, 3, f.width, f.height, 10.0f, 1);
+          }(f));
+    BENCH(affinewarpimage_bands,
+          [](Fixture & f)
+          {
+              const PixelType * in[3]  = { f.in(), f.in2(), f.in() };
+              const PixelType * out[3] = { f.o(0), f.o(1), f.o(2) };
+              return vigra_affinewarpimage_bands_c(in, &affineMatrix(f)[0], out, 3, f.width, f.height, 1);
+          }(f));
+    BENCH(reflectimage,
+          vigra_reflectimage_c(f.in(), f.o(0), f.width, f.height, 3));
+    BENCH(fouriertransform,
+          vigra_fouriertransform_c(f.in(), f.o(0), f.o(1), f.width, f.height));
+    BENCH(fouriertransforminverse,
+          vigra_fouriertransforminverse_c(f.in(), f.in2(), f.o(0), f.o(1), f.width, f.height));
+    BENCH(fouriertransform_half,
+          vigra_fouriertransform_half_c(f.in(), f.o(0), f.o(1), f.width, f.height));
+    BENCH(fouriertransforminverse_half,
+          vigra_fouriertransforminverse_half_c(f.in(), f.in2(), f.o(0), f.width, f.height));
+    BENCH(fastcrosscorrelation,
+          vigra_fastcrosscorrelation_c(f.in(), f.in2(), f.o(0), f.width, f.height, 15, 15));
+    BENCH(fastnormalizedcrosscorrelation,
+          vigra_fastnormalizedcrosscorrelation_c(f.in(), f.in2(), f.o(0), f.width, f.height, 15, 15));
+    BENCH(localmaxima,
+          vigra_localmaxima_c(f.in(), f.o(0), f.width, f.height, true, 1.0f, 0.0f, false, false, 1.0f));
+    BENCH(localminima,
+          vigra_localminima_c(f.in(), f.o(0), f.width, f.height, true, 1.0f, 255.0f, false, false, 1.0f));
+    BENCH(subimage,
+          vigra_subimage_c(f.in(), f.o(0), f.width, f.height, f.width/4, f.height/4, 3*f.width/4, 3*f.height/4));
+    BENCH(paddimage,
+          vigra_paddimage_c(f.in(), &f.padded[0], f.width, f.height, 32, 32, f.width+32, f.height+32));
+    
+    ARITHMETIC_BENCHMARKS(, PixelType, f.in(), f.in2(), f.o(0), 10.0f, 200.0f);
+    ARITHMETIC_BENCHMARKS(_uint8, UInt8PixelType, &f.u8[0], &f.u8_2[0], f.u8o(0), 10, 200);
+    ARITHMETIC_BENCHMARKS(_uint16, UInt16PixelType, &f.u16[0], &f.u16_2[0], f.u16o(0), 2570, 51400);
+    
+    BENCH_ASYNC(resizeimage_async,
+                vigra_resizeimage_async_c(f.in(), f.o(0), f.width, f.height, f.width/2, f.height/2, 1));
+    BENCH_ASYNC(rotateimage_async,
+                vigra_rotateimage_async_c(f.in(), f.o(0), f.width, f.height, 10.0f, 1));
+    BENCH_ASYNC(affinewarpimage_async,
+                [](Fixture & f)
+                {
+                    //The matrix needs to stay valid until the job is finished
+                    static std::vector<double> matrix;
+                    matrix = affineMatrix(f);
+                    return vigra_affinewarpimage_async_c(f.in(), &matrix[0], f.o(0), f.width, f.height, 1);
+                }(f));
+    BENCH_ASYNC(fouriertransform_async,
+                vigra_fouriertransform_async_c(f.in(), f.o(0), f.o(1), f.width, f.height));
+}
+
+static void registerImpexBenchmarks()
+{
+    BENCH(importgrayimage,
+          vigra_importgrayimage_c(f.o(0), f.width, f.height, f.gray_file.c_str()));
+    BENCH(importrgbimage,
+          vigra_importrgbimage_c(f.o(0), f.o(1), f.o(2), f.width, f.height, f.rgb_file.c_str()));
+    BENCH(importrgbaimage,
+          vigra_importrgbaimage_c(f.o(0), f.o(1), f.o(2), f.o(3), f.width, f.height, f.rgba_file.c_str()));
+    BENCH(exportgrayimage,
+          vigra_exportgrayimage_c(f.in(), f.width, f.height, f.out_file.c_str(), false));
+    BENCH(exportrgbimage,
+          vigra_exportrgbimage_c(f.in(), f.in2(), f.in(), f.width, f.height, f.out_file.c_str(), false));
+    BENCH(exportrgbaimage,
+          vigra_exportrgbaimage_c(f.in(), f.in2(), f.in(), f.in2(), f.width, f.height, f.out_file.c_str(), false));
+    
+    BENCH_CALL(imagewidth, vigra_imagewidth_c(f.rgba_file.c_str()) != f.width);
+    BENCH_CALL(imageheight, vigra_imageheight_c(f.rgba_file.c_str()) != f.height);
+    BENCH_CALL(imagenumbands, vigra_imagenumbands_c(f.rgba_file.c_str()) != 4);
+    BENCH_CALL(imagenumextrabands, vigra_imagenumextrabands_c(f.rgba_file.c_str()) != 1);
+    BENCH_CALL(imageimport_open_info_close,
+               [](Fixture & f)
+               {
+                   void * handle = vigra_imageimport_open_c(f.rgba_file.c_str());
+                   int res = (vigra_imageimport_width_c(handle) != f.width) +
+                             (vigra_imageimport_height_c(handle) != f.height) +
+                             (vigra_imageimport_numbands_c(handle) != 4) +
+                             (vigra_imageimport_numextrabands_c(handle) != 1) +
+                             (vigra_imageimport_pixeltype_c(handle) == 0);
+                   return res + vigra_imageimport_close_c(handle);
+               }(f));
+    BENCH(imageimport_gray,
+          [](Fixture & f)
+          {
+              void * handle = vigra_imageimport_open_c(f.gray_file.c_str());
+              int res = vigra_imageimport_gray_c(handle, f.o(0), f.width, f.height);
+              return res + vigra_imageimport_close_c(handle);
+          }(f));
+    BENCH(imageimport_rgb,
+          [](Fixture & f)
+          {
+              void * handle = vigra_imageimport_open_c(f.rgb_file.c_str());
+              int res = vigra_imageimport_rgb_c(handle, f.o(0), f.o(1), f.o(2), f.width, f.height);
+              return res + vigra_imageimport_close_c(handle);
+          }(f));
+    BENCH(imageimport_rgba,
+          [](Fixture & f)
+          {
+              void * handle = vigra_imageimport_open_c(f.rgba_file.c_str());
+              int res = vigra_imageimport_rgba_c(handle, f.o(0), f.o(1), f.o(2), f.o(3), f.width, f.height);
+              return res + vigra_imageimport_close_c(handle);
+          }(f));
+    BENCH(imageimport_bands,
+          [](Fixture & f)
+          {
+              const PixelType * bands[4] = { f.o(0), f.o(1), f.o(2), f.o(3) };
+              void * handle = vigra_imageimport_open_c(f.rgba_file.c_str());
+              int res = vigra_imageimport_bands_c(handle, bands, 4, f.width, f.height);
+              return res + vigra_imageimport_close_c(handle);
+          }(f));
+    
+    BENCH(importgrayimage_uint8,
+          vigra_importgrayimage_uint8_c(f.u8o(0), f.width, f.height, f.uint8_gray_file.c_str()));
+    BENCH(importrgbimage_uint8,
+          vigra_importrgbimage_uint8_c(f.u8o(0), f.u8o(1), f.u8o(2), f.width, f.height, f.uint8_rgba_file.c_str()));
+    BENCH(importrgbaimage_uint8,
+          vigra_importrgbaimage_uint8_c(f.u8o(0), f.u8o(1), f.u8o(2), f.u8o(3), f.width, f.height,
+                                        f.uint8_rgba_file.c_str()));
+    BENCH(imageimport_bands_uint8,
+          [](Fixture & f)
+          {
+              const UInt8PixelType * bands[4] = { f.u8o(0), f.u8o(1), f.u8o(2), f.u8o(3) };
+              void * handle = vigra_imageimport_open_c(f.uint8_rgba_file.c_str());
+              int res = vigra_imageimport_bands_uint8_c(handle, bands, 4, f.width, f.height);
+              return res + vigra_imageimport_close_c(handle);
+          }(f));
+    BENCH(exportgrayimage_uint8,
+          vigra_exportgrayimage_uint8_c(&f.u8[0], f.width, f.height, f.out_png.c_str()));
+    BENCH(exportrgbimage_uint8,
+          vigra_exportrgbimage_uint8_c(&f.u8[0], &f.u8_2[0], &f.u8[0], f.width, f.height, f.out_png.c_str()));
+    BENCH(exportrgbaimage_uint8,
+          vigra_exportrgbaimage_uint8_c(&f.u8[0], &f.u8_2[0], &f.u8[0], &f.u8_2[0], f.width, f.height,
+                                        f.out_png.c_str()));
+    
+    BENCH(importgrayimage_uint16,
+          vigra_importgrayimage_uint16_c(f.u16o(0), f.width, f.height, f.uint16_gray_file.c_str()));
+    BENCH(importrgbimage_uint16,
+          vigra_importrgbimage_uint16_c(f.u16o(0), f.u16o(1), f.u16o(2), f.width, f.height,
+                                        f.uint16_rgba_file.c_str()));
+    BENCH(importrgbaimage_uint16,
+          vigra_importrgbaimage_uint16_c(f.u16o(0), f.u16o(1), f.u16o(2), f.u16o(3), f.width, f.height,
+                                         f.uint16_rgba_file.c_str()));
+    BENCH(imageimport_bands_uint16,
+          [](Fixture & f)
+          {
+              const UInt16PixelType * bands[4] = { f.u16o(0), f.u16o(1), f.u16o(2), f.u16o(3) };
+              void * handle = vigra_imageimport_open_c(f.uint16_rgba_file.c_str());
+              int res = vigra_imageimport_bands_uint16_c(handle, bands, 4, f.width, f.height);
+              return res + vigra_imageimport_close_c(handle);
+          }(f));
+    BENCH(exportgrayimage_uint16,
+          vigra_exportgrayimage_uint16_c(&f.u16[0], f.width, f.height, f.out_file.c_str()));
+    BENCH(exportrgbimage_uint16,
+          vigra_exportrgbimage_uint16_c(&f.u16[0], &f.u16_2[0], &f.u16[0], f.width, f.height, f.out_file.c_str()));
+    BENCH(exportrgbaimage_uint16,
+          vigra_exportrgbaimage_uint16_c(&f.u16[0], &f.u16_2[0], &f.u16[0], &f.u16_2[0], f.width, f.height,
+                                         f.out_file.c_str()));
+    
+    BENCH_ASYNC(importgrayimage_async,
+                vigra_importgrayimage_async_c(f.o(0), f.width, f.height, f.gray_file.c_str()));
+    BENCH_ASYNC(importrgbimage_async,
+                vigra_importrgbimage_async_c(f.o(0), f.o(1), f.o(2), f.width, f.height, f.rgb_file.c_str()));
+    BENCH_ASYNC(exportgrayimage_async,
+                vigra_exportgrayimage_async_c(f.in(), f.width, f.height, f.out_file.c_str(), false));
+    BENCH_ASYNC(exportrgbimage_async,
+                vigra_exportrgbimage_async_c(f.in(), f.in2(), f.in(), f.width, f.height, f.out_file.c_str(), false));
+    
+#ifdef HAS_HDF5
+    //The HDF5 functions are only registered, if the library supports HDF5 at runtime
+    if(vigra_has_hdf5_c())
+    {
+        BENCH_CALL(hdf5_numdimensions,
+                   vigra_hdf5_numdimensions_c(f.hdf5_file.c_str(), "gray") != 2);
+        BENCH_CALL(hdf5_shape,
+                   [](Fixture & f)
+                   {
+                       int shape[2] = { 0, 0 };
+                       int res = vigra_hdf5_shape_c(f.hdf5_file.c_str(), "gray", shape, 2);
+                       return res + (shape[0] != f.width) + (shape[1] != f.height);
+                   }(f));
+        BENCH(hdf5_importarray,
+              [](Fixture & f)
+              {
+                  int shape[2] = { f.width, f.height };
+                  return vigra_hdf5_importarray_c(f.hdf5_file.c_str(), "gray", f.o(0), shape, 2);
+              }(f));
+        BENCH(hdf5_exportarray,
+              [](Fixture & f)
+              {
+                  //HDF5 does not reclaim the space of overwritten datasets, thus start with a new file
+                  std::remove(f.hdf5_out_file.c_str());
+                  int shape[2] = { f.width, f.height };
+                  return vigra_hdf5_exportarray_c(&f.gray[0], shape, 2, f.hdf5_out_file.c_str(), "gray");
+              }(f));
+    }
+#endif
+}
+
+/**
+ * Macro to register the benchmarks of the morphology and labeling functions for one pixel type.
+ */
+#define TYPED_MORPHOLOGY_BENCHMARKS(suffix, binary, in, out, label_out)                    \
+    BENCH(distancetransform##suffix,                                                      \
+          vigra_distancetransform##suffix##_c(binary, f.o(0), f.width, f.height, 0, 2));  \
+    BENCH(euclideandistancetransform##suffix,                                             \
+          vigra_euclideandistancetransform##suffix##_c(binary, f.o(0), &f.nearest[0],     \
+                                                       f.width, f.height, 0, 1.0f, 1.0f));\
+    BENCH(discerosion##suffix,                                                            \
+          vigra_discerosion##suffix##_c(in, out, f.width, f.height, 3));                  \
+    BENCH(discdilation##suffix,                                                           \
+          vigra_discdilation##suffix##_c(in, out, f.width, f.height, 3));                 \
+    BENCH(morphology_rect15##suffix,                                                      \
+          vigra_morphology##suffix##_c(in, out, f.width, f.height, 0, 0, 15, 15));        \
+    BENCH(morphology_octagon15##suffix,                                                   \
+          vigra_morphology##suffix##_c(in, out, f.width, f.height, 2, 3, 15, 0));         \
+    BENCH(morphology_disc3##suffix,                                                       \
+          vigra_morphology##suffix##_c(in, out, f.width, f.height, 0, 4, 3, 0));          \
+    BENCH(labelimage##suffix,                                                             \
+          vigra_labelimage##suffix##_c(binary, label_out, f.width, f.height, true));      \
+    BENCH(labelimagewithbackground##suffix,                                               \
+          vigra_labelimagewithbackground##suffix##_c(binary, label_out, f.width,          \
+                                                     f.height, true, 0));                 \
+    BENCH(parallellabelimage##suffix,                                                     \
+          vigra_parallellabelimage##suffix##_c(binary, &f.labels[0], f.width, f.height,   \
+                                               true, nullptr));                           \
+    BENCH(parallellabelimagewithbackground##suffix,                                       \
+          vigra_parallellabelimagewithbackground##suffix##_c(binary, &f.labels[0],        \
+                                                             f.width, f.height, true, 0,  \
+                                                             nullptr))
+
+static void registerMorphologyBenchmarks()
+{
+    TYPED_MORPHOLOGY_BENCHMARKS(, &f.binary[0], f.in(), f.o(0), f.o(1));
+    TYPED_MORPHOLOGY_BENCHMARKS(_uint8, &f.u8_binary[0], &f.u8[0], f.u8o(0), &f.labels[0]);
+    TYPED_MORPHOLOGY_BENCHMARKS(_uint16, &f.u16_binary[0], &f.u16[0], f.u16o(0), &f.labels[0]);
+    
+    BENCH(voronoidistancetransform,
+          vigra_voronoidistancetransform_c(&f.seeds[0], f.o(0), f.o(1), f.width, f.height, 1.0f, 1.0f));
+    BENCH(voronoidistancetransform_labels,
+          [](Fixture & f)
+          {
+              std::copy(f.seeds.begin(), f.seeds.end(), f.seed_labels.begin());
+              return vigra_voronoidistancetransform_labels_c(&f.seed_labels[0], f.o(0), &f.labels[0],
+                                                             f.width, f.height, 1.0f, 1.0f);
+          }(f));
+    
+    BENCH(upwindimage,
+          vigra_upwindimage_c(f.in(), f.in2(), f.o(0), f.width, f.height, 0.3f));
+}
+
+static void registerSegmentationBenchmarks()
+{
+    BENCH(watershedsunionfind,
+          vigra_watershedsunionfind_c(f.in(), f.o(0), f.width, f.height, true));
+    BENCH(watershedsunionfind_labels,
+          vigra_watershedsunionfind_labels_c(f.in(), &f.labels[0], f.width, f.height, true));
+    BENCH(watershedsregiongrowing,
+          [](Fixture & f)
+          {
+              //The seeds are overwritten by the result
+              std::copy(f.seeds.begin(), f.seeds.end(), f.out[0].begin());
+              return vigra_watershedsregiongrowing_c(f.in(), f.o(0), f.width, f.height, true, false, true, -1.0);
+          }(f));
+    BENCH(watershedsregiongrowing_labels,
+          [](Fixture & f)
+          {
+              //The seeds are overwritten by the result
+              std::copy(f.seeds.begin(), f.seeds.end(), f.seed_labels.begin());
+              return vigra_watershedsregiongrowing_labels_c(f.in(), &f.seed_labels[0], f.width, f.height,
+                                                            true, false, true, -1.0);
+          }(f));
+    BENCH(slic_gray,
+          vigra_slic_gray_c(f.in(), f.o(0), f.width, f.height, 15, 20.0, 10));
+    BENCH(slic_gray_labels,
+          vigra_slic_gray_labels_c(f.in(), &f.labels[0], f.width, f.height, 15, 20.0, 10));
+    BENCH(slic_rgb,
+          vigra_slic_rgb_c(f.in(), f.in2(), f.in(), f.o(0), f.width, f.height, 15, 20.0, 10));
+    BENCH(slic_rgb_labels,
+          vigra_slic_rgb_labels_c(f.in(), f.in2(), f.in(), &f.labels[0], f.width, f.height, 15, 20.0, 10));
+    BENCH(cannyedgeimage,
+          vigra_cannyedgeimage_c(f.in(), f.o(0), f.width, f.height, 2.0f, 5.0f, 255.0f));
+    BENCH(differenceofexponentialedgeimage,
+          vigra_differenceofexponentialedgeimage_c(f.in(), f.o(0), f.width, f.height, 2.0f, 5.0f, 255.0f));
+    BENCH(regionimagetocrackedgeimage,
+          vigra_regionimagetocrackedgeimage_c(&f.regions[0], &f.crackedges[0], f.width, f.height, 0.0f));
+    BENCH(regionimagetocrackedgeimage_labels,
+          vigra_regionimagetocrackedgeimage_labels_c(&f.region_labels[0], &f.crack_labels[0],
+                                                     f.width, f.height, 0));
+    BENCH(extractfeatures_gray,
+          vigra_extractfeatures_gray_c(f.in(), &f.regions[0], &f.features[0], f.width, f.height, f.max_label));
+    BENCH(extractfeatures_gray_labels,
+          vigra_extractfeatures_gray_labels_c(f.in(), &f.region_labels[0], &f.features[0],
+                                              f.width, f.height, f.max_label));
+    BENCH(regionfeatures_tiles,
+          [](Fixture & f)
+          {
+              //Feeds tiles of 256 rows from the full-size bands
+              void * handle = vigra_regionfeatures_create_c(f.max_label);
+              int res = 0;
+              for(int y=0; y<f.height; y+=256)
+              {
+                  const std::size_t offset = std::size_t(y)*f.width;
+                  res += vigra_regionfeatures_addtile_c(handle, f.in() + offset, &f.region_labels[offset],
+                                                        f.width, std::min(256, f.height-y), 0, y);
+              }
+              res += vigra_regionfeatures_finalize_c(handle, &f.features[0]);
+              return res + vigra_regionfeatures_delete_c(handle);
+          }(f));
+    BENCH(regionfeatures_tiles_merge,
+          [](Fixture & f)
+          {
+              //Feeds the upper and lower half to separate handles (e.g. of two workers) and merges them
+              void * upper = vigra_regionfeatures_create_c(f.max_label),
+                   * lower = vigra_regionfeatures_create_c(f.max_label);
+              const int half = f.height/2;
+              const std::size_t offset = std::size_t(half)*f.width;
+              int res = vigra_regionfeatures_addtile_c(upper, f.in(), &f.region_labels[0],
+                                                       f.width, half, 0, 0);
+              res += vigra_regionfeatures_addtile_c(lower, f.in() + offset, &f.region_labels[offset],
+                                                    f.width, f.height - half, 0, half);
+              res += vigra_regionfeatures_merge_c(upper, lower);
+              res += vigra_regionfeatures_finalize_c(upper, &f.features[0]);
+              return res + vigra_regionfeatures_delete_c(upper) + vigra_regionfeatures_delete_c(lower);
+          }(f));
+    BENCH(extractfeatures_rgb,
+          vigra_extractfeatures_rgb_c(f.in(), f.in2(), f.in(), &f.regions[0], &f.features[0],
+                                      f.width, f.height, f.max_label));
+    BENCH(extractfeatures_rgb_labels,
+          vigra_extractfeatures_rgb_labels_c(f.in(), f.in2(), f.in(), &f.region_labels[0], &f.features[0],
+                                             f.width, f.height, f.max_label));
+    
+    BENCH_CALL(houghtransform_lines,
+               [](Fixture & f)
+               {
+                   void * lines = vigra_houghtransform_lines_c(&f.binary[0], 512, 512, 180, 50);
+                   int count = vigra_houghtransform_get_line_count_c(lines);
+                   std::vector<PixelType> arr(3*std::max(count, 1));
+                   int res = vigra_houghtransform_get_lines_c(lines, &arr[0], 3, count);
+                   return res + vigra_houghtransform_delete_lines_c(lines);
+               }(f));
+    BENCH_CALL(houghtransform_circles,
+               [](Fixture & f)
+               {
+                   void * circles = vigra_houghtransform_circles_c(&f.binary[0], 512, 512, 5, 20, 0.5f);
+                   int count = vigra_houghtransform_get_circle_count_c(circles);
+                   std::vector<PixelType> arr(4*std::max(count, 1));
+                   int res = vigra_houghtransform_get_circles_c(circles, &arr[0], 4, count);
+                   return res + vigra_houghtransform_delete_circles_c(circles);
+               }(f));
+}
+
+static void registerTensorBenchmarks()
+{
+    BENCH(structuretensor,
+          vigra_structuretensor_c(f.in(), f.o(0), f.o(1), f.o(2), f.width, f.height, 1.0f, 3.0f));
+    BENCH(boundarytensor,
+          vigra_boundarytensor_c(f.in(), f.o(0), f.o(1), f.o(2), f.width, f.height, 2.0f));
+    BENCH(boundarytensor1,
+          vigra_boundarytensor1_c(f.in(), f.o(0), f.o(1), f.o(2), f.width, f.height, 2.0f));
+    BENCH(gradientenergytensor,
+          vigra_gradientenergytensor_c(f.in(), deriv_3, smooth_3, f.o(0), f.o(1), f.o(2), f.width, f.height, 3, 3));
+    BENCH(tensoreigenrepresentation,
+          vigra_tensoreigenrepresentation_c(f.in(), &f.binary[0], f.in2(), f.o(0), f.o(1), f.o(2), f.width, f.height));
+    BENCH(tensortrace,
+          vigra_tensortrace_c(f.in(), &f.binary[0], f.in2(), f.o(0), f.width, f.height));
+    BENCH(tensortoedgecorner,
+          vigra_tensortoedgecorner_c(f.in(), &f.binary[0], f.in2(), f.o(0), f.o(1), f.o(2), f.width, f.height));
+    BENCH(hourglassfilter,
+          vigra_hourglassfilter_c(f.in(), &f.binary[0], f.in2(), f.o(0), f.o(1), f.o(2), f.width, f.height,
+                                  1.0f, 0.4f));
+    
+    BENCH_ASYNC(structuretensor_async,
+                vigra_structuretensor_async_c(f.in(), f.o(0), f.o(1), f.o(2), f.width, f.height, 1.0f, 3.0f));
+    BENCH_ASYNC(boundarytensor_async,
+                vigra_boundarytensor_async_c(f.in(), f.o(0), f.o(1), f.o(2), f.width, f.height, 2.0f));
+}
+
+/**
+ * Registers the benchmarks of one accessor of the spline image views, which
+ * are evaluated at spline_samples^2 positions, both by pointer and by address.
+ */
+static void addSplineAccessor(const std::string & name,
+                              const int order,
+                              float (*accessor)(void *, const double, const double),
+                              float (*accessor_by_address)(const unsigned long, const double, const double))
+{
+    add(name, SAMPLES, 0, false,
+        [=](Fixture & f)
+        {
+            void * siv = f.splineView(order);
+            const double sx = (f.width-1.0)/spline_samples, sy = (f.height-1.0)/spline_samples;
+            double sum = 0;
+            for(int y=0; y<spline_samples; ++y)
+            {
+                for(int x=0; x<spline_samples; ++x)
+                {
+                    sum += accessor(siv, x*sx, y*sy);
+                }
+            }
+            f.sink += sum;
+            return siv == nullptr;
+        });
+    add(name + "_by_address", SAMPLES, 0, false,
+        [=](Fixture & f)
+        {
+            unsigned long address = f.splineAddress(order);
+            const double sx = (f.width-1.0)/spline_samples, sy = (f.height-1.0)/spline_samples;
+            double sum = 0;
+            for(int y=0; y<spline_samples; ++y)
+            {
+                for(int x=0; x<spline_samples; ++x)
+                {
+                    sum += accessor_by_address(address, x*sx, y*sy);
+                }
+            }
+            f.sink += sum;
+            return address == 0;
+        });
+}
+
+/**
+ * Macros to register the benchmarks of the spline image views of one order.
+ */
+#define SPLINE_ACCESSOR_BENCHMARK(order, name)                                              \
+    addSplineAccessor("splineimageview" #order "_" #name, order,                          \
+                      vigra_splineimageview##order##_##name##_c,                          \
+                      vigra_splineimageview##order##_##name##_by_address_c)
+
+#define SPLINE_BENCHMARKS(order)                                                          \
+    BENCH(create_delete_splineimageview##order,                                           \
+          vigra_delete_splineimageview##order##_c(                                        \
+              vigra_create_splineimageview##order##_c(f.in(), f.width, f.height)));       \
+    BENCH(create_delete_splineimageview##order##_by_address,                              \
+          vigra_delete_splineimageview##order##_by_address_c(                             \
+              vigra_create_splineimageview##order##_address_c(f.in(), f.width, f.height))); \
+    SPLINE_ACCESSOR_BENCHMARK(order, accessor);                                           \
+    SPLINE_ACCESSOR_BENCHMARK(order, dx);                                                 \
+    SPLINE_ACCESSOR_BENCHMARK(order, dy);                                                 \
+    SPLINE_ACCESSOR_BENCHMARK(order, dxx);                                                \
+    SPLINE_ACCESSOR_BENCHMARK(order, dxy);                                                \
+    SPLINE_ACCESSOR_BENCHMARK(order, dyy);                                                \
+    SPLINE_ACCESSOR_BENCHMARK(order, dx3);                                                \
+    SPLINE_ACCESSOR_BENCHMARK(order, dxxy);                                               \
+    SPLINE_ACCESSOR_BENCHMARK(order, dxyy);                                               \
+    SPLINE_ACCESSOR_BENCHMARK(order, dy3);                                                \
+    SPLINE_ACCESSOR_BENCHMARK(order, g2);                                                 \
+    SPLINE_ACCESSOR_BENCHMARK(order, g2x);                                                \
+    SPLINE_ACCESSOR_BENCHMARK(order, g2y);                                                \
+    SPLINE_ACCESSOR_BENCHMARK(order, g2xx);                                               \
+    SPLINE_ACCESSOR_BENCHMARK(order, g2xy);                                               \
+    SPLINE_ACCESSOR_BENCHMARK(order, g2yy)
+
+static void registerSplineBenchmarks()
+{
+    SPLINE_BENCHMARKS(1);
+    SPLINE_BENCHMARKS(2);
+    SPLINE_BENCHMARKS(3);
+    SPLINE_BENCHMARKS(4);
+    SPLINE_BENCHMARKS(5);
+}
+
+/**
+ * The options of the command line.
+ */
+struct Options
+{
+    Options()
+    : sizes({512, 2048, 8192}),
+      min_time(0.5),
+      max_iterations(1000),
+      threads(-2),
+      dispatch(-2),
+      tmpdir("."),
+      full(false),
+      list(false)
+    {
+    }
+    
+    std::vector<int> sizes;
+    std::string filter;
+    double min_time;
+    int max_iterations;
+    int threads;
+    int dispatch;
+    std::string tmpdir;
+    std::string out;
+    bool full;
+    bool list;
+};
+
+static int dispatchPath(const std::string & name)
+{
+    if(name == "auto")   return -1;
+    if(name == "scalar") return 0;
+    if(name == "sse2")   return 1;
+    if(name == "avx2")   return 8;
+    if(name == "avx512") return 32;
+    if(name == "neon")   return 64;
+    return std::atoi(name.c_str());
+}
+
+static bool parseOptions(int argc, char ** argv, Options & options)
+{
+    for(int i=1; i<argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool has_value = (i+1 < argc);
+        
+        if(arg == "--sizes" && has_value)
+        {
+            options.sizes.clear();
+            std::stringstream ss(argv[++i]);
+            std::string item;
+            while(std::getline(ss, item, ','))
+            {
+                options.sizes.push_back(std::atoi(item.c_str()));
+            }
+        }
+        else if(arg == "--filter" && has_value)         options.filter = argv[++i];
+        else if(arg == "--min-time" && has_value)       options.min_time = std::atof(argv[++i]);
+        else if(arg == "--max-iterations" && has_value) options.max_iterations = std::atoi(argv[++i]);
+        else if(arg == "--threads" && has_value)        options.threads = std::atoi(argv[++i]);
+        else if(arg == "--dispatch" && has_value)       options.dispatch = dispatchPath(argv[++i]);
+        else if(arg == "--tmpdir" && has_value)         options.tmpdir = argv[++i];
+        else if(arg == "--out" && has_value)            options.out = argv[++i];
+        else if(arg == "--full")                        options.full = true;
+        else if(arg == "--list")                        options.list = true;
+        else
+        {
+            if(arg != "--help")
+            {
+                std::cerr << "Unknown option: " << arg << "\n";
+            }
+            std::cerr << "Usage: vigra_c_bench [--sizes 512,2048,8192] [--filter text] [--min-time s]\n"
+                      << "                     [--max-iterations n] [--threads n] [--dispatch path]\n"
+                      << "                     [--tmpdir dir] [--full] [--out file] [--list]\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * The result of one benchmark at one image size.
+ */
+struct Result
+{
+    const Benchmark * benchmark;
+    int width, height;
+    int status;
+    int iterations;
+    double mean_ns, min_ns;
+};
+
+/**
+ * Runs one benchmark: a warm-up call, which also determines the status, and
+ * then repeated calls until the minimal time or number of iterations is reached.
+ */
+static Result runBenchmark(const Benchmark & benchmark, Fixture & f, const Options & options)
+{
+    typedef std::chrono::steady_clock Clock;
+    
+    Result result = { &benchmark, f.width, f.height, 0, 0, 0.0, 0.0 };
+    
+    result.status = benchmark.run(f);
+    
+    double total_ns = 0.0, min_ns = 0.0;
+    
+    while(result.iterations < options.max_iterations &&
+          (result.iterations == 0 || total_ns < options.min_time*1e9))
+    {
+        Clock::time_point start = Clock::now();
+        benchmark.run(f);
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        
+        total_ns += ns;
+        min_ns = (result.iterations == 0) ? ns : std::min(min_ns, ns);
+        ++result.iterations;
+    }
+    result.mean_ns = total_ns / std::max(result.iterations, 1);
+    result.min_ns  = min_ns;
+    return result;
+}
+
+static void writeJSON(std::ostream & os, const std::vector<Result> & results, const Options & options)
+{
+    char date[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+    
+    os << "{\n"
+       << "  \"context\": {\n"
+       << "    \"library\": \"vigra_c\",\n"
+       << "    \"date\": \"" << date << "\",\n"
+       << "    \"num_threads\": " << vigra_get_num_threads_c() << ",\n"
+       << "    \"cpu_features\": " << vigra_cpu_features_c() << ",\n"
+       << "    \"cpu_dispatch\": " << vigra_cpu_dispatch_c() << ",\n"
+       << "    \"stats_enabled\": " << vigra_stats_enabled_c() << ",\n"
+       << "    \"min_time\": " << options.min_time << ",\n"
+       << "    \"spline_samples\": " << spline_samples*spline_samples << "\n"
+       << "  },\n"
+       << "  \"benchmarks\": [";
+    
+    for(std::size_t i=0; i<results.size(); ++i)
+    {
+        const Result & r = results[i];
+        const Benchmark & b = *r.benchmark;
+        
+        double items = (b.unit == PIXELS)  ? double(r.width)*r.height :
+                       (b.unit == SAMPLES) ? double(spline_samples)*spline_samples : 0.0;
+        
+        os << (i ? ",\n" : "\n")
+           << "    {\"name\": \"" << b.name << "\""
+           << ", \"width\": " << r.width
+           << ", \"height\": " << r.height
+           << ", \"status\": " << r.status
+           << ", \"iterations\": " << r.iterations
+           << ", \"mean_time_ns\": " << r.mean_ns
+           << ", \"min_time_ns\": " << r.min_ns;
+        
+        if(items > 0)
+        {
+            os << ", \"mpix_per_second\": " << items / r.mean_ns * 1e3;
+        }
+        else
+        {
+            os << ", \"calls_per_second\": " << 1e9 / r.mean_ns;
+        }
+        if(b.bytes_per_pixel > 0)
+        {
+            os << ", \"gb_per_second\": " << items * b.bytes_per_pixel / r.mean_ns;
+        }
+        os << "}";
+    }
+    os << "\n  ]\n}\n";
+}
+
+int main(int argc, char ** argv)
+{
+    Options options;
+    
+    if(!parseOptions(argc, argv, options))
+    {
+        return 1;
+    }
+    
+    registerConvertBenchmarks();
+    registerControlBenchmarks();
+    registerFilterBenchmarks();
+    registerImgprocBenchmarks();
+    registerImpexBenchmarks();
+    registerMorphologyBenchmarks();
+    registerSegmentationBenchmarks();
+    registerSplineBenchmarks();
+    registerTensorBenchmarks();
+    
+    if(options.list)
+    {
+        for(const Benchmark & b : benchmarks())
+        {
+            std::cout << b.name << "\n";
+        }
+        return 0;
+    }
+    
+    if(options.threads != -2)
+    {
+        vigra_set_num_threads_c(options.threads);
+    }
+    if(options.dispatch != -2 && vigra_set_cpu_dispatch_c(options.dispatch) != 0)
+    {
+        std::cerr << "The requested dispatch path is not available.\n";
+        return 1;
+    }
+    
+    std::vector<Result> results;
+    
+    for(int size : options.sizes)
+    {
+        Fixture f(size, options.tmpdir);
+        
+        for(const Benchmark & b : benchmarks())
+        {
+            if(b.name.find(options.filter) == std::string::npos ||
+               (b.slow && size > max_slow_size && !options.full))
+            {
+                continue;
+            }
+            std::cerr << b.name << " (" << size << "x" << size << ")..." << std::endl;
+            results.push_back(runBenchmark(b, f, options));
+        }
+    }
+    
+    if(options.out.empty())
+    {
+        writeJSON(std::cout, results, options);
+    }
+    else
+    {
+        std::ofstream file(options.out.c_str());
+        writeJSON(file, results, options);
+    }
+    return 0;
+}
@@ -67,4 +67,22 @@ typedef float PixelType;
  */
 typedef vigra::MultiArrayView<2, PixelType> ImageView;
 
+/**
+ * The PixelType of the typed 8-bit variants (*_uint8_c) of some functions:
+ * unsigned char
+ */
+typedef unsigned char UInt8PixelType;
+
+/**
+ * The PixelType of the typed 16-bit variants (*_uint16_c) of some functions:
+ * unsigned short
+ */
+typedef unsigned short UInt16PixelType;
+
+/**
+ * The LabelType, which is used by the typed variants of the labeling functions:
+ * unsigned int
+ */
+typedef unsigned int LabelType;
+
 #endif
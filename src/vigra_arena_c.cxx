@@ -0,0 +1,298 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#include "vigra_arena_c.h"
+#include "vigra_arenautils_c.h"
+#include "vigra_statsutils_c.h"
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+/**
+ * @file
+ * @brief Implementation of the per-thread scratch arena
+ */
+
+/**
+ * The alignment of the blocks in bytes.
+ */
+static const std::size_t arena_alignment = 64;
+
+/**
+ * The smallest bucket holds blocks of 2^arena_min_bucket bytes.
+ */
+static const int arena_min_bucket = 12;
+
+/**
+ * The number of buckets, i.e. blocks of up to 64 MB are kept for reuse.
+ * Larger blocks are allocated and freed directly.
+ */
+static const int arena_num_buckets = 15;
+
+/**
+ * The maximal number of idle blocks, which are kept per bucket and thread.
+ */
+static const std::size_t arena_max_idle_blocks = 4;
+
+/**
+ * The maximal number of bytes of the idle blocks, which are kept per thread.
+ */
+static const std::size_t arena_max_idle_bytes = std::size_t(256)*1024*1024;
+
+/**
+ * The bucket index of a block size.
+ */
+static int arenaBucket(std::size_t bytes)
+{
+    int bucket = arena_min_bucket;
+    while(bucket < arena_min_bucket + arena_num_buckets && (std::size_t(1) << bucket) < bytes)
+    {
+        ++bucket;
+    }
+    return bucket - arena_min_bucket;
+}
+
+/**
+ * The block size of a bucket in bytes.
+ */
+static std::size_t arenaBucketBytes(int bucket)
+{
+    return std::size_t(1) << (bucket + arena_min_bucket);
+}
+
+/**
+ * Allocates an aligned block. The pointer to the allocated memory is stored 
+ * in front of the aligned block. The global operator new is used, such that
+ * the misses of the arena are visible in the allocation counters of the
+ * statistics (see vigra_stats_c.h).
+ */
+static void * arenaAllocate(std::size_t bytes)
+{
+    char * raw = static_cast<char*>(::operator new(bytes + arena_alignment + sizeof(void*)));
+    std::uintptr_t aligned = (std::uintptr_t(raw) + sizeof(void*) + arena_alignment - 1) & ~std::uintptr_t(arena_alignment - 1);
+    reinterpret_cast<void**>(aligned)[-1] = raw;
+    return reinterpret_cast<void*>(aligned);
+}
+
+static void arenaDeallocate(void * block)
+{
+    ::operator delete(reinterpret_cast<void**>(block)[-1]);
+}
+
+/**
+ * The scratch arena of one thread, which keeps the idle blocks of each bucket.
+ * If a released block exceeds the byte budget of the idle blocks, the idle
+ * blocks of the largest buckets are freed first.
+ * The mutex is only contended, if the arena is trimmed by another thread.
+ */
+class ScratchArena
+{
+public:
+    ScratchArena();
+    ~ScratchArena();
+    
+    void * acquire(int bucket);
+    void release(void * block, int bucket);
+    void trim();
+    
+private:
+    std::mutex m_mutex;
+    std::vector<void*> m_idle[arena_num_buckets];
+    std::size_t m_idle_bytes;
+};
+
+/**
+ * The arenas of all running threads. Both are intentionally never destroyed,
+ * since threads of the worker pool may exit after the static destructors of
+ * this file have been run.
+ */
+static std::mutex & arenaRegistryMutex()
+{
+    static std::mutex * mutex = new std::mutex;
+    return *mutex;
+}
+
+static std::vector<ScratchArena*> & arenaRegistry()
+{
+    static std::vector<ScratchArena*> * registry = new std::vector<ScratchArena*>;
+    return *registry;
+}
+
+ScratchArena::ScratchArena()
+: m_idle_bytes(0)
+{
+    std::lock_guard<std::mutex> lock(arenaRegistryMutex());
+    arenaRegistry().push_back(this);
+}
+
+ScratchArena::~ScratchArena()
+{
+    {
+        std::lock_guard<std::mutex> lock(arenaRegistryMutex());
+        std::vector<ScratchArena*> & registry = arenaRegistry();
+        for(std::size_t i=0; i<registry.size(); ++i)
+        {
+            if(registry[i] == this)
+            {
+                registry.erase(registry.begin() + i);
+                break;
+            }
+        }
+    }
+    trim();
+}
+
+void * ScratchArena::acquire(int bucket)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<void*> & idle = m_idle[bucket];
+    
+    if(idle.empty())
+    {
+        return nullptr;
+    }
+    void * block = idle.back();
+    idle.pop_back();
+    m_idle_bytes -= arenaBucketBytes(bucket);
+    return block;
+}
+
+void ScratchArena::release(void * block, int bucket)
+{
+    const std::size_t bytes = arenaBucketBytes(bucket);
+    
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<void*> & idle = m_idle[bucket];
+        
+        if(idle.size() < arena_max_idle_blocks)
+        {
+            //Evict the largest idle blocks, until the block fits into the budget
+            for(int b=arena_num_buckets-1; b>=0 && m_idle_bytes + bytes > arena_max_idle_bytes; --b)
+            {
+                while(!m_idle[b].empty() && m_idle_bytes + bytes > arena_max_idle_bytes)
+                {
+                    arenaDeallocate(m_idle[b].back());
+                    m_idle[b].pop_back();
+                    m_idle_bytes -= arenaBucketBytes(b);
+                }
+            }
+            
+            if(idle.capacity() == 0)
+            {
+                idle.reserve(arena_max_idle_blocks);
+            }
+            idle.push_back(block);
+            m_idle_bytes += bytes;
+            return;
+        }
+    }
+    arenaDeallocate(block);
+}
+
+void ScratchArena::trim()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for(int bucket=0; bucket<arena_num_buckets; ++bucket)
+    {
+        for(void * block : m_idle[bucket])
+        {
+            arenaDeallocate(block);
+        }
+        m_idle[bucket].clear();
+    }
+    m_idle_bytes = 0;
+}
+
+/**
+ * The arena of the calling thread. It is created at the first use and 
+ * releases all idle blocks, when the thread exits.
+ */
+static ScratchArena & localArena()
+{
+    static thread_local ScratchArena arena;
+    return arena;
+}
+
+void * arenaAcquire(std::size_t bytes)
+{
+    if(bytes == 0)
+    {
+        return nullptr;
+    }
+    
+    int bucket = arenaBucket(bytes);
+    if(bucket == arena_num_buckets)
+    {
+        return arenaAllocate(bytes);
+    }
+    
+    void * block = localArena().acquire(bucket);
+    if(block == nullptr)
+    {
+        block = arenaAllocate(arenaBucketBytes(bucket));
+    }
+    return block;
+}
+
+void arenaRelease(void * block, std::size_t bytes)
+{
+    if(block == nullptr)
+    {
+        return;
+    }
+    
+    int bucket = arenaBucket(bytes);
+    if(bucket == arena_num_buckets)
+    {
+        arenaDeallocate(block);
+    }
+    else
+    {
+        localArena().release(block, bucket);
+    }
+}
+
+LIBEXPORT int vigra_arena_trim_c()
+{
+    VIGRA_C_STATS_SCOPE(0);
+    std::lock_guard<std::mutex> lock(arenaRegistryMutex());
+    for(ScratchArena * arena : arenaRegistry())
+    {
+        arena->trim();
+    }
+    return 0;
+}
@@ -0,0 +1,71 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#ifndef VIGRA_ARENA_C_H
+#define VIGRA_ARENA_C_H
+
+#include "config.h"
+
+/**
+ * @file
+ * @brief Header file for the control of the scratch memory
+ *
+ * @defgroup arena Scratch memory
+ * @{
+ *    @brief Release of the temporary images, which are kept for reuse
+ *
+ * Many functions need full-size temporary images, e.g. for labels, tensors
+ * or Fourier spectra. These are drawn from a per-thread arena, which keeps
+ * released blocks in power-of-two size buckets. Thus, repeated calls for 
+ * images of the same size (e.g. frames of a video) do not allocate memory 
+ * after the first call. Each thread keeps blocks of up to 64 MB and at most
+ * 256 MB of idle blocks. Larger blocks are freed directly.
+ */
+
+/**
+ * Releases all temporary images, which are currently kept for reuse by the
+ * scratch arenas of all threads. Images, which are in use by running functions,
+ * are not affected. This may e.g. be called after processing large images to
+ * give the memory back to the system.
+ *
+ * \return Always 0.
+ */
+LIBEXPORT int vigra_arena_trim_c();
+
+/**
+ * @}
+ */
+
+#endif
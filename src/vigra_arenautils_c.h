@@ -0,0 +1,136 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#ifndef VIGRA_ARENAUTILS_H
+#define VIGRA_ARENAUTILS_H
+
+#include "config.h"
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * @file
+ * @brief Header-only file for the use of the scratch arena
+ *
+ * @defgroup arenautils Scratch memory utilities
+ * @{
+ *    @brief Internal temporary images, which are drawn from the per-thread scratch arena (Header-only file)
+ */
+
+/**
+ * Internal helper to acquire a block of memory from the scratch arena of
+ * the calling thread. The block is aligned to 64 bytes and not initialized.
+ *
+ * \param bytes The needed size of the block in bytes.
+ *
+ * \return The block, or nullptr if bytes is zero.
+ */
+void * arenaAcquire(std::size_t bytes);
+
+/**
+ * Internal helper to give a block of memory back to the scratch arena of
+ * the calling thread.
+ *
+ * \param block The block, as returned by arenaAcquire.
+ * \param bytes The size of the block in bytes, as passed to arenaAcquire.
+ */
+void arenaRelease(void * block, std::size_t bytes);
+
+/**
+ * Internal temporary image, which may be used instead of a vigra::MultiArray.
+ * Its memory is drawn from the scratch arena and given back at destruction.
+ * In contrast to a vigra::MultiArray, the pixels are not initialized. Thus,
+ * it may only be used for pixel types without non-trivial construction
+ * and for images, which are completely written before they are read.
+ */
+template <class T>
+class ScratchImage
+: public vigra::MultiArrayView<2, T>
+{
+public:
+    typedef vigra::MultiArrayView<2, T> view_type;
+    
+    using view_type::operator=;
+    
+    ScratchImage()
+    : m_bytes(0)
+    {
+    }
+    
+    explicit ScratchImage(const vigra::Shape2 & shape)
+    : m_bytes(0)
+    {
+        reshape(shape);
+    }
+    
+    ScratchImage(const int width, const int height)
+    : m_bytes(0)
+    {
+        reshape(vigra::Shape2(width, height));
+    }
+    
+    ScratchImage(const ScratchImage &) = delete;
+    ScratchImage & operator=(const ScratchImage &) = delete;
+    
+    ~ScratchImage()
+    {
+        arenaRelease(this->m_ptr, m_bytes);
+    }
+    
+    /**
+     * (Re-)allocates the image for the given shape. The former contents are lost.
+     */
+    void reshape(const vigra::Shape2 & shape)
+    {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "ScratchImage needs a trivial pixel type");
+        
+        arenaRelease(this->m_ptr, m_bytes);
+        m_bytes = std::size_t(shape[0])*shape[1]*sizeof(T);
+        
+        this->m_shape  = shape;
+        this->m_stride = vigra::Shape2(1, shape[0]);
+        this->m_ptr    = static_cast<T*>(arenaAcquire(m_bytes));
+    }
+    
+private:
+    std::size_t m_bytes;
+};
+
+/**
+ * @}
+ */
+
+#endif
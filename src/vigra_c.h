@@ -34,13 +34,18 @@
 
 #ifndef VIGRA_C_H
 
+#include "vigra_arena_c.h"
 #include "vigra_convert_c.h"
+#include "vigra_dispatch_c.h"
+#include "vigra_fft_c.h"
 #include "vigra_filters_c.h"
 #include "vigra_imgproc_c.h"
 #include "vigra_impex_c.h"
 #include "vigra_morphology_c.h"
+#include "vigra_parallel_c.h"
 #include "vigra_segmentation_c.h"
 #include "vigra_splineimageview_c.h"
+#include "vigra_stats_c.h"
 #include "vigra_tensors_c.h"
 
 /**
@@ -33,6 +33,8 @@
 /************************************************************************/
 
 #include "vigra_convert_c.h"
+#include "vigra_dispatchutils_c.h"
+#include "vigra_statsutils_c.h"
 #include <cstring>
 #include <algorithm>
 
@@ -47,18 +49,8 @@ LIBEXPORT int vigra_convert_grayband_to_argb_c(const PixelType *arr_in,
                                                const int width,
                                                const int height)
 {
-    const PixelType* gray_ptr = arr_in;
-    const PixelType* gray_end = gray_ptr + (width*height);
-    
-    unsigned char* argb_ptr = (unsigned char*)argb_arr_out;
-    
-    for ( ; gray_ptr != gray_end; ++gray_ptr, argb_ptr+=4)
-    {
-        argb_ptr[0] = 255;
-        argb_ptr[1] = vigra::max(vigra::min(*gray_ptr, 255.0f), 0.0f);
-        argb_ptr[2] = argb_ptr[1];
-        argb_ptr[3] = argb_ptr[1];
-    }
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*sizeof(PixelType) + std::size_t(width)*height*4);
+    convertKernels().gray_to_argb(arr_in, (unsigned char*)argb_arr_out, std::size_t(width)*height);
     return 0;
 }
 
@@ -69,20 +61,9 @@ LIBEXPORT int vigra_convert_rgbbands_to_argb_c(const PixelType * arr_r_in,
                                                const int width,
                                                const int height)
 {
-    const PixelType* r_ptr = arr_r_in;
-    const PixelType* g_ptr = arr_g_in;
-    const PixelType* b_ptr = arr_b_in;
-    const PixelType* r_end = r_ptr + (width*height);
-    
-    unsigned char* argb_ptr = (unsigned char*)argb_arr_out;
-    
-    for ( ; r_ptr != r_end ; ++r_ptr, ++g_ptr, ++b_ptr, argb_ptr+=4)
-    {
-        argb_ptr[0] = 255;
-        argb_ptr[1] = vigra::max(vigra::min(*r_ptr, 255.0f), 0.0f);
-        argb_ptr[2] = vigra::max(vigra::min(*g_ptr, 255.0f), 0.0f);
-        argb_ptr[3] = vigra::max(vigra::min(*b_ptr, 255.0f), 0.0f);
-    }
+    VIGRA_C_STATS_SCOPE(3*std::size_t(width)*height*sizeof(PixelType) + std::size_t(width)*height*4);
+    convertKernels().rgb_to_argb(arr_r_in, arr_g_in, arr_b_in,
+                                 (unsigned char*)argb_arr_out, std::size_t(width)*height);
     return 0;
 }
 
@@ -94,21 +75,9 @@ LIBEXPORT int vigra_convert_rgbabands_to_argb_c(const PixelType * arr_r_in,
                                                 const int width,
                                                 const int height)
 {
-    const PixelType* r_ptr = arr_r_in;
-    const PixelType* g_ptr = arr_g_in;
-    const PixelType* b_ptr = arr_b_in;
-    const PixelType* a_ptr = arr_a_in;
-    const PixelType* r_end = r_ptr + (width*height);
-    
-    unsigned char* argb_ptr = (unsigned char*)argb_arr_out;
-    
-    for ( ; r_ptr != r_end ; ++r_ptr, ++g_ptr, ++b_ptr, ++a_ptr, argb_ptr+=4)
-    {
-        argb_ptr[0] = vigra::max(vigra::min(*a_ptr, 255.0f), 0.0f);
-        argb_ptr[1] = vigra::max(vigra::min(*r_ptr, 255.0f), 0.0f);
-        argb_ptr[2] = vigra::max(vigra::min(*g_ptr, 255.0f), 0.0f);
-        argb_ptr[3] = vigra::max(vigra::min(*b_ptr, 255.0f), 0.0f);
-    }
+    VIGRA_C_STATS_SCOPE(4*std::size_t(width)*height*sizeof(PixelType) + std::size_t(width)*height*4);
+    convertKernels().rgba_to_argb(arr_r_in, arr_g_in, arr_b_in, arr_a_in,
+                                  (unsigned char*)argb_arr_out, std::size_t(width)*height);
     return 0;
 }
 
@@ -117,18 +86,8 @@ LIBEXPORT int vigra_convert_argb_to_grayband_c(const char * argb_arr_in,
                                                const int width,
                                                const int height)
 {
-    const unsigned char* argb_ptr = (const unsigned char*)argb_arr_in;
-    
-    PixelType* gray_ptr = arr_out;
-    PixelType* gray_end = gray_ptr + (width*height);
-    
-    
-    for ( ; gray_ptr != gray_end; ++gray_ptr, argb_ptr+=4)
-    {
-        // since all bands are equal valued - we take the first one...
-        // argb_ptr[0] would be alpha!
-        *gray_ptr = (PixelType)argb_ptr[1];
-    }
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*4 + std::size_t(width)*height*sizeof(PixelType));
+    convertKernels().argb_to_gray((const unsigned char*)argb_arr_in, arr_out, std::size_t(width)*height);
     return 0;
 }
 
@@ -139,21 +98,9 @@ LIBEXPORT int vigra_convert_argb_to_rgbbands_c(const char * argb_arr_in,
                                                const int width,
                                                const int height)
 {
-    const unsigned char* argb_ptr = (const unsigned char*)argb_arr_in;
-    
-    PixelType* r_ptr = arr_r_out;
-    PixelType* g_ptr = arr_g_out;
-    PixelType* b_ptr = arr_b_out;
-    PixelType* r_end = r_ptr + (width*height);
-    
-    
-    for ( ; r_ptr != r_end ; ++r_ptr, ++g_ptr, ++b_ptr, argb_ptr+=4)
-    {
-        // argb_ptr[0] would be alpha!
-        *r_ptr = (PixelType)argb_ptr[1];
-        *g_ptr = (PixelType)argb_ptr[2];
-        *b_ptr = (PixelType)argb_ptr[3];
-    }
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*4 + 3*std::size_t(width)*height*sizeof(PixelType));
+    convertKernels().argb_to_rgb((const unsigned char*)argb_arr_in, arr_r_out, arr_g_out, arr_b_out,
+                                 std::size_t(width)*height);
     return 0;
 }
 
@@ -165,22 +112,9 @@ LIBEXPORT int vigra_convert_argb_to_rgbabands_c(const char * argb_arr_in,
                                                const int width,
                                                const int height)
 {
-    const unsigned char* argb_ptr = (const unsigned char*)argb_arr_in;
-    
-    PixelType* r_ptr = arr_r_out;
-    PixelType* g_ptr = arr_g_out;
-    PixelType* b_ptr = arr_b_out;
-    PixelType* a_ptr = arr_a_out;
-    PixelType* r_end = r_ptr + (width*height);
-    
-    
-    for ( ; r_ptr != r_end ; ++r_ptr, ++g_ptr, ++b_ptr, ++a_ptr, argb_ptr+=4)
-    {
-        *a_ptr = (PixelType)argb_ptr[0];
-        *r_ptr = (PixelType)argb_ptr[1];
-        *g_ptr = (PixelType)argb_ptr[2];
-        *b_ptr = (PixelType)argb_ptr[3];
-    }
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*4 + 4*std::size_t(width)*height*sizeof(PixelType));
+    convertKernels().argb_to_rgba((const unsigned char*)argb_arr_in, arr_r_out, arr_g_out, arr_b_out, arr_a_out,
+                                  std::size_t(width)*height);
     return 0;
 }
 
@@ -188,6 +122,7 @@ LIBEXPORT int vigra_copy_double_array_c(const double * arr_in,
                                         double * arr_out,
                                         const int size)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(size)*sizeof(double));
     memcpy(arr_out,arr_in,size*sizeof(double));
     return 0;
 }
@@ -196,6 +131,7 @@ LIBEXPORT int vigra_copy_float_array_c(const float * arr_in,
                                        float * arr_out,
                                        const int size)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(size)*sizeof(float));
     memcpy(arr_out,arr_in,size*sizeof(float));
     return 0;
 }
@@ -204,6 +140,7 @@ LIBEXPORT int vigra_copy_int_array_c(const int * arr_in,
                                      int * arr_out,
                                      const int size)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(size)*sizeof(int));
     memcpy(arr_out,arr_in,size*sizeof(int));
     return 0;
 }
@@ -212,6 +149,7 @@ LIBEXPORT int vigra_copy_uint8_array_c(const unsigned char * arr_in,
                                        unsigned char * arr_out,
                                        const int size)
 { 
+    VIGRA_C_STATS_SCOPE(2*std::size_t(size)*sizeof(unsigned char));
     memcpy(arr_out,arr_in,size*sizeof(unsigned char));
     return 0;
 }
@@ -220,6 +158,7 @@ LIBEXPORT int vigra_init_double_array_c(double * arr_io,
                                         const int size,
                                         double value)
 {
+    VIGRA_C_STATS_SCOPE(std::size_t(size)*sizeof(double));
     std::fill(arr_io, arr_io+size, value);
     return 0;
 }
@@ -228,6 +167,7 @@ LIBEXPORT int vigra_init_float_array_c(float * arr_io,
                                        const int size,
                                        float value)
 {
+    VIGRA_C_STATS_SCOPE(std::size_t(size)*sizeof(float));
     std::fill(arr_io, arr_io+size, value);
     return 0;
 }
@@ -236,6 +176,7 @@ LIBEXPORT int vigra_init_int_array_c(int * arr_io,
                                      const int size,
                                      int value)
 {
+    VIGRA_C_STATS_SCOPE(std::size_t(size)*sizeof(int));
     std::fill(arr_io, arr_io+size, value);
     return 0;
 }
@@ -244,6 +185,7 @@ LIBEXPORT int vigra_init_uint8_array_c(unsigned char * arr_io,
                                        const int size,
                                        unsigned char value)
 { 
+    VIGRA_C_STATS_SCOPE(std::size_t(size)*sizeof(unsigned char));
     std::fill(arr_io, arr_io+size, value);
     return 0;
 }
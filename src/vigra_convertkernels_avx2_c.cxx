@@ -0,0 +1,187 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#include "vigra_convertkernels_c.h"
+
+/**
+ * @file
+ * @brief AVX2 implementation of the ARGB conversion kernels
+ *
+ * This file is compiled with VIGRA_C_AVX2 defined and the AVX2 instruction set
+ * enabled on x86 platforms only. The kernels are only selected at runtime,
+ * if the CPU supports AVX2. Each iteration converts eight pixels.
+ */
+
+#ifdef VIGRA_C_AVX2
+
+#include <immintrin.h>
+
+/**
+ * Clamps eight floats to [0, 255] and truncates them to 32-bit integers.
+ */
+static inline __m256i clampToBytesAVX2(const __m256 v)
+{
+    return _mm256_cvttps_epi32(_mm256_max_ps(_mm256_min_ps(v, _mm256_set1_ps(255.0f)), _mm256_setzero_ps()));
+}
+
+/**
+ * Packs eight A,R,G,B values (each in [0, 255]) into eight ARGB pixels.
+ */
+static inline __m256i packARGBAVX2(const __m256i a, const __m256i r, const __m256i g, const __m256i b)
+{
+    return _mm256_or_si256(_mm256_or_si256(a,                        _mm256_slli_epi32(r, 8)),
+                           _mm256_or_si256(_mm256_slli_epi32(g, 16), _mm256_slli_epi32(b, 24)));
+}
+
+/**
+ * Extracts one channel (0=A, 1=R, 2=G, 3=B) of eight ARGB pixels as floats.
+ */
+template <int CHANNEL>
+static inline __m256 unpackChannelAVX2(const __m256i argb)
+{
+    return _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(argb, 8*CHANNEL), _mm256_set1_epi32(0xFF)));
+}
+
+static void grayToARGBAVX2(const PixelType * gray, unsigned char * argb, std::size_t size)
+{
+    const __m256i alpha = _mm256_set1_epi32(0xFF);
+    std::size_t i = 0;
+    
+    for( ; i+8 <= size; i+=8)
+    {
+        __m256i v = clampToBytesAVX2(_mm256_loadu_ps(gray+i));
+        _mm256_storeu_si256((__m256i*)(argb+4*i), packARGBAVX2(alpha, v, v, v));
+    }
+    grayToARGBScalar(gray+i, argb+4*i, size-i);
+}
+
+static void rgbToARGBAVX2(const PixelType * r, const PixelType * g, const PixelType * b,
+                          unsigned char * argb, std::size_t size)
+{
+    const __m256i alpha = _mm256_set1_epi32(0xFF);
+    std::size_t i = 0;
+    
+    for( ; i+8 <= size; i+=8)
+    {
+        _mm256_storeu_si256((__m256i*)(argb+4*i), packARGBAVX2(alpha,
+                                                               clampToBytesAVX2(_mm256_loadu_ps(r+i)),
+                                                               clampToBytesAVX2(_mm256_loadu_ps(g+i)),
+                                                               clampToBytesAVX2(_mm256_loadu_ps(b+i))));
+    }
+    rgbToARGBScalar(r+i, g+i, b+i, argb+4*i, size-i);
+}
+
+static void rgbaToARGBAVX2(const PixelType * r, const PixelType * g, const PixelType * b, const PixelType * a,
+                           unsigned char * argb, std::size_t size)
+{
+    std::size_t i = 0;
+    
+    for( ; i+8 <= size; i+=8)
+    {
+        _mm256_storeu_si256((__m256i*)(argb+4*i), packARGBAVX2(clampToBytesAVX2(_mm256_loadu_ps(a+i)),
+                                                               clampToBytesAVX2(_mm256_loadu_ps(r+i)),
+                                                               clampToBytesAVX2(_mm256_loadu_ps(g+i)),
+                                                               clampToBytesAVX2(_mm256_loadu_ps(b+i))));
+    }
+    rgbaToARGBScalar(r+i, g+i, b+i, a+i, argb+4*i, size-i);
+}
+
+static void argbToGrayAVX2(const unsigned char * argb, PixelType * gray, std::size_t size)
+{
+    std::size_t i = 0;
+    
+    for( ; i+8 <= size; i+=8)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(argb+4*i));
+        _mm256_storeu_ps(gray+i, unpackChannelAVX2<1>(v));
+    }
+    argbToGrayScalar(argb+4*i, gray+i, size-i);
+}
+
+static void argbToRGBAVX2(const unsigned char * argb, PixelType * r, PixelType * g, PixelType * b,
+                          std::size_t size)
+{
+    std::size_t i = 0;
+    
+    for( ; i+8 <= size; i+=8)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(argb+4*i));
+        _mm256_storeu_ps(r+i, unpackChannelAVX2<1>(v));
+        _mm256_storeu_ps(g+i, unpackChannelAVX2<2>(v));
+        _mm256_storeu_ps(b+i, unpackChannelAVX2<3>(v));
+    }
+    argbToRGBScalar(argb+4*i, r+i, g+i, b+i, size-i);
+}
+
+static void argbToRGBAAVX2(const unsigned char * argb, PixelType * r, PixelType * g, PixelType * b, PixelType * a,
+                           std::size_t size)
+{
+    std::size_t i = 0;
+    
+    for( ; i+8 <= size; i+=8)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(argb+4*i));
+        _mm256_storeu_ps(a+i, unpackChannelAVX2<0>(v));
+        _mm256_storeu_ps(r+i, unpackChannelAVX2<1>(v));
+        _mm256_storeu_ps(g+i, unpackChannelAVX2<2>(v));
+        _mm256_storeu_ps(b+i, unpackChannelAVX2<3>(v));
+    }
+    argbToRGBAScalar(argb+4*i, r+i, g+i, b+i, a+i, size-i);
+}
+
+static const ConvertKernels convert_kernels_avx2 =
+{
+    "AVX2",
+    grayToARGBAVX2,
+    rgbToARGBAVX2,
+    rgbaToARGBAVX2,
+    argbToGrayAVX2,
+    argbToRGBAVX2,
+    argbToRGBAAVX2
+};
+
+const ConvertKernels * convertKernelsAVX2()
+{
+    return &convert_kernels_avx2;
+}
+
+#else
+
+const ConvertKernels * convertKernelsAVX2()
+{
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,197 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#ifndef VIGRA_CONVERTKERNELS_H
+#define VIGRA_CONVERTKERNELS_H
+
+#include "config.h"
+#include <cstddef>
+
+/**
+ * @file
+ * @brief Header-only file for the ARGB conversion kernels
+ *
+ * @defgroup convertkernels ARGB conversion kernels
+ * @{
+ *    @brief Internal scalar and vectorized kernels of the ARGB conversion functions (Header-only file)
+ *
+ * The kernels convert between planar float bands and interleaved 8-bit ARGB
+ * pixels, which are stored as bytes in the order A,R,G,B. Floats are clamped to
+ * [0, 255] and truncated. The vectorized kernels are implemented in separate
+ * translation units, which are compiled with the needed instruction set flags.
+ * They compute the same results as the scalar kernels and use them for the 
+ * remaining pixels, which do not fill a whole vector.
+ */
+
+/**
+ * Internal table of the ARGB conversion kernels of one instruction set.
+ * Each kernel converts size pixels.
+ */
+struct ConvertKernels
+{
+    /** The name of the instruction set. */
+    const char * name;
+    
+    void (*gray_to_argb)(const PixelType * gray, unsigned char * argb, std::size_t size);
+    
+    void (*rgb_to_argb)(const PixelType * r, const PixelType * g, const PixelType * b,
+                        unsigned char * argb, std::size_t size);
+    
+    void (*rgba_to_argb)(const PixelType * r, const PixelType * g, const PixelType * b, const PixelType * a,
+                         unsigned char * argb, std::size_t size);
+    
+    void (*argb_to_gray)(const unsigned char * argb, PixelType * gray, std::size_t size);
+    
+    void (*argb_to_rgb)(const unsigned char * argb, PixelType * r, PixelType * g, PixelType * b,
+                        std::size_t size);
+    
+    void (*argb_to_rgba)(const unsigned char * argb, PixelType * r, PixelType * g, PixelType * b, PixelType * a,
+                         std::size_t size);
+};
+
+/**
+ * Internal helper to clamp a float to [0, 255] and truncate it to a byte.
+ */
+static inline unsigned char clampToByte(const PixelType v)
+{
+    return (unsigned char)(v < 255.0f ? (v > 0.0f ? v : 0.0f) : 255.0f);
+}
+
+/**
+ * Scalar reference kernel of the gray to ARGB conversion.
+ */
+static inline void grayToARGBScalar(const PixelType * gray, unsigned char * argb, std::size_t size)
+{
+    for(std::size_t i=0; i!=size; ++i, argb+=4)
+    {
+        argb[0] = 255;
+        argb[1] = clampToByte(gray[i]);
+        argb[2] = argb[1];
+        argb[3] = argb[1];
+    }
+}
+
+/**
+ * Scalar reference kernel of the RGB to ARGB conversion.
+ */
+static inline void rgbToARGBScalar(const PixelType * r, const PixelType * g, const PixelType * b,
+                            unsigned char * argb, std::size_t size)
+{
+    for(std::size_t i=0; i!=size; ++i, argb+=4)
+    {
+        argb[0] = 255;
+        argb[1] = clampToByte(r[i]);
+        argb[2] = clampToByte(g[i]);
+        argb[3] = clampToByte(b[i]);
+    }
+}
+
+/**
+ * Scalar reference kernel of the RGBA to ARGB conversion.
+ */
+static inline void rgbaToARGBScalar(const PixelType * r, const PixelType * g, const PixelType * b, const PixelType * a,
+                             unsigned char * argb, std::size_t size)
+{
+    for(std::size_t i=0; i!=size; ++i, argb+=4)
+    {
+        argb[0] = clampToByte(a[i]);
+        argb[1] = clampToByte(r[i]);
+        argb[2] = clampToByte(g[i]);
+        argb[3] = clampToByte(b[i]);
+    }
+}
+
+/**
+ * Scalar reference kernel of the ARGB to gray conversion.
+ */
+static inline void argbToGrayScalar(const unsigned char * argb, PixelType * gray, std::size_t size)
+{
+    for(std::size_t i=0; i!=size; ++i, argb+=4)
+    {
+        // since all bands are equal valued - we take the first one...
+        // argb[0] would be alpha!
+        gray[i] = (PixelType)argb[1];
+    }
+}
+
+/**
+ * Scalar reference kernel of the ARGB to RGB conversion.
+ */
+static inline void argbToRGBScalar(const unsigned char * argb, PixelType * r, PixelType * g, PixelType * b,
+                            std::size_t size)
+{
+    for(std::size_t i=0; i!=size; ++i, argb+=4)
+    {
+        r[i] = (PixelType)argb[1];
+        g[i] = (PixelType)argb[2];
+        b[i] = (PixelType)argb[3];
+    }
+}
+
+/**
+ * Scalar reference kernel of the ARGB to RGBA conversion.
+ */
+static inline void argbToRGBAScalar(const unsigned char * argb, PixelType * r, PixelType * g, PixelType * b, PixelType * a,
+                             std::size_t size)
+{
+    for(std::size_t i=0; i!=size; ++i, argb+=4)
+    {
+        a[i] = (PixelType)argb[0];
+        r[i] = (PixelType)argb[1];
+        g[i] = (PixelType)argb[2];
+        b[i] = (PixelType)argb[3];
+    }
+}
+
+/**
+ * Returns the SSE2 kernels, or NULL if they have not been compiled.
+ */
+const ConvertKernels * convertKernelsSSE2();
+
+/**
+ * Returns the AVX2 kernels, or NULL if they have not been compiled.
+ */
+const ConvertKernels * convertKernelsAVX2();
+
+/**
+ * Returns the NEON kernels, or NULL if they have not been compiled.
+ */
+const ConvertKernels * convertKernelsNEON();
+
+/**
+ * @}
+ */
+
+#endif
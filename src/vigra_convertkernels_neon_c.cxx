@@ -0,0 +1,196 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#include "vigra_convertkernels_c.h"
+
+/**
+ * @file
+ * @brief NEON implementation of the ARGB conversion kernels
+ *
+ * This file is compiled with VIGRA_C_NEON defined on 64-bit ARM platforms only,
+ * where NEON is always available. Each iteration converts four pixels.
+ */
+
+#ifdef VIGRA_C_NEON
+
+#include <arm_neon.h>
+
+/**
+ * Clamps four floats to [0, 255] and truncates them to 32-bit integers.
+ * NaN is clamped to 255 like in the scalar and x86 kernels.
+ */
+static inline uint32x4_t clampToBytesNEON(const float32x4_t v)
+{
+    return vcvtq_u32_f32(vmaxnmq_f32(vminnmq_f32(v, vdupq_n_f32(255.0f)), vdupq_n_f32(0.0f)));
+}
+
+/**
+ * Packs four A,R,G,B values (each in [0, 255]) into four ARGB pixels.
+ */
+static inline uint32x4_t packARGBNEON(const uint32x4_t a, const uint32x4_t r, const uint32x4_t g, const uint32x4_t b)
+{
+    return vorrq_u32(vorrq_u32(a,                 vshlq_n_u32(r, 8)),
+                     vorrq_u32(vshlq_n_u32(g, 16), vshlq_n_u32(b, 24)));
+}
+
+/**
+ * Extracts one channel (0=A, 1=R, 2=G, 3=B) of four ARGB pixels as floats.
+ */
+template <int CHANNEL>
+static inline float32x4_t unpackChannelNEON(const uint32x4_t argb)
+{
+    return vcvtq_f32_u32(vandq_u32(vshrq_n_u32(argb, 8*CHANNEL), vdupq_n_u32(0xFF)));
+}
+
+/**
+ * Specialization for the alpha channel, since NEON does not allow shifts by zero.
+ */
+template <>
+inline float32x4_t unpackChannelNEON<0>(const uint32x4_t argb)
+{
+    return vcvtq_f32_u32(vandq_u32(argb, vdupq_n_u32(0xFF)));
+}
+
+static void grayToARGBNEON(const PixelType * gray, unsigned char * argb, std::size_t size)
+{
+    const uint32x4_t alpha = vdupq_n_u32(0xFF);
+    std::size_t i = 0;
+    
+    for( ; i+4 <= size; i+=4)
+    {
+        uint32x4_t v = clampToBytesNEON(vld1q_f32(gray+i));
+        vst1q_u8(argb+4*i, vreinterpretq_u8_u32(packARGBNEON(alpha, v, v, v)));
+    }
+    grayToARGBScalar(gray+i, argb+4*i, size-i);
+}
+
+static void rgbToARGBNEON(const PixelType * r, const PixelType * g, const PixelType * b,
+                          unsigned char * argb, std::size_t size)
+{
+    const uint32x4_t alpha = vdupq_n_u32(0xFF);
+    std::size_t i = 0;
+    
+    for( ; i+4 <= size; i+=4)
+    {
+        vst1q_u8(argb+4*i, vreinterpretq_u8_u32(packARGBNEON(alpha,
+                                                             clampToBytesNEON(vld1q_f32(r+i)),
+                                                             clampToBytesNEON(vld1q_f32(g+i)),
+                                                             clampToBytesNEON(vld1q_f32(b+i)))));
+    }
+    rgbToARGBScalar(r+i, g+i, b+i, argb+4*i, size-i);
+}
+
+static void rgbaToARGBNEON(const PixelType * r, const PixelType * g, const PixelType * b, const PixelType * a,
+                           unsigned char * argb, std::size_t size)
+{
+    std::size_t i = 0;
+    
+    for( ; i+4 <= size; i+=4)
+    {
+        vst1q_u8(argb+4*i, vreinterpretq_u8_u32(packARGBNEON(clampToBytesNEON(vld1q_f32(a+i)),
+                                                             clampToBytesNEON(vld1q_f32(r+i)),
+                                                             clampToBytesNEON(vld1q_f32(g+i)),
+                                                             clampToBytesNEON(vld1q_f32(b+i)))));
+    }
+    rgbaToARGBScalar(r+i, g+i, b+i, a+i, argb+4*i, size-i);
+}
+
+static void argbToGrayNEON(const unsigned char * argb, PixelType * gray, std::size_t size)
+{
+    std::size_t i = 0;
+    
+    for( ; i+4 <= size; i+=4)
+    {
+        uint32x4_t v = vreinterpretq_u32_u8(vld1q_u8(argb+4*i));
+        vst1q_f32(gray+i, unpackChannelNEON<1>(v));
+    }
+    argbToGrayScalar(argb+4*i, gray+i, size-i);
+}
+
+static void argbToRGBNEON(const unsigned char * argb, PixelType * r, PixelType * g, PixelType * b,
+                          std::size_t size)
+{
+    std::size_t i = 0;
+    
+    for( ; i+4 <= size; i+=4)
+    {
+        uint32x4_t v = vreinterpretq_u32_u8(vld1q_u8(argb+4*i));
+        vst1q_f32(r+i, unpackChannelNEON<1>(v));
+        vst1q_f32(g+i, unpackChannelNEON<2>(v));
+        vst1q_f32(b+i, unpackChannelNEON<3>(v));
+    }
+    argbToRGBScalar(argb+4*i, r+i, g+i, b+i, size-i);
+}
+
+static void argbToRGBANEON(const unsigned char * argb, PixelType * r, PixelType * g, PixelType * b, PixelType * a,
+                           std::size_t size)
+{
+    std::size_t i = 0;
+    
+    for( ; i+4 <= size; i+=4)
+    {
+        uint32x4_t v = vreinterpretq_u32_u8(vld1q_u8(argb+4*i));
+        vst1q_f32(a+i, unpackChannelNEON<0>(v));
+        vst1q_f32(r+i, unpackChannelNEON<1>(v));
+        vst1q_f32(g+i, unpackChannelNEON<2>(v));
+        vst1q_f32(b+i, unpackChannelNEON<3>(v));
+    }
+    argbToRGBAScalar(argb+4*i, r+i, g+i, b+i, a+i, size-i);
+}
+
+static const ConvertKernels convert_kernels_neon =
+{
+    "NEON",
+    grayToARGBNEON,
+    rgbToARGBNEON,
+    rgbaToARGBNEON,
+    argbToGrayNEON,
+    argbToRGBNEON,
+    argbToRGBANEON
+};
+
+const ConvertKernels * convertKernelsNEON()
+{
+    return &convert_kernels_neon;
+}
+
+#else
+
+const ConvertKernels * convertKernelsNEON()
+{
+    return nullptr;
+}
+
+#endif
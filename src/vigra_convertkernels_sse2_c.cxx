@@ -0,0 +1,186 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#include "vigra_convertkernels_c.h"
+
+/**
+ * @file
+ * @brief SSE2 implementation of the ARGB conversion kernels
+ *
+ * This file is compiled with VIGRA_C_SSE2 defined on x86 platforms only.
+ * Each iteration converts four pixels.
+ */
+
+#ifdef VIGRA_C_SSE2
+
+#include <emmintrin.h>
+
+/**
+ * Clamps four floats to [0, 255] and truncates them to 32-bit integers.
+ */
+static inline __m128i clampToBytesSSE2(const __m128 v)
+{
+    return _mm_cvttps_epi32(_mm_max_ps(_mm_min_ps(v, _mm_set1_ps(255.0f)), _mm_setzero_ps()));
+}
+
+/**
+ * Packs four A,R,G,B values (each in [0, 255]) into four ARGB pixels.
+ */
+static inline __m128i packARGBSSE2(const __m128i a, const __m128i r, const __m128i g, const __m128i b)
+{
+    return _mm_or_si128(_mm_or_si128(a,                     _mm_slli_epi32(r, 8)),
+                        _mm_or_si128(_mm_slli_epi32(g, 16), _mm_slli_epi32(b, 24)));
+}
+
+/**
+ * Extracts one channel (0=A, 1=R, 2=G, 3=B) of four ARGB pixels as floats.
+ */
+template <int CHANNEL>
+static inline __m128 unpackChannelSSE2(const __m128i argb)
+{
+    return _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(argb, 8*CHANNEL), _mm_set1_epi32(0xFF)));
+}
+
+static void grayToARGBSSE2(const PixelType * gray, unsigned char * argb, std::size_t size)
+{
+    const __m128i alpha = _mm_set1_epi32(0xFF);
+    std::size_t i = 0;
+    
+    for( ; i+4 <= size; i+=4)
+    {
+        __m128i v = clampToBytesSSE2(_mm_loadu_ps(gray+i));
+        _mm_storeu_si128((__m128i*)(argb+4*i), packARGBSSE2(alpha, v, v, v));
+    }
+    grayToARGBScalar(gray+i, argb+4*i, size-i);
+}
+
+static void rgbToARGBSSE2(const PixelType * r, const PixelType * g, const PixelType * b,
+                          unsigned char * argb, std::size_t size)
+{
+    const __m128i alpha = _mm_set1_epi32(0xFF);
+    std::size_t i = 0;
+    
+    for( ; i+4 <= size; i+=4)
+    {
+        _mm_storeu_si128((__m128i*)(argb+4*i), packARGBSSE2(alpha,
+                                                            clampToBytesSSE2(_mm_loadu_ps(r+i)),
+                                                            clampToBytesSSE2(_mm_loadu_ps(g+i)),
+                                                            clampToBytesSSE2(_mm_loadu_ps(b+i))));
+    }
+    rgbToARGBScalar(r+i, g+i, b+i, argb+4*i, size-i);
+}
+
+static void rgbaToARGBSSE2(const PixelType * r, const PixelType * g, const PixelType * b, const PixelType * a,
+                           unsigned char * argb, std::size_t size)
+{
+    std::size_t i = 0;
+    
+    for( ; i+4 <= size; i+=4)
+    {
+        _mm_storeu_si128((__m128i*)(argb+4*i), packARGBSSE2(clampToBytesSSE2(_mm_loadu_ps(a+i)),
+                                                            clampToBytesSSE2(_mm_loadu_ps(r+i)),
+                                                            clampToBytesSSE2(_mm_loadu_ps(g+i)),
+                                                            clampToBytesSSE2(_mm_loadu_ps(b+i))));
+    }
+    rgbaToARGBScalar(r+i, g+i, b+i, a+i, argb+4*i, size-i);
+}
+
+static void argbToGraySSE2(const unsigned char * argb, PixelType * gray, std::size_t size)
+{
+    std::size_t i = 0;
+    
+    for( ; i+4 <= size; i+=4)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(argb+4*i));
+        _mm_storeu_ps(gray+i, unpackChannelSSE2<1>(v));
+    }
+    argbToGrayScalar(argb+4*i, gray+i, size-i);
+}
+
+static void argbToRGBSSE2(const unsigned char * argb, PixelType * r, PixelType * g, PixelType * b,
+                          std::size_t size)
+{
+    std::size_t i = 0;
+    
+    for( ; i+4 <= size; i+=4)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(argb+4*i));
+        _mm_storeu_ps(r+i, unpackChannelSSE2<1>(v));
+        _mm_storeu_ps(g+i, unpackChannelSSE2<2>(v));
+        _mm_storeu_ps(b+i, unpackChannelSSE2<3>(v));
+    }
+    argbToRGBScalar(argb+4*i, r+i, g+i, b+i, size-i);
+}
+
+static void argbToRGBASSE2(const unsigned char * argb, PixelType * r, PixelType * g, PixelType * b, PixelType * a,
+                           std::size_t size)
+{
+    std::size_t i = 0;
+    
+    for( ; i+4 <= size; i+=4)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(argb+4*i));
+        _mm_storeu_ps(a+i, unpackChannelSSE2<0>(v));
+        _mm_storeu_ps(r+i, unpackChannelSSE2<1>(v));
+        _mm_storeu_ps(g+i, unpackChannelSSE2<2>(v));
+        _mm_storeu_ps(b+i, unpackChannelSSE2<3>(v));
+    }
+    argbToRGBAScalar(argb+4*i, r+i, g+i, b+i, a+i, size-i);
+}
+
+static const ConvertKernels convert_kernels_sse2 =
+{
+    "SSE2",
+    grayToARGBSSE2,
+    rgbToARGBSSE2,
+    rgbaToARGBSSE2,
+    argbToGraySSE2,
+    argbToRGBSSE2,
+    argbToRGBASSE2
+};
+
+const ConvertKernels * convertKernelsSSE2()
+{
+    return &convert_kernels_sse2;
+}
+
+#else
+
+const ConvertKernels * convertKernelsSSE2()
+{
+    return nullptr;
+}
+
+#endif
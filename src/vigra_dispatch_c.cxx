@@ -0,0 +1,337 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#include "vigra_dispatch_c.h"
+#include "vigra_dispatchutils_c.h"
+#include "vigra_statsutils_c.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#define VIGRA_C_X86
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#define VIGRA_C_X86
+#endif
+
+
+/**
+ * @file
+ * @brief Implementation of the runtime CPU dispatch
+ */
+
+/**
+ * The scalar reference kernels of the ARGB conversion.
+ */
+static const ConvertKernels convert_kernels_scalar =
+{
+    "scalar",
+    grayToARGBScalar,
+    rgbToARGBScalar,
+    rgbaToARGBScalar,
+    argbToGrayScalar,
+    argbToRGBScalar,
+    argbToRGBAScalar
+};
+
+/**
+ * The scalar reference kernels of clipping and arithmetic. The line and row
+ * convolutions are left to VIGRA on the scalar path.
+ */
+static const PixelKernels pixel_kernels_scalar =
+{
+    "scalar",
+    clipScalar,
+    addScalar,
+    subtractScalar,
+    multiplyScalar,
+    divideScalar,
+    addValueScalar,
+    multiplyValueScalar,
+    nullptr,
+    nullptr
+};
+
+#ifdef VIGRA_C_X86
+/**
+ * Internal helper to query the registers of the cpuid instruction.
+ */
+static void cpuid(const unsigned int leaf, const unsigned int subleaf, unsigned int regs[4])
+{
+#ifdef _MSC_VER
+    int info[4];
+    __cpuidex(info, (int)leaf, (int)subleaf);
+    for(int i=0; i<4; ++i)
+    {
+        regs[i] = (unsigned int)info[i];
+    }
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+/**
+ * Internal helper to query the register states, which are saved by the operating system.
+ */
+static unsigned long long xgetbv0()
+{
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    unsigned int eax, edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((unsigned long long)edx << 32) | eax;
+#endif
+}
+#endif
+
+/**
+ * Internal helper to detect the CPU features. The AVX features are only
+ * reported, if the operating system saves the corresponding registers.
+ */
+static int detectCpuFeatures()
+{
+    int features = 0;
+    
+#ifdef VIGRA_C_X86
+    unsigned int regs[4];
+    
+    cpuid(0, 0, regs);
+    const unsigned int max_leaf = regs[0];
+    
+    if(max_leaf < 1)
+    {
+        return features;
+    }
+    
+    cpuid(1, 0, regs);
+    const unsigned int ecx1 = regs[2], edx1 = regs[3];
+    
+    if(edx1 & (1u << 26))  features |= CPU_SSE2;
+    if(ecx1 & (1u << 19))  features |= CPU_SSE41;
+    
+    //AVX needs the support of the operating system (OSXSAVE and the XMM/YMM states)
+    const bool os_avx = (ecx1 & (1u << 27)) && (xgetbv0() & 0x6) == 0x6;
+    
+    if(!os_avx)
+    {
+        return features;
+    }
+    
+    if(ecx1 & (1u << 28))  features |= CPU_AVX;
+    if(ecx1 & (1u << 12))  features |= CPU_FMA;
+    
+    if(max_leaf >= 7)
+    {
+        cpuid(7, 0, regs);
+        const unsigned int ebx7 = regs[1];
+        
+        if((features & CPU_AVX) && (ebx7 & (1u << 5)))
+        {
+            features |= CPU_AVX2;
+        }
+        //AVX-512 additionally needs the opmask and ZMM states
+        if((features & CPU_AVX2) && (ebx7 & (1u << 16)) && (xgetbv0() & 0xE6) == 0xE6)
+        {
+            features |= CPU_AVX512;
+        }
+    }
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    features |= CPU_NEON;
+#endif
+    
+    return features;
+}
+
+/**
+ * Internal helper to get the CPU features, which are detected once.
+ */
+static int cpuFeatures()
+{
+    static const int features = detectCpuFeatures();
+    return features;
+}
+
+/**
+ * Internal helper to determine if a code path has been compiled and is
+ * supported by the CPU. The AVX-512 path uses the AVX2 conversion kernels.
+ */
+static bool isPathAvailable(const int path)
+{
+    const int features = cpuFeatures();
+    
+    switch(path)
+    {
+        case CPU_SCALAR:
+            return true;
+        case CPU_SSE2:
+            return (features & CPU_SSE2) && convertKernelsSSE2() && pixelKernelsSSE2();
+        case CPU_AVX2:
+            return (features & CPU_AVX2) && convertKernelsAVX2() && pixelKernelsAVX2();
+        case CPU_AVX512:
+            return (features & CPU_AVX512) && convertKernelsAVX2() && pixelKernelsAVX512();
+        case CPU_NEON:
+            return (features & CPU_NEON) && convertKernelsNEON() && pixelKernelsNEON();
+        default:
+            return false;
+    }
+}
+
+/**
+ * Internal helper to select the fastest available code path, which is not
+ * faster than the given one (or the fastest one at all, if -1 is given).
+ */
+static int bestPath(const int limit)
+{
+    static const int paths[] = { CPU_AVX512, CPU_AVX2, CPU_SSE2, CPU_NEON };
+    
+    bool below_limit = (limit < 0);
+    
+    for(int path : paths)
+    {
+        below_limit = below_limit || (path == limit);
+        
+        if(below_limit && isPathAvailable(path))
+        {
+            return path;
+        }
+    }
+    return CPU_SCALAR;
+}
+
+/**
+ * Internal helper to select the initial code path, which may be limited by
+ * the environment variable VIGRA_C_DISPATCH.
+ */
+static int initialPath()
+{
+    const char * env = std::getenv("VIGRA_C_DISPATCH");
+    
+    if(env == nullptr)                  return bestPath(-1);
+    if(std::strcmp(env, "scalar") == 0) return CPU_SCALAR;
+    if(std::strcmp(env, "sse2")   == 0) return bestPath(CPU_SSE2);
+    if(std::strcmp(env, "avx2")   == 0) return bestPath(CPU_AVX2);
+    if(std::strcmp(env, "avx512") == 0) return bestPath(CPU_AVX512);
+    if(std::strcmp(env, "neon")   == 0) return bestPath(CPU_NEON);
+    
+    return bestPath(-1);
+}
+
+/**
+ * The selected code path, or -1 if it has not been selected yet.
+ */
+static std::atomic<int> selected_path(-1);
+
+/**
+ * Internal helper to get the selected code path, which is selected at the first call.
+ */
+static int currentPath()
+{
+    int path = selected_path.load(std::memory_order_relaxed);
+    
+    if(path < 0)
+    {
+        path = initialPath();
+        selected_path.store(path, std::memory_order_relaxed);
+    }
+    return path;
+}
+
+const ConvertKernels & convertKernels()
+{
+    switch(currentPath())
+    {
+        case CPU_SSE2:
+            return *convertKernelsSSE2();
+        case CPU_AVX2:
+        case CPU_AVX512:
+            return *convertKernelsAVX2();
+        case CPU_NEON:
+            return *convertKernelsNEON();
+        default:
+            return convert_kernels_scalar;
+    }
+}
+
+const PixelKernels & pixelKernels()
+{
+    switch(currentPath())
+    {
+        case CPU_SSE2:
+            return *pixelKernelsSSE2();
+        case CPU_AVX2:
+            return *pixelKernelsAVX2();
+        case CPU_AVX512:
+            return *pixelKernelsAVX512();
+        case CPU_NEON:
+            return *pixelKernelsNEON();
+        default:
+            return pixel_kernels_scalar;
+    }
+}
+
+
+LIBEXPORT int vigra_cpu_features_c()
+{
+    VIGRA_C_STATS_SCOPE(0);
+    return cpuFeatures();
+}
+
+LIBEXPORT int vigra_cpu_dispatch_c()
+{
+    VIGRA_C_STATS_SCOPE(0);
+    return currentPath();
+}
+
+LIBEXPORT int vigra_set_cpu_dispatch_c(const int path)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    if(path < 0)
+    {
+        selected_path.store(initialPath());
+        return 0;
+    }
+    
+    if(!isPathAvailable(path))
+    {
+        return 1;
+    }
+    
+    selected_path.store(path);
+    return 0;
+}
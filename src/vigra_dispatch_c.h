@@ -0,0 +1,104 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#ifndef VIGRA_DISPATCH_C_H
+#define VIGRA_DISPATCH_C_H
+
+#include "config.h"
+
+/**
+ * @file
+ * @brief Header file for the runtime CPU dispatch
+ *
+ * @defgroup dispatch CPU dispatch
+ * @{
+ *    @brief Detection of the CPU features and selection of the vectorized code paths
+ *
+ * Some hot kernels of vigra_c (the ARGB conversion, clipping, pixel-wise
+ * arithmetic and the horizontal pass of the separable convolution) have
+ * vectorized implementations for different instruction sets. The CPU is
+ * detected at the first call of such a function and the fastest supported
+ * code path is selected. The scalar path uses the same code as before.
+ *
+ * The CPU features and code paths are encoded by the following bits:
+ *  - 1: SSE2
+ *  - 2: SSE4.1
+ *  - 4: AVX
+ *  - 8: AVX2
+ *  - 16: FMA
+ *  - 32: AVX-512F
+ *  - 64: NEON
+ *
+ * The selected code path can be overridden by the environment variable
+ * VIGRA_C_DISPATCH, which may be set to "scalar", "sse2", "avx2", "avx512"
+ * or "neon". If the requested path is not supported, the fastest supported
+ * path below it is used.
+ */
+
+/**
+ * Returns the features of the CPU, which are relevant for vigra_c.
+ *
+ * \return The bitmask of the detected CPU features (see above).
+ */
+LIBEXPORT int vigra_cpu_features_c();
+
+/**
+ * Returns the code path, which is currently used by the dispatched kernels.
+ *
+ * \return 0 for the scalar path, otherwise the bit of the instruction set:
+ *         1 (SSE2), 8 (AVX2), 32 (AVX-512F) or 64 (NEON).
+ */
+LIBEXPORT int vigra_cpu_dispatch_c();
+
+/**
+ * Selects the code path of the dispatched kernels, e.g. to compare the
+ * vectorized paths with the scalar one.
+ * Please note, that this function should not be called while other threads
+ * are executing vigra_c functions.
+ *
+ * \param path The code path: -1 for the automatic selection, 0 for the scalar
+ *             path, or one of the bits 1 (SSE2), 8 (AVX2), 32 (AVX-512F) or
+ *             64 (NEON).
+ *
+ * \return 0 if the path has been selected,
+ *         1 if it has not been compiled or is not supported by the CPU.
+ */
+LIBEXPORT int vigra_set_cpu_dispatch_c(const int path);
+
+/**
+ * @}
+ */
+
+#endif
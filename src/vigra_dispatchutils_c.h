@@ -0,0 +1,80 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#ifndef VIGRA_DISPATCHUTILS_H
+#define VIGRA_DISPATCHUTILS_H
+
+#include "vigra_convertkernels_c.h"
+#include "vigra_pixelkernels_c.h"
+
+/**
+ * @file
+ * @brief Header-only file for the access of the dispatched kernels
+ *
+ * @defgroup dispatchutils Dispatch utilities
+ * @{
+ *    @brief Internal access of the kernels of the selected code path (Header-only file)
+ */
+
+/**
+ * The bits of the CPU features and code paths, see vigra_cpu_features_c.
+ */
+enum CpuFeature
+{
+    CPU_SCALAR = 0,
+    CPU_SSE2   = 1,
+    CPU_SSE41  = 2,
+    CPU_AVX    = 4,
+    CPU_AVX2   = 8,
+    CPU_FMA    = 16,
+    CPU_AVX512 = 32,
+    CPU_NEON   = 64
+};
+
+/**
+ * Returns the ARGB conversion kernels of the selected code path.
+ */
+const ConvertKernels & convertKernels();
+
+/**
+ * Returns the pixel kernels of the selected code path.
+ */
+const PixelKernels & pixelKernels();
+
+/**
+ * @}
+ */
+
+#endif
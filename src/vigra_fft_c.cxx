@@ -0,0 +1,294 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#include "vigra_fft_c.h"
+#include "vigra_fftutils_c.h"
+#include "vigra_arenautils_c.h"
+#include "vigra_statsutils_c.h"
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+/**
+ * @file
+ * @brief Implementation of the FFTW plan cache
+ */
+
+/**
+ * The key of a cached plan: kind, width, height and planner flags.
+ */
+typedef std::tuple<int, int, int, unsigned int> FFTPlanKey;
+
+/**
+ * The plan cache. The FFTW planner is not thread safe, thus the mutex guards
+ * the creation of plans as well as the wisdom. Executing a plan is thread safe.
+ * The plans are destroyed when the library is unloaded.
+ */
+class FFTPlanCache
+{
+public:
+    ~FFTPlanCache()
+    {
+        for(auto & entry : plans)
+        {
+            fftwf_destroy_plan(entry.second);
+        }
+    }
+    
+    std::mutex mutex;
+    std::map<FFTPlanKey, fftwf_plan> plans;
+    unsigned int planner_flags = FFTW_ESTIMATE;
+};
+
+static FFTPlanCache & fftPlanCache()
+{
+    static FFTPlanCache cache;
+    return cache;
+}
+
+fftwf_plan fftPlan(const FFTPlanKind kind, const int width, const int height)
+{
+    FFTPlanCache & cache = fftPlanCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    
+    FFTPlanKey key(kind, width, height, cache.planner_flags);
+    auto iter = cache.plans.find(key);
+    if(iter != cache.plans.end())
+    {
+        return iter->second;
+    }
+    
+    //Plan on scratch arrays, since measuring overwrites them.
+    //FFTW expects the row-major order (height, width).
+    fftwf_plan plan = nullptr;
+    
+    switch(kind)
+    {
+        case FFT_REAL_FORWARD:
+        {
+            ScratchImage<PixelType> in(width, height);
+            ScratchImage<ComplexType> out(width/2 + 1, height);
+            plan = fftwf_plan_dft_r2c_2d(height, width,
+                                         in.data(), (fftwf_complex*)out.data(),
+                                         cache.planner_flags | FFTW_PRESERVE_INPUT);
+            break;
+        }
+        case FFT_REAL_BACKWARD:
+        {
+            ScratchImage<ComplexType> in(width/2 + 1, height);
+            ScratchImage<PixelType> out(width, height);
+            plan = fftwf_plan_dft_c2r_2d(height, width,
+                                         (fftwf_complex*)in.data(), out.data(),
+                                         cache.planner_flags | FFTW_DESTROY_INPUT);
+            break;
+        }
+        case FFT_COMPLEX_FORWARD:
+        case FFT_COMPLEX_BACKWARD:
+        {
+            ScratchImage<ComplexType> in(width, height);
+            ScratchImage<ComplexType> out(width, height);
+            plan = fftwf_plan_dft_2d(height, width,
+                                     (fftwf_complex*)in.data(), (fftwf_complex*)out.data(),
+                                     (kind == FFT_COMPLEX_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD,
+                                     cache.planner_flags | FFTW_PRESERVE_INPUT);
+            break;
+        }
+    }
+    
+    vigra_precondition(plan != nullptr, "fftPlan(): Unable to create FFTW plan.");
+    
+    cache.plans[key] = plan;
+    return plan;
+}
+
+int fftGoodSize(const int size)
+{
+    for(int n = std::max(size, 1); ; ++n)
+    {
+        int m = n;
+        for(int p : {2, 3, 5, 7})
+        {
+            while(m % p == 0)
+            {
+                m /= p;
+            }
+        }
+        if(m == 1)
+        {
+            return n;
+        }
+    }
+}
+
+/**
+ * Tells if an array may be passed to a cached plan, which has been created
+ * for aligned arrays.
+ */
+template <class T>
+static bool fftAligned(const T * arr)
+{
+    return fftwf_alignment_of((float*)arr) == 0;
+}
+
+void fftRealForward(const PixelType * arr_in,
+                    ComplexType * arr_half_out,
+                    const int width,
+                    const int height)
+{
+    fftwf_plan plan = fftPlan(FFT_REAL_FORWARD, width, height);
+    
+    ScratchImage<PixelType> in;
+    ScratchImage<ComplexType> out;
+    PixelType * p_in = const_cast<PixelType*>(arr_in);
+    ComplexType * p_out = arr_half_out;
+    
+    if(!fftAligned(p_in))
+    {
+        in.reshape(vigra::Shape2(width, height));
+        std::memcpy(in.data(), arr_in, std::size_t(width)*height*sizeof(PixelType));
+        p_in = in.data();
+    }
+    if(!fftAligned(p_out))
+    {
+        out.reshape(vigra::Shape2(width/2 + 1, height));
+        p_out = out.data();
+    }
+    
+    fftwf_execute_dft_r2c(plan, p_in, (fftwf_complex*)p_out);
+    
+    if(p_out != arr_half_out)
+    {
+        std::memcpy(arr_half_out, p_out, std::size_t(width/2 + 1)*height*sizeof(ComplexType));
+    }
+}
+
+void fftRealBackward(ComplexType * arr_half_in,
+                     PixelType * arr_out,
+                     const int width,
+                     const int height)
+{
+    fftwf_plan plan = fftPlan(FFT_REAL_BACKWARD, width, height);
+    
+    ScratchImage<ComplexType> in;
+    ScratchImage<PixelType> out;
+    ComplexType * p_in = arr_half_in;
+    PixelType * p_out = arr_out;
+    
+    if(!fftAligned(p_in))
+    {
+        in.reshape(vigra::Shape2(width/2 + 1, height));
+        std::memcpy(in.data(), arr_half_in, std::size_t(width/2 + 1)*height*sizeof(ComplexType));
+        p_in = in.data();
+    }
+    if(!fftAligned(p_out))
+    {
+        out.reshape(vigra::Shape2(width, height));
+        p_out = out.data();
+    }
+    
+    fftwf_execute_dft_c2r(plan, (fftwf_complex*)p_in, p_out);
+    
+    if(p_out != arr_out)
+    {
+        std::memcpy(arr_out, p_out, std::size_t(width)*height*sizeof(PixelType));
+    }
+}
+
+void fftComplex(const ComplexType * arr_in,
+                ComplexType * arr_out,
+                const int width,
+                const int height,
+                const bool forward)
+{
+    fftwf_plan plan = fftPlan(forward ? FFT_COMPLEX_FORWARD : FFT_COMPLEX_BACKWARD, width, height);
+    
+    ScratchImage<ComplexType> in, out;
+    ComplexType * p_in = const_cast<ComplexType*>(arr_in);
+    ComplexType * p_out = arr_out;
+    
+    if(!fftAligned(p_in))
+    {
+        in.reshape(vigra::Shape2(width, height));
+        std::memcpy(in.data(), arr_in, std::size_t(width)*height*sizeof(ComplexType));
+        p_in = in.data();
+    }
+    if(!fftAligned(p_out))
+    {
+        out.reshape(vigra::Shape2(width, height));
+        p_out = out.data();
+    }
+    
+    fftwf_execute_dft(plan, (fftwf_complex*)p_in, (fftwf_complex*)p_out);
+    
+    if(p_out != arr_out)
+    {
+        std::memcpy(arr_out, p_out, std::size_t(width)*height*sizeof(ComplexType));
+    }
+}
+
+LIBEXPORT int vigra_fft_set_planner_effort_c(const int effort)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    static const unsigned int flags[] = {FFTW_ESTIMATE, FFTW_MEASURE, FFTW_PATIENT, FFTW_EXHAUSTIVE};
+    
+    if(effort < 0 || effort > 3)
+    {
+        return 1;
+    }
+    
+    FFTPlanCache & cache = fftPlanCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.planner_flags = flags[effort];
+    return 0;
+}
+
+LIBEXPORT int vigra_fft_import_wisdom_c(const char * filename)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    FFTPlanCache & cache = fftPlanCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return fftwf_import_wisdom_from_filename(filename) ? 0 : 1;
+}
+
+LIBEXPORT int vigra_fft_export_wisdom_c(const char * filename)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    FFTPlanCache & cache = fftPlanCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return fftwf_export_wisdom_to_filename(filename) ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#ifndef VIGRA_FFT_C_H
+#define VIGRA_FFT_C_H
+
+#include "config.h"
+
+/**
+ * @file
+ * @brief Header file for the control of the FFTW planner
+ *
+ * @defgroup fft FFTW planning
+ * @{
+ *    @brief Planner settings and wisdom of the Fourier transforms and correlations
+ *
+ * All Fourier transforms and fast correlations of vigra_c use FFTW plans,
+ * which are created once per image shape and kept until the library is
+ * unloaded. By default, the plans are estimated. Measured plans are faster,
+ * but their creation may take seconds for large images. This cost can be
+ * avoided by exporting the wisdom of the planner once and importing it
+ * at the start of each later run.
+ */
+
+/**
+ * Sets the effort of the FFTW planner for all plans, which are created
+ * after this call. Plans, which have already been created, are not changed.
+ *
+ * \param effort The planner effort:
+ *               0: FFTW_ESTIMATE (default),
+ *               1: FFTW_MEASURE,
+ *               2: FFTW_PATIENT,
+ *               3: FFTW_EXHAUSTIVE.
+ *
+ * \return 0 if the effort has been set, 1 if it is not valid.
+ */
+LIBEXPORT int vigra_fft_set_planner_effort_c(const int effort);
+
+/**
+ * Imports FFTW wisdom from a file, which has been written by
+ * vigra_fft_export_wisdom_c (or fftwf-wisdom). The wisdom is added to the
+ * wisdom of the planner and used for all plans created after this call.
+ *
+ * \param filename The name of the wisdom file.
+ *
+ * \return 0 if the wisdom has been imported, 1 else.
+ */
+LIBEXPORT int vigra_fft_import_wisdom_c(const char * filename);
+
+/**
+ * Exports the accumulated wisdom of the FFTW planner to a file.
+ *
+ * \param filename The name of the wisdom file.
+ *
+ * \return 0 if the wisdom has been exported, 1 else.
+ */
+LIBEXPORT int vigra_fft_export_wisdom_c(const char * filename);
+
+/**
+ * @}
+ */
+
+#endif
@@ -0,0 +1,140 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#ifndef VIGRA_FFTUTILS_H
+#define VIGRA_FFTUTILS_H
+
+#include "config.h"
+#include <fftw3.h>
+#include <vigra/multi_fft.hxx>
+
+/**
+ * @file
+ * @brief Header-only file for the use of cached FFTW plans
+ *
+ * @defgroup fftutils FFTW utilities
+ * @{
+ *    @brief Internal Fourier transforms, which use the shape-keyed plan cache (Header-only file)
+ */
+
+/**
+ * The complex type of the Fourier transforms. It has the same memory layout
+ * as fftwf_complex.
+ */
+typedef vigra::FFTWComplex<PixelType> ComplexType;
+
+/**
+ * The kinds of cached plans.
+ */
+enum FFTPlanKind
+{
+    FFT_REAL_FORWARD,
+    FFT_REAL_BACKWARD,
+    FFT_COMPLEX_FORWARD,
+    FFT_COMPLEX_BACKWARD
+};
+
+/**
+ * Internal helper to get a cached plan for an image shape. The plan is
+ * created at the first request with the current planner effort (see 
+ * vigra_fft_set_planner_effort_c) and kept until the library is unloaded.
+ * It is created for arrays, which are aligned to 64 bytes.
+ *
+ * \param kind The kind of the transform.
+ * \param width The width of the (real) image.
+ * \param height The height of the (real) image.
+ *
+ * \return The plan.
+ */
+fftwf_plan fftPlan(const FFTPlanKind kind, const int width, const int height);
+
+/**
+ * Internal helper to get the smallest size, which is not less than the given
+ * one and a product of the primes 2, 3, 5 and 7 only. FFTW is most
+ * efficient for these sizes.
+ */
+int fftGoodSize(const int size);
+
+/**
+ * Internal helper for the real-to-complex Fourier transform of an image. Only
+ * the non-redundant half spectrum of size (width/2+1)*height is computed.
+ * The result is not normalized.
+ *
+ * \param arr_in Flat input array of size width*height.
+ * \param[out] arr_half_out Flat output array of size (width/2+1)*height.
+ * \param width The width of the image.
+ * \param height The height of the image.
+ */
+void fftRealForward(const PixelType * arr_in,
+                    ComplexType * arr_half_out,
+                    const int width,
+                    const int height);
+
+/**
+ * Internal helper for the complex-to-real inverse Fourier transform of a half 
+ * spectrum. The result is not normalized, i.e. scaled by width*height.
+ * Please note, that the input array is overwritten.
+ *
+ * \param arr_half_in Flat input array of size (width/2+1)*height.
+ * \param[out] arr_out Flat output array of size width*height.
+ * \param width The width of the image.
+ * \param height The height of the image.
+ */
+void fftRealBackward(ComplexType * arr_half_in,
+                     PixelType * arr_out,
+                     const int width,
+                     const int height);
+
+/**
+ * Internal helper for the complex Fourier transform of an image in both directions.
+ * The result is not normalized.
+ *
+ * \param arr_in Flat input array of size width*height.
+ * \param[out] arr_out Flat output array of size width*height.
+ * \param width The width of the image.
+ * \param height The height of the image.
+ * \param forward Perform the forward (true) or backward (false) transform.
+ */
+void fftComplex(const ComplexType * arr_in,
+                ComplexType * arr_out,
+                const int width,
+                const int height,
+                const bool forward);
+
+/**
+ * @}
+ */
+
+#endif
@@ -34,11 +34,21 @@
 
 #include "vigra_filters_c.h"
 #include "vigra_kernelutils_c.h"
+#include "vigra_parallelutils_c.h"
+#include "vigra_dispatchutils_c.h"
+#include "vigra_arenautils_c.h"
+#include "vigra_fftutils_c.h"
+#include "vigra_statsutils_c.h"
 #include <vigra/medianfilter.hxx>
 #include <vigra/nonlineardiffusion.hxx>
 #include <vigra/shockfilter.hxx>
 #include <vigra/multi_convolution.hxx>
 #include <vigra/non_local_mean.hxx>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <unordered_set>
+#include <vector>
 
 
 /**
@@ -46,6 +56,354 @@
  * @brief Implementation of image filters
  */
 
+/**
+ * Internal helper to map a position outside of a line of the given width to the
+ * position inside, which is used by VIGRA's border treatment modes REPEAT,
+ * REFLECT and WRAP. Returns -1 for ZEROPAD. The kernel must not be wider
+ * than the line.
+ */
+static int borderIndex(const int x, const int width, const vigra::BorderTreatmentMode border)
+{
+    if(x >= 0 && x < width)
+    {
+        return x;
+    }
+    switch(border)
+    {
+        case vigra::BORDER_TREATMENT_REPEAT:
+            return x < 0 ? 0 : width-1;
+        case vigra::BORDER_TREATMENT_REFLECT:
+            return x < 0 ? -x : 2*(width-1)-x;
+        case vigra::BORDER_TREATMENT_WRAP:
+            return x < 0 ? x+width : x-width;
+        default:
+            return -1;
+    }
+}
+
+/**
+ * The cache budget (in bytes) of the rows, which are combined by the
+ * cache-blocked vertical convolution. The strips of adjacent columns are
+ * chosen such that all rows under the kernel fit into the L2 cache.
+ */
+static const int CONVOLVE_COLUMNS_CACHE_SIZE = 128*1024;
+
+/**
+ * Internal helper for the cache-blocked vertical convolution of an image.
+ * Instead of convolving each column with a stride of the image width, the
+ * image is split into strips of adjacent columns. For each output row, the
+ * rows under the kernel are combined by the vectorized row convolution,
+ * i.e. across adjacent columns. The strip width is chosen such that the rows
+ * of a strip stay in the cache while the kernel slides down. Rows outside
+ * of the image are selected according to the border treatment.
+ *
+ * \param in The input image with contiguous rows.
+ * \param[out] out The output image of the same shape with contiguous rows.
+ * \param kernel_v The vertical kernel, which must not be higher than the image.
+ */
+static void convolveColumns(const ImageView & in,
+                            ImageView & out,
+                            const vigra::Kernel1D<double> & kernel_v)
+{
+    const PixelKernels & kernels = pixelKernels();
+    const vigra::BorderTreatmentMode border = kernel_v.borderTreatment();
+    
+    const int width = in.width(),
+              height = in.height(),
+              kbottom = kernel_v.right(),
+              ksize = kbottom - kernel_v.left() + 1,
+              strip = std::min(width, std::max(64, int(CONVOLVE_COLUMNS_CACHE_SIZE/(ksize*sizeof(PixelType))) & ~15));
+    
+    //out(y) = sum_k kernel_v[k]*in(y-k) = sum_j kernel[j]*in(y+j-kbottom)
+    std::vector<double> kernel(ksize);
+    std::vector<PixelType> zeros(strip, 0);
+    for(int j=0; j<ksize; ++j)
+    {
+        kernel[j] = kernel_v[kbottom - j];
+    }
+    
+    std::vector<const PixelType *> rows(ksize);
+    
+    for(int x0=0; x0<width; x0+=strip)
+    {
+        const int size = std::min(strip, width - x0);
+        
+        for(int y=0; y<height; ++y)
+        {
+            for(int j=0; j<ksize; ++j)
+            {
+                int y_in = borderIndex(y + j - kbottom, height, border);
+                rows[j] = (y_in < 0) ? zeros.data() : &in(x0, y_in);
+            }
+            kernels.convolve_rows(rows.data(), &out(x0, y), size, kernel.data(), ksize);
+        }
+    }
+}
+
+/**
+ * Internal helper for the horizontal pass of a separable convolution. If the
+ * selected code path provides a vectorized line convolution, each row is
+ * padded according to the border treatment and then correlated with the
+ * mirrored kernel. Otherwise VIGRA's convolution is used. The border treatment
+ * must not be AVOID or CLIP.
+ *
+ * \param in The input image.
+ * \param[out] out The output image of the same shape.
+ * \param kernel_h The horizontal kernel.
+ */
+static void convolveX(const ImageView & in,
+                      ImageView & out,
+                      const vigra::Kernel1D<double> & kernel_h)
+{
+    const PixelKernels & kernels = pixelKernels();
+    const vigra::BorderTreatmentMode border = kernel_h.borderTreatment();
+    
+    const int width = in.width(),
+              kleft = kernel_h.left(),
+              kright = kernel_h.right(),
+              ksize = kright - kleft + 1;
+    
+    if(kernels.convolve_line == nullptr || ksize > width || out.stride(0) != 1)
+    {
+        vigra::separableConvolveX(in, out, kernel_h);
+        return;
+    }
+    
+    //out(x) = sum_k kernel_h[k]*in(x-k) = sum_j kernel[j]*line[x+j], with line[i] = in(i-kright)
+    std::vector<double> kernel(ksize);
+    std::vector<PixelType> line(width + ksize - 1);
+    for(int j=0; j<ksize; ++j)
+    {
+        kernel[j] = kernel_h[kright - j];
+    }
+    
+    for(int y=0; y<in.height(); ++y)
+    {
+        for(int i=0; i<(int)line.size(); ++i)
+        {
+            int x = borderIndex(i - kright, width, border);
+            line[i] = (x < 0) ? 0 : in(x, y);
+        }
+        kernels.convolve_line(line.data(), &out(0, y), width, kernel.data(), ksize);
+    }
+}
+
+/**
+ * Internal helper for the vertical pass of a separable convolution. If the
+ * selected code path provides a vectorized row convolution, the cache-blocked
+ * convolveColumns is used, otherwise VIGRA's convolution. The border treatment
+ * must not be AVOID or CLIP.
+ *
+ * \param in The input image.
+ * \param[out] out The output image of the same shape.
+ * \param kernel_v The vertical kernel.
+ */
+static void convolveY(const ImageView & in,
+                      ImageView & out,
+                      const vigra::Kernel1D<double> & kernel_v)
+{
+    if(pixelKernels().convolve_rows == nullptr || kernel_v.right() - kernel_v.left() + 1 > in.height() ||
+       in.stride(0) != 1 || out.stride(0) != 1)
+    {
+        vigra::separableConvolveY(in, out, kernel_v);
+    }
+    else
+    {
+        convolveColumns(in, out, kernel_v);
+    }
+}
+
+/**
+ * Internal helper for the separable convolution of an image by means of
+ * convolveX and convolveY, which use the vectorized and cache-blocked
+ * kernels of the selected code path. For the border treatments AVOID and
+ * CLIP, VIGRA's convolution is used.
+ *
+ * \param in The input image.
+ * \param[out] out The output image of the same shape.
+ * \param kernel_h The horizontal kernel.
+ * \param kernel_v The vertical kernel.
+ */
+static void separableConvolveImage(const ImageView & in,
+                                   ImageView & out,
+                                   const vigra::Kernel1D<double> & kernel_h,
+                                   const vigra::Kernel1D<double> & kernel_v)
+{
+    const vigra::BorderTreatmentMode border = kernel_h.borderTreatment();
+    
+    if(border == vigra::BORDER_TREATMENT_AVOID || border == vigra::BORDER_TREATMENT_CLIP)
+    {
+        vigra::convolveImage(in, out, kernel_h, kernel_v);
+        return;
+    }
+    
+    ScratchImage<PixelType> tmp(in.shape());
+    convolveX(in, tmp, kernel_h);
+    convolveY(tmp, out, kernel_v);
+}
+
+/**
+ * The relative tolerance, up to which vigra_convolveimage_c treats a 2D kernel
+ * as the outer product of two 1D kernels.
+ */
+static const double SEPARABLE_KERNEL_TOLERANCE = 1.0e-6;
+
+/**
+ * The minimal number of kernel elements, for which vigra_convolveimage_c
+ * convolves in the Fourier domain. Negative values disable it.
+ */
+static std::atomic<int> fft_convolution_threshold(121);
+
+/**
+ * The minimal size of the FFT tiles of the Fourier domain convolution.
+ */
+static const int FFT_CONVOLUTION_TILE_SIZE = 512;
+
+/**
+ * Internal helper to determine, if a 2D convolution is performed in the
+ * Fourier domain. This needs a padding border treatment and a kernel, which
+ * is not larger than the image.
+ */
+static bool useFFTConvolution(const int width, const int height,
+                              const int kernel_width, const int kernel_height,
+                              const vigra::BorderTreatmentMode border)
+{
+    int threshold = fft_convolution_threshold.load();
+    
+    return threshold >= 0 && kernel_width*kernel_height >= threshold &&
+           kernel_width <= width && kernel_height <= height &&
+           border != vigra::BORDER_TREATMENT_AVOID && border != vigra::BORDER_TREATMENT_CLIP;
+}
+
+/**
+ * Internal helper to derive the FFT size of the tiles for one dimension: 
+ * small images are transformed at once, larger ones in tiles of at least
+ * FFT_CONVOLUTION_TILE_SIZE or four times the kernel size.
+ */
+static int fftConvolutionSize(const int size, const int kernel_size)
+{
+    return fftGoodSize(std::min(size + kernel_size - 1,
+                                std::max(FFT_CONVOLUTION_TILE_SIZE, 4*(kernel_size - 1))));
+}
+
+/**
+ * Internal helper for the convolution of an image with a 2D kernel in the
+ * Fourier domain by means of the overlap-save method. The image is split
+ * into tiles, which are extended by the kernel radius and padded according
+ * to the border treatment. Each tile is transformed with the cached plans,
+ * multiplied with the spectrum of the kernel and transformed back. Only the
+ * valid part of each tile is written to the output. The tiles are processed
+ * in parallel on the worker pool. If the input and the output share their
+ * memory, the tiles read from a copy of the input.
+ *
+ * \param in The input image.
+ * \param[out] out The output image of the same shape.
+ * \param kernel_arr_in Flat kernel array of size kernel_width*kernel_height.
+ * \param kernel_width The (odd) width of the kernel.
+ * \param kernel_height The (odd) height of the kernel.
+ * \param border The border treatment: REPEAT, REFLECT, WRAP or ZEROPAD.
+ */
+static void fftConvolveImage(const ImageView & in,
+                             ImageView & out,
+                             const double * kernel_arr_in,
+                             const int kernel_width,
+                             const int kernel_height,
+                             const vigra::BorderTreatmentMode border)
+{
+    const int width  = in.width(),
+              height = in.height(),
+              rx = kernel_width/2,
+              ry = kernel_height/2,
+              fft_width  = fftConvolutionSize(width, kernel_width),
+              fft_height = fftConvolutionSize(height, kernel_height),
+              fft_half_width = fft_width/2 + 1,
+              tile_width  = fft_width  - kernel_width  + 1,
+              tile_height = fft_height - kernel_height + 1,
+              tiles_x = (width  + tile_width  - 1)/tile_width,
+              tiles_y = (height + tile_height - 1)/tile_height;
+    
+    //Spectrum of the kernel, which is shared by all tiles. The normalization
+    //of the inverse transform is applied here, too.
+    ScratchImage<ComplexType> kernel_fourier(fft_half_width, fft_height);
+    {
+        ScratchImage<PixelType> kernel_padded(fft_width, fft_height);
+        kernel_padded = 0;
+        
+        PixelType norm = PixelType(1.0)/(PixelType(fft_width)*fft_height);
+        for(int y=0; y<kernel_height; ++y)
+        {
+            for(int x=0; x<kernel_width; ++x)
+            {
+                kernel_padded(x, y) = PixelType(kernel_arr_in[y*kernel_width + x])*norm;
+            }
+        }
+        fftRealForward(kernel_padded.data(), kernel_fourier.data(), fft_width, fft_height);
+    }
+    
+    //The tiles read the input around their output. Thus, an in-place
+    //convolution reads from a copy of the input.
+    ScratchImage<PixelType> in_copy;
+    if(viewsOverlap(in, out))
+    {
+        in_copy.reshape(in.shape());
+        in_copy = in;
+    }
+    const ImageView & src = (in_copy.size() != 0) ? static_cast<const ImageView &>(in_copy) : in;
+    
+    //The tile at (x0, y0) covers the input positions x0-rx ... x0-rx+fft_width-1, 
+    //thus its circular convolution c yields out(x0+t) = c(t+2*rx) without wrap-around.
+    parallelForEach(tiles_x*tiles_y,
+                    [&](int tile)
+                    {
+                        int x0 = (tile % tiles_x)*tile_width,
+                            y0 = (tile / tiles_x)*tile_height;
+                        
+                        std::vector<int> x_index(fft_width), y_index(fft_height);
+                        for(int i=0; i<fft_width; ++i)
+                        {
+                            int x = borderIndex(x0 + i - rx, width, border);
+                            x_index[i] = (x < width) ? x : -1;
+                        }
+                        for(int j=0; j<fft_height; ++j)
+                        {
+                            int y = borderIndex(y0 + j - ry, height, border);
+                            y_index[j] = (y < height) ? y : -1;
+                        }
+                        
+                        ScratchImage<PixelType> padded(fft_width, fft_height);
+                        ScratchImage<ComplexType> fourier(fft_half_width, fft_height);
+                        
+                        for(int j=0; j<fft_height; ++j)
+                        {
+                            for(int i=0; i<fft_width; ++i)
+                            {
+                                padded(i, j) = (x_index[i] < 0 || y_index[j] < 0) ? 0 : src(x_index[i], y_index[j]);
+                            }
+                        }
+                        
+                        fftRealForward(padded.data(), fourier.data(), fft_width, fft_height);
+                        
+                        for(auto f_iter = fourier.begin(), k_iter = kernel_fourier.begin();
+                            f_iter != fourier.end();
+                            ++f_iter, ++k_iter)
+                        {
+                            *f_iter = *f_iter * *k_iter;
+                        }
+                        
+                        fftRealBackward(fourier.data(), padded.data(), fft_width, fft_height);
+                        
+                        int x1 = std::min(x0 + tile_width, width),
+                            y1 = std::min(y0 + tile_height, height);
+                        for(int y=y0; y<y1; ++y)
+                        {
+                            for(int x=x0; x<x1; ++x)
+                            {
+                                out(x, y) = padded(x - x0 + 2*rx, y - y0 + 2*ry);
+                            }
+                        }
+                    });
+}
+
 LIBEXPORT int vigra_convolveimage_c(const PixelType * arr_in,
                                     const double * kernel_arr_in,
                                     const PixelType * arr_out,
@@ -55,6 +413,7 @@ LIBEXPORT int vigra_convolveimage_c(const PixelType * arr_in,
                                     const int kernel_height,
                                     const int border_treatment)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
     if(border_treatment < 0 || border_treatment > 5)
     {
         //Illegal border treatment mode!
@@ -72,10 +431,155 @@ LIBEXPORT int vigra_convolveimage_c(const PixelType * arr_in,
         if ( (kernel_width % 2)==0 || (kernel_height % 2)==0)
             return 2;
         
-        vigra::convolveImage(img_in, img_out,
-                             kernel2dFromArray(kernel_arr_in,
+        //Rank-1 kernels are convolved separably, which is always cheaper
+        if(border_treatment != vigra::BORDER_TREATMENT_AVOID)
+        {
+            double residual;
+            auto terms = separableKernelsFromArray(kernel_arr_in,
+                                                   kernel_width, kernel_height,
+                                                   1, SEPARABLE_KERNEL_TOLERANCE, residual,
+                                                   (vigra::BorderTreatmentMode)border_treatment);
+            if(residual <= SEPARABLE_KERNEL_TOLERANCE)
+            {
+                auto filter = [&](const ImageView & in, ImageView * out)
+                              {
+                                  if(terms.empty())
+                                  {
+                                      out[0] = 0;
+                                  }
+                                  else
+                                  {
+                                      separableConvolveImage(in, out[0], terms[0].first, terms[0].second);
+                                  }
+                              };
+                
+                if(isTileable((vigra::BorderTreatmentMode)border_treatment))
+                {
+                    tiledFilter(img_in, {img_out}, kernel_height/2 + 1, filter);
+                }
+                else
+                {
+                    filter(img_in, &img_out);
+                }
+                return 0;
+            }
+        }
+        
+        if(useFFTConvolution(width, height, kernel_width, kernel_height,
+                             (vigra::BorderTreatmentMode)border_treatment))
+        {
+            fftConvolveImage(img_in, img_out, kernel_arr_in,
+                             kernel_width, kernel_height,
+                             (vigra::BorderTreatmentMode)border_treatment);
+            return 0;
+        }
+        
+        vigra::Kernel2D<double> kernel = kernel2dFromArray(kernel_arr_in,
+                                                           kernel_width, kernel_height,
+                                                           (vigra::BorderTreatmentMode)border_treatment);
+        
+        auto filter = [&](const ImageView & in, ImageView * out)
+                      {
+                          vigra::convolveImage(in, out[0], kernel);
+                      };
+        
+        if(isTileable((vigra::BorderTreatmentMode)border_treatment))
+        {
+            tiledFilter(img_in, {img_out}, kernel_height/2 + 1, filter);
+        }
+        else
+        {
+            filter(img_in, &img_out);
+        }
+    }
+    catch (vigra::StdException & e)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+LIBEXPORT int vigra_set_fft_convolution_threshold_c(const int kernel_size)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    fft_convolution_threshold = kernel_size;
+    return 0;
+}
+
+LIBEXPORT int vigra_convolveimage_lowrank_c(const PixelType * arr_in,
+                                            const double * kernel_arr_in,
+                                            const PixelType * arr_out,
+                                            const int width,
+                                            const int height,
+                                            const int kernel_width,
+                                            const int kernel_height,
+                                            const int border_treatment,
+                                            const int max_rank,
+                                            const float tolerance)
+{
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
+    if(border_treatment < 0 || border_treatment > 5)
+    {
+        //Illegal border treatment mode!
+        return 3;
+    }
+    
+    try
+    {
+        //Create gray scale image views for the arrays
+        vigra::Shape2 shape(width,height);
+        ImageView img_in(shape, arr_in);
+        ImageView img_out(shape, arr_out);
+        
+        //Check if kernel dimensions are odd
+        if ( (kernel_width % 2)==0 || (kernel_height % 2)==0)
+            return 2;
+        
+        if(max_rank < 1)
+            return 4;
+        
+        double residual;
+        auto terms = separableKernelsFromArray(kernel_arr_in,
                                                kernel_width, kernel_height,
-                                               (vigra::BorderTreatmentMode)border_treatment));
+                                               max_rank, tolerance, residual,
+                                               (vigra::BorderTreatmentMode)border_treatment);
+        
+        //Sum up one separable convolution per term
+        auto filter = [&](const ImageView & in, ImageView * out)
+                      {
+                          if(terms.empty())
+                          {
+                              out[0] = 0;
+                              return;
+                          }
+                          
+                          separableConvolveImage(in, out[0], terms[0].first, terms[0].second);
+                          
+                          if(terms.size() > 1)
+                          {
+                              ScratchImage<PixelType> tmp(in.shape());
+                              for(std::size_t i=1; i<terms.size(); ++i)
+                              {
+                                  //AVOID leaves the border untouched
+                                  if(border_treatment == vigra::BORDER_TREATMENT_AVOID)
+                                  {
+                                      tmp = 0;
+                                  }
+                                  separableConvolveImage(in, tmp, terms[i].first, terms[i].second);
+                                  out[0] += tmp;
+                              }
+                          }
+                      };
+        
+        if(isTileable((vigra::BorderTreatmentMode)border_treatment))
+        {
+            tiledFilter(img_in, {img_out}, kernel_height/2 + 1, filter);
+        }
+        else
+        {
+            filter(img_in, &img_out);
+        }
     }
     catch (vigra::StdException & e)
     {
@@ -95,10 +599,485 @@ LIBEXPORT int vigra_separableconvolveimage_c(const PixelType * arr_in,
                                              const int kernel_height,
                                              const int border_treatment)
 {
-    if(border_treatment < 0 || border_treatment > 5)
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
+    if(border_treatment < 0 || border_treatment > 5)
+    {
+        //Illegal border treatment mode!
+        return 3;
+    }
+    
+    try
+    {
+        //Create gray scale image views for the arrays
+        vigra::Shape2 shape(width,height);
+        ImageView img_in(shape, arr_in);
+        ImageView img_out(shape, arr_out);
+        
+        //Check if kernel dimensions are odd
+        if ( (kernel_width % 2)==0 || (kernel_height % 2)==0)
+            return 2;
+        
+        vigra::Kernel1D<double> kernel_h = kernel1dFromArray(kernel_h_arr_in,
+                                                             kernel_width,
+                                                             (vigra::BorderTreatmentMode)border_treatment),
+                                kernel_v = kernel1dFromArray(kernel_v_arr_in,
+                                                             kernel_height,
+                                                             (vigra::BorderTreatmentMode)border_treatment);
+        
+        auto filter = [&](const ImageView & in, ImageView * out)
+                      {
+                          separableConvolveImage(in, out[0], kernel_h, kernel_v);
+                      };
+        
+        if(isTileable((vigra::BorderTreatmentMode)border_treatment))
+        {
+            tiledFilter(img_in, {img_out}, kernel_height/2 + 1, filter);
+        }
+        else
+        {
+            filter(img_in, &img_out);
+        }
+    }
+    catch (vigra::StdException & e)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * Internal helper to create a Gaussian (derivative) kernel with the border
+ * treatment REFLECT, like the kernels of VIGRA's Gaussian filters.
+ *
+ * \param sigma The std.dev. of the Gaussian.
+ * \param order The order of the derivative.
+ *
+ * \return The kernel.
+ */
+static vigra::Kernel1D<double> gaussianKernel(const double sigma, const int order = 0)
+{
+    vigra::Kernel1D<double> kernel;
+    if(order == 0)
+    {
+        kernel.initGaussian(sigma);
+    }
+    else
+    {
+        kernel.initGaussianDerivative(sigma, order);
+    }
+    kernel.setBorderTreatment(vigra::BORDER_TREATMENT_REFLECT);
+    return kernel;
+}
+
+/**
+ * The minimal std.dev., from which on the Gaussian filters use the recursive
+ * implementation. Negative values disable it.
+ */
+static std::atomic<float> recursive_gaussian_threshold(-1.0f);
+
+/**
+ * The number of adjacent columns, which are filtered side by side in the
+ * vertical pass of the recursive Gaussian.
+ */
+static const int RECURSIVE_GAUSSIAN_STRIP_WIDTH = 64;
+
+/**
+ * Internal helper to determine, if a Gaussian filter of the given std.dev.
+ * uses the recursive implementation.
+ */
+static bool useRecursiveGaussian(const float sigma)
+{
+    float threshold = recursive_gaussian_threshold.load();
+    
+    return threshold >= 0.0f && sigma >= std::max(threshold, 0.5f);
+}
+
+/**
+ * Internal helper to map any position to a line of the given size by
+ * (repeated) reflection at the first and last sample.
+ */
+static int reflectIndex(int x, const int size)
+{
+    if(size == 1)
+    {
+        return 0;
+    }
+    
+    const int period = 2*(size - 1);
+    x %= period;
+    if(x < 0)
+    {
+        x += period;
+    }
+    return (x < size) ? x : period - x;
+}
+
+/**
+ * Internal helper, which applies the recursive Gaussian filter of Young and
+ * van Vliet (causal and anti-causal third order pass) in place to a block of
+ * interleaved lines: buffer[i*lines + l] is the i-th sample of line l. Thus,
+ * the inner loops run over adjacent memory. Both passes start in the steady
+ * state of the first and last sample, respectively.
+ *
+ * \param[in,out] buffer The interleaved lines of size length*lines.
+ * \param length The length of each line.
+ * \param lines The number of lines.
+ * \param sigma The std.dev. of the Gaussian (>= 0.5).
+ */
+static void recursiveGaussianLines(double * buffer, const int length, const int lines, const double sigma)
+{
+    const double q = (sigma >= 2.5) ? 0.98711*sigma - 0.96330
+                                    : 3.97156 - 4.14554*std::sqrt(1.0 - 0.26891*sigma),
+                 q2 = q*q,
+                 q3 = q2*q,
+                 b0 = 1.57825 + 2.44413*q + 1.4281*q2 + 0.422205*q3,
+                 a1 = (2.44413*q + 2.85619*q2 + 1.26661*q3)/b0,
+                 a2 = -(1.4281*q2 + 1.26661*q3)/b0,
+                 a3 = 0.422205*q3/b0,
+                 b  = 1.0 - (a1 + a2 + a3);
+    
+    //Causal pass, w(i) = b*x(i) + a1*w(i-1) + a2*w(i-2) + a3*w(i-3) with w(-k) = x(0)
+    for(int i=1; i<length; ++i)
+    {
+        double * cur = buffer + i*lines;
+        const double * p1 = buffer + (i-1)*lines,
+                     * p2 = buffer + std::max(i-2, 0)*lines,
+                     * p3 = buffer + std::max(i-3, 0)*lines;
+        for(int l=0; l<lines; ++l)
+        {
+            cur[l] = b*cur[l] + a1*p1[l] + a2*p2[l] + a3*p3[l];
+        }
+    }
+    
+    //Anti-causal pass, y(i) = b*w(i) + a1*y(i+1) + a2*y(i+2) + a3*y(i+3) with y(n-1+k) = w(n-1)
+    for(int i=length-2; i>=0; --i)
+    {
+        double * cur = buffer + i*lines;
+        const double * p1 = buffer + (i+1)*lines,
+                     * p2 = buffer + std::min(i+2, length-1)*lines,
+                     * p3 = buffer + std::min(i+3, length-1)*lines;
+        for(int l=0; l<lines; ++l)
+        {
+            cur[l] = b*cur[l] + a1*p1[l] + a2*p2[l] + a3*p3[l];
+        }
+    }
+}
+
+/**
+ * Internal helper for the Gaussian smoothing of an image by means of the
+ * recursive filter of Young and van Vliet, which costs O(1) per pixel for
+ * any std.dev. The lines are extended by 4*sigma reflected pixels on both
+ * sides, which matches the border treatment REFLECT of the FIR filters.
+ * Rows are filtered in parallel, columns in parallel strips of adjacent
+ * columns.
+ *
+ * \param in The input image.
+ * \param[out] out The output image of the same shape.
+ * \param sigma The std.dev. of the Gaussian (>= 0.5).
+ */
+static void recursiveGaussianSmoothing(const ImageView & in, ImageView & out, const double sigma)
+{
+    const int width = in.width(),
+              height = in.height(),
+              pad = int(4.0*sigma + 0.5);
+    
+    ScratchImage<PixelType> tmp(in.shape());
+    
+    parallelRows(height, 16,
+                 [&](int y0, int y1)
+                 {
+                     ScratchImage<double> line(width + 2*pad, 1);
+                     for(int y=y0; y<y1; ++y)
+                     {
+                         for(int i=0; i<width + 2*pad; ++i)
+                         {
+                             line(i, 0) = in(reflectIndex(i - pad, width), y);
+                         }
+                         recursiveGaussianLines(line.data(), width + 2*pad, 1, sigma);
+                         for(int x=0; x<width; ++x)
+                         {
+                             tmp(x, y) = PixelType(line(x + pad, 0));
+                         }
+                     }
+                 });
+    
+    parallelRows(width, RECURSIVE_GAUSSIAN_STRIP_WIDTH,
+                 [&](int x0, int x1)
+                 {
+                     for(int xs=x0; xs<x1; xs+=RECURSIVE_GAUSSIAN_STRIP_WIDTH)
+                     {
+                         const int lines = std::min(RECURSIVE_GAUSSIAN_STRIP_WIDTH, x1 - xs);
+                         
+                         ScratchImage<double> block(lines, height + 2*pad);
+                         for(int j=0; j<height + 2*pad; ++j)
+                         {
+                             const int y = reflectIndex(j - pad, height);
+                             for(int l=0; l<lines; ++l)
+                             {
+                                 block(l, j) = tmp(xs + l, y);
+                             }
+                         }
+                         recursiveGaussianLines(block.data(), height + 2*pad, lines, sigma);
+                         for(int y=0; y<height; ++y)
+                         {
+                             for(int l=0; l<lines; ++l)
+                             {
+                                 out(xs + l, y) = PixelType(block(l, y + pad));
+                             }
+                         }
+                     }
+                 });
+}
+
+/**
+ * Internal helper for the Gaussian gradient by means of central differences
+ * of the recursively smoothed image. The border treatment is REFLECT.
+ */
+static void recursiveGaussianGradient(const ImageView & in, ImageView & gx, ImageView & gy, const double sigma)
+{
+    const int width = in.width(),
+              height = in.height();
+    
+    ScratchImage<PixelType> smooth(in.shape());
+    recursiveGaussianSmoothing(in, smooth, sigma);
+    
+    parallelRows(height, 16,
+                 [&](int y0, int y1)
+                 {
+                     for(int y=y0; y<y1; ++y)
+                     {
+                         const int ym = reflectIndex(y - 1, height),
+                                   yp = reflectIndex(y + 1, height);
+                         for(int x=0; x<width; ++x)
+                         {
+                             gx(x, y) = PixelType(0.5)*(smooth(reflectIndex(x + 1, width), y) - smooth(reflectIndex(x - 1, width), y));
+                             gy(x, y) = PixelType(0.5)*(smooth(x, yp) - smooth(x, ym));
+                         }
+                     }
+                 });
+}
+
+/**
+ * Internal helper for the Laplacian of Gaussian by means of the 5-point
+ * Laplacian of the recursively smoothed image. The border treatment is REFLECT.
+ */
+static void recursiveLaplacianOfGaussian(const ImageView & in, ImageView & out, const double sigma)
+{
+    const int width = in.width(),
+              height = in.height();
+    
+    ScratchImage<PixelType> smooth(in.shape());
+    recursiveGaussianSmoothing(in, smooth, sigma);
+    
+    parallelRows(height, 16,
+                 [&](int y0, int y1)
+                 {
+                     for(int y=y0; y<y1; ++y)
+                     {
+                         const int ym = reflectIndex(y - 1, height),
+                                   yp = reflectIndex(y + 1, height);
+                         for(int x=0; x<width; ++x)
+                         {
+                             out(x, y) = smooth(reflectIndex(x + 1, width), y) + smooth(reflectIndex(x - 1, width), y)
+                                       + smooth(x, yp) + smooth(x, ym) - PixelType(4)*smooth(x, y);
+                         }
+                     }
+                 });
+}
+
+/**
+ * Internal helper for the convolution of an image with a 1D kernel in both
+ * directions, which reflects the image repeatedly at its borders (see
+ * reflectIndex). In contrast to separableConvolveImage, the kernel may be
+ * larger than the image. This is only meant for small images, like the
+ * coarse octaves of a scale space.
+ *
+ * \param in The input image.
+ * \param[out] out The output image of the same shape.
+ * \param kernel The kernel for both directions.
+ */
+static void reflectConvolveImage(const ImageView & in, ImageView & out, const vigra::Kernel1D<double> & kernel)
+{
+    const int width = in.width(),
+              height = in.height();
+    
+    ScratchImage<PixelType> tmp(in.shape());
+    
+    for(int y=0; y<height; ++y)
+    {
+        for(int x=0; x<width; ++x)
+        {
+            double sum = 0.0;
+            for(int k=kernel.left(); k<=kernel.right(); ++k)
+            {
+                sum += kernel[k]*in(reflectIndex(x - k, width), y);
+            }
+            tmp(x, y) = PixelType(sum);
+        }
+    }
+    for(int y=0; y<height; ++y)
+    {
+        for(int x=0; x<width; ++x)
+        {
+            double sum = 0.0;
+            for(int k=kernel.left(); k<=kernel.right(); ++k)
+            {
+                sum += kernel[k]*tmp(x, reflectIndex(y - k, height));
+            }
+            out(x, y) = PixelType(sum);
+        }
+    }
+}
+
+/**
+ * Internal helper for the Gaussian smoothing of an image with the border
+ * treatment REFLECT. From the threshold of vigra_set_recursive_gaussian_threshold_c
+ * on, the recursive filter is used, otherwise the tiled separable convolution.
+ * Images, which are smaller than the kernel, are convolved by reflectConvolveImage.
+ *
+ * \param img_in The input image.
+ * \param[out] img_out The output image of the same shape.
+ * \param sigma The std.dev. of the Gaussian.
+ */
+static void gaussianSmoothImage(const ImageView & img_in, ImageView & img_out, const double sigma)
+{
+    if(useRecursiveGaussian(sigma))
+    {
+        recursiveGaussianSmoothing(img_in, img_out, sigma);
+        return;
+    }
+    
+    vigra::Kernel1D<double> smooth = gaussianKernel(sigma);
+    
+    const int ksize = smooth.right() - smooth.left() + 1;
+    if(ksize > img_in.width() || ksize > img_in.height())
+    {
+        reflectConvolveImage(img_in, img_out, smooth);
+        return;
+    }
+    
+    tiledFilter(img_in, {img_out}, gaussianHalo(sigma),
+                [&](const ImageView & in, ImageView * out)
+                {
+                    separableConvolveImage(in, out[0], smooth, smooth);
+                });
+}
+
+LIBEXPORT int vigra_gaussiangradient_c(const PixelType * arr_in,
+                                       const PixelType * arr_gx_out,
+                                       const PixelType * arr_gy_out,
+                                       const int width,
+                                       const int height,
+                                       const float sigma)
+{
+    VIGRA_C_STATS_SCOPE(3*std::size_t(width)*height*sizeof(PixelType));
+    try
+    {
+        //Create gray scale image views for the arrays
+        vigra::Shape2 shape(width,height);
+        ImageView img_in(shape, arr_in);
+        ImageView img_gx(shape, arr_gx_out);
+        ImageView img_gy(shape, arr_gy_out);
+        
+        if(useRecursiveGaussian(sigma))
+        {
+            recursiveGaussianGradient(img_in, img_gx, img_gy, sigma);
+            return 0;
+        }
+        
+        vigra::Kernel1D<double> smooth = gaussianKernel(sigma),
+                                grad = gaussianKernel(sigma, 1);
+        
+        tiledFilter(img_in, {img_gx, img_gy}, gaussianHalo(sigma, 1),
+                    [&](const ImageView & in, ImageView * out)
+                    {
+                        separableConvolveImage(in, out[0], grad, smooth);
+                        separableConvolveImage(in, out[1], smooth, grad);
+                    });
+    }
+    catch (vigra::StdException & e)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+LIBEXPORT int vigra_gaussiangradientmagnitude_c(const PixelType * arr_in,
+                                                const PixelType * arr_out,
+                                                const int width,
+                                                const int height,
+                                                const float sigma)
+{
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
+    try
+    {
+        //Create gray scale image views for the arrays
+        vigra::Shape2 shape(width,height);
+        ImageView img_in(shape, arr_in);
+        ImageView img_out(shape, arr_out);
+        
+        vigra::Kernel1D<double> smooth = gaussianKernel(sigma),
+                                grad = gaussianKernel(sigma, 1);
+        
+        tiledFilter(img_in, {img_out}, gaussianHalo(sigma, 1),
+                    [&](const ImageView & in, ImageView * out)
+                    {
+                        ScratchImage<PixelType> gy(in.shape());
+                        separableConvolveImage(in, out[0], grad, smooth);
+                        separableConvolveImage(in, gy, smooth, grad);
+                        
+                        auto gy_iter = gy.begin();
+                        for(auto iter = out[0].begin(); iter != out[0].end(); ++iter, ++gy_iter)
+                        {
+                            *iter = std::sqrt(*iter * *iter + *gy_iter * *gy_iter);
+                        }
+                    });
+    }
+    catch (vigra::StdException & e)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+LIBEXPORT int vigra_gaussiansmoothing_c(const PixelType * arr_in,
+                                        const PixelType * arr_out,
+                                        const int width,
+                                        const int height,
+                                        const float sigma)
+{
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
+    try
+    {
+        //Create gray scale image views for the arrays
+        vigra::Shape2 shape(width,height);
+        ImageView img_in(shape, arr_in);
+        ImageView img_out(shape, arr_out);
+        
+        gaussianSmoothImage(img_in, img_out, sigma);
+    }
+    catch (vigra::StdException & e)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+LIBEXPORT int vigra_recursivegaussiansmoothing_c(const PixelType * arr_in,
+                                                 const PixelType * arr_out,
+                                                 const int width,
+                                                 const int height,
+                                                 const float sigma)
+{
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
+    if(sigma < 0.5f)
     {
-        //Illegal border treatment mode!
-        return 3;
+        //Recursive filter is not defined for small sigmas!
+        return 2;
     }
     
     try
@@ -108,17 +1087,7 @@ LIBEXPORT int vigra_separableconvolveimage_c(const PixelType * arr_in,
         ImageView img_in(shape, arr_in);
         ImageView img_out(shape, arr_out);
         
-        //Check if kernel dimensions are odd
-        if ( (kernel_width % 2)==0 || (kernel_height % 2)==0)
-            return 2;
-        
-        vigra::convolveImage(img_in, img_out,
-                             kernel1dFromArray(kernel_h_arr_in,
-                                               kernel_width,
-                                               (vigra::BorderTreatmentMode)border_treatment),
-                             kernel1dFromArray(kernel_v_arr_in,
-                                               kernel_height,
-                                               (vigra::BorderTreatmentMode)border_treatment));
+        recursiveGaussianSmoothing(img_in, img_out, sigma);
     }
     catch (vigra::StdException & e)
     {
@@ -128,22 +1097,156 @@ LIBEXPORT int vigra_separableconvolveimage_c(const PixelType * arr_in,
     return 0;
 }
 
-LIBEXPORT int vigra_gaussiangradient_c(const PixelType * arr_in,
-                                       const PixelType * arr_gx_out,
-                                       const PixelType * arr_gy_out,
-                                       const int width,
-                                       const int height,
-                                       const float sigma)
+LIBEXPORT int vigra_set_recursive_gaussian_threshold_c(const float sigma)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    recursive_gaussian_threshold = sigma;
+    return 0;
+}
+
+/**
+ * Internal helper to compute the layout of a Gaussian scale space, see
+ * vigra_gaussianscalespace_layout_c. The parameters must be valid.
+ */
+static void gaussianScaleSpaceLayout(const int width, const int height,
+                                     const int octaves, const int levels_per_octave,
+                                     long long * offsets, int * widths, int * heights)
+{
+    long long offset = 0;
+    int w = width,
+        h = height;
+    
+    for(int o=0; o<octaves; ++o)
+    {
+        widths[o]  = w;
+        heights[o] = h;
+        for(int l=0; l<levels_per_octave; ++l)
+        {
+            offsets[o*levels_per_octave + l] = offset;
+            offset += (long long)w*h;
+        }
+        w = (w + 1)/2;
+        h = (h + 1)/2;
+    }
+    offsets[octaves*levels_per_octave] = offset;
+}
+
+/**
+ * Internal helper to smooth an image, which is already smoothed at the scale
+ * sigma_from, to the scale sigma_to by the differential scale. If there is
+ * nothing to smooth, the image is copied.
+ */
+static void gaussianSmoothImageTo(const ImageView & in, ImageView & out, const double sigma_from, const double sigma_to)
+{
+    if(sigma_to <= sigma_from)
+    {
+        out = in;
+    }
+    else
+    {
+        gaussianSmoothImage(in, out, std::sqrt(sigma_to*sigma_to - sigma_from*sigma_from));
+    }
+}
+
+LIBEXPORT int vigra_gaussianscalespace_layout_c(const int width,
+                                                const int height,
+                                                const int octaves,
+                                                const int levels_per_octave,
+                                                long long * offsets_out,
+                                                int * widths_out,
+                                                int * heights_out)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    if(width < 1 || height < 1 || octaves < 1 || levels_per_octave < 1)
+    {
+        //Illegal size of the scale space!
+        return 2;
+    }
+    
+    gaussianScaleSpaceLayout(width, height, octaves, levels_per_octave,
+                             offsets_out, widths_out, heights_out);
+    return 0;
+}
+
+LIBEXPORT int vigra_gaussianscalespace_c(const PixelType * arr_in,
+                                         const PixelType * arr_out,
+                                         const int width,
+                                         const int height,
+                                         const int octaves,
+                                         const int levels_per_octave,
+                                         const float sigma,
+                                         const float sigma_in)
 {
+    VIGRA_C_STATS_SCOPE((3 + 4*levels_per_octave)*std::size_t(width)*height*sizeof(PixelType)/3);
+    if(sigma <= 0.0f || sigma_in < 0.0f)
+    {
+        //Illegal scales!
+        return 3;
+    }
+    if(width < 1 || height < 1 || octaves < 1 || levels_per_octave < 1)
+    {
+        //Illegal size of the scale space!
+        return 2;
+    }
+    
     try
     {
-        //Create gray scale image views for the arrays
+        std::vector<long long> offsets(octaves*levels_per_octave + 1);
+        std::vector<int> widths(octaves), heights(octaves);
+        gaussianScaleSpaceLayout(width, height, octaves, levels_per_octave,
+                                 offsets.data(), widths.data(), heights.data());
+        
+        //View on level l of octave o of the flat output array
+        auto level = [&](const int o, const int l)
+                     {
+                         return ImageView(vigra::Shape2(widths[o], heights[o]),
+                                          arr_out + offsets[o*levels_per_octave + l]);
+                     };
+        
+        //Scale of level l, measured in pixels of its octave
+        auto levelSigma = [&](const int l)
+                          {
+                              return sigma*std::pow(2.0, double(l)/levels_per_octave);
+                          };
+        
         vigra::Shape2 shape(width,height);
         ImageView img_in(shape, arr_in);
-        ImageView img_gx(shape, arr_gx_out);
-        ImageView img_gy(shape, arr_gy_out);
         
-        vigra::gaussianGradient(img_in, img_gx, img_gy, sigma);
+        for(int o=0; o<octaves; ++o)
+        {
+            ImageView first = level(o, 0);
+            
+            if(o == 0)
+            {
+                gaussianSmoothImageTo(img_in, first, sigma_in, sigma);
+            }
+            else
+            {
+                //The previous octave at twice its base scale is subsampled at
+                //the even pixels, which yields the base scale in this octave
+                ImageView prev = level(o-1, levels_per_octave-1);
+                ScratchImage<PixelType> base(prev.shape());
+                gaussianSmoothImageTo(prev, base, levelSigma(levels_per_octave-1), 2.0*sigma);
+                
+                parallelRows(first.height(), 16,
+                             [&](int y0, int y1)
+                             {
+                                 for(int y=y0; y<y1; ++y)
+                                 {
+                                     for(int x=0; x<first.width(); ++x)
+                                     {
+                                         first(x, y) = base(2*x, 2*y);
+                                     }
+                                 }
+                             });
+            }
+            
+            for(int l=1; l<levels_per_octave; ++l)
+            {
+                ImageView cur = level(o, l);
+                gaussianSmoothImageTo(level(o, l-1), cur, levelSigma(l-1), levelSigma(l));
+            }
+        }
     }
     catch (vigra::StdException & e)
     {
@@ -153,20 +1256,47 @@ LIBEXPORT int vigra_gaussiangradient_c(const PixelType * arr_in,
     return 0;
 }
 
-LIBEXPORT int vigra_gaussiangradientmagnitude_c(const PixelType * arr_in,
-                                                const PixelType * arr_out,
-                                                const int width,
-                                                const int height,
-                                                const float sigma)
+LIBEXPORT int vigra_gaussiansmoothing_bands_c(const PixelType ** arr_in_bands,
+                                              const PixelType ** arr_out_bands,
+                                              const int num_bands,
+                                              const int width,
+                                              const int height,
+                                              const float sigma)
 {
+    VIGRA_C_STATS_SCOPE(2*num_bands*std::size_t(width)*height*sizeof(PixelType));
     try
     {
-        //Create gray scale image views for the arrays
+        //Create gray scale image views for the arrays of all bands
         vigra::Shape2 shape(width,height);
-        ImageView img_in(shape, arr_in);
-        ImageView img_out(shape, arr_out);
+        std::vector<ImageView> imgs_in;
+        std::vector<std::vector<ImageView> > imgs_out;
+        
+        for(int b=0; b!=num_bands; ++b)
+        {
+            imgs_in.push_back(ImageView(shape, arr_in_bands[b]));
+            imgs_out.push_back({ImageView(shape, arr_out_bands[b])});
+        }
         
-        vigra::gaussianGradientMagnitude(img_in, img_out, sigma);
+        //The kernel is shared by all bands
+        vigra::Kernel1D<double> smooth = gaussianKernel(sigma);
+        
+        //The recursive filter and small images are dispatched like for a single
+        //band, where each band is filtered in parallel on its own
+        const int ksize = smooth.right() - smooth.left() + 1;
+        if(useRecursiveGaussian(sigma) || ksize > width || ksize > height)
+        {
+            for(int b=0; b!=num_bands; ++b)
+            {
+                gaussianSmoothImage(imgs_in[b], imgs_out[b][0], sigma);
+            }
+            return 0;
+        }
+        
+        tiledBandsFilter(imgs_in, imgs_out, gaussianHalo(sigma),
+                         [&](const ImageView & in, ImageView * out)
+                         {
+                             separableConvolveImage(in, out[0], smooth, smooth);
+                         });
     }
     catch (vigra::StdException & e)
     {
@@ -176,20 +1306,50 @@ LIBEXPORT int vigra_gaussiangradientmagnitude_c(const PixelType * arr_in,
     return 0;
 }
 
-LIBEXPORT int vigra_gaussiansmoothing_c(const PixelType * arr_in,
-                                        const PixelType * arr_out,
-                                        const int width,
-                                        const int height,
-                                        const float sigma)
+LIBEXPORT int vigra_gaussiangradient_bands_c(const PixelType ** arr_in_bands,
+                                             const PixelType ** arr_gx_out_bands,
+                                             const PixelType ** arr_gy_out_bands,
+                                             const int num_bands,
+                                             const int width,
+                                             const int height,
+                                             const float sigma)
 {
+    VIGRA_C_STATS_SCOPE(3*num_bands*std::size_t(width)*height*sizeof(PixelType));
     try
     {
-        //Create gray scale image views for the arrays
+        //Create gray scale image views for the arrays of all bands
         vigra::Shape2 shape(width,height);
-        ImageView img_in(shape, arr_in);
-        ImageView img_out(shape, arr_out);
+        std::vector<ImageView> imgs_in;
+        std::vector<std::vector<ImageView> > imgs_out;
+        
+        for(int b=0; b!=num_bands; ++b)
+        {
+            imgs_in.push_back(ImageView(shape, arr_in_bands[b]));
+            imgs_out.push_back({ImageView(shape, arr_gx_out_bands[b]),
+                                ImageView(shape, arr_gy_out_bands[b])});
+        }
+        
+        //The recursive filter is dispatched like for a single band, where
+        //each band is filtered in parallel on its own
+        if(useRecursiveGaussian(sigma))
+        {
+            for(int b=0; b!=num_bands; ++b)
+            {
+                recursiveGaussianGradient(imgs_in[b], imgs_out[b][0], imgs_out[b][1], sigma);
+            }
+            return 0;
+        }
         
-        vigra::gaussianSmoothing(img_in, img_out, sigma);
+        //The kernels are shared by all bands
+        vigra::Kernel1D<double> smooth = gaussianKernel(sigma),
+                                grad = gaussianKernel(sigma, 1);
+        
+        tiledBandsFilter(imgs_in, imgs_out, gaussianHalo(sigma, 1),
+                         [&](const ImageView & in, ImageView * out)
+                         {
+                             separableConvolveImage(in, out[0], grad, smooth);
+                             separableConvolveImage(in, out[1], smooth, grad);
+                         });
     }
     catch (vigra::StdException & e)
     {
@@ -205,6 +1365,7 @@ LIBEXPORT int vigra_laplacianofgaussian_c(const PixelType * arr_in,
                                           const int height,
                                           const float scale)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -212,7 +1373,23 @@ LIBEXPORT int vigra_laplacianofgaussian_c(const PixelType * arr_in,
         ImageView img_in(shape, arr_in);
         ImageView img_out(shape, arr_out);
         
-        vigra::laplacianOfGaussian(img_in, img_out, scale);
+        if(useRecursiveGaussian(scale))
+        {
+            recursiveLaplacianOfGaussian(img_in, img_out, scale);
+            return 0;
+        }
+        
+        vigra::Kernel1D<double> smooth = gaussianKernel(scale),
+                                deriv2 = gaussianKernel(scale, 2);
+        
+        tiledFilter(img_in, {img_out}, gaussianHalo(scale, 2),
+                    [&](const ImageView & in, ImageView * out)
+                    {
+                        ScratchImage<PixelType> tmp(in.shape());
+                        separableConvolveImage(in, out[0], deriv2, smooth);
+                        separableConvolveImage(in, tmp, smooth, deriv2);
+                        out[0] += tmp;
+                    });
     }
     catch (vigra::StdException & e)
     {
@@ -229,6 +1406,7 @@ LIBEXPORT int vigra_hessianmatrixofgaussian_c(const PixelType * arr_in,
                                               const int height,
                                               const float scale)
 {
+    VIGRA_C_STATS_SCOPE(4*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -238,7 +1416,199 @@ LIBEXPORT int vigra_hessianmatrixofgaussian_c(const PixelType * arr_in,
         ImageView img_xy(shape, arr_xy_out);
         ImageView img_yy(shape, arr_yy_out);
         
-        vigra::hessianMatrixOfGaussian(img_in, img_xx,img_xy,img_yy, scale);
+        tiledFilter(img_in, {img_xx, img_xy, img_yy}, gaussianHalo(scale, 2),
+                    [&](const ImageView & in, ImageView * out)
+                    {
+                        vigra::hessianMatrixOfGaussian(in, out[0], out[1], out[2], scale);
+                    });
+    }
+    catch (vigra::StdException & e)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * The number of outputs of vigra_gaussianderivatives_c: gx, gy, gradient
+ * magnitude, xx, xy, yy and LoG.
+ */
+static const int NUM_GAUSSIAN_DERIVATIVES = 7;
+
+/**
+ * Internal helper to count the requested outputs of vigra_gaussianderivatives_c.
+ */
+static int numGaussianDerivatives(const int outputs)
+{
+    int count = 0;
+    for(int i=0; i<NUM_GAUSSIAN_DERIVATIVES; ++i)
+    {
+        count += (outputs >> i) & 1;
+    }
+    return count;
+}
+
+LIBEXPORT int vigra_gaussianderivatives_c(const PixelType * arr_in,
+                                          const PixelType ** arr_outs,
+                                          const int width,
+                                          const int height,
+                                          const float scale,
+                                          const int outputs)
+{
+    VIGRA_C_STATS_SCOPE((1 + numGaussianDerivatives(outputs))*std::size_t(width)*height*sizeof(PixelType));
+    enum { GX = 1, GY = 2, MAGNITUDE = 4, XX = 8, XY = 16, YY = 32, LOG = 64 };
+    
+    if(outputs <= 0 || outputs >= (1 << NUM_GAUSSIAN_DERIVATIVES))
+    {
+        //Illegal output mask!
+        return 2;
+    }
+    for(int i=0; i<NUM_GAUSSIAN_DERIVATIVES; ++i)
+    {
+        if(((outputs >> i) & 1) && arr_outs[i] == nullptr)
+        {
+            return 2;
+        }
+    }
+    
+    try
+    {
+        vigra::Shape2 shape(width,height);
+        ImageView img_in(shape, arr_in);
+        
+        //Like vigra_gaussiangradient_c and vigra_laplacianofgaussian_c, the
+        //gradient and the LoG use the recursive filter from the threshold on.
+        //The gradient magnitude and the Hessian always use the FIR filters.
+        int fir_outputs = outputs;
+        if(useRecursiveGaussian(scale))
+        {
+            if(outputs & (GX | GY))
+            {
+                ScratchImage<PixelType> unused;
+                if((outputs & (GX | GY)) != (GX | GY))
+                {
+                    unused.reshape(shape);
+                }
+                ImageView img_gx = (outputs & GX) ? ImageView(shape, arr_outs[0]) : ImageView(unused),
+                          img_gy = (outputs & GY) ? ImageView(shape, arr_outs[1]) : ImageView(unused);
+                recursiveGaussianGradient(img_in, img_gx, img_gy, scale);
+            }
+            if(outputs & LOG)
+            {
+                ImageView img_log(shape, arr_outs[6]);
+                recursiveLaplacianOfGaussian(img_in, img_log, scale);
+            }
+            
+            fir_outputs &= ~(GX | GY | LOG);
+            if(fir_outputs == 0)
+            {
+                return 0;
+            }
+        }
+        
+        //Create gray scale image views for the arrays of the remaining outputs
+        std::vector<ImageView> imgs_out;
+        std::vector<int> out_index(NUM_GAUSSIAN_DERIVATIVES, -1);
+        
+        for(int i=0; i<NUM_GAUSSIAN_DERIVATIVES; ++i)
+        {
+            if((fir_outputs >> i) & 1)
+            {
+                out_index[i] = (int)imgs_out.size();
+                imgs_out.push_back(ImageView(shape, arr_outs[i]));
+            }
+        }
+        
+        //Intermediate results, which are needed by other outputs
+        const bool need_gx = fir_outputs & (GX | MAGNITUDE),
+                   need_gy = fir_outputs & (GY | MAGNITUDE),
+                   need_xx = fir_outputs & (XX | LOG),
+                   need_yy = fir_outputs & (YY | LOG),
+                   need_xy = fir_outputs & XY,
+                   second_order = need_xx || need_yy || need_xy;
+        
+        vigra::Kernel1D<double> smooth = gaussianKernel(scale),
+                                deriv1 = gaussianKernel(scale, 1),
+                                deriv2 = gaussianKernel(scale, 2);
+        
+        tiledFilter(img_in, imgs_out, gaussianHalo(scale, second_order ? 2 : 1),
+                    [&](const ImageView & in, ImageView * out)
+                    {
+                        //The result views: either the requested outputs or scratch images
+                        ScratchImage<PixelType> scratch[NUM_GAUSSIAN_DERIVATIVES];
+                        ImageView * result[NUM_GAUSSIAN_DERIVATIVES];
+                        
+                        for(int i=0; i<NUM_GAUSSIAN_DERIVATIVES; ++i)
+                        {
+                            if(out_index[i] >= 0)
+                            {
+                                result[i] = &out[out_index[i]];
+                            }
+                            else
+                            {
+                                if((i == 0 && need_gx) || (i == 1 && need_gy) ||
+                                   (i == 3 && need_xx) || (i == 5 && need_yy))
+                                {
+                                    scratch[i].reshape(in.shape());
+                                }
+                                result[i] = &scratch[i];
+                            }
+                        }
+                        
+                        //The horizontal passes are shared by the vertical ones
+                        ScratchImage<PixelType> h_smooth, h_deriv1, h_deriv2;
+                        if(need_gy || need_yy)
+                        {
+                            h_smooth.reshape(in.shape());
+                            convolveX(in, h_smooth, smooth);
+                        }
+                        if(need_gx || need_xy)
+                        {
+                            h_deriv1.reshape(in.shape());
+                            convolveX(in, h_deriv1, deriv1);
+                        }
+                        if(need_xx)
+                        {
+                            h_deriv2.reshape(in.shape());
+                            convolveX(in, h_deriv2, deriv2);
+                        }
+                        
+                        if(need_gx)
+                        {
+                            convolveY(h_deriv1, *result[0], smooth);
+                        }
+                        if(need_gy)
+                        {
+                            convolveY(h_smooth, *result[1], deriv1);
+                        }
+                        if(need_xx)
+                        {
+                            convolveY(h_deriv2, *result[3], smooth);
+                        }
+                        if(need_xy)
+                        {
+                            convolveY(h_deriv1, *result[4], deriv1);
+                        }
+                        if(need_yy)
+                        {
+                            convolveY(h_smooth, *result[5], deriv2);
+                        }
+                        
+                        if(fir_outputs & MAGNITUDE)
+                        {
+                            auto gx_iter = result[0]->begin(), gy_iter = result[1]->begin();
+                            for(auto iter = result[2]->begin(); iter != result[2]->end(); ++iter, ++gx_iter, ++gy_iter)
+                            {
+                                *iter = std::sqrt(*gx_iter * *gx_iter + *gy_iter * *gy_iter);
+                            }
+                        }
+                        if(fir_outputs & LOG)
+                        {
+                            *result[6] = *result[3];
+                            *result[6] += *result[5];
+                        }
+                    });
     }
     catch (vigra::StdException & e)
     {
@@ -255,6 +1625,7 @@ LIBEXPORT int vigra_gaussiansharpening_c(const PixelType * arr_in,
                                          const float sharpening_factor,
                                          const float scale)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -262,7 +1633,11 @@ LIBEXPORT int vigra_gaussiansharpening_c(const PixelType * arr_in,
         ImageView img_in(shape, arr_in);
         ImageView img_out(shape, arr_out);
         
-        vigra::gaussianSharpening(img_in, img_out, sharpening_factor, scale);
+        tiledFilter(img_in, {img_out}, gaussianHalo(scale),
+                    [&](const ImageView & in, ImageView * out)
+                    {
+                        vigra::gaussianSharpening(in, out[0], sharpening_factor, scale);
+                    });
     }
     catch (vigra::StdException & e)
     {
@@ -277,6 +1652,7 @@ LIBEXPORT int vigra_simplesharpening_c(const PixelType * arr_in,
                                        const int height,
                                        float sharpening_factor)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -284,7 +1660,11 @@ LIBEXPORT int vigra_simplesharpening_c(const PixelType * arr_in,
         ImageView img_in(shape, arr_in);
         ImageView img_out(shape, arr_out);
         
-        vigra::simpleSharpening(img_in, img_out, sharpening_factor);
+        tiledFilter(img_in, {img_out}, 2,
+                    [&](const ImageView & in, ImageView * out)
+                    {
+                        vigra::simpleSharpening(in, out[0], sharpening_factor);
+                    });
     }
     catch (vigra::StdException & e)
     {
@@ -293,6 +1673,318 @@ LIBEXPORT int vigra_simplesharpening_c(const PixelType * arr_in,
     return 0;
 }
 
+/**
+ * The maximal number of histogram bins of the constant-time median filter.
+ * Images with more distinct values are filtered by vigra::medianFilter.
+ */
+static const int MEDIAN_HISTOGRAM_BINS = 65536;
+
+/**
+ * The memory budget (in bytes) of the column histograms of one strip of the
+ * constant-time median filter.
+ */
+static const std::size_t MEDIAN_HISTOGRAM_BUDGET = 16*1024*1024;
+
+/**
+ * The minimal number of window elements, for which vigra_medianfilter_c uses
+ * the constant-time median filter. Negative values disable it.
+ */
+static std::atomic<int> median_histogram_threshold(225);
+
+/**
+ * Internal helper to determine, if a median filter is computed by the
+ * constant-time histogram-based median filter. This needs an odd window,
+ * which is not larger than the image.
+ */
+static bool useHistogramMedian(const int width, const int height,
+                               const int window_width, const int window_height)
+{
+    int threshold = median_histogram_threshold.load();
+    
+    return threshold >= 0 && window_width*window_height >= threshold &&
+           (window_width % 2) == 1 && (window_height % 2) == 1 &&
+           window_width <= width && window_height <= height &&
+           window_height < 65536;
+}
+
+/**
+ * Internal helper to quantize an image for the histogram-based median filter.
+ * Integer images with a range of at most MEDIAN_HISTOGRAM_BINS values are
+ * mapped to their offset to the minimum. Other images are mapped to the ranks
+ * of their (sorted) distinct values, if there are at most MEDIAN_HISTOGRAM_BINS
+ * of them. Thus, the quantization is always exact.
+ *
+ * \param in The input image.
+ * \param[out] bins The bin of each pixel, of the same shape as the input image.
+ * \param with_zero If true, the value zero gets a bin, too (for ZEROPAD).
+ * \param[out] zero_bin The bin of the value zero, if with_zero is true.
+ *
+ * \return The value of each bin, or an empty vector, if the image contains
+ *         values, which are not finite, or too many distinct values.
+ */
+static std::vector<PixelType> medianQuantize(const ImageView & in,
+                                             vigra::MultiArrayView<2, unsigned short> bins,
+                                             const bool with_zero,
+                                             int & zero_bin)
+{
+    std::vector<PixelType> values;
+    
+    PixelType lo = with_zero ? PixelType(0) : in(0, 0),
+              hi = lo;
+    bool integral = true;
+    for(auto iter = in.begin(); iter != in.end(); ++iter)
+    {
+        if(!std::isfinite(*iter))
+        {
+            return values;
+        }
+        lo = std::min(lo, *iter);
+        hi = std::max(hi, *iter);
+        integral = integral && (*iter == std::floor(*iter));
+    }
+    
+    if(integral && double(hi) - lo < MEDIAN_HISTOGRAM_BINS)
+    {
+        values.resize(int(hi - lo) + 1);
+        for(std::size_t b=0; b<values.size(); ++b)
+        {
+            values[b] = lo + PixelType(b);
+        }
+        zero_bin = int(-lo);
+        
+        parallelRows(in.height(), 16,
+                     [&](int y0, int y1)
+                     {
+                         for(int y=y0; y<y1; ++y)
+                         {
+                             for(int x=0; x<in.width(); ++x)
+                             {
+                                 bins(x, y) = (unsigned short)(in(x, y) - lo);
+                             }
+                         }
+                     });
+        return values;
+    }
+    
+    //Ordinal mapping by the ranks of the distinct values. The search stops
+    //as soon as there are too many of them for an exact mapping.
+    std::unordered_set<PixelType> distinct;
+    if(with_zero)
+    {
+        distinct.insert(0);
+    }
+    for(auto iter = in.begin(); iter != in.end(); ++iter)
+    {
+        distinct.insert(*iter);
+        if(distinct.size() > (std::size_t)MEDIAN_HISTOGRAM_BINS)
+        {
+            return values;
+        }
+    }
+    
+    values.assign(distinct.begin(), distinct.end());
+    std::sort(values.begin(), values.end());
+    
+    auto binOf = [&](const PixelType v)
+                 {
+                     return int(std::lower_bound(values.begin(), values.end(), v) - values.begin());
+                 };
+    
+    zero_bin = with_zero ? binOf(0) : 0;
+    
+    parallelRows(in.height(), 16,
+                 [&](int y0, int y1)
+                 {
+                     for(int y=y0; y<y1; ++y)
+                     {
+                         for(int x=0; x<in.width(); ++x)
+                         {
+                             bins(x, y) = (unsigned short)binOf(in(x, y));
+                         }
+                     }
+                 });
+    return values;
+}
+
+/**
+ * Internal helper for the constant-time median filter of Perreault and Hebert.
+ * The image is quantized by medianQuantize. Each column keeps a histogram of
+ * the window height, which is moved down by adding and removing one pixel.
+ * The window histogram is moved right by adding and removing a column
+ * histogram. All histograms are split into coarse buckets and fine bins: the
+ * coarse window histogram is always up to date, the fine bins of a bucket are
+ * only updated, when the median is searched in that bucket. The image is
+ * split into strips of columns, whose column histograms fit into the memory
+ * budget, which are processed in parallel.
+ * The border treatments are the same as for vigra::medianFilter, but CLIP.
+ *
+ * \param in The input image.
+ * \param[out] out The output image of the same shape.
+ * \param window_width The odd width of the window, not larger than the image.
+ * \param window_height The odd height of the window, not larger than the image.
+ * \param border The border treatment.
+ *
+ * \return True, if the median was computed, false if the image contains
+ *         values, which are not finite, or more than MEDIAN_HISTOGRAM_BINS
+ *         distinct values.
+ */
+static bool histogramMedianFilter(const ImageView & in,
+                                  ImageView & out,
+                                  const int window_width,
+                                  const int window_height,
+                                  const vigra::BorderTreatmentMode border)
+{
+    const int width = in.width(),
+              height = in.height(),
+              rx = window_width/2,
+              ry = window_height/2,
+              median = (window_width*window_height)/2;
+    
+    ScratchImage<unsigned short> bins(in.shape());
+    int zero_bin = 0;
+    const std::vector<PixelType> values = medianQuantize(in, bins, border == vigra::BORDER_TREATMENT_ZEROPAD, zero_bin);
+    if(values.empty())
+    {
+        return false;
+    }
+    
+    //Two-level histograms of num_buckets coarse buckets with fine_size bins each
+    const int num_bins = (int)values.size(),
+              fine_size = std::max(1, (int)std::ceil(std::sqrt(double(num_bins)))),
+              num_buckets = (num_bins + fine_size - 1)/fine_size;
+    
+    //AVOID leaves the pixels untouched, where the window does not fit
+    const bool avoid = (border == vigra::BORDER_TREATMENT_AVOID);
+    const int x_begin = avoid ? rx : 0,
+              x_end   = avoid ? width - rx : width,
+              y_begin = avoid ? ry : 0,
+              y_end   = avoid ? height - ry : height;
+    
+    if(x_begin >= x_end || y_begin >= y_end)
+    {
+        return true;
+    }
+    
+    const int budget_columns = int(MEDIAN_HISTOGRAM_BUDGET/(std::size_t(num_buckets + fine_size*num_buckets)*sizeof(unsigned short))),
+              strip = std::max(16, std::min(budget_columns - 2*rx,
+                                            (x_end - x_begin + numThreads() - 1)/numThreads())),
+              strips = (x_end - x_begin + strip - 1)/strip;
+    
+    parallelForEach(strips,
+                    [&](int s)
+                    {
+                        const int x0 = x_begin + s*strip,
+                                  x1 = std::min(x0 + strip, x_end),
+                                  columns = x1 - x0 + 2*rx;
+                        
+                        //Image column of each histogram column, -1 for zeros
+                        std::vector<int> x_index(columns);
+                        for(int j=0; j<columns; ++j)
+                        {
+                            x_index[j] = borderIndex(x0 - rx + j, width, border);
+                        }
+                        
+                        std::vector<unsigned short> col_coarse(std::size_t(columns)*num_buckets, 0),
+                                                    col_fine(std::size_t(columns)*num_buckets*fine_size, 0);
+                        std::vector<unsigned int> coarse(num_buckets), fine(std::size_t(num_buckets)*fine_size);
+                        std::vector<int> fine_column(num_buckets);
+                        
+                        auto updateColumns = [&](const int y, const int delta)
+                                             {
+                                                 const int y_in = borderIndex(y, height, border);
+                                                 for(int j=0; j<columns; ++j)
+                                                 {
+                                                     const int b = (y_in < 0 || x_index[j] < 0) ? zero_bin : bins(x_index[j], y_in);
+                                                     col_coarse[std::size_t(j)*num_buckets + b/fine_size] += delta;
+                                                     col_fine[std::size_t(j)*num_buckets*fine_size + b] += delta;
+                                                 }
+                                             };
+                        
+                        //Add or remove the fine bins of one bucket of a column
+                        auto updateFine = [&](const int c, const int j, const int delta)
+                                          {
+                                              const unsigned short * src = &col_fine[(std::size_t(j)*num_buckets + c)*fine_size];
+                                              unsigned int * dst = &fine[std::size_t(c)*fine_size];
+                                              for(int f=0; f<fine_size; ++f)
+                                              {
+                                                  dst[f] += delta*src[f];
+                                              }
+                                          };
+                        
+                        for(int y=y_begin - ry; y<y_begin + ry; ++y)
+                        {
+                            updateColumns(y, 1);
+                        }
+                        
+                        for(int y=y_begin; y<y_end; ++y)
+                        {
+                            updateColumns(y + ry, 1);
+                            
+                            //The window histogram of the first output column
+                            std::fill(coarse.begin(), coarse.end(), 0);
+                            for(int j=0; j<window_width; ++j)
+                            {
+                                for(int c=0; c<num_buckets; ++c)
+                                {
+                                    coarse[c] += col_coarse[std::size_t(j)*num_buckets + c];
+                                }
+                            }
+                            std::fill(fine_column.begin(), fine_column.end(), -1);
+                            
+                            for(int i=0; i<x1-x0; ++i)
+                            {
+                                if(i > 0)
+                                {
+                                    const unsigned short * add = &col_coarse[std::size_t(i + 2*rx)*num_buckets],
+                                                         * sub = &col_coarse[std::size_t(i - 1)*num_buckets];
+                                    for(int c=0; c<num_buckets; ++c)
+                                    {
+                                        coarse[c] += add[c] - sub[c];
+                                    }
+                                }
+                                
+                                //Find the bucket of the median
+                                int c = 0, count = 0;
+                                while(count + (int)coarse[c] <= median)
+                                {
+                                    count += coarse[c++];
+                                }
+                                
+                                //Bring the fine bins of this bucket up to date
+                                if(fine_column[c] < 0 || i - fine_column[c] >= window_width)
+                                {
+                                    std::fill(&fine[std::size_t(c)*fine_size], &fine[std::size_t(c+1)*fine_size], 0);
+                                    for(int j=i; j<i+window_width; ++j)
+                                    {
+                                        updateFine(c, j, 1);
+                                    }
+                                }
+                                else
+                                {
+                                    for(int t=fine_column[c]+1; t<=i; ++t)
+                                    {
+                                        updateFine(c, t + 2*rx, 1);
+                                        updateFine(c, t - 1, -1);
+                                    }
+                                }
+                                fine_column[c] = i;
+                                
+                                //Find the bin of the median
+                                const unsigned int * bucket = &fine[std::size_t(c)*fine_size];
+                                int f = 0;
+                                while(count + (int)bucket[f] <= median)
+                                {
+                                    count += bucket[f++];
+                                }
+                                out(x0 + i, y) = values[c*fine_size + f];
+                            }
+                            
+                            updateColumns(y - ry, -1);
+                        }
+                    });
+    return true;
+}
+
 LIBEXPORT int vigra_medianfilter_c(const PixelType * arr_in,
                                    const PixelType * arr_out,
                                    const int width,
@@ -301,6 +1993,7 @@ LIBEXPORT int vigra_medianfilter_c(const PixelType * arr_in,
                                    const int window_height,
 								   const int border_treatment)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
 	if (border_treatment < 0 || border_treatment > 5 || (vigra::BorderTreatmentMode)border_treatment == vigra::BORDER_TREATMENT_CLIP)
 	{
 		//Illegal border treatment mode!
@@ -314,9 +2007,28 @@ LIBEXPORT int vigra_medianfilter_c(const PixelType * arr_in,
         ImageView img_in(shape, arr_in);
         ImageView img_out(shape, arr_out);
         
-        vigra::medianFilter(img_in, img_out,
-							vigra::Diff2D(window_width, window_height),
-			                (vigra::BorderTreatmentMode)border_treatment);
+        if(useHistogramMedian(width, height, window_width, window_height) &&
+           histogramMedianFilter(img_in, img_out, window_width, window_height,
+                                 (vigra::BorderTreatmentMode)border_treatment))
+        {
+            return 0;
+        }
+        
+        auto filter = [&](const ImageView & in, ImageView * out)
+                      {
+                          vigra::medianFilter(in, out[0],
+                                              vigra::Diff2D(window_width, window_height),
+                                              (vigra::BorderTreatmentMode)border_treatment);
+                      };
+        
+        if(isTileable((vigra::BorderTreatmentMode)border_treatment))
+        {
+            tiledFilter(img_in, {img_out}, window_height/2 + 1, filter);
+        }
+        else
+        {
+            filter(img_in, &img_out);
+        }
     }
     catch (vigra::StdException & e)
     {
@@ -325,6 +2037,13 @@ LIBEXPORT int vigra_medianfilter_c(const PixelType * arr_in,
     return 0;
 }
 
+LIBEXPORT int vigra_set_median_histogram_threshold_c(const int window_size)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    median_histogram_threshold = window_size;
+    return 0;
+}
+
 LIBEXPORT int vigra_nonlineardiffusion_c(const PixelType * arr_in,
                                          const PixelType * arr_out,
                                          const int width,
@@ -332,6 +2051,7 @@ LIBEXPORT int vigra_nonlineardiffusion_c(const PixelType * arr_in,
                                          const float edge_threshold,
                                          const float scale)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -358,6 +2078,7 @@ LIBEXPORT int vigra_shockfilter_c(const PixelType *arr_in,
                                   const float upwind_factor_h,
                                   const int iterations)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -395,6 +2116,7 @@ LIBEXPORT int vigra_nonlocalmean_c(const PixelType *arr_in,
                                    const int nThreads,
                                    const bool verbose)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -425,3 +2147,182 @@ LIBEXPORT int vigra_nonlocalmean_c(const PixelType *arr_in,
     }
     return 0;
 }
+
+LIBEXPORT void * vigra_convolveimage_async_c(const PixelType * arr_in,
+                                             const double * kernel_arr_in,
+                                             const PixelType * arr_out,
+                                             const int width,
+                                             const int height,
+                                             const int kernel_width,
+                                             const int kernel_height,
+                                             const int border_treatment)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    return submitJob([=]()
+                     {
+                         return vigra_convolveimage_c(arr_in,
+                                                      kernel_arr_in,
+                                                      arr_out,
+                                                      width,
+                                                      height,
+                                                      kernel_width,
+                                                      kernel_height,
+                                                      border_treatment);
+                     });
+}
+
+LIBEXPORT void * vigra_separableconvolveimage_async_c(const PixelType * arr_in,
+                                                      const double * kernel_h_arr_in,
+                                                      const double * kernel_v_arr_in,
+                                                      const PixelType * arr_out,
+                                                      const int width,
+                                                      const int height,
+                                                      const int kernel_width,
+                                                      const int kernel_height,
+                                                      const int border_treatment)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    return submitJob([=]()
+                     {
+                         return vigra_separableconvolveimage_c(arr_in,
+                                                               kernel_h_arr_in,
+                                                               kernel_v_arr_in,
+                                                               arr_out,
+                                                               width,
+                                                               height,
+                                                               kernel_width,
+                                                               kernel_height,
+                                                               border_treatment);
+                     });
+}
+
+LIBEXPORT void * vigra_gaussiangradient_async_c(const PixelType * arr_in,
+                                                const PixelType * arr_gx_out,
+                                                const PixelType * arr_gy_out,
+                                                const int width,
+                                                const int height,
+                                                const float sigma)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    return submitJob([=]()
+                     {
+                         return vigra_gaussiangradient_c(arr_in,
+                                                         arr_gx_out,
+                                                         arr_gy_out,
+                                                         width,
+                                                         height,
+                                                         sigma);
+                     });
+}
+
+LIBEXPORT void * vigra_gaussiangradientmagnitude_async_c(const PixelType * arr_in,
+                                                         const PixelType * arr_out,
+                                                         const int width,
+                                                         const int height,
+                                                         const float sigma)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    return submitJob([=]()
+                     {
+                         return vigra_gaussiangradientmagnitude_c(arr_in,
+                                                                  arr_out,
+                                                                  width,
+                                                                  height,
+                                                                  sigma);
+                     });
+}
+
+LIBEXPORT void * vigra_gaussiansmoothing_async_c(const PixelType * arr_in,
+                                                 const PixelType * arr_out,
+                                                 const int width,
+                                                 const int height,
+                                                 const float sigma)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    return submitJob([=]()
+                     {
+                         return vigra_gaussiansmoothing_c(arr_in,
+                                                          arr_out,
+                                                          width,
+                                                          height,
+                                                          sigma);
+                     });
+}
+
+LIBEXPORT void * vigra_laplacianofgaussian_async_c(const PixelType * arr_in,
+                                                   const PixelType * arr_out,
+                                                   const int width,
+                                                   const int height,
+                                                   const float scale)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    return submitJob([=]()
+                     {
+                         return vigra_laplacianofgaussian_c(arr_in,
+                                                            arr_out,
+                                                            width,
+                                                            height,
+                                                            scale);
+                     });
+}
+
+LIBEXPORT void * vigra_hessianmatrixofgaussian_async_c(const PixelType * arr_in,
+                                                       const PixelType * arr_xx_out,
+                                                       const PixelType * arr_xy_out,
+                                                       const PixelType * arr_yy_out,
+                                                       const int width,
+                                                       const int height,
+                                                       const float scale)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    return submitJob([=]()
+                     {
+                         return vigra_hessianmatrixofgaussian_c(arr_in,
+                                                                arr_xx_out,
+                                                                arr_xy_out,
+                                                                arr_yy_out,
+                                                                width,
+                                                                height,
+                                                                scale);
+                     });
+}
+
+LIBEXPORT void * vigra_medianfilter_async_c(const PixelType * arr_in,
+                                            const PixelType * arr_out,
+                                            const int width,
+                                            const int height,
+                                            const int window_width,
+                                            const int window_height,
+                                            const int border_treatment)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    return submitJob([=]()
+                     {
+                         return vigra_medianfilter_c(arr_in,
+                                                     arr_out,
+                                                     width,
+                                                     height,
+                                                     window_width,
+                                                     window_height,
+                                                     border_treatment);
+                     });
+}
+
+LIBEXPORT void * vigra_nonlineardiffusion_async_c(const PixelType * arr_in,
+                                                  const PixelType * arr_out,
+                                                  const int width,
+                                                  const int height,
+                                                  const float edge_threshold,
+                                                  const float scale)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    return submitJob([=]()
+                     {
+                         return vigra_nonlineardiffusion_c(arr_in,
+                                                           arr_out,
+                                                           width,
+                                                           height,
+                                                           edge_threshold,
+                                                           scale);
+                     });
+}
@@ -71,6 +71,13 @@
    4 = BORDER_TREATMENT_WRAP : wrap image around (periodic boundary conditions)
    5 = BORDER_TREATMENT_ZEROPAD: assume that all outside points have value zero
  *
+ * If the kernel is the outer product of a horizontal and a vertical kernel
+ * (rank 1, like Gaussian, box or Sobel kernels), this is detected and the
+ * faster separable convolution is used for all border treatment modes but AVOID.
+ * For other large kernels (see vigra_set_fft_convolution_threshold_c) and the
+ * border treatment modes 2 to 5, the convolution is performed tile-wise in the
+ * Fourier domain instead, which yields the same result up to float precision.
+ *
  * \return 0 if the convolution was successful,
  *         3 if the border treatment mode is invalid,
  *         2 if the kernel size are not odd,
@@ -85,6 +92,61 @@ LIBEXPORT int vigra_convolveimage_c(const PixelType * arr_in,
                                     const int kernel_height,
                                     const int border_treatment);
 
+/**
+ * Sets the kernel size, from which on vigra_convolveimage_c performs the 
+ * convolution in the Fourier domain by means of the overlap-save method
+ * and cached FFTW plans. The spatial convolution costs O(kernel_width*kernel_height)
+ * per pixel, the Fourier domain convolution O(log(tile size)). 
+ * The Fourier domain is only used for the border treatment modes REPEAT,
+ * REFLECT, WRAP and ZEROPAD and kernels, which are not larger than the image.
+ *
+ * \param kernel_size The minimal number of kernel elements (kernel_width*kernel_height)
+ *                    for the Fourier domain convolution. The default is 121 (11x11).
+ *                    A negative value disables the Fourier domain convolution.
+ *
+ * \return Always 0.
+ */
+LIBEXPORT int vigra_set_fft_convolution_threshold_c(const int kernel_size);
+
+/**
+ * Low-rank approximated image convolution.
+ * Approximates the kernel by a sum of separable kernels using its singular
+ * value decomposition and convolves the image with each of the separable
+ * terms. The number of terms is increased until the residual of the kernel
+ * is below the given tolerance or max_rank is reached. For a kernel of rank r,
+ * this costs O(r*(kernel_width+kernel_height)) per pixel instead of 
+ * O(kernel_width*kernel_height) for vigra_convolveimage_c.
+ * All arrays must have been allocated before the call of this function.
+ *
+ * \param arr_in Flat input array (band) of size width*height.
+ * \param kernel_arr_in Flat input array (kernel) of size kernel_width*kernel_height.
+ * \param[out] arr_out Flat array of the convolution result (band) of size width*height.
+ * \param width The width of the flat array.
+ * \param height The height of the flat array.
+ * \param kernel_width The width of the flat kernel array.
+ * \param kernel_height The height the flat kernel array.
+ * \param border_treatment The border treatment mode, see vigra_separableconvolveimage_c.
+ * \param max_rank The maximal number of separable terms.
+ * \param tolerance The tolerated residual of the approximated kernel, relative
+ *                  to its Frobenius norm, e.g. 0.01.
+ *
+ * \return 0 if the convolution was successful,
+ *         4 if max_rank is less than 1,
+ *         3 if the border treatment mode is invalid,
+ *         2 if the kernel size are not odd,
+ *         1 else.
+ */
+LIBEXPORT int vigra_convolveimage_lowrank_c(const PixelType * arr_in,
+                                            const double * kernel_arr_in,
+                                            const PixelType * arr_out,
+                                            const int width,
+                                            const int height,
+                                            const int kernel_width,
+                                            const int kernel_height,
+                                            const int border_treatment,
+                                            const int max_rank,
+                                            const float tolerance);
+
 /**
  * Separable image convolution.
  * This function wraps the
@@ -134,6 +196,8 @@ LIBEXPORT int vigra_separableconvolveimage_c(const PixelType * arr_in,
  * </a>
  * function to C to compute both partial derivates (in x- and y-direction) at a
  * given scale (Gaussian std.dev.).
+ * From the threshold of vigra_set_recursive_gaussian_threshold_c on, the
+ * gradient is derived by central differences of the recursive smoothing.
  * All arrays must have been allocated before the call of this function.
  *
  * \param arr_in Flat input array (band) of size width*height.
@@ -186,6 +250,8 @@ LIBEXPORT int vigra_gaussiangradientmagnitude_c(const PixelType * arr_in,
  * vigra::gaussianSmoothing
  * </a>
  * function to C to compute the result at a given scale (Gaussian std.dev.).
+ * From the threshold of vigra_set_recursive_gaussian_threshold_c on,
+ * vigra_recursivegaussiansmoothing_c is used instead.
  * All arrays must have been allocated before the call of this function.
  *
  * \param arr_in Flat input array (band) of size width*height.
@@ -202,6 +268,168 @@ LIBEXPORT int vigra_gaussiansmoothing_c(const PixelType * arr_in,
                                         const int height,
                                         const float sigma);
 
+/**
+ * Computation of the Gaussian smoothing by means of the recursive (IIR) filter
+ * of Young and van Vliet. In contrast to vigra_gaussiansmoothing_c, which
+ * convolves with a kernel of radius 3*sigma, this costs a constant time per
+ * pixel for any scale. The border treatment is REFLECT, like for the FIR
+ * filter.
+ *
+ * The recursive filter approximates the Gaussian. For input values within
+ * a range R and sigma >= 3, the result deviates from vigra_gaussiansmoothing_c
+ * by at most 0.06*R (worst case bound by the L1 norm of the impulse response
+ * difference), at step edges by at most 0.015*R.
+ * All arrays must have been allocated before the call of this function.
+ *
+ * \param arr_in Flat input array (band) of size width*height.
+ * \param[out] arr_out Flat array (smoothed) of size width*height.
+ * \param width The width of the flat array.
+ * \param height The height of the flat array.
+ * \param sigma The scale (Gaussian std.dev.) for which the smoothing shall be computed.
+ *
+ * \return 0 if the smoothing was successful,
+ *         2 if sigma is less than 0.5,
+ *         1 else.
+ */
+LIBEXPORT int vigra_recursivegaussiansmoothing_c(const PixelType * arr_in,
+                                                 const PixelType * arr_out,
+                                                 const int width,
+                                                 const int height,
+                                                 const float sigma);
+
+/**
+ * Sets the scale, from which on vigra_gaussiansmoothing_c, vigra_gaussiangradient_c,
+ * vigra_laplacianofgaussian_c and the corresponding outputs of
+ * vigra_gaussianderivatives_c use the recursive Gaussian filter of
+ * vigra_recursivegaussiansmoothing_c instead of FIR kernels. The derivatives
+ * are then computed by central differences (gradient) and the 5-point
+ * Laplacian (LoG) of the smoothed image. For input values within a range R and
+ * sigma >= 3, they deviate from the FIR results by at most 0.11*R/sigma (gradient)
+ * and 0.27*R/sigma^2 (LoG), see vigra_recursivegaussiansmoothing_c for the smoothing.
+ * Scales from about 10 on are recommended.
+ *
+ * \param sigma The minimal scale for the recursive filters. The default is -1,
+ *              a negative value disables the recursive filters.
+ *
+ * \return Always 0.
+ */
+LIBEXPORT int vigra_set_recursive_gaussian_threshold_c(const float sigma);
+
+/**
+ * Computation of the memory layout of a Gaussian scale space, as it is
+ * filled by vigra_gaussianscalespace_c. The scale space consists of octaves,
+ * each with levels_per_octave levels. The first octave has the size of the
+ * input image, each further octave half the size (rounded up) of the previous
+ * one. All levels are stored one after another in one flat array, each level
+ * of size width*height of its octave.
+ *
+ * \param width The width of the input image.
+ * \param height The height of the input image.
+ * \param octaves The number of octaves.
+ * \param levels_per_octave The number of levels per octave.
+ * \param[out] offsets_out Array of size octaves*levels_per_octave+1. The offset (in
+ *                         pixels) of level l of octave o is offsets_out[o*levels_per_octave+l],
+ *                         the last element is the size of the whole scale space.
+ * \param[out] widths_out Array of size octaves for the widths of the octaves.
+ * \param[out] heights_out Array of size octaves for the heights of the octaves.
+ *
+ * \return 0 if the layout was computed successfully,
+ *         2 if the size, octaves or levels_per_octave are less than 1,
+ *         1 else.
+ */
+LIBEXPORT int vigra_gaussianscalespace_layout_c(const int width,
+                                                const int height,
+                                                const int octaves,
+                                                const int levels_per_octave,
+                                                long long * offsets_out,
+                                                int * widths_out,
+                                                int * heights_out);
+
+/**
+ * Computation of a Gaussian scale space (pyramid) of an image band.
+ * The level l of octave o is smoothed to the scale sigma*2^(o + l/levels_per_octave),
+ * measured in pixels of the input image. Each level is computed from the
+ * previous one by smoothing with the differential scale, and the first level
+ * of each octave by decimating the previous octave at twice its base scale.
+ * Thus, the kernels stay small and all octaves together cost about as much as
+ * 4/3 of the first one, instead of one full-resolution smoothing at an
+ * increasing scale per level.
+ * The border treatment is REFLECT, like for vigra_gaussiansmoothing_c.
+ * All arrays must have been allocated before the call of this function.
+ *
+ * \param arr_in Flat input array (band) of size width*height.
+ * \param[out] arr_out Flat array of the scale space, of the size and layout
+ *                     given by vigra_gaussianscalespace_layout_c.
+ * \param width The width of the flat array.
+ * \param height The height of the flat array.
+ * \param octaves The number of octaves.
+ * \param levels_per_octave The number of levels per octave.
+ * \param sigma The scale (Gaussian std.dev.) of the first level, e.g. 1.6.
+ * \param sigma_in The scale, which is already present in the input image, e.g. 0.5.
+ *                 The first level is smoothed by the difference to sigma only.
+ *
+ * \return 0 if the scale space was computed successfully,
+ *         3 if sigma is not positive or sigma_in is negative,
+ *         2 if the size, octaves or levels_per_octave are less than 1,
+ *         1 else.
+ */
+LIBEXPORT int vigra_gaussianscalespace_c(const PixelType * arr_in,
+                                         const PixelType * arr_out,
+                                         const int width,
+                                         const int height,
+                                         const int octaves,
+                                         const int levels_per_octave,
+                                         const float sigma,
+                                         const float sigma_in);
+
+/**
+ * Computation of the Gaussian smoothing for multiple bands at once.
+ * This function computes the same results as vigra_gaussiansmoothing_c for 
+ * each band, but the Gaussian kernel is created only once and the bands
+ * are processed in parallel.
+ * All arrays must have been allocated before the call of this function.
+ *
+ * \param arr_in_bands Array of num_bands flat input arrays (bands) of size width*height.
+ * \param[out] arr_out_bands Array of num_bands flat arrays (smoothed) of size width*height.
+ * \param num_bands The number of bands.
+ * \param width The width of the flat arrays.
+ * \param height The height of the flat arrays.
+ * \param sigma The scale (Gaussian std.dev.) for which the smoothing shall be computed.
+ *
+ * \return 0 if the smoothing was successful, 1 else.
+ */
+LIBEXPORT int vigra_gaussiansmoothing_bands_c(const PixelType ** arr_in_bands,
+                                              const PixelType ** arr_out_bands,
+                                              const int num_bands,
+                                              const int width,
+                                              const int height,
+                                              const float sigma);
+
+/**
+ * Computation of the first order partial derivatives for multiple bands at once.
+ * This function computes the same results as vigra_gaussiangradient_c for 
+ * each band, but the Gaussian kernels are created only once and the bands
+ * are processed in parallel.
+ * All arrays must have been allocated before the call of this function.
+ *
+ * \param arr_in_bands Array of num_bands flat input arrays (bands) of size width*height.
+ * \param[out] arr_gx_out_bands Array of num_bands flat arrays (the partial derivatives in x-direction) of size width*height.
+ * \param[out] arr_gy_out_bands Array of num_bands flat arrays (the partial derivatives in y-direction) of size width*height.
+ * \param num_bands The number of bands.
+ * \param width The width of the flat arrays.
+ * \param height The height of the flat arrays.
+ * \param sigma The scale (Gaussian std.dev.) for which the gradient shall be computed.
+ *
+ * \return 0 if the gradient computation was successful, 1 else.
+ */
+LIBEXPORT int vigra_gaussiangradient_bands_c(const PixelType ** arr_in_bands,
+                                             const PixelType ** arr_gx_out_bands,
+                                             const PixelType ** arr_gy_out_bands,
+                                             const int num_bands,
+                                             const int width,
+                                             const int height,
+                                             const float sigma);
+
 /**
  * Computation of the Laplacian of Gaussian (LoG).
  *
@@ -210,6 +438,8 @@ LIBEXPORT int vigra_gaussiansmoothing_c(const PixelType * arr_in,
  * vigra::laplacianOfGaussian
  * </a> 
  * function to C to compute the result of the LoG at a given scale (Gaussian std.dev.).
+ * From the threshold of vigra_set_recursive_gaussian_threshold_c on, the
+ * LoG is derived by the 5-point Laplacian of the recursive smoothing.
  * All arrays must have been allocated before the call of this function.
  *
  * \param arr_in Flat input array (band) of size width*height.
@@ -255,6 +485,46 @@ LIBEXPORT int vigra_hessianmatrixofgaussian_c(const PixelType * arr_in,
                                               const int height,
                                               const float scale);
 
+/**
+ * Computation of several Gaussian derivatives of an image band at once.
+ * This function computes the same results as vigra_gaussiangradient_c,
+ * vigra_gaussiangradientmagnitude_c, vigra_hessianmatrixofgaussian_c and
+ * vigra_laplacianofgaussian_c, but shares the horizontal filter passes
+ * (smoothing, first and second derivative) between all requested outputs
+ * and computes them in a single sweep over the image.
+ * From the threshold of vigra_set_recursive_gaussian_threshold_c on, the
+ * partial derivatives and the LoG are computed by the recursive filter, like
+ * in vigra_gaussiangradient_c and vigra_laplacianofgaussian_c, and the other
+ * outputs by the shared FIR passes.
+ * All requested arrays must have been allocated before the call of this function.
+ *
+ * \param arr_in Flat input array (band) of size width*height.
+ * \param[out] arr_outs Array of seven flat arrays of size width*height, in the order
+ *                      of the bits of outputs. Arrays of outputs, which have not been
+ *                      requested, are ignored and may be NULL.
+ * \param width The width of the flat array.
+ * \param height The height of the flat array.
+ * \param scale The scale (gaussian std.dev.) for which the derivatives shall be computed.
+ * \param outputs The bitmask of the requested outputs:
+ *                1 = partial derivative in x-direction,
+ *                2 = partial derivative in y-direction,
+ *                4 = gradient magnitude,
+ *                8 = second derivative in x-direction,
+ *               16 = mixed derivative in xy-direction,
+ *               32 = second derivative in y-direction,
+ *               64 = Laplacian of Gaussian.
+ *
+ * \return 0 if the derivatives were computed successfully,
+ *         2 if the output mask is invalid or a requested array is NULL,
+ *         1 else.
+ */
+LIBEXPORT int vigra_gaussianderivatives_c(const PixelType * arr_in,
+                                          const PixelType ** arr_outs,
+                                          const int width,
+                                          const int height,
+                                          const float scale,
+                                          const int outputs);
+
 /**
  * Computation of the Gaussian sharpening.
  * This function wraps the
@@ -308,6 +578,9 @@ LIBEXPORT int vigra_simplesharpening_c(const PixelType * arr_in,
  * Computation of a non-linear median filter.
  * This function wraps the vigra::medianFilter function to C to compute
  * the result at a given window size, for whic the median value is derived.
+ * From the window size of vigra_set_median_histogram_threshold_c on, the
+ * constant-time median filter of Perreault and Hebert is used instead, whose
+ * cost per pixel does not depend on the window size.
  * All arrays must have been allocated before the call of this function.
  *
  * \param arr_in Flat input array (band) of size width*height.
@@ -335,6 +608,23 @@ LIBEXPORT int vigra_medianfilter_c(const PixelType * arr_in,
                                    const int window_width,
 	                               const int window_height,
 	                               const int border_treatment);
+
+/**
+ * Sets the window size, from which on vigra_medianfilter_c uses the histogram-based
+ * median filter of Perreault and Hebert, which costs O(1) per pixel instead of 
+ * O(window_width*window_height). It is only used for odd window sizes, which are
+ * not larger than the image.
+ * It is exact and yields the same result as vigra::medianFilter. Thus, it is only
+ * used for integer images with a range of up to 65536 values and images with up to
+ * 65536 distinct values. Other images are always filtered by vigra::medianFilter.
+ *
+ * \param window_size The minimal number of window elements (window_width*window_height)
+ *                    for the histogram-based median. The default is 225 (15x15).
+ *                    A negative value disables the histogram-based median.
+ *
+ * \return Always 0.
+ */
+LIBEXPORT int vigra_set_median_histogram_threshold_c(const int window_size);
                                    
 /**
  * Computation of a non-linear (nl) diffusion filter.
@@ -435,6 +725,163 @@ LIBEXPORT int vigra_nonlocalmean_c(const PixelType *arr_in,
                                    const int iterations,
                                    const int nThreads,
                                    const bool verbose);
+/**
+ * Asynchronous variant of vigra_convolveimage_c.
+ * Submits the computation to the library's worker pool and returns immediately.
+ * All arrays must have been allocated before the call of this function and
+ * must stay valid until the job has been finished.
+ * The parameters are the same as for vigra_convolveimage_c.
+ *
+ * \return A job handle, which needs to be released by vigra_job_wait_c.
+ *         The result of vigra_job_wait_c is the return value of vigra_convolveimage_c.
+ */
+LIBEXPORT void * vigra_convolveimage_async_c(const PixelType * arr_in,
+                                             const double * kernel_arr_in,
+                                             const PixelType * arr_out,
+                                             const int width,
+                                             const int height,
+                                             const int kernel_width,
+                                             const int kernel_height,
+                                             const int border_treatment);
+
+/**
+ * Asynchronous variant of vigra_separableconvolveimage_c.
+ * Submits the computation to the library's worker pool and returns immediately.
+ * All arrays must have been allocated before the call of this function and
+ * must stay valid until the job has been finished.
+ * The parameters are the same as for vigra_separableconvolveimage_c.
+ *
+ * \return A job handle, which needs to be released by vigra_job_wait_c.
+ *         The result of vigra_job_wait_c is the return value of vigra_separableconvolveimage_c.
+ */
+LIBEXPORT void * vigra_separableconvolveimage_async_c(const PixelType * arr_in,
+                                                      const double * kernel_h_arr_in,
+                                                      const double * kernel_v_arr_in,
+                                                      const PixelType * arr_out,
+                                                      const int width,
+                                                      const int height,
+                                                      const int kernel_width,
+                                                      const int kernel_height,
+                                                      const int border_treatment);
+
+/**
+ * Asynchronous variant of vigra_gaussiangradient_c.
+ * Submits the computation to the library's worker pool and returns immediately.
+ * All arrays must have been allocated before the call of this function and
+ * must stay valid until the job has been finished.
+ * The parameters are the same as for vigra_gaussiangradient_c.
+ *
+ * \return A job handle, which needs to be released by vigra_job_wait_c.
+ *         The result of vigra_job_wait_c is the return value of vigra_gaussiangradient_c.
+ */
+LIBEXPORT void * vigra_gaussiangradient_async_c(const PixelType * arr_in,
+                                                const PixelType * arr_gx_out,
+                                                const PixelType * arr_gy_out,
+                                                const int width,
+                                                const int height,
+                                                const float sigma);
+
+/**
+ * Asynchronous variant of vigra_gaussiangradientmagnitude_c.
+ * Submits the computation to the library's worker pool and returns immediately.
+ * All arrays must have been allocated before the call of this function and
+ * must stay valid until the job has been finished.
+ * The parameters are the same as for vigra_gaussiangradientmagnitude_c.
+ *
+ * \return A job handle, which needs to be released by vigra_job_wait_c.
+ *         The result of vigra_job_wait_c is the return value of vigra_gaussiangradientmagnitude_c.
+ */
+LIBEXPORT void * vigra_gaussiangradientmagnitude_async_c(const PixelType * arr_in,
+                                                         const PixelType * arr_out,
+                                                         const int width,
+                                                         const int height,
+                                                         const float sigma);
+
+/**
+ * Asynchronous variant of vigra_gaussiansmoothing_c.
+ * Submits the computation to the library's worker pool and returns immediately.
+ * All arrays must have been allocated before the call of this function and
+ * must stay valid until the job has been finished.
+ * The parameters are the same as for vigra_gaussiansmoothing_c.
+ *
+ * \return A job handle, which needs to be released by vigra_job_wait_c.
+ *         The result of vigra_job_wait_c is the return value of vigra_gaussiansmoothing_c.
+ */
+LIBEXPORT void * vigra_gaussiansmoothing_async_c(const PixelType * arr_in,
+                                                 const PixelType * arr_out,
+                                                 const int width,
+                                                 const int height,
+                                                 const float sigma);
+
+/**
+ * Asynchronous variant of vigra_laplacianofgaussian_c.
+ * Submits the computation to the library's worker pool and returns immediately.
+ * All arrays must have been allocated before the call of this function and
+ * must stay valid until the job has been finished.
+ * The parameters are the same as for vigra_laplacianofgaussian_c.
+ *
+ * \return A job handle, which needs to be released by vigra_job_wait_c.
+ *         The result of vigra_job_wait_c is the return value of vigra_laplacianofgaussian_c.
+ */
+LIBEXPORT void * vigra_laplacianofgaussian_async_c(const PixelType * arr_in,
+                                                   const PixelType * arr_out,
+                                                   const int width,
+                                                   const int height,
+                                                   const float scale);
+
+/**
+ * Asynchronous variant of vigra_hessianmatrixofgaussian_c.
+ * Submits the computation to the library's worker pool and returns immediately.
+ * All arrays must have been allocated before the call of this function and
+ * must stay valid until the job has been finished.
+ * The parameters are the same as for vigra_hessianmatrixofgaussian_c.
+ *
+ * \return A job handle, which needs to be released by vigra_job_wait_c.
+ *         The result of vigra_job_wait_c is the return value of vigra_hessianmatrixofgaussian_c.
+ */
+LIBEXPORT void * vigra_hessianmatrixofgaussian_async_c(const PixelType * arr_in,
+                                                       const PixelType * arr_xx_out,
+                                                       const PixelType * arr_xy_out,
+                                                       const PixelType * arr_yy_out,
+                                                       const int width,
+                                                       const int height,
+                                                       const float scale);
+
+/**
+ * Asynchronous variant of vigra_medianfilter_c.
+ * Submits the computation to the library's worker pool and returns immediately.
+ * All arrays must have been allocated before the call of this function and
+ * must stay valid until the job has been finished.
+ * The parameters are the same as for vigra_medianfilter_c.
+ *
+ * \return A job handle, which needs to be released by vigra_job_wait_c.
+ *         The result of vigra_job_wait_c is the return value of vigra_medianfilter_c.
+ */
+LIBEXPORT void * vigra_medianfilter_async_c(const PixelType * arr_in,
+                                            const PixelType * arr_out,
+                                            const int width,
+                                            const int height,
+                                            const int window_width,
+                                            const int window_height,
+                                            const int border_treatment);
+
+/**
+ * Asynchronous variant of vigra_nonlineardiffusion_c.
+ * Submits the computation to the library's worker pool and returns immediately.
+ * All arrays must have been allocated before the call of this function and
+ * must stay valid until the job has been finished.
+ * The parameters are the same as for vigra_nonlineardiffusion_c.
+ *
+ * \return A job handle, which needs to be released by vigra_job_wait_c.
+ *         The result of vigra_job_wait_c is the return value of vigra_nonlineardiffusion_c.
+ */
+LIBEXPORT void * vigra_nonlineardiffusion_async_c(const PixelType * arr_in,
+                                                  const PixelType * arr_out,
+                                                  const int width,
+                                                  const int height,
+                                                  const float edge_threshold,
+                                                  const float scale);
+
 /**
  * @}
  */
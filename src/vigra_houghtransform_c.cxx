@@ -33,6 +33,7 @@
 /************************************************************************/
 
 #include "vigra_houghtransform_c.h"
+#include "vigra_statsutils_c.h"
 #include <iostream>
 #include "vigra_ext/houghtransform.hxx"
 
@@ -49,6 +50,7 @@ LIBEXPORT void* vigra_houghtransform_lines_c(const PixelType * arr_in,
                                         const int angles,
                                         const int min_supporters)
 {
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -151,6 +153,7 @@ LIBEXPORT void* vigra_houghtransform_circles_c(const PixelType * arr_in,
                                         const int max_radius,
                                         const float min_supporters)
 {
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
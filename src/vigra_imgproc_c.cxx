@@ -33,14 +33,21 @@
 /************************************************************************/
 
 #include "vigra_imgproc_c.h"
+#include "vigra_parallelutils_c.h"
+#include "vigra_typeutils_c.h"
+#include "vigra_dispatchutils_c.h"
+#include "vigra_arenautils_c.h"
+#include "vigra_fftutils_c.h"
+#include "vigra_statsutils_c.h"
 #include <iostream> //needed by labelVolume, which is needed by localMinMax
 #include <vigra/resizeimage.hxx>
 #include <vigra/affinegeometry.hxx>
 #include <vigra/basicgeometry.hxx>
 #include <vigra/multi_fft.hxx>
 #include <vigra/multi_math.hxx>
-#include <vigra/correlation.hxx>
 #include <vigra/multi_localminmax.hxx>
+#include <algorithm>
+#include <vector>
 
 
 /**
@@ -77,6 +84,7 @@ LIBEXPORT int vigra_resizeimage_c(const PixelType * arr_in,
                                   const int height_out,
                                   const int resample_method)
 {
+    VIGRA_C_STATS_SCOPE(std::size_t(width_in)*height_in*sizeof(PixelType) + std::size_t(width_out)*height_out*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -141,6 +149,7 @@ LIBEXPORT int vigra_rotateimage_c(const PixelType * arr_in,
                                   const float angle,
                                   const int resample_method)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -208,6 +217,7 @@ LIBEXPORT int vigra_affinewarpimage_c(const PixelType * arr_in,
                                       const int height,
                                       const int resample_method)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -250,6 +260,193 @@ LIBEXPORT int vigra_affinewarpimage_c(const PixelType * arr_in,
     return 0;
 }
 
+/**
+ * Internal helper to reduce the results of the band-wise function calls
+ * of the *_bands_c functions to one result.
+ *
+ * \param results The results of the band-wise calls.
+ *
+ * \return The first result, which is not zero, or 0 if all calls were successful.
+ */
+static int firstBandError(const std::vector<int> & results)
+{
+    for(int result : results)
+    {
+        if(result != 0)
+        {
+            return result;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Resizing of multiple image bands at once.
+ * This function computes the same results as vigra_resizeimage_c for 
+ * each band, but the bands are resized in parallel.
+ * All arrays must have been allocated at the correct sizes before the call of this function.
+ *
+ * \param arr_in_bands Array of num_bands flat input arrays (bands) of size width_in*height_in.
+ * \param[out] arr_out_bands Array of num_bands flat arrays of the resizing result (bands) of size width_out*height_out.
+ * \param num_bands The number of bands.
+ * \param width_in The width of the flat input arrays.
+ * \param height_in The height of the flat input arrays.
+ * \param width_out The width of the flat output arrays.
+ * \param height_out The height the flat output arrays.
+ * \param resample_method The spline order for resampling. Must be in the interval [0, 4].
+ *
+ * \return 0 if the resizing was successful,
+ *         2 if resample_method is < 0 or > 4,
+ *         1 else.
+ */
+LIBEXPORT int vigra_resizeimage_bands_c(const PixelType ** arr_in_bands,
+                                        const PixelType ** arr_out_bands,
+                                        const int num_bands,
+                                        const int width_in,
+                                        const int height_in,
+                                        const int width_out,
+                                        const int height_out,
+                                        const int resample_method)
+{
+    VIGRA_C_STATS_SCOPE(num_bands*std::size_t(width_in)*height_in*sizeof(PixelType) + num_bands*std::size_t(width_out)*height_out*sizeof(PixelType));
+    if (resample_method < 0 || resample_method > 4)
+    {
+        return 2;
+    }
+    
+    try
+    {
+        //The bands are independent of each other and thus processed in parallel
+        std::vector<int> results(num_bands, 0);
+        
+        parallelForEach(num_bands,
+                        [&](int b)
+                        {
+                            results[b] = vigra_resizeimage_c(arr_in_bands[b],
+                                                                  arr_out_bands[b],
+                                                                  width_in, height_in,
+                                                                  width_out, height_out,
+                                                                  resample_method);
+                        });
+        
+        return firstBandError(results);
+    }
+    catch (vigra::StdException & e)
+    {
+        return 1;
+    }
+}
+
+/**
+ * Rotation of multiple image bands at once.
+ * This function computes the same results as vigra_rotateimage_c for 
+ * each band, but the bands are rotated in parallel.
+ * All arrays must have been allocated before the call of this function.
+ *
+ * \param arr_in_bands Array of num_bands flat input arrays (bands) of size width*height.
+ * \param[out] arr_out_bands Array of num_bands flat arrays of the rotated result (bands) of size width*height.
+ * \param num_bands The number of bands.
+ * \param width The width of the flat arrays.
+ * \param height The height of the flat arrays.
+ * \param angle The rotation angle in degrees.
+ * \param resample_method The spline order for resampling. Must be in the interval [1, 4].
+ *
+ * \return 0 if the rotation was successful,
+ *         2 if resample_method is < 1 or > 4,
+ *         1 else.
+ */
+LIBEXPORT int vigra_rotateimage_bands_c(const PixelType ** arr_in_bands,
+                                        const PixelType ** arr_out_bands,
+                                        const int num_bands,
+                                        const int width,
+                                        const int height,
+                                        const float angle,
+                                        const int resample_method)
+{
+    VIGRA_C_STATS_SCOPE(2*num_bands*std::size_t(width)*height*sizeof(PixelType));
+    if (resample_method < 1 || resample_method > 4)
+    {
+        return 2;
+    }
+    
+    try
+    {
+        //The bands are independent of each other and thus processed in parallel
+        std::vector<int> results(num_bands, 0);
+        
+        parallelForEach(num_bands,
+                        [&](int b)
+                        {
+                            results[b] = vigra_rotateimage_c(arr_in_bands[b],
+                                                                  arr_out_bands[b],
+                                                                  width, height,
+                                                                  angle,
+                                                                  resample_method);
+                        });
+        
+        return firstBandError(results);
+    }
+    catch (vigra::StdException & e)
+    {
+        return 1;
+    }
+}
+
+/**
+ * Affine warping of multiple image bands at once.
+ * This function computes the same results as vigra_affinewarpimage_c for 
+ * each band, but the bands are warped in parallel.
+ * All arrays must have been allocated before the call of this function.
+ *
+ * \param arr_in_bands Array of num_bands flat input arrays (bands) of size width*height.
+ * \param affineMatrix Flat input array (affine matrix) of size 3*3.
+ * \param[out] arr_out_bands Array of num_bands flat arrays of the warped result (bands) of size width*height.
+ * \param num_bands The number of bands.
+ * \param width The width of the flat arrays.
+ * \param height The height of the flat arrays.
+ * \param resample_method The spline order for resampling. Must be in the interval [1, 4].
+ *
+ * \return 0 if the affine warping was successful,
+ *         2 if resample_method is < 1 or > 4,
+ *         1 else.
+ */
+LIBEXPORT int vigra_affinewarpimage_bands_c(const PixelType ** arr_in_bands,
+                                            const double * affineMatrix,
+                                            const PixelType ** arr_out_bands,
+                                            const int num_bands,
+                                            const int width,
+                                            const int height,
+                                            const int resample_method)
+{
+    VIGRA_C_STATS_SCOPE(2*num_bands*std::size_t(width)*height*sizeof(PixelType));
+    if (resample_method < 1 || resample_method > 4)
+    {
+        return 2;
+    }
+    
+    try
+    {
+        //The bands are independent of each other and thus processed in parallel
+        std::vector<int> results(num_bands, 0);
+        
+        parallelForEach(num_bands,
+                        [&](int b)
+                        {
+                            results[b] = vigra_affinewarpimage_c(arr_in_bands[b],
+                                                                      affineMatrix,
+                                                                      arr_out_bands[b],
+                                                                      width, height,
+                                                                      resample_method);
+                        });
+        
+        return firstBandError(results);
+    }
+    catch (vigra::StdException & e)
+    {
+        return 1;
+    }
+}
+
 /**
  * Reflection of image bands w.r.t. the image axes.
  * This function wraps the
@@ -276,6 +473,7 @@ LIBEXPORT int vigra_reflectimage_c(const PixelType * arr_in,
                                    const int height,
                                    const int reflect_method)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -326,16 +524,35 @@ LIBEXPORT int vigra_fouriertransform_c(const PixelType * arr_in,
                                        const int width,
                                        const int height)
 {
+    VIGRA_C_STATS_SCOPE(3*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
         vigra::Shape2 shape(width, height);
-        ImageView img(shape, arr_in);
         ImageView img_real(shape, arr_real_out);
         ImageView img_imag(shape, arr_imag_out);
-        vigra::MultiArray<2, vigra::FFTWComplex<PixelType> > fourier(shape);
         
-        vigra::fourierTransform(img, fourier);
+        //Transform the real image to the half spectrum and restore the 
+        //other half by means of the Hermitian symmetry
+        int half_width = width/2 + 1;
+        ScratchImage<ComplexType> half(half_width, height);
+        fftRealForward(arr_in, half.data(), width, height);
+        
+        ScratchImage<ComplexType> fourier(shape);
+        
+        for(int y=0; y<height; ++y)
+        {
+            int y_mirrored = (height - y) % height;
+            
+            for(int x=0; x<half_width; ++x)
+            {
+                fourier(x, y) = half(x, y);
+            }
+            for(int x=half_width; x<width; ++x)
+            {
+                fourier(x, y) = conj(half(width - x, y_mirrored));
+            }
+        }
         moveDCToCenter(fourier);
         
         auto img_real_iter = img_real.begin(),
@@ -364,6 +581,7 @@ LIBEXPORT int vigra_fouriertransforminverse_c(const PixelType * arr_real_in,
                                               const int width,
                                               const int height)
 {
+    VIGRA_C_STATS_SCOPE(4*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -371,7 +589,7 @@ LIBEXPORT int vigra_fouriertransforminverse_c(const PixelType * arr_real_in,
         ImageView img_real_in(shape, arr_real_in);
         ImageView img_imag_in(shape, arr_imag_in);
         
-        vigra::MultiArray<2, vigra::FFTWComplex<PixelType> > fourier_in(shape);
+        ScratchImage<ComplexType> fourier_in(shape);
         fourier_in.bindElementChannel(0) = img_real_in;
         fourier_in.bindElementChannel(1) = img_imag_in;
         
@@ -380,9 +598,12 @@ LIBEXPORT int vigra_fouriertransforminverse_c(const PixelType * arr_real_in,
         ImageView img_real_out(shape, arr_real_out);
         ImageView img_imag_out(shape, arr_imag_out);
         
-        vigra::MultiArray<2, vigra::FFTWComplex<PixelType> > fourier_out(shape);
+        ScratchImage<ComplexType> fourier_out(shape);
+        
+        fftComplex(fourier_in.data(), fourier_out.data(), width, height, false);
         
-        vigra::fourierTransformInverse(fourier_in, fourier_out);
+        //Normalize the result like vigra::fourierTransformInverse
+        PixelType norm = PixelType(1.0)/(PixelType(width)*height);
         
         auto img_real_iter = img_real_out.begin(),
              img_imag_iter = img_imag_out.begin();
@@ -390,6 +611,41 @@ LIBEXPORT int vigra_fouriertransforminverse_c(const PixelType * arr_real_in,
         for(auto f_iter = fourier_out.begin();
             f_iter != fourier_out.end();
             ++f_iter, ++img_real_iter, ++img_imag_iter)
+        {
+            *img_real_iter = f_iter->real()*norm;
+            *img_imag_iter = f_iter->imag()*norm;
+        }
+    }
+    catch (vigra::StdException & e)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+LIBEXPORT int vigra_fouriertransform_half_c(const PixelType * arr_in,
+                                            const PixelType * arr_real_out,
+                                            const PixelType * arr_imag_out,
+                                            const int width,
+                                            const int height)
+{
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*sizeof(PixelType) + 2*std::size_t(width/2 + 1)*height*sizeof(PixelType));
+    try
+    {
+        vigra::Shape2 half_shape(width/2 + 1, height);
+        ImageView img_real(half_shape, arr_real_out);
+        ImageView img_imag(half_shape, arr_imag_out);
+        
+        ScratchImage<ComplexType> half(half_shape);
+        fftRealForward(arr_in, half.data(), width, height);
+        
+        auto img_real_iter = img_real.begin(),
+             img_imag_iter = img_imag.begin();
+        
+        for(auto f_iter = half.begin();
+            f_iter != half.end();
+            ++f_iter, ++img_real_iter, ++img_imag_iter)
         {
             *img_real_iter = f_iter->real();
             *img_imag_iter = f_iter->imag();
@@ -403,6 +659,176 @@ LIBEXPORT int vigra_fouriertransforminverse_c(const PixelType * arr_real_in,
     return 0;
 }
 
+LIBEXPORT int vigra_fouriertransforminverse_half_c(const PixelType * arr_real_in,
+                                                   const PixelType * arr_imag_in,
+                                                   const PixelType * arr_out,
+                                                   const int width,
+                                                   const int height)
+{
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width/2 + 1)*height*sizeof(PixelType) + std::size_t(width)*height*sizeof(PixelType));
+    try
+    {
+        vigra::Shape2 shape(width, height),
+                      half_shape(width/2 + 1, height);
+        ImageView img_real_in(half_shape, arr_real_in);
+        ImageView img_imag_in(half_shape, arr_imag_in);
+        ImageView img_out(shape, arr_out);
+        
+        //The complex-to-real transform overwrites its input
+        ScratchImage<ComplexType> half(half_shape);
+        half.bindElementChannel(0) = img_real_in;
+        half.bindElementChannel(1) = img_imag_in;
+        
+        fftRealBackward(half.data(), img_out.data(), width, height);
+        
+        //Normalize the result like vigra::fourierTransformInverse
+        img_out *= PixelType(1.0)/(PixelType(width)*height);
+    }
+    catch (vigra::StdException & e)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * Internal helper for the fast (normalized) cross-correlation of an image 
+ * with an odd-sized template like vigra::fastCrossCorrelation and 
+ * vigra::fastNormalizedCrossCorrelation, but with cached real-to-complex
+ * FFTW plans. The correlation is computed on zero-padded arrays of good FFT
+ * sizes. Pixels, where the template does not fit into the image, are set to 0.
+ * For the normalized variant, the template is centered and the local sums of
+ * the image are derived from integral images.
+ *
+ * \param img The image.
+ * \param templ The template.
+ * \param corr The result, which has the same shape as the image.
+ * \param normalized Compute the correlation coefficients (true) or the
+ *                   un-normalized correlation (false).
+ */
+static void crossCorrelation(const ImageView & img,
+                             const ImageView & templ,
+                             ImageView & corr,
+                             const bool normalized)
+{
+    int width  = img.width(),
+        height = img.height(),
+        t_width  = templ.width(),
+        t_height = templ.height(),
+        rx = t_width/2,
+        ry = t_height/2;
+    
+    vigra_precondition(t_width <= width && t_height <= height,
+                       "crossCorrelation(): Template must not be larger than the image.");
+    
+    double t_mean = 0.0,
+           t_norm = 0.0;
+    
+    if(normalized)
+    {
+        for(auto iter = templ.begin(); iter != templ.end(); ++iter)
+        {
+            t_mean += *iter;
+        }
+        t_mean /= templ.size();
+        
+        for(auto iter = templ.begin(); iter != templ.end(); ++iter)
+        {
+            t_norm += (*iter - t_mean)*(*iter - t_mean);
+        }
+    }
+    
+    //Zero-padded image and template of good FFT sizes. Circular wrap-around
+    //does not reach the valid pixels, since the template fits into the image.
+    int p_width  = fftGoodSize(width),
+        p_height = fftGoodSize(height),
+        p_half_width = p_width/2 + 1;
+    
+    ScratchImage<PixelType> img_padded(p_width, p_height),
+                            templ_padded(p_width, p_height);
+    img_padded = 0;
+    templ_padded = 0;
+    img_padded.subarray(vigra::Shape2(0,0), img.shape()) = img;
+    
+    for(int y=0; y<t_height; ++y)
+    {
+        for(int x=0; x<t_width; ++x)
+        {
+            templ_padded(x, y) = PixelType(templ(x, y) - t_mean);
+        }
+    }
+    
+    ScratchImage<ComplexType> img_fourier(p_half_width, p_height),
+                              templ_fourier(p_half_width, p_height);
+    fftRealForward(img_padded.data(), img_fourier.data(), p_width, p_height);
+    fftRealForward(templ_padded.data(), templ_fourier.data(), p_width, p_height);
+    
+    //corr(x) = sum_k img(x+k)*templ(k) <=> IFFT(FFT(img)*conj(FFT(templ)))
+    PixelType norm = PixelType(1.0)/(PixelType(p_width)*p_height);
+    for(auto i_iter = img_fourier.begin(), t_iter = templ_fourier.begin();
+        i_iter != img_fourier.end();
+        ++i_iter, ++t_iter)
+    {
+        *i_iter = *i_iter * conj(*t_iter) * norm;
+    }
+    fftRealBackward(img_fourier.data(), img_padded.data(), p_width, p_height);
+    
+    //Integral images of the image and its squares for the local variances
+    ScratchImage<double> sums, sums2;
+    if(normalized)
+    {
+        sums.reshape(vigra::Shape2(width+1, height+1));
+        sums2.reshape(vigra::Shape2(width+1, height+1));
+        sums = 0.0;
+        sums2 = 0.0;
+        
+        for(int y=0; y<height; ++y)
+        {
+            double row_sum = 0.0,
+                   row_sum2 = 0.0;
+            for(int x=0; x<width; ++x)
+            {
+                row_sum  += img(x, y);
+                row_sum2 += double(img(x, y))*img(x, y);
+                sums(x+1, y+1)  = sums(x+1, y)  + row_sum;
+                sums2(x+1, y+1) = sums2(x+1, y) + row_sum2;
+            }
+        }
+    }
+    
+    double t_size = double(t_width)*t_height;
+    
+    for(int y=0; y<height; ++y)
+    {
+        for(int x=0; x<width; ++x)
+        {
+            if(x < rx || x >= width - rx || y < ry || y >= height - ry)
+            {
+                corr(x, y) = 0;
+                continue;
+            }
+            
+            //Upper left corner of the template at (x-rx, y-ry)
+            int x0 = x - rx,
+                y0 = y - ry;
+            double value = img_padded(x0, y0);
+            
+            if(normalized)
+            {
+                int x1 = x0 + t_width,
+                    y1 = y0 + t_height;
+                double sum  = sums(x1, y1)  - sums(x0, y1)  - sums(x1, y0)  + sums(x0, y0),
+                       sum2 = sums2(x1, y1) - sums2(x0, y1) - sums2(x1, y0) + sums2(x0, y0),
+                       var  = (sum2 - sum*sum/t_size)*t_norm;
+                
+                value = (var > 0.0) ? value/std::sqrt(var) : 0.0;
+            }
+            corr(x, y) = PixelType(value);
+        }
+    }
+}
+
 LIBEXPORT int vigra_fastcrosscorrelation_c(const PixelType * arr_in,
                                            const PixelType * arr_template_in,
                                            const PixelType * arr_out,
@@ -411,6 +837,7 @@ LIBEXPORT int vigra_fastcrosscorrelation_c(const PixelType * arr_in,
                                            const int template_width,
                                            const int template_height)
 {
+    VIGRA_C_STATS_SCOPE(3*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         vigra::Shape2 shape(width,height);
@@ -425,7 +852,7 @@ LIBEXPORT int vigra_fastcrosscorrelation_c(const PixelType * arr_in,
             return 2;
         }
         
-        vigra::fastCrossCorrelation(img, templ, corr);
+        crossCorrelation(img, templ, corr, false);
     }
     catch (vigra::StdException & e)
     {
@@ -442,6 +869,7 @@ LIBEXPORT int vigra_fastnormalizedcrosscorrelation_c(const PixelType * arr_in,
                                                      const int template_width,
                                                      const int template_height)
 {
+    VIGRA_C_STATS_SCOPE(3*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         vigra::Shape2 shape(width,height);
@@ -457,7 +885,7 @@ LIBEXPORT int vigra_fastnormalizedcrosscorrelation_c(const PixelType * arr_in,
         ImageView templ(template_shape, arr_template_in);
         ImageView corr(shape, arr_out);
         
-        vigra::fastNormalizedCrossCorrelation(img, templ, corr);
+        crossCorrelation(img, templ, corr, true);
     }
     catch (vigra::StdException & e)
     {
@@ -508,6 +936,7 @@ LIBEXPORT int vigra_localmaxima_c(const PixelType * arr_in,
                                   const bool allow_plateaus,
                                   const PixelType plateau_epsilon)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -553,6 +982,7 @@ LIBEXPORT int vigra_localminima_c(const PixelType * arr_in,
                                   const bool allow_plateaus,
                                   const PixelType plateau_epsilon)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -596,6 +1026,7 @@ LIBEXPORT int vigra_subimage_c(const PixelType * arr_in,
                                const int right,
                                const int lower)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(std::max(right - left, 0))*std::max(lower - upper, 0)*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -636,6 +1067,7 @@ LIBEXPORT int vigra_paddimage_c(const PixelType * arr_in,
                                 const int right,
                                 const int lower)
 {
+    VIGRA_C_STATS_SCOPE(std::size_t(width_in)*height_in*sizeof(PixelType) + std::size_t(width_in + left + right)*(height_in + upper + lower)*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -667,281 +1099,389 @@ LIBEXPORT int vigra_paddimage_c(const PixelType * arr_in,
     return 0;
 }
 
-LIBEXPORT int vigra_clipimage_c(const PixelType * arr_in,
-                                const PixelType * arr_out,
-                                const int width,
-                                const int height,
-                                const PixelType low,
-                                const PixelType upp)
+/**
+ * Internal helper for the pixel-wise arithmetic of two images for the typed
+ * arithmetic functions. The functor is called for the real values of each pair
+ * of pixels. The result is rounded and saturated, if T is not PixelType.
+ *
+ * \param arr1_in Flat input array 1 (band) of size width*height.
+ * \param arr2_in Flat input array 2 (band) of size width*height.
+ * \param[out] arr_out Flat array (band) of size width*height.
+ * \param width The width of the flat band arrays.
+ * \param height The height of the flat band arrays.
+ * \param f The binary functor.
+ */
+template <class T, class FUNCTOR>
+void pixelwiseArithmetic(const T * arr1_in,
+                         const T * arr2_in,
+                         const T * arr_out,
+                         const int width,
+                         const int height,
+                         FUNCTOR f)
 {
+    typedef typename vigra::NumericTraits<T>::RealPromote RealType;
+    
     unsigned long size = width*height;
     
-    PixelType * ptr_out = (PixelType*)arr_out;
+    T * ptr_out = (T*)arr_out;
     
     for(unsigned long l=0; l!=size; ++l)
     {
-        ptr_out[l] = vigra::max(vigra::min(arr_in[l], upp), low);
+        ptr_out[l] = PixelTypeTraits<T>::fromReal(f(RealType(arr1_in[l]), RealType(arr2_in[l])));
     }
-    
-    return 0;
 }
 
-LIBEXPORT int vigra_imageplusimage_c(const PixelType * arr1_in,
-                    const PixelType * arr2_in,
-                    const PixelType * arr_out,
-                    const int width,
-                    const int height)
+/**
+ * Internal helper for the pixel-wise arithmetic of an image for the typed
+ * arithmetic functions. The functor is called for the real value of each
+ * pixel. The result is rounded and saturated, if T is not PixelType.
+ *
+ * \param arr_in Flat input array (band) of size width*height.
+ * \param[out] arr_out Flat array (band) of size width*height.
+ * \param width The width of the flat band arrays.
+ * \param height The height of the flat band arrays.
+ * \param f The unary functor.
+ */
+template <class T, class FUNCTOR>
+void pixelwiseArithmetic(const T * arr_in,
+                         const T * arr_out,
+                         const int width,
+                         const int height,
+                         FUNCTOR f)
 {
-    using namespace vigra::multi_math;
+    typedef typename vigra::NumericTraits<T>::RealPromote RealType;
     
-    try
-    {
-        //Create gray scale image views for the arrays
-        vigra::Shape2 shape(width,height);
-        ImageView img1_in(shape, arr1_in);
-        ImageView img2_in(shape, arr2_in);
-        ImageView img_out(shape, arr_out);
-        
-        img_out = img1_in + img2_in;
-    }
-    catch (vigra::StdException & e)
+    unsigned long size = width*height;
+    
+    T * ptr_out = (T*)arr_out;
+    
+    for(unsigned long l=0; l!=size; ++l)
     {
-        return 1;
+        ptr_out[l] = PixelTypeTraits<T>::fromReal(f(RealType(arr_in[l])));
     }
-        
-    return 0;
 }
 
-LIBEXPORT int vigra_imageminusimage_c(const PixelType * arr1_in,
-                    const PixelType * arr2_in,
-                    const PixelType * arr_out,
-                    const int width,
-                    const int height)
+/**
+ * Internal helper for the pixel-wise arithmetic of two images, which may be
+ * replaced by a dispatched kernel. The kernel is only used for PixelType.
+ *
+ * \param arr1_in Flat input array 1 (band) of size width*height.
+ * \param arr2_in Flat input array 2 (band) of size width*height.
+ * \param[out] arr_out Flat array (band) of size width*height.
+ * \param width The width of the flat band arrays.
+ * \param height The height of the flat band arrays.
+ * \param f The binary functor.
+ * \param kernel The dispatched kernel, which computes the same as f, or nullptr.
+ */
+template <class T, class FUNCTOR>
+void pixelwiseArithmetic(const T * arr1_in,
+                         const T * arr2_in,
+                         const T * arr_out,
+                         const int width,
+                         const int height,
+                         FUNCTOR f,
+                         BinaryPixelKernel PixelKernels::* kernel)
 {
-    using namespace vigra::multi_math;
-    
-    try
-    {
-        //Create gray scale image views for the arrays
-        vigra::Shape2 shape(width,height);
-        ImageView img1_in(shape, arr1_in);
-        ImageView img2_in(shape, arr2_in);
-        ImageView img_out(shape, arr_out);
-        
-        img_out = img1_in - img2_in;
-    }
-    catch (vigra::StdException & e)
-    {
-        return 1;
-    }
-    
-    return 0;
+    pixelwiseArithmetic(arr1_in, arr2_in, arr_out, width, height, f);
 }
 
-LIBEXPORT int vigra_imagemultimage_c(const PixelType * arr1_in,
-                    const PixelType * arr2_in,
-                    const PixelType * arr_out,
-                    const int width,
-                    const int height)
+template <class FUNCTOR>
+void pixelwiseArithmetic(const PixelType * arr1_in,
+                         const PixelType * arr2_in,
+                         const PixelType * arr_out,
+                         const int width,
+                         const int height,
+                         FUNCTOR f,
+                         BinaryPixelKernel PixelKernels::* kernel)
 {
-    using namespace vigra::multi_math;
-    
-    try
+    if(kernel == nullptr)
     {
-        //Create gray scale image views for the arrays
-        vigra::Shape2 shape(width,height);
-        ImageView img1_in(shape, arr1_in);
-        ImageView img2_in(shape, arr2_in);
-        ImageView img_out(shape, arr_out);
-        
-        img_out = img1_in * img2_in;
+        pixelwiseArithmetic(arr1_in, arr2_in, arr_out, width, height, f);
     }
-    catch (vigra::StdException & e)
+    else
     {
-        return 1;
+        (pixelKernels().*kernel)(arr1_in, arr2_in, (PixelType*)arr_out, std::size_t(width)*height);
     }
-    
-    return 0;
 }
 
-LIBEXPORT int vigra_imagedivideimage_c(const PixelType * arr1_in,
-                    const PixelType * arr2_in,
-                    const PixelType * arr_out,
-                    const int width,
-                    const int height)
+/**
+ * Internal helper for the pixel-wise arithmetic of an image and a value, which
+ * may be replaced by a dispatched kernel. The kernel is only used for PixelType.
+ *
+ * \param arr_in Flat input array (band) of size width*height.
+ * \param[out] arr_out Flat array (band) of size width*height.
+ * \param width The width of the flat band arrays.
+ * \param height The height of the flat band arrays.
+ * \param f The unary functor.
+ * \param kernel The dispatched kernel, which computes the same as f, or nullptr.
+ * \param kernel_value The value, which is passed to the kernel.
+ */
+template <class T, class FUNCTOR>
+void pixelwiseArithmetic(const T * arr_in,
+                         const T * arr_out,
+                         const int width,
+                         const int height,
+                         FUNCTOR f,
+                         ValuePixelKernel PixelKernels::* kernel,
+                         const PixelType kernel_value)
 {
-    using namespace vigra::multi_math;
-    
-    try
-    {
-        //Create gray scale image views for the arrays
-        vigra::Shape2 shape(width,height);
-        ImageView img1_in(shape, arr1_in);
-        ImageView img2_in(shape, arr2_in);
-        ImageView img_out(shape, arr_out);
-        
-        img_out = img1_in / img2_in;
-    }
-    catch (vigra::StdException & e)
-    {
-        return 1;
-    }
-    
-    return 0;
+    pixelwiseArithmetic(arr_in, arr_out, width, height, f);
 }
 
-LIBEXPORT int vigra_imagepowimage_c(const PixelType * arr1_in,
-                    const PixelType * arr2_in,
-                    const PixelType * arr_out,
-                    const int width,
-                    const int height)
+template <class FUNCTOR>
+void pixelwiseArithmetic(const PixelType * arr_in,
+                         const PixelType * arr_out,
+                         const int width,
+                         const int height,
+                         FUNCTOR f,
+                         ValuePixelKernel PixelKernels::* kernel,
+                         const PixelType kernel_value)
 {
-    using namespace vigra::multi_math;
-    
-    try
+    if(kernel == nullptr)
     {
-        //Create gray scale image views for the arrays
-        vigra::Shape2 shape(width,height);
-        ImageView img1_in(shape, arr1_in);
-        ImageView img2_in(shape, arr2_in);
-        ImageView img_out(shape, arr_out);
-        
-        img_out = pow(img1_in, img2_in);
+        pixelwiseArithmetic(arr_in, arr_out, width, height, f);
     }
-    catch (vigra::StdException & e)
+    else
     {
-        return 1;
+        (pixelKernels().*kernel)(arr_in, kernel_value, (PixelType*)arr_out, std::size_t(width)*height);
     }
-    
-    return 0;
 }
 
-LIBEXPORT int vigra_imageplusvalue_c(const PixelType * arr_in,
-                    const PixelType * arr_out,
-                    const PixelType value,
-                    const int width,
-                    const int height)
+/**
+ * Internal helper for the typed clipping functions.
+ *
+ * \param arr_in Flat input array (band) of size width*height
+ * \param[out] arr_out Flat array (band) of size width*height.
+ * \param width The width of the flat band arrays.
+ * \param height The height of the flat band arrays.
+ * \param low The lower clipping value.
+ * \param upp The upper clipping value.
+ *
+ * \return Always 0.
+ */
+template <class T>
+int clipImage(const T * arr_in,
+              const T * arr_out,
+              const int width,
+              const int height,
+              const T low,
+              const T upp)
 {
-    using namespace vigra::multi_math;
+    unsigned long size = width*height;
     
-    try
-    {
-        //Create gray scale image views for the arrays
-        vigra::Shape2 shape(width,height);
-        ImageView img_in(shape, arr_in);
-        ImageView img_out(shape, arr_out);
-        
-        img_out = img_in + value;
-    }
-    catch (vigra::StdException & e)
+    T * ptr_out = (T*)arr_out;
+    
+    for(unsigned long l=0; l!=size; ++l)
     {
-        return 1;
+        ptr_out[l] = vigra::max(vigra::min(arr_in[l], upp), low);
     }
     
     return 0;
 }
 
-LIBEXPORT int vigra_imageminusvalue_c(const PixelType * arr_in,
-                    const PixelType * arr_out,
-                    const PixelType  value,
-                    const int width,
-                    const int height)
+/**
+ * Internal helper for the clipping of PixelType images, which uses the
+ * dispatched kernel.
+ */
+int clipImage(const PixelType * arr_in,
+              const PixelType * arr_out,
+              const int width,
+              const int height,
+              const PixelType low,
+              const PixelType upp)
 {
-    using namespace vigra::multi_math;
-    
-    try
-    {
-        //Create gray scale image views for the arrays
-        vigra::Shape2 shape(width,height);
-        ImageView img_in(shape, arr_in);
-        ImageView img_out(shape, arr_out);
-        
-        img_out = img_in - value;
-    }
-    catch (vigra::StdException & e)
-    {
-        return 1;
-    }
-    
+    pixelKernels().clip(arr_in, (PixelType*)arr_out, std::size_t(width)*height, low, upp);
     return 0;
 }
 
-LIBEXPORT int vigra_imagemultvalue_c(const PixelType * arr_in,
-                    const PixelType * arr_out,
-                    const PixelType value,
-                    const int width,
-                    const int height)
+/**
+ * Defines a preprocessor macro for the clipping functions, which are generated
+ * from one templated implementation for each pixel type
+ */
+#define CLIP_FUNCTION(suffix, type)                                                       \
+LIBEXPORT int vigra_clipimage##suffix##_c(const type * arr_in,                            \
+                                          const type * arr_out,                           \
+                                          const int width,                                \
+                                          const int height,                               \
+                                          const type low,                                 \
+                                          const type upp)                                 \
+{                                                                                         \
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(type));                        \
+    return clipImage(arr_in, arr_out, width, height, low, upp);                           \
+}
+
+CLIP_FUNCTION(, PixelType)
+CLIP_FUNCTION(_uint8, UInt8PixelType)
+CLIP_FUNCTION(_uint16, UInt16PixelType)
+
+/**
+ * Defines a preprocessor macro for the arithmetic functions of two images, which
+ * are generated from one templated implementation for each pixel type.
+ * The expression is evaluated for the real values a and b of both images.
+ */
+#define IMAGE_IMAGE_FUNCTION(name, suffix, type, expression, kernel)                      \
+LIBEXPORT int vigra_##name##suffix##_c(const type * arr1_in,                              \
+                                       const type * arr2_in,                              \
+                                       const type * arr_out,                              \
+                                       const int width,                                   \
+                                       const int height)                                  \
+{                                                                                         \
+    VIGRA_C_STATS_SCOPE(3*std::size_t(width)*height*sizeof(type));                        \
+    typedef vigra::NumericTraits<type>::RealPromote RealType;                             \
+                                                                                          \
+    pixelwiseArithmetic(arr1_in, arr2_in, arr_out, width, height,                         \
+                        [](RealType a, RealType b){ return expression; }, kernel);        \
+    return 0;                                                                             \
+}
+
+/**
+ * Defines a preprocessor macro for all pixel types of an arithmetic function of two images
+ */
+#define IMAGE_IMAGE_FUNCTIONS(name, expression, kernel)                                   \
+IMAGE_IMAGE_FUNCTION(name, , PixelType, expression, kernel)                               \
+IMAGE_IMAGE_FUNCTION(name, _uint8, UInt8PixelType, expression, kernel)                    \
+IMAGE_IMAGE_FUNCTION(name, _uint16, UInt16PixelType, expression, kernel)
+
+IMAGE_IMAGE_FUNCTIONS(imageplusimage, a + b, &PixelKernels::add)
+IMAGE_IMAGE_FUNCTIONS(imageminusimage, a - b, &PixelKernels::subtract)
+IMAGE_IMAGE_FUNCTIONS(imagemultimage, a * b, &PixelKernels::multiply)
+IMAGE_IMAGE_FUNCTIONS(imagedivideimage, a / b, &PixelKernels::divide)
+IMAGE_IMAGE_FUNCTIONS(imagepowimage, std::pow(a, b), nullptr)
+
+/**
+ * Defines a preprocessor macro for the arithmetic functions of an image and a
+ * value, which are generated from one templated implementation for each pixel type.
+ * The expression is evaluated for the real values a of the image and b of the value.
+ */
+#define IMAGE_VALUE_FUNCTION(name, suffix, type, expression, kernel, kernel_value)        \
+LIBEXPORT int vigra_##name##suffix##_c(const type * arr_in,                               \
+                                       const type * arr_out,                              \
+                                       const PixelType value,                             \
+                                       const int width,                                   \
+                                       const int height)                                  \
+{                                                                                         \
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(type));                        \
+    typedef vigra::NumericTraits<type>::RealPromote RealType;                             \
+                                                                                          \
+    pixelwiseArithmetic(arr_in, arr_out, width, height,                                   \
+                        [value](RealType a){ RealType b = value; return expression; },    \
+                        kernel, kernel_value);                                            \
+    return 0;                                                                             \
+}
+
+/**
+ * Defines a preprocessor macro for all pixel types of an arithmetic function of an image and a value
+ */
+#define IMAGE_VALUE_FUNCTIONS(name, expression, kernel, kernel_value)                     \
+IMAGE_VALUE_FUNCTION(name, , PixelType, expression, kernel, kernel_value)                 \
+IMAGE_VALUE_FUNCTION(name, _uint8, UInt8PixelType, expression, kernel, kernel_value)      \
+IMAGE_VALUE_FUNCTION(name, _uint16, UInt16PixelType, expression, kernel, kernel_value)
+
+IMAGE_VALUE_FUNCTIONS(imageplusvalue, a + b, &PixelKernels::add_value, value)
+IMAGE_VALUE_FUNCTIONS(imageminusvalue, a - b, &PixelKernels::add_value, -value)
+IMAGE_VALUE_FUNCTIONS(imagemultvalue, a * b, &PixelKernels::multiply_value, value)
+IMAGE_VALUE_FUNCTIONS(imagepowvalue, std::pow(a, b), nullptr, value)
+
+/**
+ * Defines a preprocessor macro for the division of an image by a value,
+ * which is generated from one templated implementation for each pixel type
+ */
+#define IMAGE_DIVIDE_VALUE_FUNCTION(suffix, type)                                         \
+LIBEXPORT int vigra_imagedividevalue##suffix##_c(const type * arr_in,                     \
+                                                 const type * arr_out,                    \
+                                                 const PixelType value,                   \
+                                                 const int width,                         \
+                                                 const int height)                        \
+{                                                                                         \
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(type));                        \
+    typedef vigra::NumericTraits<type>::RealPromote RealType;                             \
+                                                                                          \
+    if(value == 0)                                                                        \
+    {                                                                                     \
+        return 1;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    pixelwiseArithmetic(arr_in, arr_out, width, height,                                   \
+                        [value](RealType a){ return a / RealType(value); });              \
+    return 0;                                                                             \
+}
+
+IMAGE_DIVIDE_VALUE_FUNCTION(, PixelType)
+IMAGE_DIVIDE_VALUE_FUNCTION(_uint8, UInt8PixelType)
+IMAGE_DIVIDE_VALUE_FUNCTION(_uint16, UInt16PixelType)
+
+LIBEXPORT void * vigra_resizeimage_async_c(const PixelType * arr_in,
+                                           const PixelType * arr_out,
+                                           const int width_in,
+                                           const int height_in,
+                                           const int width_out,
+                                           const int height_out,
+                                           const int resample_method)
 {
-    using namespace vigra::multi_math;
-    
-    try
-    {
-        //Create gray scale image views for the arrays
-        vigra::Shape2 shape(width,height);
-        ImageView img_in(shape, arr_in);
-        ImageView img_out(shape, arr_out);
-        
-        img_out = img_in * value;
-    }
-    catch (vigra::StdException & e)
-    {
-        return 1;
-    }
-    
-    return 0;
+    VIGRA_C_STATS_SCOPE(0);
+    return submitJob([=]()
+                     {
+                         return vigra_resizeimage_c(arr_in,
+                                                    arr_out,
+                                                    width_in,
+                                                    height_in,
+                                                    width_out,
+                                                    height_out,
+                                                    resample_method);
+                     });
 }
 
-LIBEXPORT int vigra_imagedividevalue_c(const PixelType * arr_in,
-                    const PixelType * arr_out,
-                    const PixelType value,
-                    const int width,
-                    const int height)
+LIBEXPORT void * vigra_rotateimage_async_c(const PixelType * arr_in,
+                                           const PixelType * arr_out,
+                                           const int width,
+                                           const int height,
+                                           const float angle,
+                                           const int resample_method)
 {
-    using namespace vigra::multi_math;
-    
-    if(value == 0)
-    {
-        return 1;
-    }
-    
-    try
-    {
-        //Create gray scale image views for the arrays
-        vigra::Shape2 shape(width,height);
-        ImageView img_in(shape, arr_in);
-        ImageView img_out(shape, arr_out);
-        
-        img_out = img_in / value;
-    }
-    catch (vigra::StdException & e)
-    {
-        return 1;
-    }
-    
-    return 0;
+    VIGRA_C_STATS_SCOPE(0);
+    return submitJob([=]()
+                     {
+                         return vigra_rotateimage_c(arr_in,
+                                                    arr_out,
+                                                    width,
+                                                    height,
+                                                    angle,
+                                                    resample_method);
+                     });
 }
 
-LIBEXPORT int vigra_imagepowvalue_c(const PixelType * arr_in,
-                    const PixelType * arr_out,
-                    const PixelType value,
-                    const int width,
-                    const int height)
+LIBEXPORT void * vigra_affinewarpimage_async_c(const PixelType * arr_in,
+                                               const double * affineMatrix,
+                                               const PixelType * arr_out,
+                                               const int width,
+                                               const int height,
+                                               const int resample_method)
 {
-    using namespace vigra::multi_math;
-    
-    try
-    {
-        //Create gray scale image views for the arrays
-        vigra::Shape2 shape(width,height);
-        ImageView img_in(shape, arr_in);
-        ImageView img_out(shape, arr_out);
-        
-        img_out = pow(img_in, value);
-    }
-    catch (vigra::StdException & e)
-    {
-        return 1;
-    }
-    
-    return 0;
+    VIGRA_C_STATS_SCOPE(0);
+    return submitJob([=]()
+                     {
+                         return vigra_affinewarpimage_c(arr_in,
+                                                        affineMatrix,
+                                                        arr_out,
+                                                        width,
+                                                        height,
+                                                        resample_method);
+                     });
+}
+
+LIBEXPORT void * vigra_fouriertransform_async_c(const PixelType * arr_in,
+                                                const PixelType * arr_real_out,
+                                                const PixelType * arr_imag_out,
+                                                const int width,
+                                                const int height)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    return submitJob([=]()
+                     {
+                         return vigra_fouriertransform_c(arr_in,
+                                                         arr_real_out,
+                                                         arr_imag_out,
+                                                         width,
+                                                         height);
+                     });
 }
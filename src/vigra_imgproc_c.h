@@ -129,6 +129,86 @@ LIBEXPORT int vigra_affinewarpimage_c(const PixelType * arr_in,
                                       const int height,
                                       const int resample_method);
 
+/**
+ * Resizing of multiple image bands at once.
+ * This function computes the same results as vigra_resizeimage_c for 
+ * each band, but the bands are resized in parallel.
+ * All arrays must have been allocated at the correct sizes before the call of this function.
+ *
+ * \param arr_in_bands Array of num_bands flat input arrays (bands) of size width_in*height_in.
+ * \param[out] arr_out_bands Array of num_bands flat arrays of the resizing result (bands) of size width_out*height_out.
+ * \param num_bands The number of bands.
+ * \param width_in The width of the flat input arrays.
+ * \param height_in The height of the flat input arrays.
+ * \param width_out The width of the flat output arrays.
+ * \param height_out The height the flat output arrays.
+ * \param resample_method The spline order for resampling. Must be in the interval [0, 4].
+ *
+ * \return 0 if the resizing was successful,
+ *         2 if resample_method is < 0 or > 4,
+ *         1 else.
+ */
+LIBEXPORT int vigra_resizeimage_bands_c(const PixelType ** arr_in_bands,
+                                        const PixelType ** arr_out_bands,
+                                        const int num_bands,
+                                        const int width_in,
+                                        const int height_in,
+                                        const int width_out,
+                                        const int height_out,
+                                        const int resample_method);
+
+/**
+ * Rotation of multiple image bands at once.
+ * This function computes the same results as vigra_rotateimage_c for 
+ * each band, but the bands are rotated in parallel.
+ * All arrays must have been allocated before the call of this function.
+ *
+ * \param arr_in_bands Array of num_bands flat input arrays (bands) of size width*height.
+ * \param[out] arr_out_bands Array of num_bands flat arrays of the rotated result (bands) of size width*height.
+ * \param num_bands The number of bands.
+ * \param width The width of the flat arrays.
+ * \param height The height of the flat arrays.
+ * \param angle The rotation angle in degrees.
+ * \param resample_method The spline order for resampling. Must be in the interval [1, 4].
+ *
+ * \return 0 if the rotation was successful,
+ *         2 if resample_method is < 1 or > 4,
+ *         1 else.
+ */
+LIBEXPORT int vigra_rotateimage_bands_c(const PixelType ** arr_in_bands,
+                                        const PixelType ** arr_out_bands,
+                                        const int num_bands,
+                                        const int width,
+                                        const int height,
+                                        const float angle,
+                                        const int resample_method);
+
+/**
+ * Affine warping of multiple image bands at once.
+ * This function computes the same results as vigra_affinewarpimage_c for 
+ * each band, but the bands are warped in parallel.
+ * All arrays must have been allocated before the call of this function.
+ *
+ * \param arr_in_bands Array of num_bands flat input arrays (bands) of size width*height.
+ * \param affineMatrix Flat input array (affine matrix) of size 3*3.
+ * \param[out] arr_out_bands Array of num_bands flat arrays of the warped result (bands) of size width*height.
+ * \param num_bands The number of bands.
+ * \param width The width of the flat arrays.
+ * \param height The height of the flat arrays.
+ * \param resample_method The spline order for resampling. Must be in the interval [1, 4].
+ *
+ * \return 0 if the affine warping was successful,
+ *         2 if resample_method is < 1 or > 4,
+ *         1 else.
+ */
+LIBEXPORT int vigra_affinewarpimage_bands_c(const PixelType ** arr_in_bands,
+                                            const double * affineMatrix,
+                                            const PixelType ** arr_out_bands,
+                                            const int num_bands,
+                                            const int width,
+                                            const int height,
+                                            const int resample_method);
+
 /**
  * Reflection of image bands w.r.t. the image axes.
  * This function wraps the
@@ -208,6 +288,53 @@ LIBEXPORT int vigra_fouriertransforminverse_c(const PixelType * arr_real_in,
                                               const int width,
                                               const int height);
 
+/**
+ * Computation of the non-redundant half of the Fast Fourier Transform (FFT) 
+ * of an image band. Since the spectrum of a real image is Hermitian, i.e.
+ * F(x,y) = conj(F(width-x, height-y)), it is fully described by the columns 
+ * 0..width/2. In contrast to vigra_fouriertransform_c, the DC is not centered
+ * but remains at (0,0). The result is not normalized.
+ * Internally, this performs a real-to-complex transform with a cached plan
+ * of the FFTW lib (see vigra_fft_c.h).
+ * All arrays must have been allocated before the call of this function.
+ *
+ * \param arr_in Flat input array (band) of size width*height
+ * \param[out] arr_real_out Flat array of the real part of the FFT of size (width/2+1)*height.
+ * \param[out] arr_imag_out Flat array of the imaginary part of the FFT of size (width/2+1)*height.
+ * \param width The width of the input array.
+ * \param height The height of the flat arrays.
+ *
+ * \return 0 if the Fourier Transform was successful, 1 else.
+ */
+LIBEXPORT int vigra_fouriertransform_half_c(const PixelType * arr_in,
+                                            const PixelType * arr_real_out,
+                                            const PixelType * arr_imag_out,
+                                            const int width,
+                                            const int height);
+
+/**
+ * Computation of the inverse of a half spectrum, as computed by 
+ * vigra_fouriertransform_half_c, which results in a real image band.
+ * Like for vigra_fouriertransforminverse_c, the result is normalized by
+ * 1/(width*height), thus both functions form an identity.
+ * Internally, this performs a complex-to-real transform with a cached plan
+ * of the FFTW lib (see vigra_fft_c.h).
+ * All arrays must have been allocated before the call of this function.
+ *
+ * \param arr_real_in Flat input array of the real part of the FFT of size (width/2+1)*height.
+ * \param arr_imag_in Flat array of the imaginary part of the FFT of size (width/2+1)*height.
+ * \param[out] arr_out Flat array of the real image after the iFFT of size width*height.
+ * \param width The width of the output array.
+ * \param height The height of the flat arrays.
+ *
+ * \return 0 if the inverse Fourier Transform was successful, 1 else.
+ */
+LIBEXPORT int vigra_fouriertransforminverse_half_c(const PixelType * arr_real_in,
+                                                   const PixelType * arr_imag_in,
+                                                   const PixelType * arr_out,
+                                                   const int width,
+                                                   const int height);
+
 /**
  * Computation of the fast (un-normalized) cross-correlation an image band w.r.t.
  * another (typically smaller) image, called template.
@@ -591,6 +718,176 @@ LIBEXPORT int vigra_imagepowvalue_c(const PixelType * arr_in,
                     const PixelType value,
                     const int width,
                     const int height);
+
+/**
+ * Defines a preprocessor macro for the interfaces of the typed clipping and
+ * arithmetic functions. These are available for the pixel types UInt8PixelType 
+ * (suffix uint8) and UInt16PixelType (suffix uint16) and work directly on the
+ * narrow pixel types. The arithmetic is carried out on real values.
+ */
+#define IMGPROC_TYPED_FUNCTIONS_INTERFACE(suffix, type)                                   \
+/**                                                                                       \
+  Typed variant of vigra_clipimage_c.                                                     \
+ */                                                                                       \
+LIBEXPORT int vigra_clipimage_##suffix##_c(const type * arr_in,                           \
+                                           const type * arr_out,                          \
+                                           const int width,                               \
+                                           const int height,                              \
+                                           const type low,                                \
+                                           const type upp);                               \
+/**                                                                                       \
+  Typed variant of vigra_imageplusimage_c. The results are saturated.                     \
+ */                                                                                       \
+LIBEXPORT int vigra_imageplusimage_##suffix##_c(const type * arr1_in,                     \
+                                                const type * arr2_in,                     \
+                                                const type * arr_out,                     \
+                                                const int width,                          \
+                                                const int height);                        \
+/**                                                                                       \
+  Typed variant of vigra_imageminusimage_c. The results are saturated.                    \
+ */                                                                                       \
+LIBEXPORT int vigra_imageminusimage_##suffix##_c(const type * arr1_in,                    \
+                                                 const type * arr2_in,                    \
+                                                 const type * arr_out,                    \
+                                                 const int width,                         \
+                                                 const int height);                       \
+/**                                                                                       \
+  Typed variant of vigra_imagemultimage_c. The results are saturated.                     \
+ */                                                                                       \
+LIBEXPORT int vigra_imagemultimage_##suffix##_c(const type * arr1_in,                     \
+                                                const type * arr2_in,                     \
+                                                const type * arr_out,                     \
+                                                const int width,                          \
+                                                const int height);                        \
+/**                                                                                       \
+  Typed variant of vigra_imagedivideimage_c. The results are rounded and saturated.       \
+  Division by zero yields the maximum value of the pixel type, 0/0 yields 0.              \
+ */                                                                                       \
+LIBEXPORT int vigra_imagedivideimage_##suffix##_c(const type * arr1_in,                   \
+                                                  const type * arr2_in,                   \
+                                                  const type * arr_out,                   \
+                                                  const int width,                        \
+                                                  const int height);                      \
+/**                                                                                       \
+  Typed variant of vigra_imagepowimage_c. The results are rounded and saturated.          \
+ */                                                                                       \
+LIBEXPORT int vigra_imagepowimage_##suffix##_c(const type * arr1_in,                      \
+                                               const type * arr2_in,                      \
+                                               const type * arr_out,                      \
+                                               const int width,                           \
+                                               const int height);                         \
+/**                                                                                       \
+  Typed variant of vigra_imageplusvalue_c. The results are rounded and saturated.         \
+ */                                                                                       \
+LIBEXPORT int vigra_imageplusvalue_##suffix##_c(const type * arr_in,                      \
+                                                const type * arr_out,                     \
+                                                const PixelType value,                    \
+                                                const int width,                          \
+                                                const int height);                        \
+/**                                                                                       \
+  Typed variant of vigra_imageminusvalue_c. The results are rounded and saturated.        \
+ */                                                                                       \
+LIBEXPORT int vigra_imageminusvalue_##suffix##_c(const type * arr_in,                     \
+                                                 const type * arr_out,                    \
+                                                 const PixelType value,                   \
+                                                 const int width,                         \
+                                                 const int height);                       \
+/**                                                                                       \
+  Typed variant of vigra_imagemultvalue_c. The results are rounded and saturated.         \
+ */                                                                                       \
+LIBEXPORT int vigra_imagemultvalue_##suffix##_c(const type * arr_in,                      \
+                                                const type * arr_out,                     \
+                                                const PixelType value,                    \
+                                                const int width,                          \
+                                                const int height);                        \
+/**                                                                                       \
+  Typed variant of vigra_imagedividevalue_c. The results are rounded and saturated.       \
+ */                                                                                       \
+LIBEXPORT int vigra_imagedividevalue_##suffix##_c(const type * arr_in,                    \
+                                                  const type * arr_out,                   \
+                                                  const PixelType value,                  \
+                                                  const int width,                        \
+                                                  const int height);                      \
+/**                                                                                       \
+  Typed variant of vigra_imagepowvalue_c. The results are rounded and saturated.          \
+ */                                                                                       \
+LIBEXPORT int vigra_imagepowvalue_##suffix##_c(const type * arr_in,                       \
+                                               const type * arr_out,                      \
+                                               const PixelType value,                     \
+                                               const int width,                           \
+                                               const int height);
+
+IMGPROC_TYPED_FUNCTIONS_INTERFACE(uint8, UInt8PixelType)
+IMGPROC_TYPED_FUNCTIONS_INTERFACE(uint16, UInt16PixelType)
+
+/**
+ * Asynchronous variant of vigra_resizeimage_c.
+ * Submits the computation to the library's worker pool and returns immediately.
+ * All arrays must have been allocated before the call of this function and
+ * must stay valid until the job has been finished.
+ * The parameters are the same as for vigra_resizeimage_c.
+ *
+ * \return A job handle, which needs to be released by vigra_job_wait_c.
+ *         The result of vigra_job_wait_c is the return value of vigra_resizeimage_c.
+ */
+LIBEXPORT void * vigra_resizeimage_async_c(const PixelType * arr_in,
+                                           const PixelType * arr_out,
+                                           const int width_in,
+                                           const int height_in,
+                                           const int width_out,
+                                           const int height_out,
+                                           const int resample_method);
+
+/**
+ * Asynchronous variant of vigra_rotateimage_c.
+ * Submits the computation to the library's worker pool and returns immediately.
+ * All arrays must have been allocated before the call of this function and
+ * must stay valid until the job has been finished.
+ * The parameters are the same as for vigra_rotateimage_c.
+ *
+ * \return A job handle, which needs to be released by vigra_job_wait_c.
+ *         The result of vigra_job_wait_c is the return value of vigra_rotateimage_c.
+ */
+LIBEXPORT void * vigra_rotateimage_async_c(const PixelType * arr_in,
+                                           const PixelType * arr_out,
+                                           const int width,
+                                           const int height,
+                                           const float angle,
+                                           const int resample_method);
+
+/**
+ * Asynchronous variant of vigra_affinewarpimage_c.
+ * Submits the computation to the library's worker pool and returns immediately.
+ * All arrays must have been allocated before the call of this function and
+ * must stay valid until the job has been finished.
+ * The parameters are the same as for vigra_affinewarpimage_c.
+ *
+ * \return A job handle, which needs to be released by vigra_job_wait_c.
+ *         The result of vigra_job_wait_c is the return value of vigra_affinewarpimage_c.
+ */
+LIBEXPORT void * vigra_affinewarpimage_async_c(const PixelType * arr_in,
+                                               const double * affineMatrix,
+                                               const PixelType * arr_out,
+                                               const int width,
+                                               const int height,
+                                               const int resample_method);
+
+/**
+ * Asynchronous variant of vigra_fouriertransform_c.
+ * Submits the computation to the library's worker pool and returns immediately.
+ * All arrays must have been allocated before the call of this function and
+ * must stay valid until the job has been finished.
+ * The parameters are the same as for vigra_fouriertransform_c.
+ *
+ * \return A job handle, which needs to be released by vigra_job_wait_c.
+ *         The result of vigra_job_wait_c is the return value of vigra_fouriertransform_c.
+ */
+LIBEXPORT void * vigra_fouriertransform_async_c(const PixelType * arr_in,
+                                                const PixelType * arr_real_out,
+                                                const PixelType * arr_imag_out,
+                                                const int width,
+                                                const int height);
+
 /**
  * @}
  */
@@ -33,8 +33,15 @@
 /************************************************************************/
 
 #include "vigra_impex_c.h"
+#include "vigra_parallelutils_c.h"
+#include "vigra_typeutils_c.h"
+#include "vigra_arenautils_c.h"
+#include "vigra_statsutils_c.h"
 #include <vigra/impex.hxx>
 #include <vigra/impexalpha.hxx>
+#include <memory>
+#include <string>
+#include <vector>
 
 
 /**
@@ -42,37 +49,158 @@
  * @brief Implementation of image import and export
  */
 
-LIBEXPORT int vigra_importgrayimage_c(const PixelType * arr_out,
-                                      const int width,
-                                      const int height,
-                                      const char * filename)
+/**
+ * Internal structure behind the handles of the handle-based image import.
+ * The header information is read only once, when the handle is opened. The
+ * decoder of that opening is kept until the pixel data is read. Thus, an image,
+ * which is imported once by means of a handle, is opened only once.
+ */
+struct ImageImportHandle
 {
-    try
+    std::string filename;
+    std::string filetype;
+    std::string pixeltype;
+    int width;
+    int height;
+    int num_bands;
+    int num_extra_bands;
+    std::unique_ptr<vigra::Decoder> decoder;
+};
+
+/**
+ * Internal helper to copy the scanlines of a decoder into planar bands.
+ * The first bands.size() bands of the image are read and converted from the
+ * file's pixel type T to the bands' pixel type D. If D is not PixelType, the
+ * values are rounded and saturated.
+ *
+ * \param decoder The decoder, which has not yet delivered any scanline.
+ * \param bands The planar bands of the decoders' image size.
+ */
+template <class T, class D>
+void readScanlines(vigra::Decoder & decoder, std::vector<vigra::MultiArrayView<2, D> > & bands)
+{
+    const int width  = decoder.getWidth();
+    const int height = decoder.getHeight();
+    const unsigned int offset = decoder.getOffset();
+    
+    for(int y=0; y!=height; ++y)
     {
-        //read image given as first argument
-        //file type is determined automatically
-        vigra::ImageImportInfo info(filename);
+        decoder.nextScanline();
         
-        if(info.width() == width && info.height() == height)
+        for(unsigned int b=0; b!=bands.size(); ++b)
         {
-            if(info.isGrayscale())
-            {
-                //Create gray scale image views for the arrays
-                vigra::Shape2 shape(width, height);
-                ImageView img(shape, arr_out);
-                
-                //import the image just read
-                importImage(info, img);
-            }
-            else
+            const T * scanline = static_cast<const T*>(decoder.currentScanlineOfBand(b));
+            D * out = &bands[b](0, y);
+            
+            for(int x=0; x!=width; ++x, scanline+=offset)
             {
-                return 2;
+                out[x] = PixelTypeTraits<D>::fromReal(*scanline);
             }
         }
-        else
+    }
+}
+
+/**
+ * Internal helper to read the pixel data of a decoder into planar bands.
+ * The scanlines are converted according to the pixel type of the image.
+ *
+ * \param decoder The decoder, which has not yet delivered any scanline.
+ * \param bands The planar bands of the decoders' image size.
+ */
+template <class D>
+void readBands(vigra::Decoder & decoder, std::vector<vigra::MultiArrayView<2, D> > & bands)
+{
+    const std::string pixeltype = decoder.getPixelType();
+    
+    if(pixeltype == "UINT8")
+        readScanlines<vigra::UInt8>(decoder, bands);
+    else if(pixeltype == "INT16")
+        readScanlines<vigra::Int16>(decoder, bands);
+    else if(pixeltype == "UINT16")
+        readScanlines<vigra::UInt16>(decoder, bands);
+    else if(pixeltype == "INT32")
+        readScanlines<vigra::Int32>(decoder, bands);
+    else if(pixeltype == "UINT32")
+        readScanlines<vigra::UInt32>(decoder, bands);
+    else if(pixeltype == "FLOAT")
+        readScanlines<float>(decoder, bands);
+    else if(pixeltype == "DOUBLE")
+        readScanlines<double>(decoder, bands);
+    else
+        vigra_fail("readBands(): unsupported pixel type " + pixeltype);
+    
+    decoder.close();
+}
+
+/**
+ * Internal helper to import the pixel data of a handle into planar band arrays.
+ * The decoder of the handle is used if the pixel data has not been read before,
+ * else the file needs to be opened again.
+ *
+ * \param import_handle The image import handle.
+ * \param arr_bands_out Array of num_bands flat (band) arrays of size width*height.
+ * \param num_bands The number of bands to be imported.
+ * \param width The width of the flat band arrays.
+ * \param height The height of the flat band arrays.
+ * \param color_bands The number of non-extra bands, which the image needs to have.
+ *                    If num_bands is greater, the image needs to have extra bands, too.
+ *                    If 0, any image with at least num_bands bands is accepted.
+ *
+ * \return 0 if the image was imported,
+ *         2 if the bands of the image do not fit,
+ *         3 if the dimensions do not fit to the image,
+ *         1 else.
+ */
+template <class D>
+int importHandle(void * import_handle,
+                 const D ** arr_bands_out,
+                 const int num_bands,
+                 const int width,
+                 const int height,
+                 const int color_bands)
+{
+    try
+    {
+        if(import_handle == nullptr)
+        {
+            return 1;
+        }
+        
+        ImageImportHandle & handle = *reinterpret_cast<ImageImportHandle*>(import_handle);
+        
+        if(handle.width != width || handle.height != height)
         {
             return 3;
         }
+        if(num_bands < 1 || num_bands > handle.num_bands)
+        {
+            return 2;
+        }
+        if(color_bands != 0 &&
+           (handle.num_bands - handle.num_extra_bands != color_bands ||
+            (num_bands > color_bands && handle.num_extra_bands == 0)))
+        {
+            return 2;
+        }
+        
+        //Create image views for the arrays
+        vigra::Shape2 shape(width, height);
+        std::vector<vigra::MultiArrayView<2, D> > bands;
+        
+        for(int b=0; b!=num_bands; ++b)
+        {
+            bands.push_back(vigra::MultiArrayView<2, D>(shape, arr_bands_out[b]));
+        }
+        
+        std::unique_ptr<vigra::Decoder> decoder = std::move(handle.decoder);
+        
+        if(!decoder)
+        {
+            decoder = vigra::getDecoder(handle.filename, handle.filetype);
+        }
+        
+        //read the scanlines directly into the bands
+        readBands(*decoder, bands);
     }
     catch (vigra::StdException & e)
     {
@@ -82,57 +210,127 @@ LIBEXPORT int vigra_importgrayimage_c(const PixelType * arr_out,
     return 0;
 }
 
-LIBEXPORT int vigra_importrgbimage_c(const PixelType * arr_r_out,
-                                     const PixelType * arr_g_out,
-                                     const PixelType * arr_b_out,
-                                     const int width,
-                                     const int height,
-                                     const char * filename)
+/**
+ * Internal helper to write planar bands to an image file without creating an
+ * interleaved image first. The scanlines are filled directly from the bands.
+ *
+ * \param filename The filename of the image to be written.
+ * \param pixeltype The pixel type of the file, which must correspond to T.
+ * \param bands The planar bands, which all have the same shape.
+ * \param convert The conversion of each band value to T.
+ */
+template <class T, class S, class CONVERTER>
+void writeBands(const char * filename,
+                const std::string & pixeltype,
+                const std::vector<vigra::MultiArrayView<2, S> > & bands,
+                CONVERTER convert)
 {
-    try
+    const int width  = bands[0].shape(0);
+    const int height = bands[0].shape(1);
+    
+    std::unique_ptr<vigra::Encoder> encoder = vigra::getEncoder(filename);
+    encoder->setWidth(width);
+    encoder->setHeight(height);
+    encoder->setNumBands(bands.size());
+    encoder->setPixelType(pixeltype);
+    encoder->finalizeSettings();
+    
+    const unsigned int offset = encoder->getOffset();
+    
+    for(int y=0; y!=height; ++y)
     {
-        //read image given as first argument
-        //file type is determined automatically
-        vigra::ImageImportInfo info(filename);
-        
-        if(info.width() == width && info.height() == height)
+        for(unsigned int b=0; b!=bands.size(); ++b)
         {
-            if(info.isColor())
-            {
-                //Create gray scale image views for the arrays
-                vigra::MultiArray<2, vigra::RGBValue<PixelType> > img(info.width(), info.height());
-                
-                //import the image just read
-                importImage(info, img);
-                
-                //write the color channels to the different arrays
-                vigra::Shape2 shape(width, height);
-                ImageView img_red(shape, arr_r_out);
-                ImageView img_green(shape, arr_g_out);
-                ImageView img_blue(shape, arr_b_out);
-                
-                auto red_iter   = img_red.begin(),
-                     green_iter = img_green.begin(),
-                     blue_iter  = img_blue.begin();
-                
-                for(auto img_iter = img.begin();
-                    img_iter != img.end();
-                    ++img_iter, ++red_iter, ++green_iter, ++blue_iter)
-                {
-                    *red_iter = img_iter->red();
-                    *green_iter = img_iter->green();
-                    *blue_iter = img_iter->blue();
-                }
-            }
-            else
+            T * scanline = static_cast<T*>(encoder->currentScanlineOfBand(b));
+            const S * in = &bands[b](0, y);
+            
+            for(int x=0; x!=width; ++x, scanline+=offset)
             {
-                return 2;
+                *scanline = convert(in[x]);
             }
         }
-        else
+        encoder->nextScanline();
+    }
+    encoder->close();
+}
+
+/**
+ * Internal helper to determine if the file format, which is given by the 
+ * extension of a filename, is able to store float pixels.
+ *
+ * \param filename The filename of the image to be written.
+ *
+ * \return true, if float pixels are supported, else false.
+ */
+static bool supportsFloat(const char * filename)
+{
+    return vigra::isPixelTypeSupported(vigra::getEncoderType(filename), "FLOAT");
+}
+
+/**
+ * Internal helper to import an image file into planar band arrays.
+ * The file is opened only once.
+ *
+ * \param filename The filename of the image to be loaded.
+ * \param arr_bands_out Array of num_bands flat (band) arrays of size width*height.
+ * \param num_bands The number of bands to be imported.
+ * \param width The width of the flat band arrays.
+ * \param height The height of the flat band arrays.
+ * \param color_bands The number of non-extra bands, which the image needs to have,
+ *                    see importHandle.
+ *
+ * \return The result of importHandle.
+ */
+template <class D>
+int importFile(const char * filename,
+               const D ** arr_bands_out,
+               const int num_bands,
+               const int width,
+               const int height,
+               const int color_bands)
+{
+    //read image given as first argument
+    //file type is determined automatically
+    void * import_handle = vigra_imageimport_open_c(filename);
+    
+    //the scanlines are written directly to the different arrays
+    int result = importHandle(import_handle, arr_bands_out, num_bands, width, height, color_bands);
+    
+    vigra_imageimport_close_c(import_handle);
+    return result;
+}
+
+/**
+ * Internal helper to export planar band arrays of a typed variant to an image file.
+ * The file is written with the pixel type of the bands.
+ *
+ * \param arr_bands_in Array of num_bands flat (band) arrays of size width*height.
+ * \param num_bands The number of bands to be exported.
+ * \param width The width of the flat band arrays.
+ * \param height The height of the flat band arrays.
+ * \param filename The filename of the image to be saved.
+ *
+ * \return 0 if the image was saved to the filesystem, 1 else.
+ */
+template <class T>
+int exportFile(const T ** arr_bands_in,
+               const int num_bands,
+               const int width,
+               const int height,
+               const char * filename)
+{
+    try
+    {
+        //Create image views for the arrays
+        vigra::Shape2 shape(width, height);
+        std::vector<vigra::MultiArrayView<2, T> > bands;
+        
+        for(int b=0; b!=num_bands; ++b)
         {
-            return 3;
+            bands.push_back(vigra::MultiArrayView<2, T>(shape, arr_bands_in[b]));
         }
+        
+        writeBands<T>(filename, PixelTypeTraits<T>::name(), bands, [](T v){ return v; });
     }
     catch (vigra::StdException & e)
     {
@@ -142,6 +340,28 @@ LIBEXPORT int vigra_importrgbimage_c(const PixelType * arr_r_out,
     return 0;
 }
 
+LIBEXPORT int vigra_importgrayimage_c(const PixelType * arr_out,
+                                      const int width,
+                                      const int height,
+                                      const char * filename)
+{
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*sizeof(PixelType));
+    const PixelType * arr_bands_out[] = {arr_out};
+    return importFile(filename, arr_bands_out, 1, width, height, 1);
+}
+
+LIBEXPORT int vigra_importrgbimage_c(const PixelType * arr_r_out,
+                                     const PixelType * arr_g_out,
+                                     const PixelType * arr_b_out,
+                                     const int width,
+                                     const int height,
+                                     const char * filename)
+{
+    VIGRA_C_STATS_SCOPE(3*std::size_t(width)*height*sizeof(PixelType));
+    const PixelType * arr_bands_out[] = {arr_r_out, arr_g_out, arr_b_out};
+    return importFile(filename, arr_bands_out, 3, width, height, 3);
+}
+
 LIBEXPORT int vigra_importrgbaimage_c(const PixelType * arr_r_out,
                                       const PixelType * arr_g_out,
                                       const PixelType * arr_b_out,
@@ -150,58 +370,9 @@ LIBEXPORT int vigra_importrgbaimage_c(const PixelType * arr_r_out,
                                       const int height,
                                       const char * filename)
 {
-    try
-    {
-        //read image given as first argument
-        //file type is determined automatically
-        vigra::ImageImportInfo info(filename);
-        
-        if(info.width() == width && info.height() == height)
-        {
-            if(info.isColor() && info.numExtraBands())
-            {
-                //Create gray scale image views for the arrays
-                vigra::Shape2 shape(width, height);
-                vigra::MultiArray<2, vigra::RGBValue<PixelType> > img(shape);
-                ImageView img_alpha(shape, arr_a_out);
-                
-                //import the image just read into rgb-temp image and alpha arr
-                importImageAlpha(info, img, img_alpha);
-                
-                //write the color channels to the different arrays
-                ImageView img_red(shape, arr_r_out);
-                ImageView img_green(shape, arr_g_out);
-                ImageView img_blue(shape, arr_b_out);
-                
-                auto red_iter   = img_red.begin(),
-                     green_iter = img_green.begin(),
-                     blue_iter  = img_blue.begin();
-                
-                for(auto img_iter = img.begin();
-                    img_iter != img.end();
-                    ++img_iter, ++red_iter, ++green_iter, ++blue_iter)
-                {
-                    *red_iter = img_iter->red();
-                    *green_iter = img_iter->green();
-                    *blue_iter = img_iter->blue();
-                }
-            }
-            else
-            {
-                return 2;
-            }
-        }
-        else
-        {
-            return 3;
-        }
-    }
-    catch (vigra::StdException & e)
-    {
-        return 1;
-    }
-    
-    return 0;
+    VIGRA_C_STATS_SCOPE(4*std::size_t(width)*height*sizeof(PixelType));
+    const PixelType * arr_bands_out[] = {arr_r_out, arr_g_out, arr_b_out, arr_a_out};
+    return importFile(filename, arr_bands_out, 4, width, height, 3);
 }
 
 LIBEXPORT int vigra_exportgrayimage_c(const PixelType * arr_in,
@@ -210,6 +381,7 @@ LIBEXPORT int vigra_exportgrayimage_c(const PixelType * arr_in,
                                       const char * filename,
                                       bool rescale_range)
 {
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -222,15 +394,14 @@ LIBEXPORT int vigra_exportgrayimage_c(const PixelType * arr_in,
         }
         else
         {
-            vigra::MultiArray<2, unsigned char> img8bit(shape);
-            auto img8Bit_iter = img8bit.begin();
-        
-            for(auto img_iter = img.begin(); img_iter != img.end(); ++img_iter, ++img8Bit_iter)
-            {
-                *img8Bit_iter = vigra::max(vigra::min(*img_iter, 255.0f), 0.0f);
-            }
+            std::vector<ImageView> bands = {img};
             
-            vigra::exportImage(img8bit, filename);
+            //clip and write the scanlines directly from the array
+            writeBands<vigra::UInt8>(filename, "UINT8", bands,
+                                     [](PixelType v)
+                                     {
+                                         return vigra::UInt8(vigra::max(vigra::min(v, 255.0f), 0.0f));
+                                     });
         }
     }
     catch (vigra::StdException & e)
@@ -248,23 +419,41 @@ LIBEXPORT int vigra_exportrgbimage_c(const PixelType * arr_r_in,
                                      const char * filename,
                                      bool rescale_range)
 {
+    VIGRA_C_STATS_SCOPE(3*std::size_t(width)*height*sizeof(PixelType));
     try
     {
-        //create a floating (32-bit) color image of appropriate size
-        vigra::MultiArray<2, vigra::RGBValue<PixelType> > img(width, height);
-        
-        //write the color channels from the different arrays
+        //Create gray scale image views for the arrays
         vigra::Shape2 shape_in(width,height);
         ImageView img_red(shape_in, arr_r_in);
         ImageView img_green(shape_in, arr_g_in);
         ImageView img_blue(shape_in, arr_b_in);
         
-        auto red_iter = img_red.begin(),
-             green_iter = img_green.begin(),
-             blue_iter = img_blue.begin();
+        std::vector<ImageView> bands = {img_red, img_green, img_blue};
         
-        if(rescale_range)
+        if(!rescale_range)
+        {
+            //clip and write the scanlines directly from the different arrays
+            writeBands<vigra::UInt8>(filename, "UINT8", bands,
+                                     [](PixelType v)
+                                     {
+                                         return vigra::NumericTraits<vigra::UInt8>::fromRealPromote(v);
+                                     });
+        }
+        else if(supportsFloat(filename))
         {
+            //no range mapping needed, write the scanlines directly from the different arrays
+            writeBands<float>(filename, "FLOAT", bands, [](PixelType v){ return v; });
+        }
+        else
+        {
+            //create a floating (32-bit) color image of appropriate size
+            //to let vigra find the range mapping
+            ScratchImage<vigra::RGBValue<PixelType> > img(width, height);
+            
+            auto red_iter = img_red.begin(),
+                 green_iter = img_green.begin(),
+                 blue_iter = img_blue.begin();
+            
             for(auto img_iter = img.begin(); img_iter != img.end(); ++img_iter, ++red_iter, ++green_iter, ++blue_iter)
             {
                 img_iter->red() = *red_iter;
@@ -274,18 +463,6 @@ LIBEXPORT int vigra_exportrgbimage_c(const PixelType * arr_r_in,
             // export the image, which has just been filled
             vigra::exportImage(img, filename);
         }
-        else
-        {
-            for(auto img_iter = img.begin(); img_iter != img.end(); ++img_iter, ++red_iter, ++green_iter, ++blue_iter)
-            {
-                img_iter->red() = vigra::max(vigra::min(*red_iter, 255.0f), 0.0f);
-                img_iter->green() = vigra::max(vigra::min(*green_iter, 255.0f), 0.0f);
-                img_iter->blue() = vigra::max(vigra::min(*blue_iter, 255.0f), 0.0f);
-            }
-            
-            vigra::MultiArray<2, vigra::RGBValue<unsigned char> > img8bit(img);
-            vigra::exportImage(img8bit, filename);
-        }
     }
     catch (vigra::StdException & e)
     {
@@ -304,24 +481,42 @@ LIBEXPORT int vigra_exportrgbaimage_c(const PixelType * arr_r_in,
                                       const char * filename,
                                       bool rescale_range)
 {
+    VIGRA_C_STATS_SCOPE(4*std::size_t(width)*height*sizeof(PixelType));
     try
     {
-        //create a floating (32-bit) color image of appropriate size
-        vigra::MultiArray<2, vigra::RGBValue<PixelType> > img(width, height);
-        
-        //write the color channels from the different arrays
+        //Create gray scale image views for the arrays
         vigra::Shape2 shape_in(width,height);
         ImageView img_red(shape_in, arr_r_in);
         ImageView img_green(shape_in, arr_g_in);
         ImageView img_blue(shape_in, arr_b_in);
         ImageView img_alpha(shape_in, arr_a_in);
         
-        auto red_iter = img_red.begin(),
-             green_iter = img_green.begin(),
-             blue_iter = img_blue.begin();
+        std::vector<ImageView> bands = {img_red, img_green, img_blue, img_alpha};
         
-        if(rescale_range)
+        if(!rescale_range)
+        {
+            //clip and write the scanlines directly from the different arrays
+            writeBands<vigra::UInt8>(filename, "UINT8", bands,
+                                     [](PixelType v)
+                                     {
+                                         return vigra::NumericTraits<vigra::UInt8>::fromRealPromote(v);
+                                     });
+        }
+        else if(supportsFloat(filename))
+        {
+            //no range mapping needed, write the scanlines directly from the different arrays
+            writeBands<float>(filename, "FLOAT", bands, [](PixelType v){ return v; });
+        }
+        else
         {
+            //create a floating (32-bit) color image of appropriate size
+            //to let vigra find the range mapping
+            ScratchImage<vigra::RGBValue<PixelType> > img(width, height);
+            
+            auto red_iter = img_red.begin(),
+                 green_iter = img_green.begin(),
+                 blue_iter = img_blue.begin();
+            
             for(auto img_iter = img.begin(); img_iter != img.end(); ++img_iter, ++red_iter, ++green_iter, ++blue_iter)
             {
                 img_iter->red() = *red_iter;
@@ -332,23 +527,6 @@ LIBEXPORT int vigra_exportrgbaimage_c(const PixelType * arr_r_in,
             // export the image, which has just been filled
             vigra::exportImageAlpha(img, img_alpha, filename);
         }
-        else
-        {
-            for(auto img_iter = img.begin(); img_iter != img.end(); ++img_iter, ++red_iter, ++green_iter, ++blue_iter)
-            {
-                img_iter->red() = vigra::max(vigra::min(*red_iter, 255.0f), 0.0f);
-                img_iter->green() = vigra::max(vigra::min(*green_iter, 255.0f), 0.0f);
-                img_iter->blue() = vigra::max(vigra::min(*blue_iter, 255.0f), 0.0f);
-            }
-            
-            for(auto img_iter = img_alpha.begin(); img_iter != img_alpha.end(); ++img_iter)
-            {
-                *img_iter = vigra::max(vigra::min(*img_iter, 255.0f), 0.0f);
-            }
-           
-            vigra::MultiArray<2, vigra::RGBValue<unsigned char> > img8bit(img);
-            vigra::exportImageAlpha(img8bit, img_alpha, filename);
-        }
     }
     catch (vigra::StdException & e)
     {
@@ -360,6 +538,7 @@ LIBEXPORT int vigra_exportrgbaimage_c(const PixelType * arr_r_in,
 
 LIBEXPORT int vigra_imagewidth_c(const char * filename)
 {
+    VIGRA_C_STATS_SCOPE(0);
     try
     {
         // read image given as first argument
@@ -375,6 +554,7 @@ LIBEXPORT int vigra_imagewidth_c(const char * filename)
 
 LIBEXPORT int vigra_imageheight_c(const char * filename)
 {
+    VIGRA_C_STATS_SCOPE(0);
     try
     {
         // read image given as first argument
@@ -390,6 +570,7 @@ LIBEXPORT int vigra_imageheight_c(const char * filename)
 
 LIBEXPORT int vigra_imagenumbands_c(const char * filename)
 {
+    VIGRA_C_STATS_SCOPE(0);
     try
     {
         // read image given as first argument
@@ -405,6 +586,7 @@ LIBEXPORT int vigra_imagenumbands_c(const char * filename)
 
 LIBEXPORT int vigra_imagenumextrabands_c(const char * filename)
 {
+    VIGRA_C_STATS_SCOPE(0);
     try
     {
         // read image given as first argument
@@ -418,9 +600,244 @@ LIBEXPORT int vigra_imagenumextrabands_c(const char * filename)
     }
 }
 
+LIBEXPORT void * vigra_imageimport_open_c(const char * filename)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    try
+    {
+        std::unique_ptr<ImageImportHandle> handle(new ImageImportHandle);
+        
+        //open the file and read its header
+        //file type is determined automatically
+        handle->filename = filename;
+        handle->decoder = vigra::getDecoder(handle->filename);
+        
+        handle->filetype        = handle->decoder->getFileType();
+        handle->pixeltype       = handle->decoder->getPixelType();
+        handle->width           = handle->decoder->getWidth();
+        handle->height          = handle->decoder->getHeight();
+        handle->num_bands       = handle->decoder->getNumBands();
+        handle->num_extra_bands = handle->decoder->getNumExtraBands();
+        
+        return handle.release();
+    }
+    catch (vigra::StdException & e)
+    {
+        return nullptr;
+    }
+}
+
+LIBEXPORT int vigra_imageimport_width_c(const void * import_handle)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    if(import_handle == nullptr)
+    {
+        return 0;
+    }
+    return reinterpret_cast<const ImageImportHandle*>(import_handle)->width;
+}
+
+LIBEXPORT int vigra_imageimport_height_c(const void * import_handle)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    if(import_handle == nullptr)
+    {
+        return 0;
+    }
+    return reinterpret_cast<const ImageImportHandle*>(import_handle)->height;
+}
+
+LIBEXPORT int vigra_imageimport_numbands_c(const void * import_handle)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    if(import_handle == nullptr)
+    {
+        return 0;
+    }
+    return reinterpret_cast<const ImageImportHandle*>(import_handle)->num_bands;
+}
+
+LIBEXPORT int vigra_imageimport_numextrabands_c(const void * import_handle)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    if(import_handle == nullptr)
+    {
+        return 0;
+    }
+    return reinterpret_cast<const ImageImportHandle*>(import_handle)->num_extra_bands;
+}
+
+LIBEXPORT int vigra_imageimport_pixeltype_c(const void * import_handle)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    if(import_handle == nullptr)
+    {
+        return 0;
+    }
+    
+    const std::string & pixeltype = reinterpret_cast<const ImageImportHandle*>(import_handle)->pixeltype;
+    
+    if(pixeltype == "UINT8")  return 1;
+    if(pixeltype == "INT16")  return 2;
+    if(pixeltype == "UINT16") return 3;
+    if(pixeltype == "INT32")  return 4;
+    if(pixeltype == "UINT32") return 5;
+    if(pixeltype == "FLOAT")  return 6;
+    if(pixeltype == "DOUBLE") return 7;
+    return 0;
+}
+
+LIBEXPORT int vigra_imageimport_gray_c(void * import_handle,
+                                       const PixelType * arr_out,
+                                       const int width,
+                                       const int height)
+{
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*sizeof(PixelType));
+    const PixelType * arr_bands_out[] = {arr_out};
+    return importHandle(import_handle, arr_bands_out, 1, width, height, 1);
+}
+
+LIBEXPORT int vigra_imageimport_rgb_c(void * import_handle,
+                                      const PixelType * arr_r_out,
+                                      const PixelType * arr_g_out,
+                                      const PixelType * arr_b_out,
+                                      const int width,
+                                      const int height)
+{
+    VIGRA_C_STATS_SCOPE(3*std::size_t(width)*height*sizeof(PixelType));
+    const PixelType * arr_bands_out[] = {arr_r_out, arr_g_out, arr_b_out};
+    return importHandle(import_handle, arr_bands_out, 3, width, height, 3);
+}
+
+LIBEXPORT int vigra_imageimport_rgba_c(void * import_handle,
+                                       const PixelType * arr_r_out,
+                                       const PixelType * arr_g_out,
+                                       const PixelType * arr_b_out,
+                                       const PixelType * arr_a_out,
+                                       const int width,
+                                       const int height)
+{
+    VIGRA_C_STATS_SCOPE(4*std::size_t(width)*height*sizeof(PixelType));
+    const PixelType * arr_bands_out[] = {arr_r_out, arr_g_out, arr_b_out, arr_a_out};
+    return importHandle(import_handle, arr_bands_out, 4, width, height, 3);
+}
+
+LIBEXPORT int vigra_imageimport_bands_c(void * import_handle,
+                                        const PixelType ** arr_bands_out,
+                                        const int num_bands,
+                                        const int width,
+                                        const int height)
+{
+    VIGRA_C_STATS_SCOPE(num_bands*std::size_t(width)*height*sizeof(PixelType));
+    return importHandle(import_handle, arr_bands_out, num_bands, width, height, 0);
+}
+
+LIBEXPORT int vigra_imageimport_close_c(void * import_handle)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    try
+    {
+        ImageImportHandle * handle = reinterpret_cast<ImageImportHandle*>(import_handle);
+        delete handle;
+    }
+    catch (vigra::StdException & e)
+    {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Defines a preprocessor macro for the typed import and export functions, which
+ * are generated from the templated implementation for each pixel type
+ */
+#define IMPEX_TYPED_FUNCTIONS(suffix, type)                                                         \
+LIBEXPORT int vigra_importgrayimage_##suffix##_c(const type * arr_out,                              \
+                                                 const int width,                                   \
+                                                 const int height,                                  \
+                                                 const char * filename)                             \
+{                                                                                                   \
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*sizeof(type));                                    \
+    const type * arr_bands_out[] = {arr_out};                                                       \
+    return importFile(filename, arr_bands_out, 1, width, height, 1);                                \
+}                                                                                                   \
+                                                                                                    \
+LIBEXPORT int vigra_importrgbimage_##suffix##_c(const type * arr_r_out,                             \
+                                                const type * arr_g_out,                             \
+                                                const type * arr_b_out,                             \
+                                                const int width,                                    \
+                                                const int height,                                   \
+                                                const char * filename)                              \
+{                                                                                                   \
+    VIGRA_C_STATS_SCOPE(3*std::size_t(width)*height*sizeof(type));                                  \
+    const type * arr_bands_out[] = {arr_r_out, arr_g_out, arr_b_out};                               \
+    return importFile(filename, arr_bands_out, 3, width, height, 3);                                \
+}                                                                                                   \
+                                                                                                    \
+LIBEXPORT int vigra_importrgbaimage_##suffix##_c(const type * arr_r_out,                            \
+                                                 const type * arr_g_out,                            \
+                                                 const type * arr_b_out,                            \
+                                                 const type * arr_a_out,                            \
+                                                 const int width,                                   \
+                                                 const int height,                                  \
+                                                 const char * filename)                             \
+{                                                                                                   \
+    VIGRA_C_STATS_SCOPE(4*std::size_t(width)*height*sizeof(type));                                  \
+    const type * arr_bands_out[] = {arr_r_out, arr_g_out, arr_b_out, arr_a_out};                    \
+    return importFile(filename, arr_bands_out, 4, width, height, 3);                                \
+}                                                                                                   \
+                                                                                                    \
+LIBEXPORT int vigra_imageimport_bands_##suffix##_c(void * import_handle,                            \
+                                                   const type ** arr_bands_out,                     \
+                                                   const int num_bands,                             \
+                                                   const int width,                                 \
+                                                   const int height)                                \
+{                                                                                                   \
+    VIGRA_C_STATS_SCOPE(num_bands*std::size_t(width)*height*sizeof(type));                          \
+    return importHandle(import_handle, arr_bands_out, num_bands, width, height, 0);                 \
+}                                                                                                   \
+                                                                                                    \
+LIBEXPORT int vigra_exportgrayimage_##suffix##_c(const type * arr_in,                               \
+                                                 const int width,                                   \
+                                                 const int height,                                  \
+                                                 const char * filename)                             \
+{                                                                                                   \
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*sizeof(type));                                    \
+    const type * arr_bands_in[] = {arr_in};                                                         \
+    return exportFile(arr_bands_in, 1, width, height, filename);                                    \
+}                                                                                                   \
+                                                                                                    \
+LIBEXPORT int vigra_exportrgbimage_##suffix##_c(const type * arr_r_in,                              \
+                                                const type * arr_g_in,                              \
+                                                const type * arr_b_in,                              \
+                                                const int width,                                    \
+                                                const int height,                                   \
+                                                const char * filename)                              \
+{                                                                                                   \
+    VIGRA_C_STATS_SCOPE(3*std::size_t(width)*height*sizeof(type));                                  \
+    const type * arr_bands_in[] = {arr_r_in, arr_g_in, arr_b_in};                                   \
+    return exportFile(arr_bands_in, 3, width, height, filename);                                    \
+}                                                                                                   \
+                                                                                                    \
+LIBEXPORT int vigra_exportrgbaimage_##suffix##_c(const type * arr_r_in,                             \
+                                                 const type * arr_g_in,                             \
+                                                 const type * arr_b_in,                             \
+                                                 const type * arr_a_in,                             \
+                                                 const int width,                                   \
+                                                 const int height,                                  \
+                                                 const char * filename)                             \
+{                                                                                                   \
+    VIGRA_C_STATS_SCOPE(4*std::size_t(width)*height*sizeof(type));                                  \
+    const type * arr_bands_in[] = {arr_r_in, arr_g_in, arr_b_in, arr_a_in};                         \
+    return exportFile(arr_bands_in, 4, width, height, filename);                                    \
+}
+
+IMPEX_TYPED_FUNCTIONS(uint8, UInt8PixelType)
+IMPEX_TYPED_FUNCTIONS(uint16, UInt16PixelType)
 
 LIBEXPORT int vigra_has_hdf5_c()
 {
+    VIGRA_C_STATS_SCOPE(0);
     #ifdef HAS_HDF5
         return 1;
     #else
@@ -433,6 +850,7 @@ LIBEXPORT int vigra_has_hdf5_c()
 
 LIBEXPORT int vigra_hdf5_numdimensions_c(const char* filename, const char* pathInFile)
 {
+    VIGRA_C_STATS_SCOPE(0);
     try
     {
         // read image given as first argument
@@ -449,6 +867,7 @@ LIBEXPORT int vigra_hdf5_numdimensions_c(const char* filename, const char* pathI
 
 LIBEXPORT int vigra_hdf5_shape_c(const char * filename, const char* pathInFile, int* shape_arr, const int dimensions)
 {
+    VIGRA_C_STATS_SCOPE(0);
     try
     {
         // read image given as first argument
@@ -473,6 +892,7 @@ LIBEXPORT int vigra_hdf5_shape_c(const char * filename, const char* pathInFile,
 
 LIBEXPORT int vigra_hdf5_importarray_c(const char * filename, const char* pathInFile, float* flat_arr, int* shape_arr, const int dimensions)
 {
+    VIGRA_C_STATS_SCOPE(0);
     try
     {
         vigra::HDF5ImportInfo info(filename, pathInFile);
@@ -570,6 +990,7 @@ LIBEXPORT int vigra_hdf5_importarray_c(const char * filename, const char* pathIn
 
 LIBEXPORT int vigra_hdf5_exportarray_c(float* flat_arr, int* shape_arr, const int dimensions, const char * filename, const char* pathInFile)
 {
+    VIGRA_C_STATS_SCOPE(0);
     try
     {
         switch(dimensions)
@@ -647,3 +1068,79 @@ LIBEXPORT int vigra_hdf5_exportarray_c(float* flat_arr, int* shape_arr, const in
     }
 }
 #endif
+
+LIBEXPORT void * vigra_importgrayimage_async_c(const PixelType * arr_out,
+                                               const int width,
+                                               const int height,
+                                               const char * filename)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    std::string filename_str(filename);
+    return submitJob([=]()
+                     {
+                         return vigra_importgrayimage_c(arr_out,
+                                                        width,
+                                                        height,
+                                                        filename_str.c_str());
+                     });
+}
+
+LIBEXPORT void * vigra_importrgbimage_async_c(const PixelType * arr_r_out,
+                                              const PixelType * arr_g_out,
+                                              const PixelType * arr_b_out,
+                                              const int width,
+                                              const int height,
+                                              const char * filename)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    std::string filename_str(filename);
+    return submitJob([=]()
+                     {
+                         return vigra_importrgbimage_c(arr_r_out,
+                                                       arr_g_out,
+                                                       arr_b_out,
+                                                       width,
+                                                       height,
+                                                       filename_str.c_str());
+                     });
+}
+
+LIBEXPORT void * vigra_exportgrayimage_async_c(const PixelType * arr_in,
+                                               const int width,
+                                               const int height,
+                                               const char * filename,
+                                               bool rescale_range)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    std::string filename_str(filename);
+    return submitJob([=]()
+                     {
+                         return vigra_exportgrayimage_c(arr_in,
+                                                        width,
+                                                        height,
+                                                        filename_str.c_str(),
+                                                        rescale_range);
+                     });
+}
+
+LIBEXPORT void * vigra_exportrgbimage_async_c(const PixelType * arr_r_in,
+                                              const PixelType * arr_g_in,
+                                              const PixelType * arr_b_in,
+                                              const int width,
+                                              const int height,
+                                              const char * filename,
+                                              bool rescale_range)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    std::string filename_str(filename);
+    return submitJob([=]()
+                     {
+                         return vigra_exportrgbimage_c(arr_r_in,
+                                                       arr_g_in,
+                                                       arr_b_in,
+                                                       width,
+                                                       height,
+                                                       filename_str.c_str(),
+                                                       rescale_range);
+                     });
+}
@@ -280,6 +280,274 @@ LIBEXPORT int vigra_imagenumbands_c(const char * filename);
  */
 LIBEXPORT int vigra_imagenumextrabands_c(const char * filename);
 
+/**
+ * Opens an image file for the handle-based import. The header of the image is
+ * read only once and the information is cached on the returned handle. The file
+ * stays open until the pixel data has been imported by one of the 
+ * vigra_imageimport_*_c functions below. Thus, the header of an image, which
+ * is imported once by means of a handle, is parsed only once. Each further
+ * import of the pixel data from the same handle opens the file again.
+ * A handle must not be used by different threads at the same time.
+ * It needs to be closed by vigra_imageimport_close_c.
+ *
+ * For more information, refer to the
+ * <a href="https://ukoethe.github.io/vigra/doc-release/vigra/group__VigraImpex.html">
+ * vigra Import/Export documentation
+ * </a>.
+ *
+ * \param filename The filename of the image to be opened.
+ *
+ * \return The import handle, or NULL if the image could not be opened.
+ */
+LIBEXPORT void * vigra_imageimport_open_c(const char * filename);
+
+/**
+ * Returns the image width of an opened image.
+ *
+ * \param import_handle The import handle of the image.
+ *
+ * \return 0,   if the handle is NULL,
+ *         else the width of the image.
+ */
+LIBEXPORT int vigra_imageimport_width_c(const void * import_handle);
+
+/**
+ * Returns the image height of an opened image.
+ *
+ * \param import_handle The import handle of the image.
+ *
+ * \return 0,   if the handle is NULL,
+ *         else the height of the image.
+ */
+LIBEXPORT int vigra_imageimport_height_c(const void * import_handle);
+
+/**
+ * Returns the number of bands (including the extra bands) of an opened image.
+ *
+ * \param import_handle The import handle of the image.
+ *
+ * \return 0,   if the handle is NULL,
+ *         else the number of bands of the image.
+ */
+LIBEXPORT int vigra_imageimport_numbands_c(const void * import_handle);
+
+/**
+ * Returns the number of additional (alpha-)bands of an opened image.
+ *
+ * \param import_handle The import handle of the image.
+ *
+ * \return 0,   if the handle is NULL or there are no additional bands,
+ *         else the number of extra bands of the image.
+ */
+LIBEXPORT int vigra_imageimport_numextrabands_c(const void * import_handle);
+
+/**
+ * Returns the pixel type, in which an opened image is stored in the file.
+ * Regardless of this type, the pixel data is always imported as PixelType.
+ *
+ * \param import_handle The import handle of the image.
+ *
+ * \return 0 if the handle is NULL or the pixel type is unknown,
+ *         1 for UINT8,
+ *         2 for INT16,
+ *         3 for UINT16,
+ *         4 for INT32,
+ *         5 for UINT32,
+ *         6 for FLOAT,
+ *         7 for DOUBLE.
+ */
+LIBEXPORT int vigra_imageimport_pixeltype_c(const void * import_handle);
+
+/**
+ * Import of an opened grayscale image into a single band array, which needs 
+ * already to be allocated at correct size (width*height).
+ *
+ * \param import_handle The import handle of the image.
+ * \param[out] arr_out The flat (band) array for the image of size width*height.
+ * \param width The width of the flat band array.
+ * \param height The height of the flat band array.
+ *
+ * \return 0 if the grayscale image was imported,
+ *         2 if the image is not grayscale,
+ *         3 if the dimensions do not fit to the image,
+ *         1 else.
+ */
+LIBEXPORT int vigra_imageimport_gray_c(void * import_handle,
+                                       const PixelType * arr_out,
+                                       const int width,
+                                       const int height);
+
+/**
+ * Import of an opened color image into three band arrays, which need 
+ * already to be allocated at correct size (width*height).
+ *
+ * \param import_handle The import handle of the image.
+ * \param[out] arr_r_out The flat (band) array for the red channel of size width*height.
+ * \param[out] arr_g_out The flat (band) array for the green channel of size width*height.
+ * \param[out] arr_b_out The flat (band) array for the blue channel of size width*height.
+ * \param width The width of the flat band arrays.
+ * \param height The height of the flat band arrays.
+ *
+ * \return 0 if the color image was imported,
+ *         2 if the image is not a color image,
+ *         3 if the dimensions do not fit to the image,
+ *         1 else.
+ */
+LIBEXPORT int vigra_imageimport_rgb_c(void * import_handle,
+                                      const PixelType * arr_r_out,
+                                      const PixelType * arr_g_out,
+                                      const PixelType * arr_b_out,
+                                      const int width,
+                                      const int height);
+
+/**
+ * Import of an opened color image with alpha channel into four band arrays, which
+ * need already to be allocated at correct size (width*height).
+ *
+ * \param import_handle The import handle of the image.
+ * \param[out] arr_r_out The flat (band) array for the red channel of size width*height.
+ * \param[out] arr_g_out The flat (band) array for the green channel of size width*height.
+ * \param[out] arr_b_out The flat (band) array for the blue channel of size width*height.
+ * \param[out] arr_a_out The flat (band) array for the alpha channel of size width*height.
+ * \param width The width of the flat band arrays.
+ * \param height The height of the flat band arrays.
+ *
+ * \return 0 if the color image was imported,
+ *         2 if the image is not a color image with alpha channel,
+ *         3 if the dimensions do not fit to the image,
+ *         1 else.
+ */
+LIBEXPORT int vigra_imageimport_rgba_c(void * import_handle,
+                                       const PixelType * arr_r_out,
+                                       const PixelType * arr_g_out,
+                                       const PixelType * arr_b_out,
+                                       const PixelType * arr_a_out,
+                                       const int width,
+                                       const int height);
+
+/**
+ * Import of the first num_bands bands of an opened image into band arrays,
+ * which need already to be allocated at correct size (width*height).
+ *
+ * \param import_handle The import handle of the image.
+ * \param[out] arr_bands_out Array of num_bands flat (band) arrays of size width*height.
+ * \param num_bands The number of bands to be imported. Must be in the interval
+ *                  [1, vigra_imageimport_numbands_c(import_handle)].
+ * \param width The width of the flat band arrays.
+ * \param height The height of the flat band arrays.
+ *
+ * \return 0 if the image was imported,
+ *         2 if num_bands does not fit to the image,
+ *         3 if the dimensions do not fit to the image,
+ *         1 else.
+ */
+LIBEXPORT int vigra_imageimport_bands_c(void * import_handle,
+                                        const PixelType ** arr_bands_out,
+                                        const int num_bands,
+                                        const int width,
+                                        const int height);
+
+/**
+ * Closes an image, which has been opened by vigra_imageimport_open_c, 
+ * and frees the handle.
+ *
+ * \param import_handle The import handle of the image.
+ *
+ * \return 0 on success, else 1.
+ */
+LIBEXPORT int vigra_imageimport_close_c(void * import_handle);
+
+/**
+ * Defines a preprocessor macro for the interfaces of the typed import and export
+ * functions. These are available for the pixel types UInt8PixelType (suffix uint8)
+ * and UInt16PixelType (suffix uint16). Please note, that e.g. JPEG does not support
+ * 16-bit images.
+ */
+#define IMPEX_TYPED_FUNCTIONS_INTERFACE(suffix, type)                                               \
+/**                                                                                                 \
+  Typed variant of vigra_importgrayimage_c, which imports into a band array                         \
+  of the given pixel type. Values of other pixel types are rounded and saturated.                   \
+  The return values are the same as for vigra_importgrayimage_c.                                    \
+ */                                                                                                 \
+LIBEXPORT int vigra_importgrayimage_##suffix##_c(const type * arr_out,                              \
+                                                 const int width,                                   \
+                                                 const int height,                                  \
+                                                 const char * filename);                            \
+/**                                                                                                 \
+  Typed variant of vigra_importrgbimage_c, which imports into band arrays                           \
+  of the given pixel type. Values of other pixel types are rounded and saturated.                   \
+  The return values are the same as for vigra_importrgbimage_c.                                     \
+ */                                                                                                 \
+LIBEXPORT int vigra_importrgbimage_##suffix##_c(const type * arr_r_out,                             \
+                                                const type * arr_g_out,                             \
+                                                const type * arr_b_out,                             \
+                                                const int width,                                    \
+                                                const int height,                                   \
+                                                const char * filename);                             \
+/**                                                                                                 \
+  Typed variant of vigra_importrgbaimage_c, which imports into band arrays                          \
+  of the given pixel type. Values of other pixel types are rounded and saturated.                   \
+  The return values are the same as for vigra_importrgbaimage_c.                                    \
+ */                                                                                                 \
+LIBEXPORT int vigra_importrgbaimage_##suffix##_c(const type * arr_r_out,                            \
+                                                 const type * arr_g_out,                            \
+                                                 const type * arr_b_out,                            \
+                                                 const type * arr_a_out,                            \
+                                                 const int width,                                   \
+                                                 const int height,                                  \
+                                                 const char * filename);                            \
+/**                                                                                                 \
+  Typed variant of vigra_imageimport_bands_c, which imports into band arrays                        \
+  of the given pixel type. Values of other pixel types are rounded and saturated.                   \
+  The return values are the same as for vigra_imageimport_bands_c.                                  \
+ */                                                                                                 \
+LIBEXPORT int vigra_imageimport_bands_##suffix##_c(void * import_handle,                            \
+                                                   const type ** arr_bands_out,                     \
+                                                   const int num_bands,                             \
+                                                   const int width,                                 \
+                                                   const int height);                               \
+/**                                                                                                 \
+  Typed variant of vigra_exportgrayimage_c. The image is saved with the                             \
+  given pixel type, thus no clipping or rescaling is needed.                                        \
+                                                                                                    \
+  \return 0 if the image was saved to the filesystem,                                               \
+          1 else, e.g. if the file format does not support the pixel type.                          \
+ */                                                                                                 \
+LIBEXPORT int vigra_exportgrayimage_##suffix##_c(const type * arr_in,                               \
+                                                 const int width,                                   \
+                                                 const int height,                                  \
+                                                 const char * filename);                            \
+/**                                                                                                 \
+  Typed variant of vigra_exportrgbimage_c. The image is saved with the                              \
+  given pixel type, thus no clipping or rescaling is needed.                                        \
+                                                                                                    \
+  \return 0 if the image was saved to the filesystem,                                               \
+          1 else, e.g. if the file format does not support the pixel type.                          \
+ */                                                                                                 \
+LIBEXPORT int vigra_exportrgbimage_##suffix##_c(const type * arr_r_in,                              \
+                                                const type * arr_g_in,                              \
+                                                const type * arr_b_in,                              \
+                                                const int width,                                    \
+                                                const int height,                                   \
+                                                const char * filename);                             \
+/**                                                                                                 \
+  Typed variant of vigra_exportrgbaimage_c. The image is saved with the                             \
+  given pixel type, thus no clipping or rescaling is needed.                                        \
+                                                                                                    \
+  \return 0 if the image was saved to the filesystem,                                               \
+          1 else, e.g. if the file format does not support the pixel type.                          \
+ */                                                                                                 \
+LIBEXPORT int vigra_exportrgbaimage_##suffix##_c(const type * arr_r_in,                             \
+                                                 const type * arr_g_in,                             \
+                                                 const type * arr_b_in,                             \
+                                                 const type * arr_a_in,                             \
+                                                 const int width,                                   \
+                                                 const int height,                                  \
+                                                 const char * filename);
+
+IMPEX_TYPED_FUNCTIONS_INTERFACE(uint8, UInt8PixelType)
+IMPEX_TYPED_FUNCTIONS_INTERFACE(uint16, UInt16PixelType)
+
 /**
  * Function to indicate whether hdf5 import/export is available
  *
@@ -375,6 +643,72 @@ LIBEXPORT int vigra_hdf5_exportarray_c(float* flat_arr, int* shape_arr, const in
 
 #endif
 
+/**
+ * Asynchronous variant of vigra_importgrayimage_c.
+ * Submits the computation to the library's worker pool and returns immediately.
+ * All arrays must have been allocated before the call of this function and
+ * must stay valid until the job has been finished.
+ * The parameters are the same as for vigra_importgrayimage_c.
+ *
+ * \return A job handle, which needs to be released by vigra_job_wait_c.
+ *         The result of vigra_job_wait_c is the return value of vigra_importgrayimage_c.
+ */
+LIBEXPORT void * vigra_importgrayimage_async_c(const PixelType * arr_out,
+                                               const int width,
+                                               const int height,
+                                               const char * filename);
+
+/**
+ * Asynchronous variant of vigra_importrgbimage_c.
+ * Submits the computation to the library's worker pool and returns immediately.
+ * All arrays must have been allocated before the call of this function and
+ * must stay valid until the job has been finished.
+ * The parameters are the same as for vigra_importrgbimage_c.
+ *
+ * \return A job handle, which needs to be released by vigra_job_wait_c.
+ *         The result of vigra_job_wait_c is the return value of vigra_importrgbimage_c.
+ */
+LIBEXPORT void * vigra_importrgbimage_async_c(const PixelType * arr_r_out,
+                                              const PixelType * arr_g_out,
+                                              const PixelType * arr_b_out,
+                                              const int width,
+                                              const int height,
+                                              const char * filename);
+
+/**
+ * Asynchronous variant of vigra_exportgrayimage_c.
+ * Submits the computation to the library's worker pool and returns immediately.
+ * All arrays must have been allocated before the call of this function and
+ * must stay valid until the job has been finished.
+ * The parameters are the same as for vigra_exportgrayimage_c.
+ *
+ * \return A job handle, which needs to be released by vigra_job_wait_c.
+ *         The result of vigra_job_wait_c is the return value of vigra_exportgrayimage_c.
+ */
+LIBEXPORT void * vigra_exportgrayimage_async_c(const PixelType * arr_in,
+                                               const int width,
+                                               const int height,
+                                               const char * filename,
+                                               bool rescale_range);
+
+/**
+ * Asynchronous variant of vigra_exportrgbimage_c.
+ * Submits the computation to the library's worker pool and returns immediately.
+ * All arrays must have been allocated before the call of this function and
+ * must stay valid until the job has been finished.
+ * The parameters are the same as for vigra_exportrgbimage_c.
+ *
+ * \return A job handle, which needs to be released by vigra_job_wait_c.
+ *         The result of vigra_job_wait_c is the return value of vigra_exportrgbimage_c.
+ */
+LIBEXPORT void * vigra_exportrgbimage_async_c(const PixelType * arr_r_in,
+                                              const PixelType * arr_g_in,
+                                              const PixelType * arr_b_in,
+                                              const int width,
+                                              const int height,
+                                              const char * filename,
+                                              bool rescale_range);
+
 /**
  * @}
  */
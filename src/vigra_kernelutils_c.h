@@ -37,6 +37,9 @@
 
 #include <vigra/stdconvolution.hxx>
 #include <vigra/multi_array.hxx>
+#include <cmath>
+#include <utility>
+#include <vector>
 
 /**
  * @file
@@ -125,6 +128,156 @@ vigra::Kernel1D<T> kernel1dFromArray(const T * arr_in,
     return kernel;
 }
 
+/**
+ * Internal helper function to decompose a flat 2D kernel array into a sum of
+ * separable kernels, i.e. outer products of a horizontal and a vertical kernel.
+ * The terms are the leading singular triplets of the kernel matrix, which
+ * are computed one after the other by power iteration and deflation. The
+ * decomposition stops, if the residual is small enough or max_rank terms
+ * have been found. For a rank-1 kernel (e.g. Gaussian, box or Sobel), the
+ * first term is already exact.
+ *
+ * \param arr_in Flat input array of size width*height.
+ * \param width The width of the flat array.
+ * \param height The height of the flat array.
+ * \param max_rank The maximal number of separable terms.
+ * \param tolerance The tolerated residual, relative to the Frobenius norm of the kernel.
+ * \param[out] residual The residual of the returned terms, relative to the Frobenius
+ *                      norm of the kernel.
+ * \param border_treatment The border treatment mode of the resulting kernels.
+ *
+ * \return The pairs of horizontal and vertical kernels.
+ */
+template<class T>
+std::vector<std::pair<vigra::Kernel1D<T>, vigra::Kernel1D<T> > >
+separableKernelsFromArray(const T * arr_in,
+                          const int width,
+                          const int height,
+                          const int max_rank,
+                          const double tolerance,
+                          double & residual,
+                          vigra::BorderTreatmentMode border_treatment = vigra::BORDER_TREATMENT_REFLECT)
+{
+    std::vector<std::pair<vigra::Kernel1D<T>, vigra::Kernel1D<T> > > terms;
+    
+    //Residual matrix R(x,y) = arr_in[y*width + x]
+    std::vector<double> r(arr_in, arr_in + width*height);
+    
+    double norm = 0.0;
+    for(double value : r)
+    {
+        norm += value*value;
+    }
+    norm = std::sqrt(norm);
+    residual = 0.0;
+    
+    if(norm == 0.0)
+    {
+        return terms;
+    }
+    
+    std::vector<double> u(width), v(height);
+    
+    for(int rank=0; rank<max_rank; ++rank)
+    {
+        //Start with the row of the largest norm
+        int best_row = 0;
+        double best_norm = -1.0;
+        for(int y=0; y<height; ++y)
+        {
+            double row_norm = 0.0;
+            for(int x=0; x<width; ++x)
+            {
+                row_norm += r[y*width + x]*r[y*width + x];
+            }
+            if(row_norm > best_norm)
+            {
+                best_norm = row_norm;
+                best_row = y;
+            }
+        }
+        std::fill(v.begin(), v.end(), 0.0);
+        v[best_row] = 1.0;
+        
+        //Power iteration: u = R^T v / |R^T v|, v = R u / |R u|
+        double sigma = 0.0;
+        for(int iteration=0; iteration<100; ++iteration)
+        {
+            double u_norm = 0.0;
+            for(int x=0; x<width; ++x)
+            {
+                u[x] = 0.0;
+                for(int y=0; y<height; ++y)
+                {
+                    u[x] += r[y*width + x]*v[y];
+                }
+                u_norm += u[x]*u[x];
+            }
+            u_norm = std::sqrt(u_norm);
+            if(u_norm == 0.0)
+            {
+                break;
+            }
+            for(double & value : u)
+            {
+                value /= u_norm;
+            }
+            
+            double v_norm = 0.0, change = 0.0;
+            for(int y=0; y<height; ++y)
+            {
+                double value = 0.0;
+                for(int x=0; x<width; ++x)
+                {
+                    value += r[y*width + x]*u[x];
+                }
+                v_norm += value*value;
+                change += (value - sigma*v[y])*(value - sigma*v[y]);
+                v[y] = value;
+            }
+            v_norm = std::sqrt(v_norm);
+            for(double & value : v)
+            {
+                value /= v_norm;
+            }
+            
+            bool converged = (change <= 1e-24*v_norm*v_norm);
+            sigma = v_norm;
+            if(converged)
+            {
+                break;
+            }
+        }
+        
+        //Deflate and compute the remaining residual
+        double residual_norm = 0.0;
+        std::vector<T> kernel_h(width), kernel_v(height);
+        for(int x=0; x<width; ++x)
+        {
+            kernel_h[x] = T(sigma*u[x]);
+        }
+        for(int y=0; y<height; ++y)
+        {
+            kernel_v[y] = T(v[y]);
+            for(int x=0; x<width; ++x)
+            {
+                r[y*width + x] -= sigma*u[x]*v[y];
+                residual_norm += r[y*width + x]*r[y*width + x];
+            }
+        }
+        
+        terms.push_back(std::make_pair(kernel1dFromArray(kernel_h.data(), width, border_treatment),
+                                       kernel1dFromArray(kernel_v.data(), height, border_treatment)));
+        
+        residual = std::sqrt(residual_norm)/norm;
+        if(residual <= tolerance)
+        {
+            break;
+        }
+    }
+    return terms;
+}
+
 /**
  * @}
  */
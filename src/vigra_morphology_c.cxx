@@ -33,9 +33,17 @@
 /************************************************************************/
 
 #include "vigra_morphology_c.h"
+#include "vigra_arenautils_c.h"
+#include "vigra_parallelutils_c.h"
+#include "vigra_statsutils_c.h"
+#include "vigra_typeutils_c.h"
 #include <vigra/flatmorphology.hxx>
 #include <vigra/distancetransform.hxx>
 #include <vigra/shockfilter.hxx>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
 
 
 /**
@@ -43,18 +51,59 @@
  * @brief Implementation of morphological operators
  */
 
-LIBEXPORT int vigra_distancetransform_c(const PixelType * arr_in,
-                                        const PixelType * arr_out,
-                                        const int width,
-                                        const int height,
-                                        const float background_label,
-                                        const int norm)
+/**
+ * Internal helper to get an 8-bit image for vigra's disc rank order filters, which
+ * need values in [0, 255]. 8-bit images are used directly, all other images are
+ * rounded and saturated to a temporary 8-bit image.
+ *
+ * \param img The image.
+ * \param tmp The temporary 8-bit image.
+ *
+ * \return A view to an 8-bit image with the contents of img.
+ */
+template <class T>
+vigra::MultiArrayView<2, UInt8PixelType> byteImage(const vigra::MultiArrayView<2, T> & img,
+                                                   ScratchImage<UInt8PixelType> & tmp)
+{
+    tmp.reshape(img.shape());
+    
+    //Assigning the view would only cast the values, which wraps 16-bit values around
+    parallelRows(img.height(), 16,
+                 [&](int y0, int y1)
+                 {
+                     for(int y=y0; y<y1; ++y)
+                     {
+                         for(int x=0; x<img.width(); ++x)
+                         {
+                             tmp(x, y) = PixelTypeTraits<UInt8PixelType>::fromReal(img(x, y));
+                         }
+                     }
+                 });
+    return tmp;
+}
+
+inline vigra::MultiArrayView<2, UInt8PixelType> byteImage(const vigra::MultiArrayView<2, UInt8PixelType> & img,
+                                                          ScratchImage<UInt8PixelType> & /*tmp*/)
+{
+    return img;
+}
+
+/**
+ * Internal helper for the distance transform of each pixel type.
+ */
+template <class T>
+int distanceTransform(const T * arr_in,
+                      const PixelType * arr_out,
+                      const int width,
+                      const int height,
+                      const T background_label,
+                      const int norm)
 {
     try
     {
-        //Create gray scale image views for the arrays
+        //Create image views for the arrays
         vigra::Shape2 shape(width,height);
-        ImageView img_in(shape, arr_in);
+        vigra::MultiArrayView<2, T> img_in(shape, arr_in);
         ImageView img_out(shape, arr_out);
         
         if(norm>=0 && norm <= 2)
@@ -69,45 +118,268 @@ LIBEXPORT int vigra_distancetransform_c(const PixelType * arr_in,
     return 0;
 }
 
-LIBEXPORT int vigra_discerosion_c(const PixelType * arr_in,
-                                  const PixelType * arr_out,
-                                  const int width,
-                                  const int height,
-                                  const int radius)
+/**
+ * Internal helper for the exact Euclidean distance transform of Felzenszwalb
+ * and Huttenlocher, which costs O(1) per pixel. The first pass finds the
+ * nearest site in each column by a forward and a backward sweep, which are
+ * run over strips of adjacent columns in parallel. The second pass computes
+ * the lower envelope of the parabolas of each row, rooted at the results of
+ * the first pass. The rows are processed in parallel.
+ *
+ * \param width The width of the image.
+ * \param height The height of the image.
+ * \param pitch_x The horizontal pixel pitch.
+ * \param pitch_y The vertical pixel pitch.
+ * \param is_site Functor, which is called by is_site(x, y) and returns true
+ *                for the pixels, whose distance is measured.
+ * \param result Functor, which is called by result(x, y, squared_distance, nearest_x, nearest_y)
+ *               for each pixel. If there is no site, nearest_x and nearest_y are -1
+ *               and the squared distance is infinite.
+ */
+template <class SITE, class RESULT>
+void exactDistanceTransform(const int width,
+                            const int height,
+                            const double pitch_x,
+                            const double pitch_y,
+                            SITE is_site,
+                            RESULT result)
+{
+    //The row of the nearest site of each column, -1 if there is none
+    ScratchImage<int> nearest_row(width, height);
+    
+    parallelRows(width, 64,
+                 [&](int x0, int x1)
+                 {
+                     std::vector<int> last(x1 - x0, -1);
+                     for(int y=0; y<height; ++y)
+                     {
+                         for(int x=x0; x<x1; ++x)
+                         {
+                             if(is_site(x, y))
+                             {
+                                 last[x-x0] = y;
+                             }
+                             nearest_row(x, y) = last[x-x0];
+                         }
+                     }
+                     
+                     std::fill(last.begin(), last.end(), -1);
+                     for(int y=height-1; y>=0; --y)
+                     {
+                         for(int x=x0; x<x1; ++x)
+                         {
+                             if(is_site(x, y))
+                             {
+                                 last[x-x0] = y;
+                             }
+                             const int above = nearest_row(x, y),
+                                       below = last[x-x0];
+                             if(below >= 0 && (above < 0 || below - y < y - above))
+                             {
+                                 nearest_row(x, y) = below;
+                             }
+                         }
+                     }
+                 });
+    
+    const double ax = pitch_x*pitch_x,
+                 ay = pitch_y*pitch_y,
+                 inf = std::numeric_limits<double>::infinity();
+    
+    parallelRows(height, 16,
+                 [&](int y0, int y1)
+                 {
+                     std::vector<double> f(width), z(width + 1);
+                     std::vector<int> v(width);
+                     
+                     for(int y=y0; y<y1; ++y)
+                     {
+                         //Lower envelope of the parabolas ax*(x-q)^2 + f(q) of all columns with a site
+                         int k = -1;
+                         for(int q=0; q<width; ++q)
+                         {
+                             const int row = nearest_row(q, y);
+                             if(row < 0)
+                             {
+                                 continue;
+                             }
+                             f[q] = ay*double(y - row)*(y - row);
+                             
+                             if(k < 0)
+                             {
+                                 k = 0;
+                                 v[0] = q;
+                                 z[0] = -inf;
+                                 z[1] = inf;
+                                 continue;
+                             }
+                             
+                             //Terminates at k == 0 at the latest, since z[0] is -inf
+                             double s;
+                             while(true)
+                             {
+                                 const int p = v[k];
+                                 s = ((f[q] + ax*double(q)*q) - (f[p] + ax*double(p)*p))/(2.0*ax*(q - p));
+                                 if(s > z[k])
+                                 {
+                                     break;
+                                 }
+                                 --k;
+                             }
+                             ++k;
+                             v[k] = q;
+                             z[k] = s;
+                             z[k+1] = inf;
+                         }
+                         
+                         if(k < 0)
+                         {
+                             for(int x=0; x<width; ++x)
+                             {
+                                 result(x, y, inf, -1, -1);
+                             }
+                             continue;
+                         }
+                         
+                         k = 0;
+                         for(int x=0; x<width; ++x)
+                         {
+                             while(z[k+1] < x)
+                             {
+                                 ++k;
+                             }
+                             const int q = v[k];
+                             result(x, y, ax*double(x - q)*(x - q) + f[q], q, nearest_row(q, y));
+                         }
+                     }
+                 });
+}
+
+/**
+ * Internal helper for the exact Euclidean distance transform of each pixel type.
+ */
+template <class T>
+int euclideanDistanceTransform(const T * arr_in,
+                               const PixelType * arr_out,
+                               int * arr_nearest_out,
+                               const int width,
+                               const int height,
+                               const T background_label,
+                               const float pitch_x,
+                               const float pitch_y)
 {
+    if(!(pitch_x > 0.0f) || !(pitch_y > 0.0f))
+    {
+        //Illegal pixel pitch!
+        return 2;
+    }
+    
     try
     {
-        //Create gray scale image views for the arrays
+        //Create image views for the arrays
         vigra::Shape2 shape(width,height);
-        ImageView img_in(shape, arr_in);
+        vigra::MultiArrayView<2, T> img_in(shape, arr_in);
         ImageView img_out(shape, arr_out);
         
-        vigra::MultiArray<2, unsigned char> b_img = img_in;
-        vigra::discErosion(b_img, img_out, radius);
+        exactDistanceTransform(width, height, pitch_x, pitch_y,
+                               [&](int x, int y)
+                               {
+                                   return img_in(x, y) == background_label;
+                               },
+                               [&](int x, int y, double squared_distance, int nearest_x, int nearest_y)
+                               {
+                                   img_out(x, y) = (nearest_x < 0) ? std::numeric_limits<PixelType>::max()
+                                                                   : PixelType(std::sqrt(squared_distance));
+                                   if(arr_nearest_out != nullptr)
+                                   {
+                                       arr_nearest_out[std::size_t(y)*width + x] = (nearest_x < 0) ? -1 : nearest_y*width + nearest_x;
+                                   }
+                               });
     }
     catch (vigra::StdException & e)
     {
         return 1;
     }
-    
     return 0;
 }
 
-LIBEXPORT int vigra_discdilation_c(const PixelType * arr_in,
-                                   const PixelType * arr_out,
-                                   const int width,
-                                   const int height,
-                                   const int radius)
+/**
+ * Internal helper for the Voronoi distance transform of each label type.
+ */
+template <class L>
+int voronoiDistanceTransform(const L * arr_labels_in,
+                             const PixelType * arr_out,
+                             const L * arr_labels_out,
+                             const int width,
+                             const int height,
+                             const float pitch_x,
+                             const float pitch_y)
 {
+    if(!(pitch_x > 0.0f) || !(pitch_y > 0.0f))
+    {
+        //Illegal pixel pitch!
+        return 2;
+    }
+    
     try
     {
-        //Create gray scale image views for the arrays
+        //Create image views for the arrays
         vigra::Shape2 shape(width,height);
-        ImageView img_in(shape, arr_in);
+        vigra::MultiArrayView<2, L> img_labels_in(shape, arr_labels_in);
         ImageView img_out(shape, arr_out);
+        vigra::MultiArrayView<2, L> img_labels_out(shape, arr_labels_out);
+        
+        exactDistanceTransform(width, height, pitch_x, pitch_y,
+                               [&](int x, int y)
+                               {
+                                   return img_labels_in(x, y) != 0;
+                               },
+                               [&](int x, int y, double squared_distance, int nearest_x, int nearest_y)
+                               {
+                                   if(nearest_x < 0)
+                                   {
+                                       img_out(x, y) = std::numeric_limits<PixelType>::max();
+                                       img_labels_out(x, y) = 0;
+                                   }
+                                   else
+                                   {
+                                       img_out(x, y) = PixelType(std::sqrt(squared_distance));
+                                       img_labels_out(x, y) = img_labels_in(nearest_x, nearest_y);
+                                   }
+                               });
+    }
+    catch (vigra::StdException & e)
+    {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Internal helper for the disc erosion and dilation of each pixel type.
+ */
+template <class T>
+int discMorphology(const T * arr_in,
+                   const T * arr_out,
+                   const int width,
+                   const int height,
+                   const int radius,
+                   const bool dilation)
+{
+    try
+    {
+        //Create image views for the arrays
+        vigra::Shape2 shape(width,height);
+        vigra::MultiArrayView<2, T> img_in(shape, arr_in);
+        vigra::MultiArrayView<2, T> img_out(shape, arr_out);
         
-        vigra::MultiArray<2, unsigned char> b_img = img_in;
-        vigra::discDilation(b_img, img_out, radius);
+        ScratchImage<UInt8PixelType> tmp;
+        vigra::MultiArrayView<2, UInt8PixelType> b_img = byteImage(img_in, tmp);
+        
+        if(dilation)
+            vigra::discDilation(b_img, img_out, radius);
+        else
+            vigra::discErosion(b_img, img_out, radius);
     }
     catch (vigra::StdException & e)
     {
@@ -117,6 +389,536 @@ LIBEXPORT int vigra_discdilation_c(const PixelType * arr_in,
     return 0;
 }
 
+/**
+ * The structuring elements of the grayscale morphology, see vigra_morphology_c.
+ */
+enum StructuringElement
+{
+    SE_RECTANGLE = 0,
+    SE_LINE_DOWN = 1,
+    SE_LINE_UP   = 2,
+    SE_OCTAGON   = 3,
+    SE_DISC      = 4
+};
+
+/**
+ * The number of adjacent lines, which are processed side by side by the
+ * vertical and diagonal passes of the grayscale morphology.
+ */
+static const int MORPHOLOGY_STRIP_WIDTH = 64;
+
+/**
+ * Internal functor of the grayscale erosion (minimum) and dilation (maximum).
+ * Pixels outside of the image take the neutral value of the operation, thus
+ * the structuring element is cropped at the image border.
+ */
+template <class T, bool DILATION>
+struct MorphologyOp
+{
+    static T neutral()
+    {
+        if(DILATION)
+        {
+            return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+        }
+        return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+    }
+    
+    static T apply(const T a, const T b)
+    {
+        return DILATION ? (a < b ? b : a) : (b < a ? b : a);
+    }
+};
+
+/**
+ * Internal helper for the van Herk/Gil-Werman algorithm, which computes the
+ * minimum or maximum of a window of 2*radius+1 samples with three operations
+ * per sample for any radius. The lines are split into blocks of the window size,
+ * for which the running results from the left (g) and from the right (h) are
+ * computed. Each window covers the end of one block and the start of the next.
+ * The lines are interleaved: in[i*lines + l] is the i-th sample of line l. Thus,
+ * the inner loops run over adjacent memory and are vectorized by the compiler.
+ *
+ * \param in The interleaved input lines of size length*lines.
+ * \param[out] out The interleaved output lines of size length*lines.
+ * \param length The length of each line.
+ * \param lines The number of lines.
+ * \param radius The radius of the window.
+ * \param g Temporary array of size padded*lines, with padded = length+2*radius
+ *          rounded up to a multiple of the window size.
+ * \param h Temporary array of the same size as g.
+ * \param neutral Array of lines neutral values, which are used outside of the lines.
+ */
+template <class OP, class T>
+static void vanHerkLines(const T * in, T * out,
+                         const int length, const int lines, const int radius,
+                         T * g, T * h, const T * neutral)
+{
+    const int size = 2*radius + 1,
+              padded = ((length + 2*radius + size - 1)/size)*size;
+    
+    //The padded sample j is the input sample j-radius
+    auto sample = [&](const int j)
+                  {
+                      return (j >= radius && j < length + radius) ? in + std::size_t(j - radius)*lines : neutral;
+                  };
+    
+    for(int b=0; b<padded; b+=size)
+    {
+        std::copy(sample(b), sample(b) + lines, g + std::size_t(b)*lines);
+        for(int j=b+1; j<b+size; ++j)
+        {
+            const T * src = sample(j),
+                    * prev = g + std::size_t(j-1)*lines;
+            T * dst = g + std::size_t(j)*lines;
+            for(int l=0; l<lines; ++l)
+            {
+                dst[l] = OP::apply(prev[l], src[l]);
+            }
+        }
+        
+        std::copy(sample(b+size-1), sample(b+size-1) + lines, h + std::size_t(b+size-1)*lines);
+        for(int j=b+size-2; j>=b; --j)
+        {
+            const T * src = sample(j),
+                    * next = h + std::size_t(j+1)*lines;
+            T * dst = h + std::size_t(j)*lines;
+            for(int l=0; l<lines; ++l)
+            {
+                dst[l] = OP::apply(next[l], src[l]);
+            }
+        }
+    }
+    
+    for(int i=0; i<length; ++i)
+    {
+        const T * left = h + std::size_t(i)*lines,
+                * right = g + std::size_t(i + 2*radius)*lines;
+        T * dst = out + std::size_t(i)*lines;
+        for(int l=0; l<lines; ++l)
+        {
+            dst[l] = OP::apply(left[l], right[l]);
+        }
+    }
+}
+
+/**
+ * Internal helper for the erosion or dilation of an image with a horizontal
+ * line of 2*radius+1 pixels. The rows are processed in parallel.
+ */
+template <class OP, class T>
+static void horizontalLineMorphology(const vigra::MultiArrayView<2, T> & in,
+                                     vigra::MultiArrayView<2, T> & out,
+                                     const int radius)
+{
+    const int width = in.width(),
+              size = 2*radius + 1,
+              padded = ((width + 2*radius + size - 1)/size)*size;
+    
+    parallelRows(in.height(), 16,
+                 [&](int y0, int y1)
+                 {
+                     ScratchImage<T> g(padded, 1), h(padded, 1);
+                     const T neutral = OP::neutral();
+                     
+                     for(int y=y0; y<y1; ++y)
+                     {
+                         vanHerkLines<OP>(&in(0, y), &out(0, y), width, 1, radius, g.data(), h.data(), &neutral);
+                     }
+                 });
+}
+
+/**
+ * Internal helper for the erosion or dilation of an image with a vertical or
+ * diagonal line of 2*radius+1 pixels: {(shear*i, i) | -radius <= i <= radius}.
+ * The image is sheared, such that the lines become columns, i.e. column u of
+ * the sheared image contains the pixels (u + shear*y, y). Strips of adjacent
+ * columns are gathered into a temporary, processed by vanHerkLines side by side,
+ * and scattered back. The strips are processed in parallel.
+ *
+ * \param in The input image.
+ * \param[out] out The output image of the same shape.
+ * \param radius The radius of the line.
+ * \param shear 0 for vertical lines, 1 for diagonal lines from the top left to
+ *              the bottom right, -1 for diagonal lines from the bottom left to
+ *              the top right.
+ */
+template <class OP, class T>
+static void shearedLineMorphology(const vigra::MultiArrayView<2, T> & in,
+                                  vigra::MultiArrayView<2, T> & out,
+                                  const int radius,
+                                  const int shear)
+{
+    const int width = in.width(),
+              height = in.height(),
+              size = 2*radius + 1,
+              padded = ((height + 2*radius + size - 1)/size)*size,
+              u_begin = (shear > 0) ? -(height - 1) : 0,
+              u_end = (shear < 0) ? width + height - 1 : width,
+              strips = (u_end - u_begin + MORPHOLOGY_STRIP_WIDTH - 1)/MORPHOLOGY_STRIP_WIDTH;
+    
+    parallelForEach(strips,
+                    [&](int s)
+                    {
+                        const int u0 = u_begin + s*MORPHOLOGY_STRIP_WIDTH,
+                                  lines = std::min(MORPHOLOGY_STRIP_WIDTH, u_end - u0);
+                        
+                        ScratchImage<T> strip_in(lines, height), strip_out(lines, height),
+                                        g(lines, padded), h(lines, padded);
+                        const std::vector<T> neutral(lines, OP::neutral());
+                        
+                        for(int y=0; y<height; ++y)
+                        {
+                            for(int l=0; l<lines; ++l)
+                            {
+                                const int x = u0 + l + shear*y;
+                                strip_in(l, y) = (x >= 0 && x < width) ? in(x, y) : neutral[l];
+                            }
+                        }
+                        
+                        vanHerkLines<OP>(strip_in.data(), strip_out.data(), height, lines, radius,
+                                         g.data(), h.data(), neutral.data());
+                        
+                        for(int y=0; y<height; ++y)
+                        {
+                            for(int l=0; l<lines; ++l)
+                            {
+                                const int x = u0 + l + shear*y;
+                                if(x >= 0 && x < width)
+                                {
+                                    out(x, y) = strip_out(l, y);
+                                }
+                            }
+                        }
+                    });
+}
+
+/**
+ * Internal helper for the erosion or dilation of an image with a disc. The
+ * disc is decomposed into the horizontal chords of each row offset, which are
+ * the same as for vigra's disc rank order filters. For each input row, the
+ * results of the (distinct) chord lengths are computed by vanHerkLines and
+ * combined into the output rows under the disc. This costs O(radius) per pixel.
+ * The output rows are processed in parallel.
+ */
+template <class OP, class T>
+static void discChordMorphology(const vigra::MultiArrayView<2, T> & in,
+                                vigra::MultiArrayView<2, T> & out,
+                                const int radius)
+{
+    const int width = in.width(),
+              height = in.height();
+    
+    //Half lengths of the chords and the index of each distinct half length
+    std::vector<int> chord(radius + 1), chord_index(radius + 1), half_lengths;
+    for(int i=0; i<=radius; ++i)
+    {
+        const double r = i - 0.5;
+        chord[i] = (i == 0) ? radius : int(std::sqrt(double(radius)*radius - r*r) + 0.5);
+        
+        auto pos = std::find(half_lengths.begin(), half_lengths.end(), chord[i]);
+        chord_index[i] = int(pos - half_lengths.begin());
+        if(pos == half_lengths.end())
+        {
+            half_lengths.push_back(chord[i]);
+        }
+    }
+    const int padded = width + 4*radius + 2;
+    
+    parallelRows(height, std::max(16, 4*radius),
+                 [&](int y0, int y1)
+                 {
+                     ScratchImage<T> chords(width, (int)half_lengths.size()), g(padded, 1), h(padded, 1);
+                     const T neutral = OP::neutral();
+                     
+                     for(int y=y0; y<y1; ++y)
+                     {
+                         std::fill(&out(0, y), &out(0, y) + width, neutral);
+                     }
+                     
+                     for(int yy=std::max(0, y0-radius); yy<std::min(height, y1+radius); ++yy)
+                     {
+                         for(int k=0; k<(int)half_lengths.size(); ++k)
+                         {
+                             vanHerkLines<OP>(&in(0, yy), &chords(0, k), width, 1, half_lengths[k],
+                                              g.data(), h.data(), &neutral);
+                         }
+                         for(int y=std::max(y0, yy-radius); y<std::min(y1, yy+radius+1); ++y)
+                         {
+                             const T * src = &chords(0, chord_index[std::abs(yy - y)]);
+                             T * dst = &out(0, y);
+                             for(int x=0; x<width; ++x)
+                             {
+                                 dst[x] = OP::apply(dst[x], src[x]);
+                             }
+                         }
+                     }
+                 });
+}
+
+/**
+ * Internal helper for the erosion or dilation of an image with a structuring
+ * element, which is decomposed into lines (see vigra_morphology_c).
+ *
+ * Since the lines are cropped at the image border, the decomposed erosion and
+ * dilation are only adjoint, if one applies the lines in reverse order of the
+ * other. Thus, the second pass of openings and closings has to be reversed to
+ * keep them anti-extensive and extensive near the border.
+ *
+ * \param in The input image.
+ * \param[out] out The output image of the same shape.
+ * \param se_shape The structuring element.
+ * \param radius_x The horizontal radius, or the radius of lines, octagons and discs.
+ * \param radius_y The vertical radius of rectangles.
+ * \param reverse If true, the lines are applied in reverse order.
+ */
+template <class OP, class T>
+static void flatMorphology(const vigra::MultiArrayView<2, T> & in,
+                           vigra::MultiArrayView<2, T> & out,
+                           const int se_shape,
+                           const int radius_x,
+                           const int radius_y,
+                           const bool reverse = false)
+{
+    switch(se_shape)
+    {
+        case SE_RECTANGLE:
+        {
+            ScratchImage<T> tmp(in.shape());
+            if(reverse)
+            {
+                shearedLineMorphology<OP>(in, tmp, radius_y, 0);
+                horizontalLineMorphology<OP>(tmp, out, radius_x);
+            }
+            else
+            {
+                horizontalLineMorphology<OP>(in, tmp, radius_x);
+                shearedLineMorphology<OP>(tmp, out, radius_y, 0);
+            }
+            break;
+        }
+        case SE_LINE_DOWN:
+            shearedLineMorphology<OP>(in, out, radius_x, 1);
+            break;
+        case SE_LINE_UP:
+            shearedLineMorphology<OP>(in, out, radius_x, -1);
+            break;
+        case SE_OCTAGON:
+        {
+            //A square of radius a and a diamond of radius 2b (of both diagonals)
+            //reach a+2b along the axes and a+b along the diagonals
+            int b = int(0.2929*radius_x + 0.5),
+                a = radius_x - 2*b;
+            if(b > 0 && a < 1)
+            {
+                //The diagonals alone only reach every second pixel
+                b = (radius_x - 1)/2;
+                a = radius_x - 2*b;
+            }
+            
+            ScratchImage<T> tmp1(in.shape()), tmp2(in.shape());
+            if(b == 0)
+            {
+                if(reverse)
+                {
+                    shearedLineMorphology<OP>(in, tmp1, a, 0);
+                    horizontalLineMorphology<OP>(tmp1, out, a);
+                }
+                else
+                {
+                    horizontalLineMorphology<OP>(in, tmp1, a);
+                    shearedLineMorphology<OP>(tmp1, out, a, 0);
+                }
+            }
+            else if(reverse)
+            {
+                shearedLineMorphology<OP>(in, tmp1, b, -1);
+                shearedLineMorphology<OP>(tmp1, tmp2, b, 1);
+                shearedLineMorphology<OP>(tmp2, tmp1, a, 0);
+                horizontalLineMorphology<OP>(tmp1, out, a);
+            }
+            else
+            {
+                horizontalLineMorphology<OP>(in, tmp1, a);
+                shearedLineMorphology<OP>(tmp1, tmp2, a, 0);
+                shearedLineMorphology<OP>(tmp2, tmp1, b, 1);
+                shearedLineMorphology<OP>(tmp1, out, b, -1);
+            }
+            break;
+        }
+        case SE_DISC:
+            discChordMorphology<OP>(in, out, radius_x);
+            break;
+    }
+}
+
+/**
+ * Internal helper for the grayscale morphology of each pixel type.
+ */
+template <class T>
+int grayMorphology(const T * arr_in,
+                   const T * arr_out,
+                   const int width,
+                   const int height,
+                   const int operation,
+                   const int se_shape,
+                   const int radius_x,
+                   const int radius_y)
+{
+    typedef MorphologyOp<T, false> Erosion;
+    typedef MorphologyOp<T, true>  Dilation;
+    
+    if(operation < 0 || operation > 5)
+    {
+        //Illegal operation!
+        return 2;
+    }
+    if(se_shape < SE_RECTANGLE || se_shape > SE_DISC || radius_x < 0 || radius_y < 0)
+    {
+        //Illegal structuring element!
+        return 3;
+    }
+    
+    try
+    {
+        //Create image views for the arrays
+        vigra::Shape2 shape(width,height);
+        vigra::MultiArrayView<2, T> img_in(shape, arr_in);
+        vigra::MultiArrayView<2, T> img_out(shape, arr_out);
+        
+        ScratchImage<T> tmp;
+        if(operation >= 2)
+        {
+            tmp.reshape(shape);
+        }
+        
+        switch(operation)
+        {
+            case 0:
+                flatMorphology<Erosion>(img_in, img_out, se_shape, radius_x, radius_y);
+                break;
+            case 1:
+                flatMorphology<Dilation>(img_in, img_out, se_shape, radius_x, radius_y);
+                break;
+            case 2:
+            case 4:
+                flatMorphology<Erosion>(img_in, tmp, se_shape, radius_x, radius_y);
+                flatMorphology<Dilation>(tmp, img_out, se_shape, radius_x, radius_y, true);
+                break;
+            case 3:
+            case 5:
+                flatMorphology<Dilation>(img_in, tmp, se_shape, radius_x, radius_y);
+                flatMorphology<Erosion>(tmp, img_out, se_shape, radius_x, radius_y, true);
+                break;
+        }
+        
+        //White top-hat: image - opening, black top-hat: closing - image
+        if(operation >= 4)
+        {
+            parallelRows(height, 16,
+                         [&](int y0, int y1)
+                         {
+                             for(int y=y0; y<y1; ++y)
+                             {
+                                 for(int x=0; x<width; ++x)
+                                 {
+                                     img_out(x, y) = (operation == 4) ? T(img_in(x, y) - img_out(x, y))
+                                                                      : T(img_out(x, y) - img_in(x, y));
+                                 }
+                             }
+                         });
+        }
+    }
+    catch (vigra::StdException & e)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+LIBEXPORT int vigra_distancetransform_c(const PixelType * arr_in,
+                                        const PixelType * arr_out,
+                                        const int width,
+                                        const int height,
+                                        const float background_label,
+                                        const int norm)
+{
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
+    return distanceTransform(arr_in, arr_out, width, height, background_label, norm);
+}
+
+LIBEXPORT int vigra_euclideandistancetransform_c(const PixelType * arr_in,
+                                                 const PixelType * arr_out,
+                                                 int * arr_nearest_out,
+                                                 const int width,
+                                                 const int height,
+                                                 const float background_label,
+                                                 const float pitch_x,
+                                                 const float pitch_y)
+{
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*(2*sizeof(PixelType) + (arr_nearest_out ? sizeof(int) : 0)));
+    return euclideanDistanceTransform(arr_in, arr_out, arr_nearest_out, width, height,
+                                      background_label, pitch_x, pitch_y);
+}
+
+LIBEXPORT int vigra_voronoidistancetransform_c(const PixelType * arr_labels_in,
+                                               const PixelType * arr_out,
+                                               const PixelType * arr_labels_out,
+                                               const int width,
+                                               const int height,
+                                               const float pitch_x,
+                                               const float pitch_y)
+{
+    VIGRA_C_STATS_SCOPE(3*std::size_t(width)*height*sizeof(PixelType));
+    return voronoiDistanceTransform(arr_labels_in, arr_out, arr_labels_out, width, height, pitch_x, pitch_y);
+}
+
+LIBEXPORT int vigra_voronoidistancetransform_labels_c(const LabelType * arr_labels_in,
+                                                      const PixelType * arr_out,
+                                                      const LabelType * arr_labels_out,
+                                                      const int width,
+                                                      const int height,
+                                                      const float pitch_x,
+                                                      const float pitch_y)
+{
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*(2*sizeof(LabelType) + sizeof(PixelType)));
+    return voronoiDistanceTransform(arr_labels_in, arr_out, arr_labels_out, width, height, pitch_x, pitch_y);
+}
+
+LIBEXPORT int vigra_discerosion_c(const PixelType * arr_in,
+                                  const PixelType * arr_out,
+                                  const int width,
+                                  const int height,
+                                  const int radius)
+{
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
+    return discMorphology(arr_in, arr_out, width, height, radius, false);
+}
+
+LIBEXPORT int vigra_discdilation_c(const PixelType * arr_in,
+                                   const PixelType * arr_out,
+                                   const int width,
+                                   const int height,
+                                   const int radius)
+{
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
+    return discMorphology(arr_in, arr_out, width, height, radius, true);
+}
+
+LIBEXPORT int vigra_morphology_c(const PixelType * arr_in,
+                                 const PixelType * arr_out,
+                                 const int width,
+                                 const int height,
+                                 const int operation,
+                                 const int se_shape,
+                                 const int radius_x,
+                                 const int radius_y)
+{
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
+    return grayMorphology(arr_in, arr_out, width, height, operation, se_shape, radius_x, radius_y);
+}
+
 LIBEXPORT int vigra_upwindimage_c(const PixelType * arr_in,
                                   const PixelType * arr_fac_in,
                                   const PixelType * arr_out,
@@ -124,6 +926,7 @@ LIBEXPORT int vigra_upwindimage_c(const PixelType * arr_in,
                                   const int height,
                                   const float weight)
 {
+    VIGRA_C_STATS_SCOPE(3*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -140,3 +943,71 @@ LIBEXPORT int vigra_upwindimage_c(const PixelType * arr_in,
     }
     return 0;
 }
+
+/**
+ * Defines a preprocessor macro for the typed morphology functions, which are
+ * generated from the templated implementations for each pixel type
+ */
+#define MORPHOLOGY_TYPED_FUNCTIONS(suffix, type)                                          \
+LIBEXPORT int vigra_distancetransform_##suffix##_c(const type * arr_in,                   \
+                                                   const PixelType * arr_out,             \
+                                                   const int width,                       \
+                                                   const int height,                      \
+                                                   const type background_label,           \
+                                                   const int norm)                        \
+{                                                                                         \
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*(sizeof(type) + sizeof(PixelType)));    \
+    return distanceTransform(arr_in, arr_out, width, height, background_label, norm);     \
+}                                                                                         \
+                                                                                          \
+LIBEXPORT int vigra_euclideandistancetransform_##suffix##_c(const type * arr_in,          \
+                                                            const PixelType * arr_out,    \
+                                                            int * arr_nearest_out,        \
+                                                            const int width,              \
+                                                            const int height,             \
+                                                            const type background_label,  \
+                                                            const float pitch_x,          \
+                                                            const float pitch_y)          \
+{                                                                                         \
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*(sizeof(type) + sizeof(PixelType) +     \
+                                                   (arr_nearest_out ? sizeof(int) : 0))); \
+    return euclideanDistanceTransform(arr_in, arr_out, arr_nearest_out, width, height,    \
+                                      background_label, pitch_x, pitch_y);                \
+}                                                                                         \
+                                                                                          \
+LIBEXPORT int vigra_discerosion_##suffix##_c(const type * arr_in,                         \
+                                             const type * arr_out,                        \
+                                             const int width,                             \
+                                             const int height,                            \
+                                             const int radius)                            \
+{                                                                                         \
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(type));                        \
+    return discMorphology(arr_in, arr_out, width, height, radius, false);                 \
+}                                                                                         \
+                                                                                          \
+LIBEXPORT int vigra_discdilation_##suffix##_c(const type * arr_in,                        \
+                                              const type * arr_out,                       \
+                                              const int width,                            \
+                                              const int height,                           \
+                                              const int radius)                           \
+{                                                                                         \
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(type));                        \
+    return discMorphology(arr_in, arr_out, width, height, radius, true);                  \
+}                                                                                         \
+                                                                                          \
+LIBEXPORT int vigra_morphology_##suffix##_c(const type * arr_in,                          \
+                                            const type * arr_out,                         \
+                                            const int width,                              \
+                                            const int height,                             \
+                                            const int operation,                          \
+                                            const int se_shape,                           \
+                                            const int radius_x,                           \
+                                            const int radius_y)                           \
+{                                                                                         \
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(type));                        \
+    return grayMorphology(arr_in, arr_out, width, height,                                 \
+                          operation, se_shape, radius_x, radius_y);                       \
+}
+
+MORPHOLOGY_TYPED_FUNCTIONS(uint8, UInt8PixelType)
+MORPHOLOGY_TYPED_FUNCTIONS(uint16, UInt16PixelType)
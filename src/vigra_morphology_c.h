@@ -74,6 +74,87 @@ LIBEXPORT int vigra_distancetransform_c(const PixelType * arr_in,
                                         const float background_label,
                                         const int norm);
 
+/**
+ * Computation of the exact Euclidean distance transform.
+ * Other than vigra_distancetransform_c, this function does not wrap VIGRA, but
+ * implements the separable algorithm of Felzenszwalb and Huttenlocher, which
+ * needs linear time w.r.t. the number of pixels and is run in parallel over
+ * columns and rows. It computes the distance of each pixel to the nearest
+ * pixel, which has the given background label. Optionally, the position of
+ * this nearest background pixel is returned as well.
+ * All arrays must have been allocated before the call of this function.
+ *
+ * \param arr_in Flat input array (band) of size width*height.
+ * \param[out] arr_out Flat array (distance transform) of size width*height.
+ *             If there is no background pixel, all distances are set to FLT_MAX.
+ * \param[out] arr_nearest_out Flat array of size width*height, which is filled with
+ *             the flat index y*width+x of the nearest background pixel of each pixel,
+ *             or -1 if there is no background pixel. May be NULL.
+ * \param width The width of the flat array.
+ * \param height The height of the flat array.
+ * \param background_label The intensity of the background.
+ * \param pitch_x The horizontal pixel pitch, which allows for anisotropic pixels.
+ * \param pitch_y The vertical pixel pitch, which allows for anisotropic pixels.
+ *
+ * \return 0 if the distance transform was successful,
+ *         2 if a pixel pitch is not positive,
+ *         1 else.
+ */
+LIBEXPORT int vigra_euclideandistancetransform_c(const PixelType * arr_in,
+                                                 const PixelType * arr_out,
+                                                 int * arr_nearest_out,
+                                                 const int width,
+                                                 const int height,
+                                                 const float background_label,
+                                                 const float pitch_x,
+                                                 const float pitch_y);
+
+/**
+ * Computation of the exact Euclidean distance transform w.r.t. labelled sites.
+ * Each pixel with a label != 0 is a site. This function computes the distance of
+ * each pixel to the nearest site and assigns the label of that site to the pixel.
+ * The result is the (discrete) Voronoi tesselation of the sites, which uses the
+ * same linear time algorithm as vigra_euclideandistancetransform_c.
+ * All arrays must have been allocated before the call of this function.
+ *
+ * \param arr_labels_in Flat input array (labels of the sites) of size width*height.
+ * \param[out] arr_out Flat array (distance transform) of size width*height.
+ *             If there is no site, all distances are set to FLT_MAX.
+ * \param[out] arr_labels_out Flat array (label of the nearest site) of size width*height.
+ *             If there is no site, all labels are set to 0.
+ * \param width The width of the flat array.
+ * \param height The height of the flat array.
+ * \param pitch_x The horizontal pixel pitch, which allows for anisotropic pixels.
+ * \param pitch_y The vertical pixel pitch, which allows for anisotropic pixels.
+ *
+ * \return 0 if the distance transform was successful,
+ *         2 if a pixel pitch is not positive,
+ *         1 else.
+ */
+LIBEXPORT int vigra_voronoidistancetransform_c(const PixelType * arr_labels_in,
+                                               const PixelType * arr_out,
+                                               const PixelType * arr_labels_out,
+                                               const int width,
+                                               const int height,
+                                               const float pitch_x,
+                                               const float pitch_y);
+
+/**
+ * Variant of vigra_voronoidistancetransform_c, which reads the sites from and
+ * writes the labels to flat arrays of LabelType.
+ *
+ * \return 0 if the distance transform was successful,
+ *         2 if a pixel pitch is not positive,
+ *         1 else.
+ */
+LIBEXPORT int vigra_voronoidistancetransform_labels_c(const LabelType * arr_labels_in,
+                                                      const PixelType * arr_out,
+                                                      const LabelType * arr_labels_out,
+                                                      const int width,
+                                                      const int height,
+                                                      const float pitch_x,
+                                                      const float pitch_y);
+
 /**
  * Computation of the morpholgical erosion operator.
  * This function wraps the
@@ -122,6 +203,57 @@ LIBEXPORT int vigra_discdilation_c(const PixelType * arr_in,
                                    const int height,
                                    const int radius);
 
+/**
+ * Computation of the grayscale morphology of an image band with a flat
+ * structuring element. Rectangles and lines are computed by the van Herk/Gil-Werman
+ * algorithm, which costs O(1) per pixel for any size. Octagons are decomposed
+ * into a horizontal, a vertical and two diagonal lines and thus cost O(1) per
+ * pixel, too. Discs are decomposed into their horizontal chords, which costs
+ * O(radius) per pixel. The image is processed in parallel strips.
+ * Pixels outside of the image are ignored, i.e. the structuring element is
+ * cropped at the image border. For the octagon, this holds for each of its
+ * lines separately. The second pass of openings and closings applies the lines
+ * in reverse order, thus openings never exceed and closings never fall below
+ * the image, and the top-hats are never negative.
+ * In contrast to vigra_discerosion_c and vigra_discdilation_c, this works on
+ * the values of the band directly and not only on binary or 8-bit images.
+ * All arrays must have been allocated before the call of this function.
+ *
+ * \param arr_in Flat input array (band) of size width*height.
+ * \param[out] arr_out Flat array (result) of size width*height.
+ * \param width The width of the flat array.
+ * \param height The height of the flat array.
+ * \param operation The morphological operation:
+ *                  0 = erosion,
+ *                  1 = dilation,
+ *                  2 = opening (erosion followed by dilation),
+ *                  3 = closing (dilation followed by erosion),
+ *                  4 = white top-hat (image minus opening),
+ *                  5 = black top-hat (closing minus image).
+ * \param se_shape The structuring element:
+ *                 0 = rectangle of size (2*radius_x+1)x(2*radius_y+1), which includes
+ *                     horizontal (radius_y = 0) and vertical lines (radius_x = 0),
+ *                 1 = diagonal line from top left to bottom right {(i,i) | -radius_x <= i <= radius_x},
+ *                 2 = diagonal line from bottom left to top right {(i,-i) | -radius_x <= i <= radius_x},
+ *                 3 = octagon of radius radius_x,
+ *                 4 = disc of radius radius_x.
+ * \param radius_x The horizontal radius of the rectangle, or the radius of the other elements.
+ * \param radius_y The vertical radius of the rectangle, which is ignored for the other elements.
+ *
+ * \return 0 if the morphological operation was successful,
+ *         3 if the structuring element or its radii are invalid,
+ *         2 if the operation is invalid,
+ *         1 else.
+ */
+LIBEXPORT int vigra_morphology_c(const PixelType * arr_in,
+                                 const PixelType * arr_out,
+                                 const int width,
+                                 const int height,
+                                 const int operation,
+                                 const int se_shape,
+                                 const int radius_x,
+                                 const int radius_y);
+
 /**
  * Computation of the morpholgical upwdind operator.
  * This function wraps the vigra::upwindImage function to C to compute
@@ -145,6 +277,68 @@ LIBEXPORT int vigra_upwindimage_c(const PixelType * arr_in,
                                   const int height,
                                   const float weight);
 
+/**
+ * Defines a preprocessor macro for the interfaces of the typed morphology
+ * functions. These are available for the pixel types UInt8PixelType (suffix uint8)
+ * and UInt16PixelType (suffix uint16). The disc erosion and dilation work on
+ * 8-bit values. Thus, only the uint8 variants avoid a conversion of the input band.
+ */
+#define MORPHOLOGY_TYPED_FUNCTIONS_INTERFACE(suffix, type)                                \
+/**                                                                                       \
+  Typed variant of vigra_distancetransform_c for input bands of the given                 \
+  pixel type. The distances are written to a band of PixelType.                           \
+  The return values are the same as for vigra_distancetransform_c.                        \
+ */                                                                                       \
+LIBEXPORT int vigra_distancetransform_##suffix##_c(const type * arr_in,                   \
+                                                   const PixelType * arr_out,             \
+                                                   const int width,                       \
+                                                   const int height,                      \
+                                                   const type background_label,           \
+                                                   const int norm);                       \
+/**                                                                                       \
+  Typed variant of vigra_euclideandistancetransform_c for input bands of the              \
+  given pixel type. The distances are written to a band of PixelType.                     \
+ */                                                                                       \
+LIBEXPORT int vigra_euclideandistancetransform_##suffix##_c(const type * arr_in,          \
+                                                            const PixelType * arr_out,    \
+                                                            int * arr_nearest_out,        \
+                                                            const int width,              \
+                                                            const int height,             \
+                                                            const type background_label,  \
+                                                            const float pitch_x,          \
+                                                            const float pitch_y);         \
+/**                                                                                       \
+  Typed variant of vigra_discerosion_c.                                                   \
+ */                                                                                       \
+LIBEXPORT int vigra_discerosion_##suffix##_c(const type * arr_in,                         \
+                                             const type * arr_out,                        \
+                                             const int width,                             \
+                                             const int height,                            \
+                                             const int radius);                           \
+/**                                                                                       \
+  Typed variant of vigra_discdilation_c.                                                  \
+ */                                                                                       \
+LIBEXPORT int vigra_discdilation_##suffix##_c(const type * arr_in,                        \
+                                              const type * arr_out,                       \
+                                              const int width,                            \
+                                              const int height,                           \
+                                              const int radius);                          \
+/**                                                                                       \
+  Typed variant of vigra_morphology_c, which works on the given pixel type                \
+  without any conversion.                                                                 \
+ */                                                                                       \
+LIBEXPORT int vigra_morphology_##suffix##_c(const type * arr_in,                          \
+                                            const type * arr_out,                         \
+                                            const int width,                              \
+                                            const int height,                             \
+                                            const int operation,                          \
+                                            const int se_shape,                           \
+                                            const int radius_x,                           \
+                                            const int radius_y);
+
+MORPHOLOGY_TYPED_FUNCTIONS_INTERFACE(uint8, UInt8PixelType)
+MORPHOLOGY_TYPED_FUNCTIONS_INTERFACE(uint16, UInt16PixelType)
+
 /**
  * @}
  */
@@ -0,0 +1,220 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#include "vigra_parallel_c.h"
+#include "vigra_parallelutils_c.h"
+#include "vigra_statsutils_c.h"
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <vector>
+
+
+/**
+ * @file
+ * @brief Implementation of the control of parallel execution
+ */
+
+/**
+ * The requested number of threads (VIGRA's ParallelOptions semantics).
+ */
+static int requested_num_threads = vigra::ParallelOptions::Auto;
+
+/**
+ * The mutex, which guards the requested number of threads and the worker pool.
+ */
+static std::mutex worker_pool_mutex;
+
+/**
+ * The lazily created, library-wide worker pool. It is destroyed when the library
+ * is unloaded, which finishes all pending jobs and joins the worker threads.
+ */
+static std::shared_ptr<vigra::ThreadPool> worker_pool;
+
+/**
+ * The pools, which have been replaced by vigra_set_num_threads_c. Each one is
+ * released by its own reaper thread, which finishes the pending jobs and joins
+ * the workers of the pool. The reapers are joined when the library is unloaded.
+ */
+static std::vector<std::future<void> > retired_pools;
+
+/**
+ * Marks the threads, which currently execute a task of the worker pool.
+ */
+static thread_local bool is_worker_thread = false;
+
+
+WorkerThreadScope::WorkerThreadScope()
+: m_previous(is_worker_thread)
+{
+    is_worker_thread = true;
+}
+
+WorkerThreadScope::~WorkerThreadScope()
+{
+    is_worker_thread = m_previous;
+}
+
+bool WorkerThreadScope::active()
+{
+    return is_worker_thread;
+}
+
+std::shared_ptr<vigra::ThreadPool> threadPool()
+{
+    std::lock_guard<std::mutex> lock(worker_pool_mutex);
+    
+    if(!worker_pool)
+    {
+        //Asynchronous jobs need at least one worker, even if the filters run single-threaded
+        worker_pool = std::make_shared<vigra::ThreadPool>(vigra::ParallelOptions().numThreads(requested_num_threads).getActualNumThreads());
+    }
+    return worker_pool;
+}
+
+int numThreads()
+{
+    if(WorkerThreadScope::active())
+    {
+        return 1;
+    }
+    
+    std::lock_guard<std::mutex> lock(worker_pool_mutex);
+    return vigra::ParallelOptions().numThreads(requested_num_threads).getActualNumThreads();
+}
+
+LIBEXPORT int vigra_set_num_threads_c(const int num_threads)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    std::lock_guard<std::mutex> lock(worker_pool_mutex);
+    
+    if(num_threads < 0)
+    {
+        requested_num_threads = vigra::ParallelOptions::Auto;
+    }
+    else if(num_threads <= 1)
+    {
+        requested_num_threads = vigra::ParallelOptions::NoThreads;
+    }
+    else
+    {
+        requested_num_threads = num_threads;
+    }
+    
+    if(worker_pool)
+    {
+        //Release the reapers of the pools, which have already been joined
+        retired_pools.erase(std::remove_if(retired_pools.begin(), retired_pools.end(),
+                                           [](const std::future<void> & reaper)
+                                           {
+                                               return reaper.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+                                           }),
+                            retired_pools.end());
+        
+        //The previous pool finishes its pending jobs and is joined by a reaper
+        //thread as soon as the last running filter releases it. Thus, this
+        //call does not wait for the pending jobs.
+        retired_pools.push_back(std::async(std::launch::async,
+                                           [](std::shared_ptr<vigra::ThreadPool> previous_pool)
+                                           {
+                                               previous_pool.reset();
+                                           },
+                                           std::move(worker_pool)));
+    }
+    return 0;
+}
+
+LIBEXPORT int vigra_get_num_threads_c()
+{
+    VIGRA_C_STATS_SCOPE(0);
+    return numThreads();
+}
+
+LIBEXPORT int vigra_job_wait_c(void * job)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    if(job == nullptr)
+    {
+        return 1;
+    }
+    
+    Job * job_ptr = (Job *) job;
+    int result = -1;
+    
+    //Cancelled jobs may still be queued, but they will never touch any array
+    if(job_ptr->state->load() != Job::CANCELLED)
+    {
+        result = job_ptr->result.get();
+    }
+    delete job_ptr;
+    return result;
+}
+
+LIBEXPORT int vigra_job_poll_c(void * job)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    if(job == nullptr)
+    {
+        return 2;
+    }
+    
+    Job * job_ptr = (Job *) job;
+    
+    if(    job_ptr->state->load() == Job::CANCELLED
+        || job_ptr->result.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+        return 1;
+    }
+    return 0;
+}
+
+LIBEXPORT int vigra_job_cancel_c(void * job)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    if(job == nullptr)
+    {
+        return 2;
+    }
+    
+    Job * job_ptr = (Job *) job;
+    
+    int expected = Job::PENDING;
+    if(job_ptr->state->compare_exchange_strong(expected, Job::CANCELLED))
+    {
+        return 0;
+    }
+    return 1;
+}
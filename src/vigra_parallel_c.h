@@ -0,0 +1,126 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#ifndef VIGRA_PARALLEL_C_H
+#define VIGRA_PARALLEL_C_H
+
+#include "config.h"
+
+/**
+ * @file
+ * @brief Header file for the control of parallel execution
+ *
+ * @defgroup parallel Parallel execution
+ * @{
+ *    @brief Settings of the library-wide worker pool and handling of asynchronous jobs
+ *
+ * The worker pool is created lazily at the first parallel or asynchronous call
+ * and joined when the library is unloaded. Many time-consuming functions have
+ * an asynchronous variant (with the suffix _async_c), which submits the
+ * computation to the worker pool and immediately returns a job handle.
+ * All arrays passed to such a function need to stay valid until the job has
+ * been finished. Each job handle needs to be released by vigra_job_wait_c.
+ */
+
+/**
+ * Sets the number of worker threads, which are used by the band-wise filters
+ * of vigra_c. These filters split each band into overlapping horizontal strips
+ * and process them concurrently. The results are written directly into the 
+ * output arrays given by the caller.
+ * The worker pool is (re-)created lazily at the next call of such a filter.
+ * This function does not wait for the pending jobs of the previous pool, which
+ * are finished by its workers before they are joined in the background.
+ * Please note, that this function should not be called while other threads
+ * are executing vigra_c functions.
+ *
+ * \param num_threads The number of threads to use:
+ *                    -1 (or any negative number): use all available cores (default),
+ *                     0 or 1: process everything on the caller's thread,
+ *                    >1: use this number of worker threads.
+ *
+ * \return Always 0.
+ */
+LIBEXPORT int vigra_set_num_threads_c(const int num_threads);
+
+/**
+ * Returns the number of threads, which are currently used by the band-wise
+ * filters of vigra_c.
+ *
+ * \return The number of threads (at least 1).
+ */
+LIBEXPORT int vigra_get_num_threads_c();
+
+/**
+ * Waits for an asynchronous job to be finished and releases its handle.
+ * The handle must not be used after the call of this function.
+ *
+ * \param job The job handle, as returned by one of the _async_c functions.
+ *
+ * \return The return value of the corresponding synchronous function,
+ *         -1 if the job has been cancelled before it started, or
+ *         1 if the handle is NULL.
+ */
+LIBEXPORT int vigra_job_wait_c(void * job);
+
+/**
+ * Tells if an asynchronous job has already been finished (or cancelled), thus
+ * if vigra_job_wait_c will return without blocking.
+ *
+ * \param job The job handle, as returned by one of the _async_c functions.
+ *
+ * \return 1 if the job is finished,
+ *         0 if it is still pending or running,
+ *         2 if the handle is NULL.
+ */
+LIBEXPORT int vigra_job_poll_c(void * job);
+
+/**
+ * Cancels an asynchronous job, if it has not been started yet.
+ * Running jobs cannot be interrupted. In any case, the handle still 
+ * needs to be released by vigra_job_wait_c.
+ *
+ * \param job The job handle, as returned by one of the _async_c functions.
+ *
+ * \return 0 if the job has been cancelled,
+ *         1 if it is already running or finished,
+ *         2 if the handle is NULL.
+ */
+LIBEXPORT int vigra_job_cancel_c(void * job);
+
+/**
+ * @}
+ */
+
+#endif
@@ -0,0 +1,389 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#ifndef VIGRA_PARALLELUTILS_H
+#define VIGRA_PARALLELUTILS_H
+
+#include "config.h"
+#include <vigra/threadpool.hxx>
+#include <vigra/bordertreatment.hxx>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+
+/**
+ * @file
+ * @brief Header file for internal parallelization utilities
+ *
+ * @defgroup parallelutils Parallelization utilities
+ * @{
+ *    @brief Internal helpers to run band-wise filters tile-parallel on the library's worker pool
+ */
+
+/**
+ * Internal accessor of the library-wide worker pool. The pool is created lazily
+ * w.r.t. the number of threads set by vigra_set_num_threads_c.
+ *
+ * \return A shared pointer to the current worker pool.
+ */
+std::shared_ptr<vigra::ThreadPool> threadPool();
+
+/**
+ * Internal accessor of the number of threads, which shall be used for tiled processing.
+ * If the caller is already running on a thread of the worker pool, this is 1, 
+ * since nested parallelism might otherwise dead-lock the pool.
+ *
+ * \return The number of threads for tiled processing (at least 1).
+ */
+int numThreads();
+
+/**
+ * Internal marker, which is set for the lifetime of each task on a pool worker.
+ */
+class WorkerThreadScope
+{
+public:
+    WorkerThreadScope();
+    ~WorkerThreadScope();
+    
+    /**
+     * \return True, if the current thread is executing a task of the worker pool.
+     */
+    static bool active();
+    
+private:
+    bool m_previous;
+};
+
+/**
+ * Internal representation of an asynchronous job, which is handed out as an
+ * opaque handle by the _async_c functions.
+ */
+struct Job
+{
+    /**
+     * The possible states of a job.
+     */
+    enum State { PENDING, RUNNING, CANCELLED };
+    
+    /**
+     * The state of the job, which is shared with the task on the worker pool.
+     */
+    std::shared_ptr<std::atomic<int> > state;
+    
+    /**
+     * The (future) return value of the job.
+     */
+    std::future<int> result;
+};
+
+/**
+ * Internal helper to submit a job to the worker pool. 
+ *
+ * \param f The functor, which is called by f() on the worker pool and
+ *          returns the result of the corresponding synchronous function.
+ *
+ * \return An opaque handle to the job, which needs to be released by vigra_job_wait_c.
+ */
+template <class FUNCTOR>
+void * submitJob(FUNCTOR f)
+{
+    Job * job = new Job;
+    job->state = std::make_shared<std::atomic<int> >(Job::PENDING);
+    
+    std::shared_ptr<std::atomic<int> > state = job->state;
+    
+    job->result = threadPool()->enqueue([=](int /*thread_id*/) -> int
+                                        {
+                                            int expected = Job::PENDING;
+                                            if(!state->compare_exchange_strong(expected, Job::RUNNING))
+                                            {
+                                                return -1;
+                                            }
+                                            WorkerThreadScope scope;
+                                            return f();
+                                        });
+    return job;
+}
+
+/**
+ * The minimal height of the core (without halo) of a strip for tiled processing.
+ */
+static const int MIN_STRIP_HEIGHT = 64;
+
+/**
+ * Internal helper to derive the halo size (in pixels) of a Gaussian (derivative)
+ * filter from its std.dev. This matches the kernel radius of VIGRA's Gaussian kernels
+ * with one additional safety pixel.
+ *
+ * \param sigma The std.dev. of the Gaussian.
+ * \param order The order of the derivative.
+ *
+ * \return The halo size for tiled processing.
+ */
+inline int gaussianHalo(double sigma, int order = 0)
+{
+    return int((3.0 + 0.5*order)*sigma + 0.5) + 1;
+}
+
+/**
+ * Internal helper to determine, if a filter with the given border treatment
+ * may be split into strips. For AVOID, the untouched border pixels of the output
+ * must not be overwritten and for WRAP, each strip would need the opposite border.
+ *
+ * \param border_treatment The border treatment mode, according to VIGRA's border treatment modes.
+ *
+ * \return True, if tiled processing yields the same results as processing at once.
+ */
+inline bool isTileable(vigra::BorderTreatmentMode border_treatment)
+{
+    return     border_treatment != vigra::BORDER_TREATMENT_AVOID
+            && border_treatment != vigra::BORDER_TREATMENT_WRAP;
+}
+
+/**
+ * Internal helper to run a functor for all indices [0, count) on the worker pool.
+ * The caller waits until all indices have been processed. Exceptions of the functor
+ * are passed to the caller.
+ *
+ * \param count The number of indices.
+ * \param f The functor, which is called by f(i) for each index i.
+ */
+template <class FUNCTOR>
+void parallelForEach(const int count, FUNCTOR f)
+{
+    if(count == 1 || numThreads() == 1)
+    {
+        for(int i=0; i!=count; ++i)
+        {
+            f(i);
+        }
+        return;
+    }
+    
+    std::shared_ptr<vigra::ThreadPool> pool = threadPool();
+    std::vector<std::future<void> > futures;
+    
+    for(int i=0; i!=count; ++i)
+    {
+        futures.push_back(pool->enqueue([i, &f](int /*thread_id*/)
+                                        {
+                                            WorkerThreadScope scope;
+                                            f(i);
+                                        }));
+    }
+    
+    //Wait for all indices before passing the first exception (if any) 
+    for(auto & fut : futures)
+    {
+        fut.wait();
+    }
+    for(auto & fut : futures)
+    {
+        fut.get();
+    }
+}
+
+/**
+ * Internal helper to run a functor for disjoint row ranges [y0, y1) of an image
+ * of a given height on the worker pool. The caller waits until all ranges have
+ * been processed. Exceptions of the functor are passed to the caller.
+ *
+ * \param height The height of the image.
+ * \param min_rows The minimal number of rows per range.
+ * \param f The functor, which is called by f(y0, y1).
+ */
+template <class FUNCTOR>
+void parallelRows(const int height, const int min_rows, FUNCTOR f)
+{
+    int strips  = std::max(1, std::min(numThreads(), height/std::max(1, min_rows)));
+    
+    parallelForEach(strips,
+                    [&](int s)
+                    {
+                        f((s*height)/strips, ((s+1)*height)/strips);
+                    });
+}
+
+/**
+ * Internal helper to determine, if the memory of two image views may overlap,
+ * e.g. if a filter is called in place with the same array as input and output.
+ */
+inline bool viewsOverlap(const ImageView & a, const ImageView & b)
+{
+    if(a.size() == 0 || b.size() == 0)
+    {
+        return false;
+    }
+    const PixelType * a_begin = a.data(),
+                    * a_end   = &a(a.width()-1, a.height()-1) + 1,
+                    * b_begin = b.data(),
+                    * b_end   = &b(b.width()-1, b.height()-1) + 1;
+    
+    return std::less<const PixelType *>()(a_begin, b_end) && std::less<const PixelType *>()(b_begin, a_end);
+}
+
+/**
+ * Internal helper to run a band-wise filter tile-parallel. The input band is split
+ * into horizontal strips, which are extended by a halo of rows on both sides.
+ * Each strip is filtered into a temporary of strip size and only its core rows
+ * are written back into the output bands. Thus, no full-sized copy of any band
+ * is needed. If an output band shares its memory with the input band (in-place
+ * filtering), the core rows are written back after all strips have been filtered,
+ * since other strips may still read them as their halo. If only one thread is
+ * available or the image is too small, the filter is applied to the whole band at once.
+ *
+ * \param img_in The input band.
+ * \param imgs_out The output bands, which need to have the same shape as the input band.
+ * \param halo The number of additional rows needed by the filter on each side of a strip, e.g.
+ *             the radius of the filter's kernel.
+ * \param f The filter functor, which is called by f(strip_in, strips_out) with strips_out
+ *          being a pointer to the first of imgs_out.size() output views.
+ */
+template <class FUNCTOR>
+void tiledFilter(const ImageView & img_in, std::vector<ImageView> imgs_out, const int halo, FUNCTOR f)
+{
+    const int width  = img_in.width(),
+              height = img_in.height(),
+              min_rows = std::max(MIN_STRIP_HEIGHT, 2*halo);
+    
+    int threads = numThreads();
+    
+    if (threads == 1 || height < 2*min_rows)
+    {
+        f(img_in, imgs_out.data());
+        return;
+    }
+    
+    bool in_place = false;
+    for(const ImageView & img_out : imgs_out)
+    {
+        in_place = in_place || viewsOverlap(img_in, img_out);
+    }
+    
+    const int strips = std::max(1, std::min(threads, height/min_rows));
+    
+    //The filtered strips are kept until all strips are done for in-place filtering
+    std::vector<std::vector<vigra::MultiArray<2, PixelType> > > strips_out(strips);
+    
+    auto copyBack = [&](int s)
+                    {
+                        const int y0 = (s*height)/strips,
+                                  y1 = ((s+1)*height)/strips,
+                                  ya = std::max(0, y0-halo);
+                        
+                        for(unsigned int i=0; i!=imgs_out.size(); ++i)
+                        {
+                            imgs_out[i].subarray(vigra::Shape2(0, y0), vigra::Shape2(width, y1))
+                                = strips_out[s][i].subarray(vigra::Shape2(0, y0-ya), vigra::Shape2(width, y1-ya));
+                        }
+                        strips_out[s].clear();
+                    };
+    
+    parallelForEach(strips,
+                    [&](int s)
+                    {
+                        const int y0 = (s*height)/strips,
+                                  y1 = ((s+1)*height)/strips,
+                                  ya = std::max(0, y0-halo),
+                                  yb = std::min(height, y1+halo);
+                        
+                        ImageView strip_in = img_in.subarray(vigra::Shape2(0, ya), vigra::Shape2(width, yb));
+                        
+                        strips_out[s].resize(imgs_out.size());
+                        std::vector<ImageView> strips_out_views;
+                        
+                        for(auto & strip_out : strips_out[s])
+                        {
+                            strip_out.reshape(strip_in.shape());
+                            strips_out_views.push_back(strip_out);
+                        }
+                        
+                        f(strip_in, strips_out_views.data());
+                        
+                        //Copy the core rows back to the output bands
+                        if(!in_place)
+                        {
+                            copyBack(s);
+                        }
+                    });
+    
+    if(in_place)
+    {
+        parallelForEach(strips, copyBack);
+    }
+}
+
+/**
+ * Internal helper to run a band-wise filter on multiple bands in parallel.
+ * If there are at least as many bands as threads, each band is filtered at once
+ * by one thread. Otherwise, the bands are filtered one after another, but each one
+ * tile-parallel (see tiledFilter).
+ *
+ * \param imgs_in The input bands.
+ * \param imgs_out The output bands, ordered by band: [band][output].
+ * \param halo The number of additional rows needed by the filter on each side of a strip.
+ * \param f The filter functor, which is called by f(in, outs) like for tiledFilter.
+ */
+template <class FUNCTOR>
+void tiledBandsFilter(const std::vector<ImageView> & imgs_in, std::vector<std::vector<ImageView> > imgs_out, const int halo, FUNCTOR f)
+{
+    const int num_bands = imgs_in.size();
+    
+    if(num_bands >= numThreads())
+    {
+        parallelForEach(num_bands,
+                        [&](int b)
+                        {
+                            f(imgs_in[b], imgs_out[b].data());
+                        });
+    }
+    else
+    {
+        for(int b=0; b!=num_bands; ++b)
+        {
+            tiledFilter(imgs_in[b], imgs_out[b], halo, f);
+        }
+    }
+}
+
+/**
+ * @}
+ */
+ 
+#endif
@@ -0,0 +1,95 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#include "vigra_pixelkernels_c.h"
+
+/**
+ * @file
+ * @brief AVX2 implementation of the pixel kernels
+ *
+ * This file is compiled with VIGRA_C_AVX2 defined and the AVX2 instruction set
+ * enabled on x86 platforms only. The kernels are selected at runtime, if the
+ * CPU supports AVX2.
+ */
+
+#ifdef VIGRA_C_AVX2
+
+#include <immintrin.h>
+#include "vigra_pixelkernelsimpl_c.h"
+
+/**
+ * Wrapper of the AVX2 intrinsics for the generic pixel kernels.
+ */
+struct SIMDAVX2
+{
+    typedef __m256 Vector;
+    
+    static const std::size_t SIZE = 8;
+    
+    static inline Vector load(const PixelType * p)            { return _mm256_loadu_ps(p); }
+    static inline void   store(PixelType * p, Vector v)       { _mm256_storeu_ps(p, v); }
+    static inline Vector set1(PixelType v)                    { return _mm256_set1_ps(v); }
+    static inline Vector add(Vector a, Vector b)              { return _mm256_add_ps(a, b); }
+    static inline Vector sub(Vector a, Vector b)              { return _mm256_sub_ps(a, b); }
+    static inline Vector mul(Vector a, Vector b)              { return _mm256_mul_ps(a, b); }
+    static inline Vector div(Vector a, Vector b)              { return _mm256_div_ps(a, b); }
+    static inline Vector lessSelect(Vector a, Vector b)       { return _mm256_min_ps(a, b); }
+    static inline Vector greaterSelect(Vector a, Vector b)    { return _mm256_max_ps(a, b); }
+    
+    typedef __m256d DoubleVector;
+    
+    static const std::size_t DOUBLE_SIZE = 4;
+    
+    static inline DoubleVector loadDouble(const PixelType * p)                 { return _mm256_cvtps_pd(_mm_loadu_ps(p)); }
+    static inline void         storeFloat(PixelType * p, DoubleVector v)       { _mm_storeu_ps(p, _mm256_cvtpd_ps(v)); }
+    static inline DoubleVector set1Double(double v)                            { return _mm256_set1_pd(v); }
+    static inline DoubleVector addDouble(DoubleVector a, DoubleVector b)       { return _mm256_add_pd(a, b); }
+    static inline DoubleVector mulDouble(DoubleVector a, DoubleVector b)       { return _mm256_mul_pd(a, b); }
+};
+
+const PixelKernels * pixelKernelsAVX2()
+{
+    static const PixelKernels kernels = PixelKernelsImpl<SIMDAVX2>::table("AVX2");
+    return &kernels;
+}
+
+#else
+
+const PixelKernels * pixelKernelsAVX2()
+{
+    return nullptr;
+}
+
+#endif
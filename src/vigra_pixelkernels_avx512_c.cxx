@@ -0,0 +1,95 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#include "vigra_pixelkernels_c.h"
+
+/**
+ * @file
+ * @brief AVX-512 implementation of the pixel kernels
+ *
+ * This file is compiled with VIGRA_C_AVX512 defined and the AVX-512
+ * instruction set enabled on x86 platforms only. The kernels are selected at
+ * runtime, if the CPU supports AVX-512F.
+ */
+
+#ifdef VIGRA_C_AVX512
+
+#include <immintrin.h>
+#include "vigra_pixelkernelsimpl_c.h"
+
+/**
+ * Wrapper of the AVX-512 intrinsics for the generic pixel kernels.
+ */
+struct SIMDAVX512
+{
+    typedef __m512 Vector;
+    
+    static const std::size_t SIZE = 16;
+    
+    static inline Vector load(const PixelType * p)            { return _mm512_loadu_ps(p); }
+    static inline void   store(PixelType * p, Vector v)       { _mm512_storeu_ps(p, v); }
+    static inline Vector set1(PixelType v)                    { return _mm512_set1_ps(v); }
+    static inline Vector add(Vector a, Vector b)              { return _mm512_add_ps(a, b); }
+    static inline Vector sub(Vector a, Vector b)              { return _mm512_sub_ps(a, b); }
+    static inline Vector mul(Vector a, Vector b)              { return _mm512_mul_ps(a, b); }
+    static inline Vector div(Vector a, Vector b)              { return _mm512_div_ps(a, b); }
+    static inline Vector lessSelect(Vector a, Vector b)       { return _mm512_min_ps(a, b); }
+    static inline Vector greaterSelect(Vector a, Vector b)    { return _mm512_max_ps(a, b); }
+    
+    typedef __m512d DoubleVector;
+    
+    static const std::size_t DOUBLE_SIZE = 8;
+    
+    static inline DoubleVector loadDouble(const PixelType * p)                 { return _mm512_cvtps_pd(_mm256_loadu_ps(p)); }
+    static inline void         storeFloat(PixelType * p, DoubleVector v)       { _mm256_storeu_ps(p, _mm512_cvtpd_ps(v)); }
+    static inline DoubleVector set1Double(double v)                            { return _mm512_set1_pd(v); }
+    static inline DoubleVector addDouble(DoubleVector a, DoubleVector b)       { return _mm512_add_pd(a, b); }
+    static inline DoubleVector mulDouble(DoubleVector a, DoubleVector b)       { return _mm512_mul_pd(a, b); }
+};
+
+const PixelKernels * pixelKernelsAVX512()
+{
+    static const PixelKernels kernels = PixelKernelsImpl<SIMDAVX512>::table("AVX-512");
+    return &kernels;
+}
+
+#else
+
+const PixelKernels * pixelKernelsAVX512()
+{
+    return nullptr;
+}
+
+#endif
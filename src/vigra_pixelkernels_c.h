@@ -0,0 +1,245 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#ifndef VIGRA_PIXELKERNELS_H
+#define VIGRA_PIXELKERNELS_H
+
+#include "config.h"
+#include <cstddef>
+
+/**
+ * @file
+ * @brief Header-only file for the pixel-wise and line convolution kernels
+ *
+ * @defgroup pixelkernels Pixel kernels
+ * @{
+ *    @brief Internal scalar and vectorized kernels of clipping, arithmetic and line convolution (Header-only file)
+ *
+ * The kernels work on contiguous float arrays. Like the ARGB conversion kernels,
+ * the vectorized kernels are implemented in separate translation units, which
+ * are compiled with the needed instruction set flags. The clipping and 
+ * arithmetic kernels compute the same results as the scalar kernels. Like
+ * VIGRA's convolution with vigra::Kernel1D<double>, the line and row convolutions
+ * take double weights, accumulate the products in double, and sum them up in
+ * the same order as VIGRA. Only the results are rounded to float.
+ */
+
+/**
+ * The signature of the pixel-wise arithmetic kernels of two arrays.
+ */
+typedef void (*BinaryPixelKernel)(const PixelType * in1, const PixelType * in2, PixelType * out, std::size_t size);
+
+/**
+ * The signature of the pixel-wise arithmetic kernels of an array and a value.
+ */
+typedef void (*ValuePixelKernel)(const PixelType * in, PixelType value, PixelType * out, std::size_t size);
+
+/**
+ * Internal table of the pixel kernels of one instruction set.
+ * Each kernel processes size pixels.
+ */
+struct PixelKernels
+{
+    /** The name of the instruction set. */
+    const char * name;
+    
+    /** out = min(max(in, low), upp), with NaNs passed through like vigra::min/max. */
+    void (*clip)(const PixelType * in, PixelType * out, std::size_t size, PixelType low, PixelType upp);
+    
+    BinaryPixelKernel add;
+    BinaryPixelKernel subtract;
+    BinaryPixelKernel multiply;
+    BinaryPixelKernel divide;
+    
+    ValuePixelKernel add_value;
+    ValuePixelKernel multiply_value;
+    
+    /**
+     * Correlates a padded line with a kernel: out[i] = sum_j kernel[j]*in[i+j].
+     * The input line has size+kernel_size-1 elements. This is NULL for the
+     * scalar kernels, since VIGRA's convolution is used instead.
+     */
+    void (*convolve_line)(const PixelType * in, PixelType * out, std::size_t size,
+                          const double * kernel, std::size_t kernel_size);
+    
+    /**
+     * Combines kernel_size rows column-wise: out[i] = sum_j kernel[j]*rows[j][i].
+     * Thus, adjacent columns are convolved vertically at once. This is NULL
+     * for the scalar kernels, since VIGRA's convolution is used instead.
+     */
+    void (*convolve_rows)(const PixelType * const * rows, PixelType * out, std::size_t size,
+                          const double * kernel, std::size_t kernel_size);
+};
+
+/**
+ * Scalar reference kernel of the clipping, the same as vigra::max(vigra::min(v, upp), low).
+ */
+static inline void clipScalar(const PixelType * in, PixelType * out, std::size_t size, PixelType low, PixelType upp)
+{
+    for(std::size_t i=0; i!=size; ++i)
+    {
+        PixelType v = upp < in[i] ? upp : in[i];
+        out[i] = v < low ? low : v;
+    }
+}
+
+/**
+ * Scalar reference kernel of the pixel-wise addition.
+ */
+static inline void addScalar(const PixelType * in1, const PixelType * in2, PixelType * out, std::size_t size)
+{
+    for(std::size_t i=0; i!=size; ++i)
+    {
+        out[i] = in1[i] + in2[i];
+    }
+}
+
+/**
+ * Scalar reference kernel of the pixel-wise subtraction.
+ */
+static inline void subtractScalar(const PixelType * in1, const PixelType * in2, PixelType * out, std::size_t size)
+{
+    for(std::size_t i=0; i!=size; ++i)
+    {
+        out[i] = in1[i] - in2[i];
+    }
+}
+
+/**
+ * Scalar reference kernel of the pixel-wise multiplication.
+ */
+static inline void multiplyScalar(const PixelType * in1, const PixelType * in2, PixelType * out, std::size_t size)
+{
+    for(std::size_t i=0; i!=size; ++i)
+    {
+        out[i] = in1[i] * in2[i];
+    }
+}
+
+/**
+ * Scalar reference kernel of the pixel-wise division.
+ */
+static inline void divideScalar(const PixelType * in1, const PixelType * in2, PixelType * out, std::size_t size)
+{
+    for(std::size_t i=0; i!=size; ++i)
+    {
+        out[i] = in1[i] / in2[i];
+    }
+}
+
+/**
+ * Scalar reference kernel of the addition of a value.
+ */
+static inline void addValueScalar(const PixelType * in, PixelType value, PixelType * out, std::size_t size)
+{
+    for(std::size_t i=0; i!=size; ++i)
+    {
+        out[i] = in[i] + value;
+    }
+}
+
+/**
+ * Scalar reference kernel of the multiplication with a value.
+ */
+static inline void multiplyValueScalar(const PixelType * in, PixelType value, PixelType * out, std::size_t size)
+{
+    for(std::size_t i=0; i!=size; ++i)
+    {
+        out[i] = in[i] * value;
+    }
+}
+
+/**
+ * Scalar kernel of the line convolution, which is used for the remaining
+ * pixels of the vectorized line convolutions.
+ */
+static inline void convolveLineScalar(const PixelType * in, PixelType * out, std::size_t size,
+                               const double * kernel, std::size_t kernel_size)
+{
+    for(std::size_t i=0; i!=size; ++i)
+    {
+        double sum = 0;
+        for(std::size_t j=0; j!=kernel_size; ++j)
+        {
+            sum += kernel[j]*in[i+j];
+        }
+        out[i] = (PixelType)sum;
+    }
+}
+
+/**
+ * Scalar kernel of the column-wise row combination, which is used for the
+ * remaining pixels of the vectorized row combinations. It processes the
+ * columns [begin, size).
+ */
+static inline void convolveRowsScalar(const PixelType * const * rows, PixelType * out, std::size_t size,
+                                      const double * kernel, std::size_t kernel_size, std::size_t begin = 0)
+{
+    for(std::size_t i=begin; i<size; ++i)
+    {
+        double sum = 0;
+        for(std::size_t j=0; j!=kernel_size; ++j)
+        {
+            sum += kernel[j]*rows[j][i];
+        }
+        out[i] = (PixelType)sum;
+    }
+}
+
+/**
+ * Returns the SSE2 kernels, or NULL if they have not been compiled.
+ */
+const PixelKernels * pixelKernelsSSE2();
+
+/**
+ * Returns the AVX2 kernels, or NULL if they have not been compiled.
+ */
+const PixelKernels * pixelKernelsAVX2();
+
+/**
+ * Returns the AVX-512 kernels, or NULL if they have not been compiled.
+ */
+const PixelKernels * pixelKernelsAVX512();
+
+/**
+ * Returns the NEON kernels, or NULL if they have not been compiled.
+ */
+const PixelKernels * pixelKernelsNEON();
+
+/**
+ * @}
+ */
+
+#endif
@@ -0,0 +1,94 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#include "vigra_pixelkernels_c.h"
+
+/**
+ * @file
+ * @brief NEON implementation of the pixel kernels
+ *
+ * This file is compiled with VIGRA_C_NEON defined and the NEON instruction set
+ * enabled on 64-bit ARM platforms only. NEON is part of every 64-bit ARM CPU.
+ */
+
+#ifdef VIGRA_C_NEON
+
+#include <arm_neon.h>
+#include "vigra_pixelkernelsimpl_c.h"
+
+/**
+ * Wrapper of the NEON intrinsics for the generic pixel kernels.
+ */
+struct SIMDNEON
+{
+    typedef float32x4_t Vector;
+    
+    static const std::size_t SIZE = 4;
+    
+    static inline Vector load(const PixelType * p)            { return vld1q_f32(p); }
+    static inline void   store(PixelType * p, Vector v)       { vst1q_f32(p, v); }
+    static inline Vector set1(PixelType v)                    { return vdupq_n_f32(v); }
+    static inline Vector add(Vector a, Vector b)              { return vaddq_f32(a, b); }
+    static inline Vector sub(Vector a, Vector b)              { return vsubq_f32(a, b); }
+    static inline Vector mul(Vector a, Vector b)              { return vmulq_f32(a, b); }
+    static inline Vector div(Vector a, Vector b)              { return vdivq_f32(a, b); }
+    static inline Vector lessSelect(Vector a, Vector b)       { return vbslq_f32(vcltq_f32(a, b), a, b); }
+    static inline Vector greaterSelect(Vector a, Vector b)    { return vbslq_f32(vcgtq_f32(a, b), a, b); }
+    
+    typedef float64x2_t DoubleVector;
+    
+    static const std::size_t DOUBLE_SIZE = 2;
+    
+    static inline DoubleVector loadDouble(const PixelType * p)                 { return vcvt_f64_f32(vld1_f32(p)); }
+    static inline void         storeFloat(PixelType * p, DoubleVector v)       { vst1_f32(p, vcvt_f32_f64(v)); }
+    static inline DoubleVector set1Double(double v)                            { return vdupq_n_f64(v); }
+    static inline DoubleVector addDouble(DoubleVector a, DoubleVector b)       { return vaddq_f64(a, b); }
+    static inline DoubleVector mulDouble(DoubleVector a, DoubleVector b)       { return vmulq_f64(a, b); }
+};
+
+const PixelKernels * pixelKernelsNEON()
+{
+    static const PixelKernels kernels = PixelKernelsImpl<SIMDNEON>::table("NEON");
+    return &kernels;
+}
+
+#else
+
+const PixelKernels * pixelKernelsNEON()
+{
+    return nullptr;
+}
+
+#endif
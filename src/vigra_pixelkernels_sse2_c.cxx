@@ -0,0 +1,95 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#include "vigra_pixelkernels_c.h"
+
+/**
+ * @file
+ * @brief SSE2 implementation of the pixel kernels
+ *
+ * This file is compiled with VIGRA_C_SSE2 defined and the SSE2 instruction set
+ * enabled on x86 platforms only. The kernels are selected at runtime, if the
+ * CPU supports SSE2.
+ */
+
+#ifdef VIGRA_C_SSE2
+
+#include <emmintrin.h>
+#include "vigra_pixelkernelsimpl_c.h"
+
+/**
+ * Wrapper of the SSE2 intrinsics for the generic pixel kernels.
+ */
+struct SIMDSSE2
+{
+    typedef __m128 Vector;
+    
+    static const std::size_t SIZE = 4;
+    
+    static inline Vector load(const PixelType * p)            { return _mm_loadu_ps(p); }
+    static inline void   store(PixelType * p, Vector v)       { _mm_storeu_ps(p, v); }
+    static inline Vector set1(PixelType v)                    { return _mm_set1_ps(v); }
+    static inline Vector add(Vector a, Vector b)              { return _mm_add_ps(a, b); }
+    static inline Vector sub(Vector a, Vector b)              { return _mm_sub_ps(a, b); }
+    static inline Vector mul(Vector a, Vector b)              { return _mm_mul_ps(a, b); }
+    static inline Vector div(Vector a, Vector b)              { return _mm_div_ps(a, b); }
+    static inline Vector lessSelect(Vector a, Vector b)       { return _mm_min_ps(a, b); }
+    static inline Vector greaterSelect(Vector a, Vector b)    { return _mm_max_ps(a, b); }
+    
+    typedef __m128d DoubleVector;
+    
+    static const std::size_t DOUBLE_SIZE = 2;
+    
+    static inline DoubleVector loadDouble(const PixelType * p)                 { return _mm_cvtps_pd(_mm_castpd_ps(_mm_load_sd((const double *)p))); }
+    static inline void         storeFloat(PixelType * p, DoubleVector v)       { _mm_storel_pi((__m64 *)p, _mm_cvtpd_ps(v)); }
+    static inline DoubleVector set1Double(double v)                            { return _mm_set1_pd(v); }
+    static inline DoubleVector addDouble(DoubleVector a, DoubleVector b)       { return _mm_add_pd(a, b); }
+    static inline DoubleVector mulDouble(DoubleVector a, DoubleVector b)       { return _mm_mul_pd(a, b); }
+};
+
+const PixelKernels * pixelKernelsSSE2()
+{
+    static const PixelKernels kernels = PixelKernelsImpl<SIMDSSE2>::table("SSE2");
+    return &kernels;
+}
+
+#else
+
+const PixelKernels * pixelKernelsSSE2()
+{
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,208 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#ifndef VIGRA_PIXELKERNELSIMPL_H
+#define VIGRA_PIXELKERNELSIMPL_H
+
+#include "vigra_pixelkernels_c.h"
+
+/**
+ * @file
+ * @brief Header-only file for the generic implementation of the vectorized pixel kernels
+ *
+ * @addtogroup pixelkernels
+ * @{
+ */
+
+/**
+ * Internal generic implementation of the vectorized pixel kernels. The
+ * template argument wraps the intrinsics of one instruction set:
+ * - Vector: the register type of SIZE floats,
+ * - load, store, set1: unaligned memory access and broadcast,
+ * - add, sub, mul, div: the arithmetic operations,
+ * - lessSelect(a, b): a < b ? a : b,
+ * - greaterSelect(a, b): a > b ? a : b,
+ * - DoubleVector: the register type of DOUBLE_SIZE = SIZE/2 doubles,
+ * - loadDouble, storeFloat: load DOUBLE_SIZE floats as doubles and store
+ *   DOUBLE_SIZE doubles rounded to floats,
+ * - set1Double, addDouble, mulDouble: broadcast and arithmetic of doubles.
+ *
+ * This header must only be included by the translation units, which are
+ * compiled with the corresponding instruction set flags.
+ */
+template <class SIMD>
+struct PixelKernelsImpl
+{
+    typedef typename SIMD::Vector Vector;
+    
+    static void clip(const PixelType * in, PixelType * out, std::size_t size, PixelType low, PixelType upp)
+    {
+        const Vector l = SIMD::set1(low), u = SIMD::set1(upp);
+        std::size_t i = 0;
+        
+        for( ; i + SIMD::SIZE <= size; i += SIMD::SIZE)
+        {
+            SIMD::store(out+i, SIMD::greaterSelect(l, SIMD::lessSelect(u, SIMD::load(in+i))));
+        }
+        clipScalar(in+i, out+i, size-i, low, upp);
+    }
+    
+    typedef void (*BinaryKernel)(const PixelType *, const PixelType *, PixelType *, std::size_t);
+    
+    template <Vector (*OP)(Vector, Vector), BinaryKernel TAIL>
+    static void binary(const PixelType * in1, const PixelType * in2, PixelType * out, std::size_t size)
+    {
+        std::size_t i = 0;
+        
+        for( ; i + SIMD::SIZE <= size; i += SIMD::SIZE)
+        {
+            SIMD::store(out+i, OP(SIMD::load(in1+i), SIMD::load(in2+i)));
+        }
+        TAIL(in1+i, in2+i, out+i, size-i);
+    }
+    
+    static void add(const PixelType * in1, const PixelType * in2, PixelType * out, std::size_t size)
+    {
+        binary<SIMD::add, addScalar>(in1, in2, out, size);
+    }
+    
+    static void subtract(const PixelType * in1, const PixelType * in2, PixelType * out, std::size_t size)
+    {
+        binary<SIMD::sub, subtractScalar>(in1, in2, out, size);
+    }
+    
+    static void multiply(const PixelType * in1, const PixelType * in2, PixelType * out, std::size_t size)
+    {
+        binary<SIMD::mul, multiplyScalar>(in1, in2, out, size);
+    }
+    
+    static void divide(const PixelType * in1, const PixelType * in2, PixelType * out, std::size_t size)
+    {
+        binary<SIMD::div, divideScalar>(in1, in2, out, size);
+    }
+    
+    static void addValue(const PixelType * in, PixelType value, PixelType * out, std::size_t size)
+    {
+        const Vector v = SIMD::set1(value);
+        std::size_t i = 0;
+        
+        for( ; i + SIMD::SIZE <= size; i += SIMD::SIZE)
+        {
+            SIMD::store(out+i, SIMD::add(SIMD::load(in+i), v));
+        }
+        addValueScalar(in+i, value, out+i, size-i);
+    }
+    
+    static void multiplyValue(const PixelType * in, PixelType value, PixelType * out, std::size_t size)
+    {
+        const Vector v = SIMD::set1(value);
+        std::size_t i = 0;
+        
+        for( ; i + SIMD::SIZE <= size; i += SIMD::SIZE)
+        {
+            SIMD::store(out+i, SIMD::mul(SIMD::load(in+i), v));
+        }
+        multiplyValueScalar(in+i, value, out+i, size-i);
+    }
+    
+    static void convolveLine(const PixelType * in, PixelType * out, std::size_t size,
+                             const double * kernel, std::size_t kernel_size)
+    {
+        typedef typename SIMD::DoubleVector DoubleVector;
+        const std::size_t D = SIMD::DOUBLE_SIZE;
+        std::size_t i = 0;
+        
+        //Four independent accumulators of doubles hide the latency of the additions
+        for( ; i + 4*D <= size; i += 4*D)
+        {
+            DoubleVector sum0 = SIMD::set1Double(0), sum1 = SIMD::set1Double(0),
+                         sum2 = SIMD::set1Double(0), sum3 = SIMD::set1Double(0);
+            for(std::size_t j=0; j!=kernel_size; ++j)
+            {
+                const DoubleVector k = SIMD::set1Double(kernel[j]);
+                const PixelType * src = in+i+j;
+                sum0 = SIMD::addDouble(sum0, SIMD::mulDouble(k, SIMD::loadDouble(src)));
+                sum1 = SIMD::addDouble(sum1, SIMD::mulDouble(k, SIMD::loadDouble(src+D)));
+                sum2 = SIMD::addDouble(sum2, SIMD::mulDouble(k, SIMD::loadDouble(src+2*D)));
+                sum3 = SIMD::addDouble(sum3, SIMD::mulDouble(k, SIMD::loadDouble(src+3*D)));
+            }
+            SIMD::storeFloat(out+i, sum0);
+            SIMD::storeFloat(out+i+D, sum1);
+            SIMD::storeFloat(out+i+2*D, sum2);
+            SIMD::storeFloat(out+i+3*D, sum3);
+        }
+        convolveLineScalar(in+i, out+i, size-i, kernel, kernel_size);
+    }
+    
+    static void convolveRows(const PixelType * const * rows, PixelType * out, std::size_t size,
+                             const double * kernel, std::size_t kernel_size)
+    {
+        typedef typename SIMD::DoubleVector DoubleVector;
+        const std::size_t D = SIMD::DOUBLE_SIZE;
+        std::size_t i = 0;
+        
+        for( ; i + 4*D <= size; i += 4*D)
+        {
+            DoubleVector sum0 = SIMD::set1Double(0), sum1 = SIMD::set1Double(0),
+                         sum2 = SIMD::set1Double(0), sum3 = SIMD::set1Double(0);
+            for(std::size_t j=0; j!=kernel_size; ++j)
+            {
+                const DoubleVector k = SIMD::set1Double(kernel[j]);
+                const PixelType * src = rows[j]+i;
+                sum0 = SIMD::addDouble(sum0, SIMD::mulDouble(k, SIMD::loadDouble(src)));
+                sum1 = SIMD::addDouble(sum1, SIMD::mulDouble(k, SIMD::loadDouble(src+D)));
+                sum2 = SIMD::addDouble(sum2, SIMD::mulDouble(k, SIMD::loadDouble(src+2*D)));
+                sum3 = SIMD::addDouble(sum3, SIMD::mulDouble(k, SIMD::loadDouble(src+3*D)));
+            }
+            SIMD::storeFloat(out+i, sum0);
+            SIMD::storeFloat(out+i+D, sum1);
+            SIMD::storeFloat(out+i+2*D, sum2);
+            SIMD::storeFloat(out+i+3*D, sum3);
+        }
+        convolveRowsScalar(rows, out, size, kernel, kernel_size, i);
+    }
+    
+    static PixelKernels table(const char * name)
+    {
+        PixelKernels kernels = { name, clip, add, subtract, multiply, divide, addValue, multiplyValue, convolveLine, convolveRows };
+        return kernels;
+    }
+};
+
+/**
+ * @}
+ */
+
+#endif
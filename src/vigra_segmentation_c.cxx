@@ -33,6 +33,9 @@
 /************************************************************************/
 
 #include "vigra_segmentation_c.h"
+#include "vigra_arenautils_c.h"
+#include "vigra_parallelutils_c.h"
+#include "vigra_statsutils_c.h"
 #include <iostream> //needed by labelVolume, which is needed by localMinMax
 #include <vigra/labelimage.hxx>
 #include <vigra/watersheds.hxx>
@@ -40,7 +43,14 @@
 #include <vigra/accumulator.hxx>
 #include <vigra/slic.hxx>
 #include <vigra/colorconversions.hxx>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 
 /**
@@ -50,23 +60,328 @@
 
 static const unsigned long long MAX_FLOAT_INTEGER = pow(2, std::numeric_limits<float>::digits-1)*2;
 
+/** The minimal number of rows of each strip of the block-parallel labeling. */
+static const int LABELING_MIN_STRIP_HEIGHT = 64;
+
+/**
+ * Internal helper to find the root of a label in a union-find forest, where
+ * each parent is not larger than its child. Compresses the path by halving.
+ */
+inline LabelType findLabelRoot(std::vector<LabelType> & parent, LabelType l)
+{
+    while(parent[l] != l)
+    {
+        parent[l] = parent[parent[l]];
+        l = parent[l];
+    }
+    return l;
+}
+
+/**
+ * Internal helper to unite two labels of a union-find forest. The smaller root
+ * becomes the root of the union, which is returned.
+ */
+inline LabelType uniteLabels(std::vector<LabelType> & parent, LabelType a, LabelType b)
+{
+    a = findLabelRoot(parent, a);
+    b = findLabelRoot(parent, b);
+    if(a < b)
+    {
+        parent[b] = a;
+        return a;
+    }
+    parent[a] = b;
+    return b;
+}
+
+/**
+ * Internal helper for the block-parallel connected component labeling of each
+ * pixel type. The image is split into horizontal strips, which are labeled in
+ * parallel by a union-find scan with strip-local provisional labels. Then, the
+ * provisional labels of all strips are mapped to one forest, the components
+ * are merged along the seams of the strips and the roots are numbered. Since
+ * the smallest provisional label of each component becomes its root, the
+ * final labels are assigned in scan order - exactly like vigra::labelImage.
+ *
+ * \param img_in The input band.
+ * \param labels The output labels, which need to have the same shape as the input band.
+ * \param eight_connectivity If set to true, 8-conectivity is used, else 4.
+ * \param use_background If set to true, pixels with the background intensity get label 0.
+ * \param background Intensity value of the background.
+ *
+ * \return The largest label assigned.
+ */
+template <class T>
+LabelType parallelLabelImage(const vigra::MultiArrayView<2, T> & img_in,
+                             vigra::MultiArrayView<2, LabelType> & labels,
+                             const bool eight_connectivity,
+                             const bool use_background,
+                             const T background)
+{
+    const int width  = (int)img_in.width(),
+              height = (int)img_in.height(),
+              strips = std::max(1, std::min(numThreads(), height/LABELING_MIN_STRIP_HEIGHT));
+    
+    auto stripBegin = [&](int s) { return int((std::size_t(s)*height)/strips); };
+    
+    //Phase 1: Label each strip with local provisional labels
+    std::vector<std::vector<LabelType> > local_parents(strips);
+    
+    parallelForEach(strips,
+                    [&](int s)
+                    {
+                        const int y0 = stripBegin(s),
+                                  y1 = stripBegin(s+1);
+                        std::vector<LabelType> & parent = local_parents[s];
+                        parent.assign(1, 0);
+                        
+                        for(int y=y0; y<y1; ++y)
+                        {
+                            for(int x=0; x<width; ++x)
+                            {
+                                const T value = img_in(x, y);
+                                if(use_background && value == background)
+                                {
+                                    labels(x, y) = 0;
+                                    continue;
+                                }
+                                
+                                LabelType l = 0;
+                                auto join = [&](int nx, int ny)
+                                            {
+                                                if(img_in(nx, ny) == value)
+                                                {
+                                                    l = (l == 0) ? labels(nx, ny) : uniteLabels(parent, l, labels(nx, ny));
+                                                }
+                                            };
+                                if(x > 0)
+                                {
+                                    join(x-1, y);
+                                }
+                                if(y > y0)
+                                {
+                                    join(x, y-1);
+                                    if(eight_connectivity)
+                                    {
+                                        if(x > 0)
+                                        {
+                                            join(x-1, y-1);
+                                        }
+                                        if(x+1 < width)
+                                        {
+                                            join(x+1, y-1);
+                                        }
+                                    }
+                                }
+                                if(l == 0)
+                                {
+                                    l = LabelType(parent.size());
+                                    parent.push_back(l);
+                                }
+                                labels(x, y) = l;
+                            }
+                        }
+                    });
+    
+    //Phase 2: Map the local forests to one global forest
+    std::vector<std::size_t> offsets(strips + 1, 0);
+    for(int s=0; s<strips; ++s)
+    {
+        offsets[s+1] = offsets[s] + local_parents[s].size() - 1;
+    }
+    vigra_precondition(offsets[strips] < std::numeric_limits<LabelType>::max(),
+                       "parallelLabelImage(): Too many provisional labels.");
+    
+    std::vector<LabelType> parent(offsets[strips] + 1);
+    parent[0] = 0;
+    
+    parallelForEach(strips,
+                    [&](int s)
+                    {
+                        std::vector<LabelType> & local_parent = local_parents[s];
+                        for(std::size_t l=1; l<local_parent.size(); ++l)
+                        {
+                            parent[offsets[s] + l] = LabelType(offsets[s] + findLabelRoot(local_parent, LabelType(l)));
+                        }
+                        std::vector<LabelType>().swap(local_parent);
+                    });
+    
+    //Phase 3: Merge the components along the seams of the strips
+    for(int s=1; s<strips; ++s)
+    {
+        const int y = stripBegin(s);
+        
+        for(int x=0; x<width; ++x)
+        {
+            const T value = img_in(x, y);
+            if(use_background && value == background)
+            {
+                continue;
+            }
+            
+            const LabelType l = LabelType(offsets[s] + labels(x, y));
+            auto join = [&](int nx)
+                        {
+                            if(img_in(nx, y-1) == value)
+                            {
+                                uniteLabels(parent, l, LabelType(offsets[s-1] + labels(nx, y-1)));
+                            }
+                        };
+            join(x);
+            if(eight_connectivity)
+            {
+                if(x > 0)
+                {
+                    join(x-1);
+                }
+                if(x+1 < width)
+                {
+                    join(x+1);
+                }
+            }
+        }
+    }
+    
+    //Phase 4: Number the roots in scan order. Since each parent is smaller than
+    //its child, the final label of each root is known before its children.
+    LabelType label_count = 0;
+    for(std::size_t l=1; l<parent.size(); ++l)
+    {
+        parent[l] = (parent[l] == l) ? ++label_count : parent[parent[l]];
+    }
+    
+    //Phase 5: Write the final labels
+    parallelForEach(strips,
+                    [&](int s)
+                    {
+                        for(int y=stripBegin(s); y<stripBegin(s+1); ++y)
+                        {
+                            for(int x=0; x<width; ++x)
+                            {
+                                LabelType & l = labels(x, y);
+                                if(l != 0)
+                                {
+                                    l = parent[offsets[s] + l];
+                                }
+                            }
+                        }
+                    });
+    
+    return label_count;
+}
+
+/**
+ * Internal helper for the labeling of each pixel type. The labels are written
+ * to a flat array of LabelType.
+ *
+ * \return If the labelling was sucessful, the largest label assigned, else -1.
+ */
+template <class T>
+int labelImage(const T * arr_in,
+               const LabelType * arr_out,
+               const int width,
+               const int height,
+               const bool eight_connectivity)
+{
+    try
+    {
+        vigra::Shape2 shape(width,height);
+        vigra::MultiArrayView<2, T> img_in(shape, arr_in);
+        vigra::MultiArrayView<2, LabelType> labels(shape, arr_out);
+        
+        LabelType label_count = parallelLabelImage(img_in, labels, eight_connectivity, false, T());
+        
+        return (label_count > (LabelType)std::numeric_limits<int>::max()) ? -1 : int(label_count);
+    }
+    catch (vigra::StdException & e)
+    {
+        return -1;
+    }
+}
+
+/**
+ * Internal helper for the labeling w.r.t. a background intensity of each pixel type.
+ * The labels are written to a flat array of LabelType.
+ *
+ * \return If the labelling was sucessful, the largest label assigned, else -1.
+ */
+template <class T>
+int labelImageWithBackground(const T * arr_in,
+                             const LabelType * arr_out,
+                             const int width,
+                             const int height,
+                             const bool eight_connectivity,
+                             const T background)
+{
+    try
+    {
+        vigra::Shape2 shape(width,height);
+        vigra::MultiArrayView<2, T> img_in(shape, arr_in);
+        vigra::MultiArrayView<2, LabelType> labels(shape, arr_out);
+        
+        LabelType label_count = parallelLabelImage(img_in, labels, eight_connectivity, true, background);
+        
+        return (label_count > (LabelType)std::numeric_limits<int>::max()) ? -1 : int(label_count);
+    }
+    catch (vigra::StdException & e)
+    {
+        return -1;
+    }
+}
+
+/**
+ * Internal helper for the block-parallel labeling of each pixel type, which
+ * reports the number of labels by means of an out-parameter.
+ *
+ * \return 0 if the labelling was sucessful, 1 else.
+ */
+template <class T>
+int labelImageWithCount(const T * arr_in,
+                        const LabelType * arr_out,
+                        const int width,
+                        const int height,
+                        const bool eight_connectivity,
+                        const bool use_background,
+                        const T background,
+                        LabelType * label_count)
+{
+    try
+    {
+        vigra::Shape2 shape(width,height);
+        vigra::MultiArrayView<2, T> img_in(shape, arr_in);
+        vigra::MultiArrayView<2, LabelType> labels(shape, arr_out);
+        
+        LabelType count = parallelLabelImage(img_in, labels, eight_connectivity, use_background, background);
+        
+        if(label_count != nullptr)
+        {
+            *label_count = count;
+        }
+    }
+    catch (vigra::StdException & e)
+    {
+        return 1;
+    }
+    return 0;
+}
+
 LIBEXPORT int vigra_labelimage_c(const PixelType * arr_in,
                                  const PixelType * arr_out,
                                  const int width,
                                  const int height,
                                  const bool eight_connectivity)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         vigra::Shape2 shape(width,height);
-        ImageView img_in(shape, arr_in);
         ImageView img_out(shape, arr_out);
         
-        vigra::MultiArray<2, unsigned int> labels(width, height);
+        ScratchImage<LabelType> labels(width, height);
         
-        auto labelCount = vigra::labelImage(img_in, labels, eight_connectivity);
+        auto labelCount = labelImage(arr_in, labels.data(), width, height, eight_connectivity);
         
-        if (labelCount > MAX_FLOAT_INTEGER)
+        if (labelCount < 0 || (unsigned long long)labelCount > MAX_FLOAT_INTEGER)
         {
             return -1;
         }
@@ -89,17 +404,17 @@ LIBEXPORT int vigra_labelimagewithbackground_c(const PixelType * arr_in,
                                                const bool eight_connectivity,
                                                const PixelType background)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         vigra::Shape2 shape(width,height);
-        ImageView img_in(shape, arr_in);
         ImageView img_out(shape, arr_out);
         
-        vigra::MultiArray<2, unsigned int> labels(width, height);
+        ScratchImage<LabelType> labels(width, height);
         
-        auto labelCount = vigra::labelImageWithBackground(img_in, labels, eight_connectivity, background);
+        auto labelCount = labelImageWithBackground(arr_in, labels.data(), width, height, eight_connectivity, background);
         
-        if (labelCount > MAX_FLOAT_INTEGER)
+        if (labelCount < 0 || (unsigned long long)labelCount > MAX_FLOAT_INTEGER)
         {
             return -1;
         }
@@ -115,29 +430,264 @@ LIBEXPORT int vigra_labelimagewithbackground_c(const PixelType * arr_in,
     }
 }
 
+LIBEXPORT int vigra_parallellabelimage_c(const PixelType * arr_in,
+                                         const LabelType * arr_out,
+                                         const int width,
+                                         const int height,
+                                         const bool eight_connectivity,
+                                         LabelType * label_count)
+{
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*(sizeof(PixelType) + sizeof(LabelType)));
+    return labelImageWithCount(arr_in, arr_out, width, height, eight_connectivity, false, PixelType(), label_count);
+}
+
+LIBEXPORT int vigra_parallellabelimagewithbackground_c(const PixelType * arr_in,
+                                                       const LabelType * arr_out,
+                                                       const int width,
+                                                       const int height,
+                                                       const bool eight_connectivity,
+                                                       const PixelType background,
+                                                       LabelType * label_count)
+{
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*(sizeof(PixelType) + sizeof(LabelType)));
+    return labelImageWithCount(arr_in, arr_out, width, height, eight_connectivity, true, background, label_count);
+}
+
+/**
+ * Defines a preprocessor macro for the typed labeling functions, which are
+ * generated from the templated implementations for each pixel type
+ */
+#define LABELING_TYPED_FUNCTIONS(suffix, type)                                                                \
+LIBEXPORT int vigra_labelimage_##suffix##_c(const type * arr_in,                                              \
+                                            const LabelType * arr_out,                                        \
+                                            const int width,                                                  \
+                                            const int height,                                                 \
+                                            const bool eight_connectivity)                                    \
+{                                                                                                             \
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*(sizeof(type) + sizeof(LabelType)));                        \
+    return labelImage(arr_in, arr_out, width, height, eight_connectivity);                                    \
+}                                                                                                             \
+                                                                                                              \
+LIBEXPORT int vigra_labelimagewithbackground_##suffix##_c(const type * arr_in,                                \
+                                                          const LabelType * arr_out,                          \
+                                                          const int width,                                    \
+                                                          const int height,                                   \
+                                                          const bool eight_connectivity,                      \
+                                                          const type background)                              \
+{                                                                                                             \
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*(sizeof(type) + sizeof(LabelType)));                        \
+    return labelImageWithBackground(arr_in, arr_out, width, height, eight_connectivity, background);          \
+}                                                                                                             \
+                                                                                                              \
+LIBEXPORT int vigra_parallellabelimage_##suffix##_c(const type * arr_in,                                      \
+                                                    const LabelType * arr_out,                                \
+                                                    const int width,                                          \
+                                                    const int height,                                         \
+                                                    const bool eight_connectivity,                            \
+                                                    LabelType * label_count)                                  \
+{                                                                                                             \
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*(sizeof(type) + sizeof(LabelType)));                        \
+    return labelImageWithCount(arr_in, arr_out, width, height, eight_connectivity, false, type(), label_count);\
+}                                                                                                             \
+                                                                                                              \
+LIBEXPORT int vigra_parallellabelimagewithbackground_##suffix##_c(const type * arr_in,                        \
+                                                                  const LabelType * arr_out,                  \
+                                                                  const int width,                            \
+                                                                  const int height,                           \
+                                                                  const bool eight_connectivity,              \
+                                                                  const type background,                      \
+                                                                  LabelType * label_count)                    \
+{                                                                                                             \
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*(sizeof(type) + sizeof(LabelType)));                        \
+    return labelImageWithCount(arr_in, arr_out, width, height, eight_connectivity, true, background,          \
+                               label_count);                                                                  \
+}
+
+LABELING_TYPED_FUNCTIONS(uint8, UInt8PixelType)
+LABELING_TYPED_FUNCTIONS(uint16, UInt16PixelType)
+
+/**
+ * Internal helper for the union-find watershed segmentation, which writes the
+ * labels to an image of LabelType.
+ *
+ * \return The largest label assigned.
+ */
+LabelType watershedsUnionFindLabels(const ImageView & img_in,
+                                    vigra::MultiArrayView<2, LabelType> & labels,
+                                    const bool eight_connectivity)
+{
+    if(eight_connectivity)
+    {
+        return vigra::watershedsUnionFind(img_in, labels, vigra::EightNeighborCode());
+    }
+    else
+    {
+        return vigra::watershedsUnionFind(img_in, labels, vigra::FourNeighborCode());
+    }
+}
+
+/**
+ * Internal helper for the region-growing watershed segmentation. The labels image
+ * of LabelType needs to be filled with the seeds before and contains the result after
+ * the call.
+ *
+ * \return The largest label assigned.
+ */
+LabelType watershedsRegionGrowingLabels(const ImageView & img_in,
+                                        vigra::MultiArrayView<2, LabelType> & labels,
+                                        const bool eight_connectivity,
+                                        const bool keep_contours,
+                                        const bool use_turbo,
+                                        const double stop_cost)
+{
+    vigra::WatershedOptions options;
+    
+    if(keep_contours)
+    {
+        options = options.keepContours();
+    }
+    
+    LabelType labelCount = 0;
+    
+    if(use_turbo)
+    {
+        options = options.turboAlgorithm(256);
+        
+        // quantize the gradient image to 256 gray levels
+        ScratchImage<unsigned char> img_in256(img_in.shape());
+        vigra::FindMinMax<float> minmax;
+        vigra::inspectImage(img_in, minmax); // find original range
+        vigra::transformImage(img_in, img_in256,
+                                linearRangeMapping(minmax, 0, 255));
+        
+        //Adapt the stop costs to 0..255, too.
+        if(stop_cost>0)
+        {
+            options = options.stopAtThreshold(255.0*(stop_cost-minmax.min)/(minmax.max-minmax.min));
+        }
+        
+        // call the turbo algorithm with 256 bins:
+        if(eight_connectivity)
+        {
+            labelCount = vigra::watershedsRegionGrowing(img_in256, labels,
+                            vigra::EightNeighborCode(),
+                            options);
+        }
+        else
+        {
+            labelCount = vigra::watershedsRegionGrowing(img_in256, labels,
+                            vigra::FourNeighborCode(),
+                            options);
+        }
+    }
+    else
+    {
+    
+        if(stop_cost>0)
+        {
+            options = options.stopAtThreshold(stop_cost);
+        }
+        
+        if(eight_connectivity)
+        {
+            labelCount =  vigra::watershedsRegionGrowing(img_in, labels,
+                            vigra::EightNeighborCode(),
+                            options);
+        }
+        else
+        {
+            labelCount =  vigra::watershedsRegionGrowing(img_in, labels,
+                            vigra::FourNeighborCode(),
+                            options);
+        }
+    }
+    return labelCount;
+}
+
+/**
+ * Internal helper for the SLIC superpixels of a gray image, which writes the
+ * labels to an image of LabelType.
+ *
+ * \return The largest label assigned.
+ */
+LabelType slicGray(const ImageView & img_in,
+                   vigra::MultiArrayView<2, LabelType> & labels,
+                   const int seedDistance,
+                   const double intensityScaling,
+                   const int iterations)
+{
+    labels = 0;
+    
+    //int seedDistance = 15;
+    //double intensityScaling = 20.0;
+    
+    // compute seeds automatically, perform 40 iterations, and scale intensity differences
+    // down to 1/20 before comparing with spatial distances
+    return vigra::slicSuperpixels(img_in, labels, intensityScaling, seedDistance, vigra::SlicOptions().iterations(iterations));
+}
+
+/**
+ * Internal helper for the SLIC superpixels of a RGB image, which writes the
+ * labels to an image of LabelType.
+ *
+ * \return The largest label assigned.
+ */
+LabelType slicRGB(const ImageView & img_red,
+                  const ImageView & img_green,
+                  const ImageView & img_blue,
+                  vigra::MultiArrayView<2, LabelType> & labels,
+                  const int seedDistance,
+                  const double intensityScaling,
+                  const int iterations)
+{
+    ScratchImage<vigra::RGBValue<float> > src(img_red.shape());
+    // fill src image
+    src.bindElementChannel(0) = img_red;
+    src.bindElementChannel(1) = img_green;
+    src.bindElementChannel(2) = img_blue;
+    
+    labels = 0;
+    
+    // transform image to Lab color space
+    vigra::transformMultiArray(srcMultiArrayRange(src), destMultiArray(src),
+                               vigra::RGBPrime2LabFunctor<float>());
+    
+    //int seedDistance = 15;
+    //double intensityScaling = 20.0;
+    
+    // compute seeds automatically, perform 40 iterations, and scale intensity differences
+    // down to 1/20 before comparing with spatial distances
+    return vigra::slicSuperpixels(src, labels, intensityScaling, seedDistance,
+                                  vigra::SlicOptions().iterations(iterations));
+}
+
+/**
+ * Internal helper to return the largest label assigned by a segmentation to
+ * an image of LabelType.
+ *
+ * \return The largest label assigned, or -1 if it does not fit into an int.
+ */
+inline int labelCountResult(const LabelType labelCount)
+{
+    return (labelCount > (LabelType)std::numeric_limits<int>::max()) ? -1 : int(labelCount);
+}
+
 LIBEXPORT int vigra_watershedsunionfind_c(const PixelType * arr_in,
                                           const PixelType * arr_out,
                                           const int width,
                                           const int height,
                                           const bool eight_connectivity)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         vigra::Shape2 shape(width,height);
         ImageView img_in(shape, arr_in);
         ImageView img_out(shape, arr_out);
         
-        vigra::MultiArray<2, unsigned int> labels(width, height);
-        unsigned int labelCount = 0;
+        ScratchImage<LabelType> labels(width, height);
+        LabelType labelCount = watershedsUnionFindLabels(img_in, labels, eight_connectivity);
         
-        if(eight_connectivity)
-        {
-            labelCount = vigra::watershedsUnionFind(img_in, labels, vigra::EightNeighborCode());
-        }
-        else
-        {
-            labelCount = vigra::watershedsUnionFind(img_in, labels, vigra::FourNeighborCode());
-        }
         if (labelCount > MAX_FLOAT_INTEGER)
         {
             return -1;
@@ -154,6 +704,27 @@ LIBEXPORT int vigra_watershedsunionfind_c(const PixelType * arr_in,
     }
 }
 
+LIBEXPORT int vigra_watershedsunionfind_labels_c(const PixelType * arr_in,
+                                                 const LabelType * arr_out,
+                                                 const int width,
+                                                 const int height,
+                                                 const bool eight_connectivity)
+{
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*(sizeof(PixelType) + sizeof(LabelType)));
+    try
+    {
+        vigra::Shape2 shape(width,height);
+        ImageView img_in(shape, arr_in);
+        vigra::MultiArrayView<2, LabelType> labels(shape, arr_out);
+        
+        return labelCountResult(watershedsUnionFindLabels(img_in, labels, eight_connectivity));
+    }
+    catch (vigra::StdException & e)
+    {
+        return -1;
+    }
+}
+
 LIBEXPORT int vigra_watershedsregiongrowing_c(const PixelType * arr_in,
                                               const PixelType * arr_inout,
                                               const int width,
@@ -163,77 +734,19 @@ LIBEXPORT int vigra_watershedsregiongrowing_c(const PixelType * arr_in,
                                               const bool use_turbo,
                                               const double stop_cost)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         vigra::Shape2 shape(width,height);
         ImageView img_in(shape, arr_in);
         ImageView img_inout(shape, arr_inout);
         
-        vigra::WatershedOptions options;
-        
-        if(keep_contours)
-        {
-            options = options.keepContours();
-        }
-        
-        vigra::MultiArray<2, unsigned int> labels(width, height);
+        ScratchImage<LabelType> labels(width, height);
         //Fill labels image woth markers
         labels = img_inout;
         
-        unsigned int labelCount = 0;
-        
-        if(use_turbo)
-        {
-            options = options.turboAlgorithm(256);
-            
-            // quantize the gradient image to 256 gray levels
-            vigra::MultiArray<2, unsigned char> img_in256(width, height);
-            vigra::FindMinMax<float> minmax;
-            vigra::inspectImage(img_in, minmax); // find original range
-            vigra::transformImage(img_in, img_in256,
-                                    linearRangeMapping(minmax, 0, 255));
-            
-            //Adapt the stop costs to 0..255, too.
-            if(stop_cost>0)
-            {
-                options = options.stopAtThreshold(255.0*(stop_cost-minmax.min)/(minmax.max-minmax.min));
-            }
-            
-            // call the turbo algorithm with 256 bins:
-            if(eight_connectivity)
-            {
-                labelCount = vigra::watershedsRegionGrowing(img_in256, labels,
-                                vigra::EightNeighborCode(),
-                                options);
-            }
-            else
-            {
-                labelCount = vigra::watershedsRegionGrowing(img_in256, labels,
-                                vigra::FourNeighborCode(),
-                                options);
-            }
-        }
-        else
-        {
-        
-            if(stop_cost>0)
-            {
-                options = options.stopAtThreshold(stop_cost);
-            }
-            
-            if(eight_connectivity)
-            {
-                labelCount =  vigra::watershedsRegionGrowing(img_in, labels,
-                                vigra::EightNeighborCode(),
-                                options);
-            }
-            else
-            {
-                labelCount =  vigra::watershedsRegionGrowing(img_in, labels,
-                                vigra::FourNeighborCode(),
-                                options);
-            }
-        }
+        LabelType labelCount = watershedsRegionGrowingLabels(img_in, labels, eight_connectivity,
+                                                             keep_contours, use_turbo, stop_cost);
         
         if (labelCount > MAX_FLOAT_INTEGER)
         {
@@ -251,6 +764,31 @@ LIBEXPORT int vigra_watershedsregiongrowing_c(const PixelType * arr_in,
     }
 }
 
+LIBEXPORT int vigra_watershedsregiongrowing_labels_c(const PixelType * arr_in,
+                                                     const LabelType * arr_inout,
+                                                     const int width,
+                                                     const int height,
+                                                     const bool eight_connectivity,
+                                                     const bool keep_contours,
+                                                     const bool use_turbo,
+                                                     const double stop_cost)
+{
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*(sizeof(PixelType) + sizeof(LabelType)));
+    try
+    {
+        vigra::Shape2 shape(width,height);
+        ImageView img_in(shape, arr_in);
+        vigra::MultiArrayView<2, LabelType> labels(shape, arr_inout);
+        
+        return labelCountResult(watershedsRegionGrowingLabels(img_in, labels, eight_connectivity,
+                                                              keep_contours, use_turbo, stop_cost));
+    }
+    catch (vigra::StdException & e)
+    {
+        return -1;
+    }
+}
+
 LIBEXPORT int vigra_slic_gray_c(const PixelType * arr_in,
                                 const PixelType * arr_out,
                                 const int width,
@@ -259,6 +797,7 @@ LIBEXPORT int vigra_slic_gray_c(const PixelType * arr_in,
                                 const double intensityScaling,
                                 const int iterations)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         vigra::Shape2 shape(width,height);
@@ -266,14 +805,9 @@ LIBEXPORT int vigra_slic_gray_c(const PixelType * arr_in,
         ImageView img_out(shape, arr_out);
         
         //We need to define a new array here to avoid abiguities inside the extractFeatures for (float, float)
-        vigra::MultiArray<2, unsigned int> labels(shape);
+        ScratchImage<LabelType> labels(shape);
         
-        //int seedDistance = 15;
-        //double intensityScaling = 20.0;
-        
-        // compute seeds automatically, perform 40 iterations, and scale intensity differences
-        // down to 1/20 before comparing with spatial distances
-        auto labelCount = vigra::slicSuperpixels(img_in, labels, intensityScaling, seedDistance, vigra::SlicOptions().iterations(iterations));
+        auto labelCount = slicGray(img_in, labels, seedDistance, intensityScaling, iterations);
         
         if (labelCount > MAX_FLOAT_INTEGER)
         {
@@ -291,6 +825,29 @@ LIBEXPORT int vigra_slic_gray_c(const PixelType * arr_in,
     }
 }
 
+LIBEXPORT int vigra_slic_gray_labels_c(const PixelType * arr_in,
+                                       const LabelType * arr_out,
+                                       const int width,
+                                       const int height,
+                                       const int seedDistance,
+                                       const double intensityScaling,
+                                       const int iterations)
+{
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*(sizeof(PixelType) + sizeof(LabelType)));
+    try
+    {
+        vigra::Shape2 shape(width,height);
+        ImageView img_in(shape, arr_in);
+        vigra::MultiArrayView<2, LabelType> labels(shape, arr_out);
+        
+        return labelCountResult(slicGray(img_in, labels, seedDistance, intensityScaling, iterations));
+    }
+    catch (vigra::StdException & e)
+    {
+        return -1;
+    }
+}
+
 LIBEXPORT int vigra_slic_rgb_c(const PixelType * arr_r_in,
                                const PixelType * arr_g_in,
                                const PixelType * arr_b_in,
@@ -301,6 +858,7 @@ LIBEXPORT int vigra_slic_rgb_c(const PixelType * arr_r_in,
                                const double intensityScaling,
                                const int iterations)
 {
+    VIGRA_C_STATS_SCOPE(4*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //write the color channels from the different arrays
@@ -311,25 +869,10 @@ LIBEXPORT int vigra_slic_rgb_c(const PixelType * arr_r_in,
         
         ImageView img_out(shape, arr_out);
         
-        vigra::MultiArray<2, vigra::RGBValue<float> > src(shape);
-        // fill src image
-        src.bindElementChannel(0) = img_red;
-        src.bindElementChannel(1) = img_green;
-        src.bindElementChannel(2) = img_blue;
+        ScratchImage<LabelType> labels(shape);
         
-        vigra::MultiArray<2, unsigned int> labels(shape);
-        
-        // transform image to Lab color space
-        vigra::transformMultiArray(srcMultiArrayRange(src), destMultiArray(src),
-                                   vigra::RGBPrime2LabFunctor<float>());
-        
-        //int seedDistance = 15;
-        //double intensityScaling = 20.0;
-        
-        // compute seeds automatically, perform 40 iterations, and scale intensity differences
-        // down to 1/20 before comparing with spatial distances
-        auto labelCount = vigra::slicSuperpixels(src, labels, intensityScaling, seedDistance,
-                                      vigra::SlicOptions().iterations(iterations));
+        auto labelCount = slicRGB(img_red, img_green, img_blue, labels,
+                                  seedDistance, intensityScaling, iterations);
         
         if (labelCount > MAX_FLOAT_INTEGER)
         {
@@ -347,7 +890,37 @@ LIBEXPORT int vigra_slic_rgb_c(const PixelType * arr_r_in,
     }
 }
 
-LIBEXPORT int vigra_cannyedgeimage_c(const PixelType * arr_in,
+LIBEXPORT int vigra_slic_rgb_labels_c(const PixelType * arr_r_in,
+                                      const PixelType * arr_g_in,
+                                      const PixelType * arr_b_in,
+                                      const LabelType * arr_out,
+                                      const int width,
+                                      const int height,
+                                      const int seedDistance,
+                                      const double intensityScaling,
+                                      const int iterations)
+{
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*(3*sizeof(PixelType) + sizeof(LabelType)));
+    try
+    {
+        //write the color channels from the different arrays
+        vigra::Shape2 shape(width, height);
+        ImageView img_red(shape, arr_r_in);
+        ImageView img_green(shape, arr_g_in);
+        ImageView img_blue(shape, arr_b_in);
+        
+        vigra::MultiArrayView<2, LabelType> labels(shape, arr_out);
+        
+        return labelCountResult(slicRGB(img_red, img_green, img_blue, labels,
+                                        seedDistance, intensityScaling, iterations));
+    }
+    catch (vigra::StdException & e)
+    {
+        return -1;
+    }
+}
+
+LIBEXPORT int vigra_cannyedgeimage_c(const PixelType * arr_in,
                                      const PixelType * arr_out,
                                      const int width,
                                      const int height,
@@ -355,6 +928,7 @@ LIBEXPORT int vigra_cannyedgeimage_c(const PixelType * arr_in,
                                      const float gradient_threshold,
                                      const float mark)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         vigra::Shape2 shape(width,height);
@@ -378,6 +952,7 @@ LIBEXPORT int vigra_differenceofexponentialedgeimage_c(const PixelType * arr_in,
                                                        const float gradient_threshold,
                                                        const float mark)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         vigra::Shape2 shape(width,height);
@@ -399,6 +974,7 @@ LIBEXPORT int vigra_regionimagetocrackedgeimage_c(const PixelType * arr_in,
                                                   const int height_in,
                                                   const float mark)
 {
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width_in)*height_in*sizeof(PixelType));
     try
     {
         vigra::Shape2 shape_in(width_in,height_in);
@@ -415,6 +991,110 @@ LIBEXPORT int vigra_regionimagetocrackedgeimage_c(const PixelType * arr_in,
     return 0;
 }
 
+LIBEXPORT int vigra_regionimagetocrackedgeimage_labels_c(const LabelType * arr_in,
+                                                         const LabelType * arr_out,
+                                                         const int width_in,
+                                                         const int height_in,
+                                                         const LabelType mark)
+{
+    VIGRA_C_STATS_SCOPE(std::size_t(width_in)*height_in*sizeof(LabelType)
+                        + std::size_t(2*width_in-1)*(2*height_in-1)*sizeof(LabelType));
+    try
+    {
+        vigra::Shape2 shape_in(width_in,height_in);
+        vigra::MultiArrayView<2, LabelType> img_in(shape_in, arr_in);
+        vigra::Shape2 shape_out(2*width_in-1, 2*height_in-1);
+        vigra::MultiArrayView<2, LabelType> img_out(shape_out, arr_out);
+        
+        vigra::regionImageToCrackEdgeImage(img_in, img_out, mark);
+    }
+    catch (vigra::StdException & e)
+    {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Internal helper to extract the region features of a gray image w.r.t. an image
+ * of LabelType. The features are written to a view of shape (22, max_label+1).
+ */
+void extractFeaturesGray(const ImageView & img_in,
+                         const vigra::MultiArrayView<2, LabelType> & labels,
+                         ImageView & img_out,
+                         const int max_label)
+{
+    using namespace vigra::acc;
+    
+    //Order (x,y) with y = region_id (from 0...max_label) and:
+    // x=  0       - > region_size,
+    // x=( 1 ..  2) -> upperleft-x and y-coord
+    // x=( 3 ..  4) -> lowerright-x and y-coord
+    // x=( 5 ..  6) -> mean-x and y-coord
+    // x=  7        -> min grey value
+    // x=  8        -> max grey value
+    // x=  9        -> mean grey value
+    // x= 10        -> std.dev. grey value
+    // x=(11 .. 12) -> major ev: x and y-coord
+    // x=(13 .. 14) -> minor ev: x and y-coord
+    // x= 15        -> major ew
+    // x= 16        -> minor ew
+    // x=(17 .. 18) -> grey value weighted mean-x and y-coord
+    // x=19         -> perimeter (region contour length)
+    // x=20         -> skewness
+    // x=21         -> kurtosis
+    typedef
+        AccumulatorChainArray<vigra::CoupledArrays<2, PixelType, LabelType>,
+            Select< DataArg<1>, LabelArg<2>, // in which array to look (coordinates are always arg 0)
+                    Count,
+                    Coord<Minimum>, Coord<Maximum>, Coord<Mean>,
+                    Minimum, Maximum, Mean, StdDev,
+                    RegionAxes, RegionRadii,
+                    Weighted<Coord<Mean> >,
+                    RegionPerimeter,
+                    Skewness, Kurtosis > >
+        AccumulatorType;
+    
+    AccumulatorType a;
+    
+    extractFeatures(img_in, labels, a);
+
+    for(unsigned int i=0; i!=max_label+1; ++i)
+    {
+        img_out(0, i) = get<Count>(a,i);
+        
+        img_out(1, i) = get<Coord<Minimum>>(a,i)[0];
+        img_out(2, i) = get<Coord<Minimum>>(a,i)[1];
+        
+        img_out(3, i) = get<Coord<Maximum>>(a,i)[0];
+        img_out(4, i) = get<Coord<Maximum>>(a,i)[1];
+        
+        img_out(5, i) = get<Coord<Mean>>(a,i)[0];
+        img_out(6, i) = get<Coord<Mean>>(a,i)[1];
+        
+        img_out(7, i) = get<Minimum>(a,i);
+        img_out(8, i) = get<Maximum>(a,i);
+        img_out(9, i) = get<Mean>(a,i);
+        img_out(10,i) = get<StdDev>(a,i);
+        
+        img_out(11,i) = get<RegionAxes>(a,i)(0,0);
+        img_out(12,i) = get<RegionAxes>(a,i)(1,0);
+        img_out(13,i) = get<RegionAxes>(a,i)(0,1);
+        img_out(14,i) = get<RegionAxes>(a,i)(1,1);
+        
+        img_out(15,i) = get<RegionRadii>(a,i)[0];
+        img_out(16,i) = get<RegionRadii>(a,i)[1];
+        
+        img_out(17, i) = get<Weighted<Coord<Mean>>>(a,i)[0];
+        img_out(18, i) = get<Weighted<Coord<Mean>>>(a,i)[1];
+        
+        img_out(19, i) = get<RegionPerimeter>(a,i);
+        
+        img_out(20, i) = get<Skewness>(a,i);
+        img_out(21, i) = get<Kurtosis>(a,i);
+    }
+}
+
 LIBEXPORT int vigra_extractfeatures_gray_c(const PixelType * arr_gray_in,
                                            const PixelType * arr_labels_in,
                                            const PixelType * arr_out,
@@ -422,8 +1102,7 @@ LIBEXPORT int vigra_extractfeatures_gray_c(const PixelType * arr_gray_in,
                                            const int height_in,
                                            const int max_label)
 {
-    using namespace vigra::acc;
-    
+    VIGRA_C_STATS_SCOPE(2*std::size_t(width_in)*height_in*sizeof(PixelType));
     try
     {
         vigra::Shape2 shape_in(width_in,height_in);
@@ -432,77 +1111,537 @@ LIBEXPORT int vigra_extractfeatures_gray_c(const PixelType * arr_gray_in,
         ImageView labels_in(shape_in, arr_labels_in);
         
         //temp copy to int-type array
-        vigra::MultiArray<2, unsigned int> labels = labels_in;
-        
-        //Order (x,y) with y = region_id (from 0...max_label) and:
-        // x=  0       - > region_size,
-        // x=( 1 ..  2) -> upperleft-x and y-coord
-        // x=( 3 ..  4) -> lowerright-x and y-coord
-        // x=( 5 ..  6) -> mean-x and y-coord
-        // x=  7        -> min grey value
-        // x=  8        -> max grey value
-        // x=  9        -> mean grey value
-        // x= 10        -> std.dev. grey value
-        // x=(11 .. 12) -> major ev: x and y-coord
-        // x=(13 .. 14) -> minor ev: x and y-coord
-        // x= 15        -> major ew
-        // x= 16        -> minor ew
-        // x=(17 .. 18) -> grey value weighted mean-x and y-coord
-        // x=19         -> perimeter (region contour length)
-        // x=20         -> skewness
-        // x=21         -> kurtosis
+        ScratchImage<LabelType> labels(shape_in);
+        labels = labels_in;
+        
         vigra::Shape2 shape_out(22, max_label+1);
         ImageView img_out(shape_out, arr_out);
         
-        typedef
-            AccumulatorChainArray<vigra::CoupledArrays<2, PixelType, unsigned int>,
-                Select< DataArg<1>, LabelArg<2>, // in which array to look (coordinates are always arg 0)
-                        Count,
-                        Coord<Minimum>, Coord<Maximum>, Coord<Mean>,
-                        Minimum, Maximum, Mean, StdDev,
-                        RegionAxes, RegionRadii,
-                        Weighted<Coord<Mean> >,
-                        RegionPerimeter,
-                        Skewness, Kurtosis > >
-            AccumulatorType;
+        extractFeaturesGray(img_in, labels, img_out, max_label);
+    }
+    catch (vigra::StdException & e)
+    {
+        return 1;
+    }
+    return 0;
+}
+
+LIBEXPORT int vigra_extractfeatures_gray_labels_c(const PixelType * arr_gray_in,
+                                                  const LabelType * arr_labels_in,
+                                                  const PixelType * arr_out,
+                                                  const int width_in,
+                                                  const int height_in,
+                                                  const int max_label)
+{
+    VIGRA_C_STATS_SCOPE(std::size_t(width_in)*height_in*(sizeof(PixelType) + sizeof(LabelType)));
+    try
+    {
+        vigra::Shape2 shape_in(width_in,height_in);
+        
+        ImageView img_in(shape_in, arr_gray_in);
+        vigra::MultiArrayView<2, LabelType> labels(shape_in, arr_labels_in);
+        
+        vigra::Shape2 shape_out(22, max_label+1);
+        ImageView img_out(shape_out, arr_out);
+        
+        extractFeaturesGray(img_in, labels, img_out, max_label);
+    }
+    catch (vigra::StdException & e)
+    {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Internal structure for the streaming accumulation of the region features of
+ * vigra_extractfeatures_gray_c. All statistics can be updated by one pixel at a
+ * time and merged with the statistics of other pixel sets. The central moments
+ * are updated and merged by the formulas of Pebay.
+ */
+struct RegionFeatureStats
+{
+    RegionFeatureStats()
+    : count(0),
+      min_x(std::numeric_limits<double>::max()), min_y(std::numeric_limits<double>::max()),
+      max_x(std::numeric_limits<double>::lowest()), max_y(std::numeric_limits<double>::lowest()),
+      mean_x(0), mean_y(0), cxx(0), cxy(0), cyy(0),
+      min_g(std::numeric_limits<double>::max()), max_g(std::numeric_limits<double>::lowest()),
+      mean_g(0), m2(0), m3(0), m4(0),
+      sum_w(0), sum_wx(0), sum_wy(0),
+      perimeter(0)
+    {
+    }
+    
+    void update(const double x, const double y, const double g)
+    {
+        const double n1 = count;
+        count += 1;
+        const double n = count;
+        
+        min_x = std::min(min_x, x);  max_x = std::max(max_x, x);
+        min_y = std::min(min_y, y);  max_y = std::max(max_y, y);
+        
+        const double dx = x - mean_x,
+                     dy = y - mean_y;
+        mean_x += dx/n;
+        mean_y += dy/n;
+        cxx += dx*(x - mean_x);
+        cxy += dx*(y - mean_y);
+        cyy += dy*(y - mean_y);
+        
+        min_g = std::min(min_g, g);
+        max_g = std::max(max_g, g);
+        
+        const double delta    = g - mean_g,
+                     delta_n  = delta/n,
+                     delta_n2 = delta_n*delta_n,
+                     term     = delta*delta_n*n1;
+        mean_g += delta_n;
+        m4 += term*delta_n2*(n*n - 3*n + 3) + 6*delta_n2*m2 - 4*delta_n*m3;
+        m3 += term*delta_n*(n - 2) - 3*delta_n*m2;
+        m2 += term;
+        
+        sum_w  += g;
+        sum_wx += g*x;
+        sum_wy += g*y;
+    }
+    
+    void merge(const RegionFeatureStats & o)
+    {
+        if(o.count == 0)
+        {
+            return;
+        }
+        if(count == 0)
+        {
+            *this = o;
+            return;
+        }
+        
+        const double na = count,
+                     nb = o.count,
+                     n  = na + nb;
+        
+        min_x = std::min(min_x, o.min_x);  max_x = std::max(max_x, o.max_x);
+        min_y = std::min(min_y, o.min_y);  max_y = std::max(max_y, o.max_y);
+        
+        const double dx = o.mean_x - mean_x,
+                     dy = o.mean_y - mean_y;
+        cxx += o.cxx + dx*dx*na*nb/n;
+        cxy += o.cxy + dx*dy*na*nb/n;
+        cyy += o.cyy + dy*dy*na*nb/n;
+        mean_x += dx*nb/n;
+        mean_y += dy*nb/n;
+        
+        min_g = std::min(min_g, o.min_g);
+        max_g = std::max(max_g, o.max_g);
+        
+        const double delta   = o.mean_g - mean_g,
+                     delta_n = delta/n;
+        m4 += o.m4 + delta*delta_n*delta_n*delta_n*na*nb*(na*na - na*nb + nb*nb)
+                   + 6*delta_n*delta_n*(na*na*o.m2 + nb*nb*m2)
+                   + 4*delta_n*(na*o.m3 - nb*m3);
+        m3 += o.m3 + delta*delta_n*delta_n*na*nb*(na - nb)
+                   + 3*delta_n*(na*o.m2 - nb*m2);
+        m2 += o.m2 + delta*delta_n*na*nb;
+        mean_g += delta_n*nb;
+        
+        sum_w  += o.sum_w;
+        sum_wx += o.sum_wx;
+        sum_wy += o.sum_wy;
+        
+        perimeter += o.perimeter;
+        count = n;
+    }
+    
+    double count;
+    double min_x, min_y, max_x, max_y;
+    double mean_x, mean_y, cxx, cxy, cyy;
+    double min_g, max_g, mean_g, m2, m3, m4;
+    double sum_w, sum_wx, sum_wy;
+    double perimeter;
+};
+
+/** The label of all pixels, which are outside of the accumulated tiles. */
+static const LabelType OUTSIDE_LABEL = std::numeric_limits<LabelType>::max();
+
+/**
+ * Internal helper to add the contour length of the regions at one vertex (pixel corner)
+ * to a functor. The contour of each region is the polygon through the midpoints of its
+ * boundary cracks. Thus, each contour passes a vertex straight (length 1) or turns at
+ * it (length sqrt(0.5)). The sum over all vertices is the contour length of a region
+ * including the contours of its holes.
+ *
+ * \param a The label of the top-left pixel of the vertex.
+ * \param b The label of the top-right pixel of the vertex.
+ * \param c The label of the bottom-left pixel of the vertex.
+ * \param d The label of the bottom-right pixel of the vertex.
+ * \param add Functor, which is called by add(label, length) for each region at the vertex.
+ */
+template <class ADD>
+inline void vertexContourLength(const LabelType a, const LabelType b, const LabelType c, const LabelType d, ADD add)
+{
+    if(a == b && a == c && a == d)
+    {
+        return;
+    }
+    
+    static const double turn = std::sqrt(0.5);
+    const LabelType v[4] = {a, b, c, d};
+    
+    for(int i=0; i<4; ++i)
+    {
+        if(v[i] == OUTSIDE_LABEL || (i > 0 && v[0] == v[i]) || (i > 1 && v[1] == v[i]) || (i > 2 && v[2] == v[i]))
+        {
+            continue;
+        }
+        
+        const int mask = (v[0] == v[i]) | (v[1] == v[i]) << 1 | (v[2] == v[i]) << 2 | (v[3] == v[i]) << 3;
+        
+        switch(mask)
+        {
+            case 0x3: case 0xC: case 0x5: case 0xA:
+                add(v[i], 1.0);
+                break;
+            case 0x6: case 0x9:
+                add(v[i], 2*turn);
+                break;
+            default:
+                add(v[i], turn);
+        }
+    }
+}
+
+/**
+ * Internal helper to create the key of a pixel or vertex position.
+ */
+inline std::uint64_t positionKey(const int x, const int y)
+{
+    return (std::uint64_t(std::uint32_t(y)) << 32) | std::uint32_t(x);
+}
+
+/**
+ * Internal structure behind the handles of the streaming region feature accumulation.
+ * Besides the statistics of each region, the labels of the border pixels of all
+ * tiles are stored. These are needed to compute the contour lengths at the vertices
+ * on the borders of the tiles, when the features are finalized.
+ */
+struct RegionFeaturesHandle
+{
+    int max_label;
+    std::vector<RegionFeatureStats> stats;
+    std::unordered_map<std::uint64_t, LabelType> border_labels;
+    std::vector<std::uint64_t> border_vertices;
+    std::mutex mutex;
+};
+
+LIBEXPORT void * vigra_regionfeatures_create_c(const int max_label)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    if(max_label < 0 || (LabelType)max_label >= OUTSIDE_LABEL)
+    {
+        return nullptr;
+    }
+    
+    try
+    {
+        std::unique_ptr<RegionFeaturesHandle> handle(new RegionFeaturesHandle);
+        handle->max_label = max_label;
+        handle->stats.resize(std::size_t(max_label) + 1);
+        
+        return handle.release();
+    }
+    catch (vigra::StdException & e)
+    {
+        return nullptr;
+    }
+}
+
+LIBEXPORT int vigra_regionfeatures_addtile_c(void * feature_handle,
+                                             const PixelType * arr_gray_in,
+                                             const LabelType * arr_labels_in,
+                                             const int width,
+                                             const int height,
+                                             const int offset_x,
+                                             const int offset_y)
+{
+    VIGRA_C_STATS_SCOPE(std::size_t(width)*height*(sizeof(PixelType) + sizeof(LabelType)));
+    if(feature_handle == nullptr || width <= 0 || height <= 0 || offset_x < 0 || offset_y < 0)
+    {
+        return 1;
+    }
+    
+    try
+    {
+        RegionFeaturesHandle & handle = *reinterpret_cast<RegionFeaturesHandle*>(feature_handle);
+        
+        vigra::Shape2 shape(width,height);
+        ImageView img_in(shape, arr_gray_in);
+        vigra::MultiArrayView<2, LabelType> labels(shape, arr_labels_in);
+        
+        //Partial statistics of the regions of this tile
+        std::unordered_map<LabelType, std::size_t> slots;
+        std::vector<LabelType> slot_labels;
+        std::vector<RegionFeatureStats> stats;
+        
+        LabelType last_label = OUTSIDE_LABEL;
+        std::size_t last_slot = 0;
         
-        AccumulatorType a;
+        auto slot = [&](const LabelType l) -> RegionFeatureStats &
+                    {
+                        if(l != last_label)
+                        {
+                            auto it = slots.find(l);
+                            if(it == slots.end())
+                            {
+                                it = slots.emplace(l, stats.size()).first;
+                                slot_labels.push_back(l);
+                                stats.emplace_back();
+                            }
+                            last_label = l;
+                            last_slot  = it->second;
+                        }
+                        return stats[last_slot];
+                    };
         
-        extractFeatures(img_in, labels, a);
+        for(int y=0; y<height; ++y)
+        {
+            for(int x=0; x<width; ++x)
+            {
+                const LabelType l = labels(x, y);
+                if(l > (LabelType)handle.max_label)
+                {
+                    //Label out of range!
+                    return 2;
+                }
+                slot(l).update(offset_x + x, offset_y + y, img_in(x, y));
+            }
+        }
+        
+        //Contour lengths at the vertices inside the tile
+        for(int y=1; y<height; ++y)
+        {
+            for(int x=1; x<width; ++x)
+            {
+                vertexContourLength(labels(x-1, y-1), labels(x, y-1), labels(x-1, y), labels(x, y),
+                                    [&](LabelType l, double length)
+                                    {
+                                        slot(l).perimeter += length;
+                                    });
+            }
+        }
+        
+        //Labels of the border pixels and the vertices on the border of the tile
+        std::vector<std::pair<std::uint64_t, LabelType> > border_labels;
+        std::vector<std::uint64_t> border_vertices;
+        
+        auto borderPixel = [&](int x, int y)
+                           {
+                               border_labels.emplace_back(positionKey(offset_x + x, offset_y + y), labels(x, y));
+                           };
+        for(int x=0; x<width; ++x)
+        {
+            borderPixel(x, 0);
+            if(height > 1)
+            {
+                borderPixel(x, height-1);
+            }
+        }
+        for(int y=1; y<height-1; ++y)
+        {
+            borderPixel(0, y);
+            if(width > 1)
+            {
+                borderPixel(width-1, y);
+            }
+        }
+        for(int x=0; x<=width; ++x)
+        {
+            border_vertices.push_back(positionKey(offset_x + x, offset_y));
+            border_vertices.push_back(positionKey(offset_x + x, offset_y + height));
+        }
+        for(int y=1; y<height; ++y)
+        {
+            border_vertices.push_back(positionKey(offset_x, offset_y + y));
+            border_vertices.push_back(positionKey(offset_x + width, offset_y + y));
+        }
+        
+        //Merge the partial statistics into the handle
+        std::lock_guard<std::mutex> lock(handle.mutex);
+        
+        for(std::size_t i=0; i<stats.size(); ++i)
+        {
+            handle.stats[slot_labels[i]].merge(stats[i]);
+        }
+        handle.border_labels.insert(border_labels.begin(), border_labels.end());
+        handle.border_vertices.insert(handle.border_vertices.end(), border_vertices.begin(), border_vertices.end());
+    }
+    catch (vigra::StdException & e)
+    {
+        return 1;
+    }
+    return 0;
+}
 
-        for(unsigned int i=0; i!=max_label+1; ++i)
+LIBEXPORT int vigra_regionfeatures_merge_c(void * feature_handle,
+                                           void * other_feature_handle)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    if(feature_handle == nullptr || other_feature_handle == nullptr || feature_handle == other_feature_handle)
+    {
+        return 1;
+    }
+    
+    try
+    {
+        RegionFeaturesHandle & handle = *reinterpret_cast<RegionFeaturesHandle*>(feature_handle);
+        RegionFeaturesHandle & other  = *reinterpret_cast<RegionFeaturesHandle*>(other_feature_handle);
+        
+        std::lock(handle.mutex, other.mutex);
+        std::lock_guard<std::mutex> lock(handle.mutex, std::adopt_lock);
+        std::lock_guard<std::mutex> other_lock(other.mutex, std::adopt_lock);
+        
+        if(handle.max_label != other.max_label)
+        {
+            //Different label ranges!
+            return 2;
+        }
+        
+        for(std::size_t i=0; i<handle.stats.size(); ++i)
         {
-            img_out(0, i) = get<Count>(a,i);
+            handle.stats[i].merge(other.stats[i]);
+        }
+        handle.border_labels.insert(other.border_labels.begin(), other.border_labels.end());
+        handle.border_vertices.insert(handle.border_vertices.end(), other.border_vertices.begin(), other.border_vertices.end());
+    }
+    catch (vigra::StdException & e)
+    {
+        return 1;
+    }
+    return 0;
+}
+
+LIBEXPORT int vigra_regionfeatures_finalize_c(void * feature_handle,
+                                              const PixelType * arr_out)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    if(feature_handle == nullptr)
+    {
+        return 1;
+    }
+    
+    try
+    {
+        RegionFeaturesHandle & handle = *reinterpret_cast<RegionFeaturesHandle*>(feature_handle);
+        std::lock_guard<std::mutex> lock(handle.mutex);
+        
+        //Contour lengths at the vertices on the borders of the tiles
+        std::vector<double> perimeter(handle.stats.size());
+        for(std::size_t i=0; i<handle.stats.size(); ++i)
+        {
+            perimeter[i] = handle.stats[i].perimeter;
+        }
+        
+        std::vector<std::uint64_t> vertices(handle.border_vertices);
+        std::sort(vertices.begin(), vertices.end());
+        vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+        
+        auto label = [&](int x, int y)
+                     {
+                         if(x < 0 || y < 0)
+                         {
+                             return OUTSIDE_LABEL;
+                         }
+                         auto it = handle.border_labels.find(positionKey(x, y));
+                         return (it == handle.border_labels.end()) ? OUTSIDE_LABEL : it->second;
+                     };
+        
+        for(std::uint64_t key : vertices)
+        {
+            const int x = int(key & 0xFFFFFFFFu),
+                      y = int(key >> 32);
+            vertexContourLength(label(x-1, y-1), label(x, y-1), label(x-1, y), label(x, y),
+                                [&](LabelType l, double length)
+                                {
+                                    perimeter[l] += length;
+                                });
+        }
+        
+        //Same order as for vigra_extractfeatures_gray_c
+        vigra::Shape2 shape_out(22, handle.max_label+1);
+        ImageView img_out(shape_out, arr_out);
+        img_out = 0;
+        
+        for(int i=0; i<=handle.max_label; ++i)
+        {
+            const RegionFeatureStats & s = handle.stats[i];
+            if(s.count == 0)
+            {
+                continue;
+            }
+            
+            const double n = s.count;
+            
+            //Eigensystem of the coordinate covariance matrix
+            const double a = s.cxx/n,
+                         b = s.cxy/n,
+                         d = s.cyy/n,
+                         root = std::sqrt(0.25*(a - d)*(a - d) + b*b),
+                         ew_major = 0.5*(a + d) + root,
+                         ew_minor = 0.5*(a + d) - root;
+            //Use the numerically stable one of both solutions for the major axis
+            double ev_x = (a >= d) ? ew_major - d : b,
+                   ev_y = (a >= d) ? b : ew_major - a;
+            const double norm = std::hypot(ev_x, ev_y);
+            if(norm > 0)
+            {
+                ev_x /= norm;
+                ev_y /= norm;
+            }
+            else
+            {
+                ev_x = 1.0;
+                ev_y = 0.0;
+            }
+            //The sign of the axes is arbitrary. Let the dominant component be positive.
+            if((std::abs(ev_x) >= std::abs(ev_y)) ? (ev_x < 0) : (ev_y < 0))
+            {
+                ev_x = -ev_x;
+                ev_y = -ev_y;
+            }
+            
+            img_out(0, i) = n;
             
-            img_out(1, i) = get<Coord<Minimum>>(a,i)[0];
-            img_out(2, i) = get<Coord<Minimum>>(a,i)[1];
+            img_out(1, i) = s.min_x;
+            img_out(2, i) = s.min_y;
             
-            img_out(3, i) = get<Coord<Maximum>>(a,i)[0];
-            img_out(4, i) = get<Coord<Maximum>>(a,i)[1];
+            img_out(3, i) = s.max_x;
+            img_out(4, i) = s.max_y;
             
-            img_out(5, i) = get<Coord<Mean>>(a,i)[0];
-            img_out(6, i) = get<Coord<Mean>>(a,i)[1];
+            img_out(5, i) = s.mean_x;
+            img_out(6, i) = s.mean_y;
             
-            img_out(7, i) = get<Minimum>(a,i);
-            img_out(8, i) = get<Maximum>(a,i);
-            img_out(9, i) = get<Mean>(a,i);
-            img_out(10,i) = get<StdDev>(a,i);
+            img_out(7, i) = s.min_g;
+            img_out(8, i) = s.max_g;
+            img_out(9, i) = s.mean_g;
+            img_out(10,i) = std::sqrt(s.m2/n);
             
-            img_out(11,i) = get<RegionAxes>(a,i)(0,0);
-            img_out(12,i) = get<RegionAxes>(a,i)(1,0);
-            img_out(13,i) = get<RegionAxes>(a,i)(0,1);
-            img_out(14,i) = get<RegionAxes>(a,i)(1,1);
+            img_out(11,i) =  ev_x;
+            img_out(12,i) =  ev_y;
+            img_out(13,i) = -ev_y;
+            img_out(14,i) =  ev_x;
             
-            img_out(15,i) = get<RegionRadii>(a,i)[0];
-            img_out(16,i) = get<RegionRadii>(a,i)[1];
+            img_out(15,i) = std::sqrt(std::max(ew_major, 0.0));
+            img_out(16,i) = std::sqrt(std::max(ew_minor, 0.0));
             
-            img_out(17, i) = get<Weighted<Coord<Mean>>>(a,i)[0];
-            img_out(18, i) = get<Weighted<Coord<Mean>>>(a,i)[1];
+            img_out(17, i) = s.sum_wx/s.sum_w;
+            img_out(18, i) = s.sum_wy/s.sum_w;
             
-            img_out(19, i) = get<RegionPerimeter>(a,i);
+            img_out(19, i) = perimeter[i];
             
-            img_out(20, i) = get<Skewness>(a,i);
-            img_out(21, i) = get<Kurtosis>(a,i);
+            img_out(20, i) = std::sqrt(n)*s.m3/std::pow(s.m2, 1.5);
+            img_out(21, i) = n*s.m4/(s.m2*s.m2) - 3.0;
         }
     }
     catch (vigra::StdException & e)
@@ -512,6 +1651,130 @@ LIBEXPORT int vigra_extractfeatures_gray_c(const PixelType * arr_gray_in,
     return 0;
 }
 
+LIBEXPORT int vigra_regionfeatures_delete_c(void * feature_handle)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    try
+    {
+        RegionFeaturesHandle * handle = reinterpret_cast<RegionFeaturesHandle*>(feature_handle);
+        delete handle;
+    }
+    catch (vigra::StdException & e)
+    {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Internal helper to extract the region features of a RGB image w.r.t. an image
+ * of LabelType. The features are written to a view of shape (34, max_label+1).
+ */
+void extractFeaturesRGB(const ImageView & img_red,
+                        const ImageView & img_green,
+                        const ImageView & img_blue,
+                        const vigra::MultiArrayView<2, LabelType> & labels,
+                        ImageView & img_out,
+                        const int max_label)
+{
+    using namespace vigra::acc;
+    using namespace vigra::multi_math;
+    
+    ScratchImage<vigra::RGBValue<float> > src(img_red.shape());
+    // fill src image
+    src.bindElementChannel(0) = img_red;
+    src.bindElementChannel(1) = img_green;
+    src.bindElementChannel(2) = img_blue;
+    
+    //weights array (RGB->grey)
+    ScratchImage<double> weights(img_red.shape());
+    weights = 0.3*img_red + 0.59*img_green + 0.11*img_blue;
+    
+    //Order (x,y) with y = region_id (from 0...max_label) and:
+    // x=0          -> region_size,
+    // x=( 1 ..  2) -> upperleft-x and y-coord
+    // x=( 3 ..  4) -> lowerright-x and y-coord
+    // x=( 5 ..  6) -> mean-x and y-coord
+    // x=( 7 ..  9) -> min r,g,b value
+    // x=(10 .. 12) -> max r,g,b value
+    // x=(13 .. 15) -> mean r,g,b value
+    // x=(16 .. 18) -> stddev r,g,b value
+    // x=(19 .. 20) -> major ev: x and y-coord
+    // x=(21 .. 22) -> minor ev: x and y-coord
+    // x=23         -> major ew
+    // x=24         -> minor ew
+    // x=(25 .. 26) -> luminace weighted mean-x and y-coord
+    // x=27         -> perimeter (region contour length)
+    // x=(28 .. 30) -> skewness (red, green, blue)
+    // x=(31 .. 33) -> kurtosis (red, green, blue)
+    typedef
+        AccumulatorChainArray<vigra::CoupledArrays<2, vigra::RGBValue<float>, double, LabelType>,
+            Select< DataArg<1>, WeightArg<2>, LabelArg<3>, // in which array to look (coordinates are always arg 0)
+                    Count,
+                    Coord<Minimum>, Coord<Maximum>, Coord<Mean>,
+                    Minimum, Maximum, Mean, StdDev,
+                    RegionAxes, RegionRadii,
+                    Weighted<Coord<Mean>>,
+                    RegionPerimeter,
+                    Skewness, Kurtosis  > >
+        AccumulatorType;
+    
+    AccumulatorType a;
+    
+    extractFeatures(src, weights, labels, a);
+
+    for(unsigned int i=0; i!=max_label+1; ++i)
+    {
+        img_out( 0, i) = get<Count>(a,i);
+        
+        img_out( 1, i) = get<Coord<Minimum>>(a,i)[0];
+        img_out( 2, i) = get<Coord<Minimum>>(a,i)[1];
+        
+        img_out( 3, i) = get<Coord<Maximum>>(a,i)[0];
+        img_out( 4, i) = get<Coord<Maximum>>(a,i)[1];
+        
+        img_out( 5, i) = get<Coord<Mean>>(a,i)[0];
+        img_out( 6, i) = get<Coord<Mean>>(a,i)[1];
+        
+        img_out( 7, i) = get<Minimum>(a,i)[0];
+        img_out( 8, i) = get<Minimum>(a,i)[1];
+        img_out( 9, i) = get<Minimum>(a,i)[2];
+        
+        img_out(10, i) = get<Maximum>(a,i)[0];
+        img_out(11, i) = get<Maximum>(a,i)[1];
+        img_out(12, i) = get<Maximum>(a,i)[2];
+        
+        img_out(13, i) = get<Mean>(a,i)[0];
+        img_out(14, i) = get<Mean>(a,i)[1];
+        img_out(15, i) = get<Mean>(a,i)[2];
+        
+        img_out(16, i) = get<StdDev>(a,i)[0];
+        img_out(17, i) = get<StdDev>(a,i)[1];
+        img_out(18, i) = get<StdDev>(a,i)[2];
+        
+        img_out(19,i) = get<RegionAxes>(a,i)(0,0);
+        img_out(20,i) = get<RegionAxes>(a,i)(1,0);
+        img_out(21,i) = get<RegionAxes>(a,i)(0,1);
+        img_out(22,i) = get<RegionAxes>(a,i)(1,1);
+        
+        img_out(23,i) = get<RegionRadii>(a,i)[0];
+        img_out(24,i) = get<RegionRadii>(a,i)[1];
+        
+        img_out(25, i) = get<Weighted<Coord<Mean>>>(a,i)[0];
+        img_out(26, i) = get<Weighted<Coord<Mean>>>(a,i)[1];
+        
+        img_out(27, i) = get<RegionPerimeter>(a,i);
+        
+        img_out(28, i) = get<Skewness>(a,i)[0];
+        img_out(29, i) = get<Skewness>(a,i)[1];
+        img_out(30, i) = get<Skewness>(a,i)[2];
+        
+        img_out(31, i) = get<Kurtosis>(a,i)[0];
+        img_out(32, i) = get<Kurtosis>(a,i)[1];
+        img_out(33, i) = get<Kurtosis>(a,i)[2];
+    }
+}
+
 LIBEXPORT int vigra_extractfeatures_rgb_c( const PixelType * arr_r_in,
                                            const PixelType * arr_g_in,
                                            const PixelType * arr_b_in,
@@ -521,8 +1784,7 @@ LIBEXPORT int vigra_extractfeatures_rgb_c( const PixelType * arr_r_in,
                                            const int height_in,
                                            const int max_label)
 {
-    using namespace vigra::acc;
-    
+    VIGRA_C_STATS_SCOPE(4*std::size_t(width_in)*height_in*sizeof(PixelType));
     try
     {
         //write the color channels from the different arrays
@@ -531,109 +1793,48 @@ LIBEXPORT int vigra_extractfeatures_rgb_c( const PixelType * arr_r_in,
         ImageView img_green(shape_in, arr_g_in);
         ImageView img_blue(shape_in, arr_b_in);
         
-        vigra::MultiArray<2, vigra::RGBValue<float> > src(shape_in);
-        // fill src image
-        src.bindElementChannel(0) = img_red;
-        src.bindElementChannel(1) = img_green;
-        src.bindElementChannel(2) = img_blue;
-        
         ImageView labels_in(shape_in, arr_labels_in);
         
-        using namespace vigra::multi_math;
-        
-        //weights array (RGB->grey)
-        vigra::MultiArray<2, double> weights = 0.3*img_red + 0.59*img_green + 0.11*img_blue;
-        
-        
         //temp copy to int-type array
-        vigra::MultiArray<2, unsigned int> labels = labels_in;
-        
-        //Order (x,y) with y = region_id (from 0...max_label) and:
-        // x=0          -> region_size,
-        // x=( 1 ..  2) -> upperleft-x and y-coord
-        // x=( 3 ..  4) -> lowerright-x and y-coord
-        // x=( 5 ..  6) -> mean-x and y-coord
-        // x=( 7 ..  9) -> min r,g,b value
-        // x=(10 .. 12) -> max r,g,b value
-        // x=(13 .. 15) -> mean r,g,b value
-        // x=(16 .. 18) -> stddev r,g,b value
-        // x=(19 .. 20) -> major ev: x and y-coord
-        // x=(21 .. 22) -> minor ev: x and y-coord
-        // x=23         -> major ew
-        // x=24         -> minor ew
-        // x=(25 .. 26) -> luminace weighted mean-x and y-coord
-        // x=27         -> perimeter (region contour length)
-        // x=(28 .. 30) -> skewness (red, green, blue)
-        // x=(31 .. 33) -> kurtosis (red, green, blue)
+        ScratchImage<LabelType> labels(shape_in);
+        labels = labels_in;
+        
         vigra::Shape2 shape_out(34, max_label+1);
         ImageView img_out(shape_out, arr_out);
         
-        typedef
-            AccumulatorChainArray<vigra::CoupledArrays<2, vigra::RGBValue<float>, double, unsigned int>,
-                Select< DataArg<1>, WeightArg<2>, LabelArg<3>, // in which array to look (coordinates are always arg 0)
-                        Count,
-                        Coord<Minimum>, Coord<Maximum>, Coord<Mean>,
-                        Minimum, Maximum, Mean, StdDev,
-                        RegionAxes, RegionRadii,
-                        Weighted<Coord<Mean>>,
-                        RegionPerimeter,
-                        Skewness, Kurtosis  > >
-            AccumulatorType;
+        extractFeaturesRGB(img_red, img_green, img_blue, labels, img_out, max_label);
+    }
+    catch (vigra::StdException & e)
+    {
+        return 1;
+    }
+    return 0;
+}
+
+LIBEXPORT int vigra_extractfeatures_rgb_labels_c(const PixelType * arr_r_in,
+                                                 const PixelType * arr_g_in,
+                                                 const PixelType * arr_b_in,
+                                                 const LabelType * arr_labels_in,
+                                                 const PixelType * arr_out,
+                                                 const int width_in,
+                                                 const int height_in,
+                                                 const int max_label)
+{
+    VIGRA_C_STATS_SCOPE(std::size_t(width_in)*height_in*(3*sizeof(PixelType) + sizeof(LabelType)));
+    try
+    {
+        //write the color channels from the different arrays
+        vigra::Shape2 shape_in(width_in, height_in);
+        ImageView img_red(shape_in, arr_r_in);
+        ImageView img_green(shape_in, arr_g_in);
+        ImageView img_blue(shape_in, arr_b_in);
         
-        AccumulatorType a;
+        vigra::MultiArrayView<2, LabelType> labels(shape_in, arr_labels_in);
         
-        extractFeatures(src, weights, labels, a);
-
-        for(unsigned int i=0; i!=max_label+1; ++i)
-        {
-            img_out( 0, i) = get<Count>(a,i);
-            
-            img_out( 1, i) = get<Coord<Minimum>>(a,i)[0];
-            img_out( 2, i) = get<Coord<Minimum>>(a,i)[1];
-            
-            img_out( 3, i) = get<Coord<Maximum>>(a,i)[0];
-            img_out( 4, i) = get<Coord<Maximum>>(a,i)[1];
-            
-            img_out( 5, i) = get<Coord<Mean>>(a,i)[0];
-            img_out( 6, i) = get<Coord<Mean>>(a,i)[1];
-            
-            img_out( 7, i) = get<Minimum>(a,i)[0];
-            img_out( 8, i) = get<Minimum>(a,i)[1];
-            img_out( 9, i) = get<Minimum>(a,i)[2];
-            
-            img_out(10, i) = get<Maximum>(a,i)[0];
-            img_out(11, i) = get<Maximum>(a,i)[1];
-            img_out(12, i) = get<Maximum>(a,i)[2];
-            
-            img_out(13, i) = get<Mean>(a,i)[0];
-            img_out(14, i) = get<Mean>(a,i)[1];
-            img_out(15, i) = get<Mean>(a,i)[2];
-            
-            img_out(16, i) = get<StdDev>(a,i)[0];
-            img_out(17, i) = get<StdDev>(a,i)[1];
-            img_out(18, i) = get<StdDev>(a,i)[2];
-            
-            img_out(19,i) = get<RegionAxes>(a,i)(0,0);
-            img_out(20,i) = get<RegionAxes>(a,i)(1,0);
-            img_out(21,i) = get<RegionAxes>(a,i)(0,1);
-            img_out(22,i) = get<RegionAxes>(a,i)(1,1);
-            
-            img_out(23,i) = get<RegionRadii>(a,i)[0];
-            img_out(24,i) = get<RegionRadii>(a,i)[1];
-            
-            img_out(25, i) = get<Weighted<Coord<Mean>>>(a,i)[0];
-            img_out(26, i) = get<Weighted<Coord<Mean>>>(a,i)[1];
-            
-            img_out(27, i) = get<RegionPerimeter>(a,i);
-            
-            img_out(28, i) = get<Skewness>(a,i)[0];
-            img_out(29, i) = get<Skewness>(a,i)[1];
-            img_out(30, i) = get<Skewness>(a,i)[2];
-            
-            img_out(31, i) = get<Kurtosis>(a,i)[0];
-            img_out(32, i) = get<Kurtosis>(a,i)[1];
-            img_out(33, i) = get<Kurtosis>(a,i)[2];
-        }
+        vigra::Shape2 shape_out(34, max_label+1);
+        ImageView img_out(shape_out, arr_out);
+        
+        extractFeaturesRGB(img_red, img_green, img_blue, labels, img_out, max_label);
     }
     catch (vigra::StdException & e)
     {
@@ -48,12 +48,13 @@
  
 /**
  * Labels the connected components of an image band.
- * This function wraps the 
+ * This function computes the same labels as the
  * <a href="https://ukoethe.github.io/vigra/doc-release/vigra/group__Labeling.html">
  * vigra::labelImage
  * </a>
- * function to C to carry out a union-find algorithm. This finds the and sets 
- * unique labels for the connected components of same grayvalues in the given image.
+ * function by means of the block-parallel union-find algorithm of
+ * vigra_parallellabelimage_c. This finds the and sets unique labels for the
+ * connected components of same grayvalues in the given image.
  * All arrays must have been allocated before the call of this function.
  *
  * \param arr_in Flat input array (band) of size width*height.
@@ -73,12 +74,13 @@ LIBEXPORT int vigra_labelimage_c(const PixelType * arr_in,
 /**
  * Labels the connected components of an image band w.r.t. a background intensity,
  * which should not be considered by the lageling.
- * This function wraps the
+ * This function computes the same labels as the
  * <a href="https://ukoethe.github.io/vigra/doc-release/vigra/group__Labeling.html">
  * vigra::labelImageWithBackground
  * </a>
- * function to C to carry out a union-find algorithm. This finds the and sets 
- * unique labels for the connected components of same grayvalues in the given image.
+ * function by means of the block-parallel union-find algorithm of
+ * vigra_parallellabelimagewithbackground_c. This finds the and sets unique labels
+ * for the connected components of same grayvalues in the given image.
  * All arrays must have been allocated before the call of this function.
  *
  * \param arr_in Flat input array (band) of size width*height.
@@ -98,6 +100,111 @@ LIBEXPORT int vigra_labelimagewithbackground_c(const PixelType * arr_in,
                                                const bool eight_connectivity,
                                                const PixelType background);
 
+/**
+ * Labels the connected components of an image band by a block-parallel union-find
+ * algorithm. The image is split into horizontal strips, which are labeled in parallel.
+ * Afterwards, the components are merged along the seams of the strips. The labels
+ * are identical to those of vigra_labelimage_c, but written to a flat array of
+ * LabelType. Thus, the number of labels is neither restricted by the precision of
+ * PixelType nor by the return value.
+ * All arrays must have been allocated before the call of this function.
+ *
+ * \param arr_in Flat input array (band) of size width*height.
+ * \param[out] arr_out Flat array (labels) of size width*height.
+ * \param width The width of the flat array.
+ * \param height The height of the flat array.
+ * \param eight_connectivity If set to true, 8-conectivity is used, else 4.
+ * \param[out] label_count The largest label assigned. May be NULL.
+ *
+ * \return 0 if the labelling was sucessful, 1 else.
+ */
+LIBEXPORT int vigra_parallellabelimage_c(const PixelType * arr_in,
+                                         const LabelType * arr_out,
+                                         const int width,
+                                         const int height,
+                                         const bool eight_connectivity,
+                                         LabelType * label_count);
+
+/**
+ * Labels the connected components of an image band w.r.t. a background intensity
+ * by a block-parallel union-find algorithm. The labels are identical to those of
+ * vigra_labelimagewithbackground_c, but written to a flat array of LabelType.
+ * All arrays must have been allocated before the call of this function.
+ *
+ * \param arr_in Flat input array (band) of size width*height.
+ * \param[out] arr_out Flat array (labels) of size width*height.
+ * \param width The width of the flat array.
+ * \param height The height of the flat array.
+ * \param eight_connectivity If set to true, 8-conectivity is used, else 4.
+ * \param background Intensity value of the background. Will not be counted as
+ *        any label and will get label-id 0 at the final result.
+ * \param[out] label_count The largest label assigned. May be NULL.
+ *
+ * \return 0 if the labelling was sucessful, 1 else.
+ */
+LIBEXPORT int vigra_parallellabelimagewithbackground_c(const PixelType * arr_in,
+                                                       const LabelType * arr_out,
+                                                       const int width,
+                                                       const int height,
+                                                       const bool eight_connectivity,
+                                                       const PixelType background,
+                                                       LabelType * label_count);
+
+/**
+ * Defines a preprocessor macro for the interfaces of the typed labeling
+ * functions. These are available for the pixel types UInt8PixelType (suffix uint8)
+ * and UInt16PixelType (suffix uint16).
+ */
+#define LABELING_TYPED_FUNCTIONS_INTERFACE(suffix, type)                                                      \
+/**                                                                                                           \
+  Typed variant of vigra_labelimage_c for input bands of the given pixel type.                                \
+  The labels are written to a flat array of LabelType, thus the number of labels                              \
+  is not restricted by the precision of PixelType.                                                            \
+                                                                                                              \
+  \return If the labelling was sucessful, the largest label assigned, else -1.                                \
+ */                                                                                                           \
+LIBEXPORT int vigra_labelimage_##suffix##_c(const type * arr_in,                                              \
+                                            const LabelType * arr_out,                                        \
+                                            const int width,                                                  \
+                                            const int height,                                                 \
+                                            const bool eight_connectivity);                                   \
+/**                                                                                                           \
+  Typed variant of vigra_labelimagewithbackground_c for input bands of the given                              \
+  pixel type. The labels are written to a flat array of LabelType, thus the number                            \
+  of labels is not restricted by the precision of PixelType.                                                  \
+                                                                                                              \
+  \return If the labelling was sucessful, the largest label assigned, else -1.                                \
+ */                                                                                                           \
+LIBEXPORT int vigra_labelimagewithbackground_##suffix##_c(const type * arr_in,                                \
+                                                          const LabelType * arr_out,                          \
+                                                          const int width,                                    \
+                                                          const int height,                                   \
+                                                          const bool eight_connectivity,                      \
+                                                          const type background);                             \
+/**                                                                                                           \
+  Typed variant of vigra_parallellabelimage_c for input bands of the given pixel type.                        \
+ */                                                                                                           \
+LIBEXPORT int vigra_parallellabelimage_##suffix##_c(const type * arr_in,                                      \
+                                                    const LabelType * arr_out,                                \
+                                                    const int width,                                          \
+                                                    const int height,                                         \
+                                                    const bool eight_connectivity,                            \
+                                                    LabelType * label_count);                                 \
+/**                                                                                                           \
+  Typed variant of vigra_parallellabelimagewithbackground_c for input bands of the                            \
+  given pixel type.                                                                                           \
+ */                                                                                                           \
+LIBEXPORT int vigra_parallellabelimagewithbackground_##suffix##_c(const type * arr_in,                        \
+                                                                  const LabelType * arr_out,                  \
+                                                                  const int width,                            \
+                                                                  const int height,                           \
+                                                                  const bool eight_connectivity,              \
+                                                                  const type background,                      \
+                                                                  LabelType * label_count);
+
+LABELING_TYPED_FUNCTIONS_INTERFACE(uint8, UInt8PixelType)
+LABELING_TYPED_FUNCTIONS_INTERFACE(uint16, UInt16PixelType)
+
 /**
  * Applies the Watershed Transform to an image band.
  * This function wraps the
@@ -124,6 +231,19 @@ LIBEXPORT int vigra_watershedsunionfind_c(const PixelType * arr_in,
                                           const int width,
                                           const int height,
                                           const bool eight_connectivity);
+
+/**
+ * Variant of vigra_watershedsunionfind_c, which writes the labels to a flat array
+ * of LabelType. Thus, the number of labels is not restricted by the precision of
+ * PixelType and no conversion of the labels is needed.
+ *
+ * \return If the segmentation was sucessful, the largest label assigned, else -1.
+ */
+LIBEXPORT int vigra_watershedsunionfind_labels_c(const PixelType * arr_in,
+                                                 const LabelType * arr_out,
+                                                 const int width,
+                                                 const int height,
+                                                 const bool eight_connectivity);
                                           
 /**
  * Applies the Watershed Transform to an image band.
@@ -160,6 +280,21 @@ LIBEXPORT int vigra_watershedsregiongrowing_c(const PixelType * arr_in,
                                               const bool use_turbo,
                                               const double stop_cost);
 
+/**
+ * Variant of vigra_watershedsregiongrowing_c, which reads the seeds from and writes
+ * the labels to a flat array of LabelType.
+ *
+ * \return If the segmentation was sucessful, the largest label assigned, else -1.
+ */
+LIBEXPORT int vigra_watershedsregiongrowing_labels_c(const PixelType * arr_in,
+                                                     const LabelType * arr_inout,
+                                                     const int width,
+                                                     const int height,
+                                                     const bool eight_connectivity,
+                                                     const bool keep_contours,
+                                                     const bool use_turbo,
+                                                     const double stop_cost);
+
 /**
  * Applies the SLIC segmenation to an image band.
  * This function wraps the
@@ -189,6 +324,19 @@ LIBEXPORT int vigra_slic_gray_c(const PixelType * arr_in,
                                 const double intensityScaling,
                                 const int iterations);
 
+/**
+ * Variant of vigra_slic_gray_c, which writes the labels to a flat array of LabelType.
+ *
+ * \return If the segmentation was sucessful, the largest label assigned, else -1.
+ */
+LIBEXPORT int vigra_slic_gray_labels_c(const PixelType * arr_in,
+                                       const LabelType * arr_out,
+                                       const int width,
+                                       const int height,
+                                       const int seedDistance,
+                                       const double intensityScaling,
+                                       const int iterations);
+
 /**
  * Applies the SLIC segmenation to an RGB image.
  * This function wraps the
@@ -223,6 +371,21 @@ LIBEXPORT int vigra_slic_rgb_c(const PixelType * arr_r_in,
                                const double intensityScaling,
                                const int iterations);
 
+/**
+ * Variant of vigra_slic_rgb_c, which writes the labels to a flat array of LabelType.
+ *
+ * \return If the segmentation was sucessful, the largest label assigned, else -1.
+ */
+LIBEXPORT int vigra_slic_rgb_labels_c(const PixelType * arr_r_in,
+                                      const PixelType * arr_g_in,
+                                      const PixelType * arr_b_in,
+                                      const LabelType * arr_out,
+                                      const int width,
+                                      const int height,
+                                      const int seedDistance,
+                                      const double intensityScaling,
+                                      const int iterations);
+
 /**
  * Computation of the Canny Edge Detector.
  * This function wraps the
@@ -309,6 +472,18 @@ LIBEXPORT int vigra_regionimagetocrackedgeimage_c(const PixelType * arr_in,
                                                   const int height_in,
                                                   const float mark);
 
+/**
+ * Variant of vigra_regionimagetocrackedgeimage_c for label bands of LabelType.
+ * The crack-edges are written to a flat array of LabelType, too.
+ *
+ * \return 0 if the crackedge image generation was successful, 1 else.
+ */
+LIBEXPORT int vigra_regionimagetocrackedgeimage_labels_c(const LabelType * arr_in,
+                                                         const LabelType * arr_out,
+                                                         const int width_in,
+                                                         const int height_in,
+                                                         const LabelType mark);
+
 /**
  * Extracts features from a given label image band w.r.t. its corresponding
  * grey value intensity band. This function internally maps the
@@ -356,6 +531,103 @@ LIBEXPORT int vigra_extractfeatures_gray_c(const PixelType * arr_gray_in,
                                            const int height_in,
                                            const int max_label);
 
+/**
+ * Variant of vigra_extractfeatures_gray_c for label bands of LabelType, which
+ * are used without any conversion.
+ *
+ * \return 0 if the feature extraction was successful, 1 else.
+ */
+LIBEXPORT int vigra_extractfeatures_gray_labels_c(const PixelType * arr_gray_in,
+                                                  const LabelType * arr_labels_in,
+                                                  const PixelType * arr_out,
+                                                  const int width_in,
+                                                  const int height_in,
+                                                  const int max_label);
+
+/**
+ * Creates a handle for the streaming extraction of the region features of
+ * vigra_extractfeatures_gray_c. Other than there, the gray value and label bands
+ * need not be in memory at once, but are fed tile by tile by means of
+ * vigra_regionfeatures_addtile_c. Thus, the features of images can be computed,
+ * which do not fit into memory. All statistics are accumulated in one pass and the
+ * partial results of the tiles are merged. Only the labels of the border pixels of
+ * each tile are kept to compute the perimeters, when the features are finalized by
+ * vigra_regionfeatures_finalize_c.
+ * The handle needs to be deleted by vigra_regionfeatures_delete_c.
+ *
+ * \param max_label The maximum region label to derive statistics for.
+ *
+ * \return The feature handle, or NULL if max_label is invalid.
+ */
+LIBEXPORT void * vigra_regionfeatures_create_c(const int max_label);
+
+/**
+ * Adds a tile of a gray value band and its corresponding labels to the region
+ * features of a handle. The tiles must not overlap, i.e. each pixel of the image
+ * must be added once. This function may be called by different threads for the
+ * same handle at the same time. The statistics of each tile are accumulated
+ * without locking and merged into the handle afterwards.
+ *
+ * \param feature_handle The feature handle.
+ * \param arr_gray_in Flat input array (band) of size width*height.
+ * \param arr_labels_in Flat input array (labels) of size width*height.
+ * \param width The width of the tile.
+ * \param height The height of the tile.
+ * \param offset_x The x-coordinate of the upper left pixel of the tile in the image.
+ * \param offset_y The y-coordinate of the upper left pixel of the tile in the image.
+ *
+ * \return 0 if the tile has been added,
+ *         2 if a label is larger than the maximum label of the handle,
+ *         1 else.
+ */
+LIBEXPORT int vigra_regionfeatures_addtile_c(void * feature_handle,
+                                             const PixelType * arr_gray_in,
+                                             const LabelType * arr_labels_in,
+                                             const int width,
+                                             const int height,
+                                             const int offset_x,
+                                             const int offset_y);
+
+/**
+ * Merges the partial region features of another handle, e.g. of another worker,
+ * into a handle. Both handles need to have the same maximum label and their tiles
+ * must not overlap. The other handle is not changed and still needs to be deleted.
+ *
+ * \param feature_handle The feature handle to merge into.
+ * \param other_feature_handle The feature handle to be merged.
+ *
+ * \return 0 if the merge was successful,
+ *         2 if the maximum labels of the handles differ,
+ *         1 else.
+ */
+LIBEXPORT int vigra_regionfeatures_merge_c(void * feature_handle,
+                                           void * other_feature_handle);
+
+/**
+ * Writes the region features of a handle to a flat array of size 22*(max_label+1).
+ * The features have the same order as for vigra_extractfeatures_gray_c. There are
+ * two differences: First, the perimeter (index 19) is the length of all contours of
+ * a region including the contours of its holes. Second, all features of regions
+ * without any pixel are set to 0. The handle may be finalized several times, e.g.
+ * to get intermediate results.
+ *
+ * \param feature_handle The feature handle.
+ * \param[out] arr_out Flat array (results) of size 22*(max_label+1).
+ *
+ * \return 0 if the features have been written, 1 else.
+ */
+LIBEXPORT int vigra_regionfeatures_finalize_c(void * feature_handle,
+                                              const PixelType * arr_out);
+
+/**
+ * Deletes a handle, which has been created by vigra_regionfeatures_create_c.
+ *
+ * \param feature_handle The feature handle.
+ *
+ * \return 0 on success, else 1.
+ */
+LIBEXPORT int vigra_regionfeatures_delete_c(void * feature_handle);
+
 /**
  * Extracts features from a given label image band w.r.t. its corresponding
  * rgb value intensity bands. This function internally maps the
@@ -408,6 +680,21 @@ LIBEXPORT int vigra_extractfeatures_rgb_c(const PixelType * arr_r_in,
                                            const int width_in,
                                            const int height_in,
                                            const int max_label);
+
+/**
+ * Variant of vigra_extractfeatures_rgb_c for label bands of LabelType, which
+ * are used without any conversion.
+ *
+ * \return 0 if the feature extraction was successful, 1 else.
+ */
+LIBEXPORT int vigra_extractfeatures_rgb_labels_c(const PixelType * arr_r_in,
+                                                 const PixelType * arr_g_in,
+                                                 const PixelType * arr_b_in,
+                                                 const LabelType * arr_labels_in,
+                                                 const PixelType * arr_out,
+                                                 const int width_in,
+                                                 const int height_in,
+                                                 const int max_label);
 /**
  * @}
  */
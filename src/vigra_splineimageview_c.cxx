@@ -33,6 +33,7 @@
 /************************************************************************/
 
 #include "vigra_splineimageview_c.h"
+#include "vigra_statsutils_c.h"
 #include <vigra/splineimageview.hxx>
 
 
@@ -77,6 +78,7 @@ LIBEXPORT void * vigra_create_splineimageview##order##_c(const PixelType *arr_in
                                                          const int width,         \
                                                          const int height)	      \
 {                                                                                 \
+  VIGRA_C_STATS_SCOPE(std::size_t(width)*height*sizeof(PixelType));               \
   ImageView img(vigra::Shape2(width, height), arr_in);							  \
   return new SplineImageView##order (img);								          \
 }
@@ -93,6 +95,7 @@ SIV_CREATION_FUNCTION(5)
 #define SIV_DELETION_FUNCTION(order)                                  \
 LIBEXPORT int vigra_delete_splineimageview##order##_c(void * siv)     \
 {                                                                     \
+  VIGRA_C_STATS_SCOPE(0);                                             \
   SplineImageView##order * siv_ptr = (SplineImageView##order * ) siv; \
   delete siv_ptr;                                                     \
   return 0;                                                           \
@@ -238,6 +241,7 @@ LIBEXPORT unsigned long vigra_create_splineimageview##order##_address_c(const Pi
                                                                         const int width,         \
                                                                         const int height)	     \
 {                                                                                                \
+  VIGRA_C_STATS_SCOPE(std::size_t(width)*height*sizeof(PixelType));                              \
   ImageView img(vigra::Shape2(width, height), arr_in);                                           \
   SplineImageView##order* siv = new SplineImageView##order(img);                                 \
   return (unsigned long) siv;                                                                    \
@@ -255,6 +259,7 @@ SIV_ADDRESS_CREATION_FUNCTION(5)
 #define SIV_DELETION_BY_ADDRESS_FUNCTION(order)                                               \
 LIBEXPORT int vigra_delete_splineimageview##order##_by_address_c(const unsigned long address) \
 {                                                                                             \
+  VIGRA_C_STATS_SCOPE(0);                                                                     \
   SplineImageView##order * siv = (SplineImageView##order * ) address;                         \
   delete siv;                                                                                 \
   return 0;                                                                                   \
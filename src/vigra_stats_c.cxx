@@ -0,0 +1,394 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#include "vigra_stats_c.h"
+#include "vigra_statsutils_c.h"
+
+#ifdef VIGRA_C_STATS
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+#endif
+
+
+/**
+ * @file
+ * @brief Implementation of the instrumentation of the exported functions
+ */
+
+#ifdef VIGRA_C_STATS
+
+/**
+ * The maximal number of instrumented functions.
+ */
+static const int max_stats_functions = 1024;
+
+/**
+ * The counters of one function. They are updated by the owning thread and may
+ * be reset by other threads, thus the updates are atomic read-modify-write
+ * operations. Relaxed ordering suffices, since no other data depends on them.
+ */
+struct FunctionCounters
+{
+    std::atomic<unsigned long long> calls;
+    std::atomic<unsigned long long> total_ns;
+    std::atomic<unsigned long long> max_ns;
+    std::atomic<unsigned long long> bytes;
+    std::atomic<unsigned long long> allocations;
+};
+
+/**
+ * The counters of all functions of one thread.
+ */
+struct ThreadCounters
+{
+    FunctionCounters functions[max_stats_functions];
+};
+
+/**
+ * The mutex, which guards the function names and the list of thread counters.
+ * It is only locked at the registration of functions and threads and for
+ * snapshots and resets, but not while recording calls.
+ */
+static std::mutex stats_mutex;
+
+/**
+ * The names of the registered functions.
+ */
+static std::vector<std::string> stats_function_names;
+
+/**
+ * The counters of all threads, which have called an instrumented function.
+ * They are kept until the library is unloaded, so that the statistics of 
+ * finished threads are not lost.
+ */
+static std::vector<ThreadCounters*> stats_thread_counters;
+
+/**
+ * The counters of finished threads, which are reused by new threads, and their
+ * mutex. Both are intentionally never destroyed, since threads of the worker
+ * pool may exit after the static destructors of this file have been run.
+ */
+static std::mutex & freeCountersMutex()
+{
+    static std::mutex * mutex = new std::mutex;
+    return *mutex;
+}
+
+static std::vector<ThreadCounters*> & freeCounters()
+{
+    static std::vector<ThreadCounters*> * free_counters = new std::vector<ThreadCounters*>;
+    return *free_counters;
+}
+
+/**
+ * The counters of the current thread, which are given back for reuse, when
+ * the thread exits. Thus, the number of counters is bounded by the maximal
+ * number of concurrent threads, even if many short-lived threads call vigra_c.
+ */
+static thread_local struct LocalCounters
+{
+    ThreadCounters * counters = nullptr;
+    
+    ~LocalCounters()
+    {
+        if(counters != nullptr)
+        {
+            std::lock_guard<std::mutex> lock(freeCountersMutex());
+            freeCounters().push_back(counters);
+        }
+    }
+} local_counters;
+
+/**
+ * The number of heap allocations of the current thread.
+ */
+static thread_local unsigned long long local_allocations = 0;
+
+static ThreadCounters & localCounters()
+{
+    if(local_counters.counters == nullptr)
+    {
+        //The counters of a finished thread keep their statistics and are continued
+        {
+            std::lock_guard<std::mutex> lock(freeCountersMutex());
+            std::vector<ThreadCounters*> & free_counters = freeCounters();
+            
+            if(!free_counters.empty())
+            {
+                local_counters.counters = free_counters.back();
+                free_counters.pop_back();
+                return *local_counters.counters;
+            }
+        }
+        
+        ThreadCounters * counters = new ThreadCounters();
+        
+        std::lock_guard<std::mutex> lock(stats_mutex);
+        stats_thread_counters.push_back(counters);
+        local_counters.counters = counters;
+    }
+    return *local_counters.counters;
+}
+
+int statsRegisterFunction(const char * name)
+{
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    
+    if(stats_function_names.size() >= (std::size_t)max_stats_functions)
+    {
+        return -1;
+    }
+    stats_function_names.push_back(name);
+    return int(stats_function_names.size()) - 1;
+}
+
+StatsScope::StatsScope(const int function, const unsigned long long bytes)
+: m_function(function),
+  m_bytes(bytes),
+  m_allocations(local_allocations),
+  m_start(std::chrono::steady_clock::now())
+{
+}
+
+StatsScope::~StatsScope()
+{
+    if(m_function < 0)
+    {
+        return;
+    }
+    
+    unsigned long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now() - m_start).count();
+    
+    FunctionCounters & counters = localCounters().functions[m_function];
+    
+    //Read-modify-write operations, so that a concurrent reset is never lost
+    counters.calls.fetch_add(1, std::memory_order_relaxed);
+    counters.total_ns.fetch_add(ns, std::memory_order_relaxed);
+    counters.bytes.fetch_add(m_bytes, std::memory_order_relaxed);
+    counters.allocations.fetch_add(local_allocations - m_allocations, std::memory_order_relaxed);
+    
+    unsigned long long max_ns = counters.max_ns.load(std::memory_order_relaxed);
+    while(ns > max_ns && !counters.max_ns.compare_exchange_weak(max_ns, ns, std::memory_order_relaxed))
+    {
+    }
+}
+
+/**
+ * Internal helper to create the JSON report of the statistics of all threads.
+ */
+static std::string statsReport()
+{
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    
+    std::ostringstream report;
+    report << "[";
+    
+    bool first = true;
+    
+    for(std::size_t f=0; f<stats_function_names.size(); ++f)
+    {
+        unsigned long long calls = 0, total_ns = 0, max_ns = 0, bytes = 0, allocations = 0;
+        
+        for(ThreadCounters * thread : stats_thread_counters)
+        {
+            const FunctionCounters & counters = thread->functions[f];
+            calls       += counters.calls.load(std::memory_order_relaxed);
+            total_ns    += counters.total_ns.load(std::memory_order_relaxed);
+            bytes       += counters.bytes.load(std::memory_order_relaxed);
+            allocations += counters.allocations.load(std::memory_order_relaxed);
+            max_ns = std::max(max_ns, counters.max_ns.load(std::memory_order_relaxed));
+        }
+        
+        if(calls == 0)
+        {
+            continue;
+        }
+        
+        report << (first ? "\n" : ",\n")
+               << "  {\"name\": \"" << stats_function_names[f] << "\""
+               << ", \"calls\": " << calls
+               << ", \"total_ms\": " << total_ns/1e6
+               << ", \"max_ms\": " << max_ns/1e6
+               << ", \"bytes\": " << bytes
+               << ", \"allocations\": " << allocations << "}";
+        first = false;
+    }
+    report << "\n]\n";
+    return report.str();
+}
+
+/**
+ * Writes the report at the unloading of the library, if the environment
+ * variable VIGRA_C_STATS_REPORT is set. Declared after the counters, so that
+ * it is destroyed before them.
+ */
+static struct StatsReportAtExit
+{
+    ~StatsReportAtExit()
+    {
+        const char * target = std::getenv("VIGRA_C_STATS_REPORT");
+        
+        if(target == nullptr || *target == 0)
+        {
+            return;
+        }
+        
+        std::string report = statsReport();
+        
+        if(std::strcmp(target, "stderr") == 0)
+        {
+            std::fputs(report.c_str(), stderr);
+        }
+        else if(FILE * file = std::fopen(target, "w"))
+        {
+            std::fputs(report.c_str(), file);
+            std::fclose(file);
+        }
+    }
+} stats_report_at_exit;
+
+/**
+ * The replaced global allocation functions count the heap allocations of the
+ * current thread. Please note, that on platforms with a flat symbol namespace
+ * (like Linux), they replace the allocation functions of the whole process.
+ */
+void * operator new(std::size_t size)
+{
+    ++local_allocations;
+    
+    if(void * ptr = std::malloc(size ? size : 1))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void * operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void * operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    ++local_allocations;
+    return std::malloc(size ? size : 1);
+}
+
+void * operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return operator new(size, std::nothrow);
+}
+
+void operator delete(void * ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void * ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void * ptr, const std::nothrow_t &) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void * ptr, const std::nothrow_t &) noexcept
+{
+    std::free(ptr);
+}
+
+#endif
+
+
+LIBEXPORT int vigra_stats_enabled_c()
+{
+#ifdef VIGRA_C_STATS
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+LIBEXPORT int vigra_stats_snapshot_c(char * report_out, const int size)
+{
+#ifdef VIGRA_C_STATS
+    std::string report = statsReport();
+    
+    if(report_out != nullptr && size > 0)
+    {
+        std::size_t n = std::min(report.size(), std::size_t(size - 1));
+        std::memcpy(report_out, report.data(), n);
+        report_out[n] = 0;
+    }
+    return int(report.size());
+#else
+    (void)report_out;
+    (void)size;
+    return -1;
+#endif
+}
+
+LIBEXPORT int vigra_stats_reset_c()
+{
+#ifdef VIGRA_C_STATS
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    
+    for(ThreadCounters * thread : stats_thread_counters)
+    {
+        for(FunctionCounters & counters : thread->functions)
+        {
+            counters.calls.store(0, std::memory_order_relaxed);
+            counters.total_ns.store(0, std::memory_order_relaxed);
+            counters.max_ns.store(0, std::memory_order_relaxed);
+            counters.bytes.store(0, std::memory_order_relaxed);
+            counters.allocations.store(0, std::memory_order_relaxed);
+        }
+    }
+    return 0;
+#else
+    return 1;
+#endif
+}
@@ -0,0 +1,98 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#ifndef VIGRA_STATS_C_H
+#define VIGRA_STATS_C_H
+
+#include "config.h"
+
+/**
+ * @file
+ * @brief Header file for the instrumentation of the exported functions
+ *
+ * @defgroup stats Instrumentation
+ * @{
+ *    @brief Call counts, timings and memory statistics of the exported functions
+ *
+ * If vigra_c has been built with the CMake option VIGRA_C_STATS, each exported
+ * function records its number of calls, the cumulative and maximal wall time,
+ * the bytes of the image arrays it reads and writes, and the number of heap 
+ * allocations of the calling thread. The counters are kept per thread and
+ * updated without locks. Without this option, no instrumentation code is 
+ * compiled into the exported functions.
+ *
+ * If the environment variable VIGRA_C_STATS_REPORT is set, a report is written
+ * when the library is unloaded: to stderr, if the variable is set to "stderr",
+ * else to the file of the given name.
+ */
+
+/**
+ * Tells if vigra_c has been built with the instrumentation.
+ *
+ * \return 1 if the instrumentation is available, 0 else.
+ */
+LIBEXPORT int vigra_stats_enabled_c();
+
+/**
+ * Writes a snapshot of the statistics of all threads as a JSON report into
+ * a caller-allocated character buffer. The report contains one entry for each
+ * function, which has been called since the last reset, with the fields 
+ * "name", "calls", "total_ms", "max_ms", "bytes" and "allocations".
+ * If the buffer is too small, the report is truncated. The result is always
+ * null-terminated.
+ *
+ * \param report_out The character buffer.
+ * \param size The size of the character buffer.
+ *
+ * \return The length of the complete report (without the terminating null
+ *         character), or -1 if the instrumentation is not available.
+ */
+LIBEXPORT int vigra_stats_snapshot_c(char * report_out, const int size);
+
+/**
+ * Resets the statistics of all threads.
+ * Please note, that this function should not be called while other threads
+ * are executing vigra_c functions.
+ *
+ * \return 0 if the statistics have been reset, 
+ *         1 if the instrumentation is not available.
+ */
+LIBEXPORT int vigra_stats_reset_c();
+
+/**
+ * @}
+ */
+
+#endif
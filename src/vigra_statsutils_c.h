@@ -0,0 +1,98 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#ifndef VIGRA_STATSUTILS_H
+#define VIGRA_STATSUTILS_H
+
+#ifdef VIGRA_C_STATS
+#include <chrono>
+#endif
+
+/**
+ * @file
+ * @brief Header-only file for the instrumentation of the exported functions
+ *
+ * @defgroup statsutils Instrumentation utilities
+ * @{
+ *    @brief Internal scope guard, which records the statistics of an exported function (Header-only file)
+ */
+
+#ifdef VIGRA_C_STATS
+
+/**
+ * Internal helper to register an instrumented function. 
+ *
+ * \param name The name of the function.
+ *
+ * \return The index of the function, or -1 if too many functions have been registered.
+ */
+int statsRegisterFunction(const char * name);
+
+/**
+ * Internal scope guard, which records one call of an instrumented function
+ * in the counters of the calling thread, when it is destroyed.
+ */
+class StatsScope
+{
+public:
+    StatsScope(const int function, const unsigned long long bytes);
+    ~StatsScope();
+    
+private:
+    int m_function;
+    unsigned long long m_bytes;
+    unsigned long long m_allocations;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+/**
+ * Instruments the enclosing exported function. The argument gives the bytes of
+ * the image arrays, which are read and written by the function.
+ */
+#define VIGRA_C_STATS_SCOPE(bytes)                                                        \
+    static const int vigra_c_stats_function = statsRegisterFunction(__func__);            \
+    StatsScope vigra_c_stats_scope(vigra_c_stats_function, (unsigned long long)(bytes))
+
+#else
+
+#define VIGRA_C_STATS_SCOPE(bytes)
+
+#endif
+
+/**
+ * @}
+ */
+
+#endif
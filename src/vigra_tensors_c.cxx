@@ -34,6 +34,9 @@
 
 #include "vigra_tensors_c.h"
 #include "vigra_kernelutils_c.h"
+#include "vigra_parallelutils_c.h"
+#include "vigra_arenautils_c.h"
+#include "vigra_statsutils_c.h"
 #include <vigra/tensorutilities.hxx>
 #include <vigra/gradient_energy_tensor.hxx>
 #include <vigra/boundarytensor.hxx>
@@ -77,6 +80,7 @@ LIBEXPORT int vigra_structuretensor_c(const PixelType * arr_in,
                                       const float inner_scale,
                                       const float outer_scale)
 {
+    VIGRA_C_STATS_SCOPE(4*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -123,6 +127,7 @@ LIBEXPORT int vigra_boundarytensor_c(const PixelType * arr_in,
                                      const int height,
                                      const float scale)
 {
+    VIGRA_C_STATS_SCOPE(4*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -133,7 +138,7 @@ LIBEXPORT int vigra_boundarytensor_c(const PixelType * arr_in,
         ImageView img_yy(shape, arr_yy_out);
         
         //create the temporary tensor
-        vigra::MultiArray<2, vigra::TinyVector<float, 3> > tensor(width,height);
+        ScratchImage<vigra::TinyVector<float, 3> > tensor(width,height);
         
         vigra::boundaryTensor(img_in, tensor, scale);
         
@@ -186,6 +191,7 @@ LIBEXPORT int vigra_boundarytensor1_c(const PixelType * arr_in,
                                       const int height,
                                       const float scale)
 {
+    VIGRA_C_STATS_SCOPE(4*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -196,7 +202,7 @@ LIBEXPORT int vigra_boundarytensor1_c(const PixelType * arr_in,
         ImageView img_yy(shape, arr_yy_out);
         
         //create the temporary tensor
-        vigra::MultiArray<2, vigra::TinyVector<float, 3> > tensor(width,height);
+        ScratchImage<vigra::TinyVector<float, 3> > tensor(width,height);
         
         vigra::boundaryTensor1(img_in, tensor, scale);
         
@@ -256,6 +262,7 @@ LIBEXPORT int vigra_gradientenergytensor_c(const PixelType * arr_in,
                                            const int derivKernel_size,
                                            const int smoothKernel_size)
 {
+    VIGRA_C_STATS_SCOPE(4*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -270,7 +277,7 @@ LIBEXPORT int vigra_gradientenergytensor_c(const PixelType * arr_in,
             return 2;
         
         //create the temporary tensor
-        vigra::MultiArray<2, vigra::TinyVector<float, 3> > tensor(width,height);
+        ScratchImage<vigra::TinyVector<float, 3> > tensor(width,height);
         
         vigra::gradientEnergyTensor(img_in, tensor,
                                     kernel1dFromArray(arr_derivKernel_in, derivKernel_size),
@@ -325,6 +332,7 @@ LIBEXPORT int vigra_tensoreigenrepresentation_c(const PixelType * arr_xx_in,
                                                 const int width,
                                                 const int height)
 {
+    VIGRA_C_STATS_SCOPE(6*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -338,7 +346,7 @@ LIBEXPORT int vigra_tensoreigenrepresentation_c(const PixelType * arr_xx_in,
         ImageView img_ang(shape, arr_ang_out);
         
         //create the temporary tensor
-        vigra::MultiArray<2, vigra::TinyVector<float, 3> > tensor(width,height);
+        ScratchImage<vigra::TinyVector<float, 3> > tensor(width,height);
         
         auto xx_iter = img_xx.begin(),
              xy_iter = img_xy.begin(),
@@ -400,6 +408,7 @@ LIBEXPORT int vigra_tensortrace_c(const PixelType * arr_xx_in,
                                   const int width,
                                   const int height)
 {
+    VIGRA_C_STATS_SCOPE(4*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -410,7 +419,7 @@ LIBEXPORT int vigra_tensortrace_c(const PixelType * arr_xx_in,
         ImageView img_trace(shape, arr_trace_out);
         
         //create the temporary tensor
-        vigra::MultiArray<2, vigra::TinyVector<float, 3> > tensor(width,height);
+        ScratchImage<vigra::TinyVector<float, 3> > tensor(width,height);
         
         auto xx_iter = img_xx.begin(),
         xy_iter = img_xy.begin(),
@@ -464,6 +473,7 @@ LIBEXPORT int vigra_tensortoedgecorner_c(const PixelType * arr_xx_in,
                                          const int width,
                                          const int height)
 {
+    VIGRA_C_STATS_SCOPE(6*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -477,8 +487,8 @@ LIBEXPORT int vigra_tensortoedgecorner_c(const PixelType * arr_xx_in,
         ImageView img_cornerness(shape, arr_cornerness_out);
         
         //create the temporary tensor
-        vigra::MultiArray<2, vigra::TinyVector<float, 3> > tensor(width,height);
-        vigra::MultiArray<2, vigra::TinyVector<float, 2> > edgePart(width,height);
+        ScratchImage<vigra::TinyVector<float, 3> > tensor(width,height);
+        ScratchImage<vigra::TinyVector<float, 2> > edgePart(width,height);
         
         auto xx_iter = img_xx.begin(),
         xy_iter = img_xy.begin(),
@@ -543,6 +553,7 @@ LIBEXPORT int vigra_hourglassfilter_c(const PixelType * arr_xx_in,
                                       const float sigma,
                                       const float rho)
 {
+    VIGRA_C_STATS_SCOPE(6*std::size_t(width)*height*sizeof(PixelType));
     try
     {
         //Create gray scale image views for the arrays
@@ -556,8 +567,8 @@ LIBEXPORT int vigra_hourglassfilter_c(const PixelType * arr_xx_in,
         ImageView img_hgyy(shape, arr_hgyy_out);
         
         //create the temporary tensor
-        vigra::MultiArray<2, vigra::TinyVector<float, 3> > tensor(width,height);
-        vigra::MultiArray<2, vigra::TinyVector<float, 3> > hg_tensor(width,height);
+        ScratchImage<vigra::TinyVector<float, 3> > tensor(width,height);
+        ScratchImage<vigra::TinyVector<float, 3> > hg_tensor(width,height);
         
         auto xx_iter = img_xx.begin(),
         xy_iter = img_xy.begin(),
@@ -591,3 +602,47 @@ LIBEXPORT int vigra_hourglassfilter_c(const PixelType * arr_xx_in,
     
     return 0;
 }
+
+LIBEXPORT void * vigra_structuretensor_async_c(const PixelType * arr_in,
+                                               const PixelType * arr_xx_out,
+                                               const PixelType * arr_xy_out,
+                                               const PixelType * arr_yy_out,
+                                               const int width,
+                                               const int height,
+                                               const float inner_scale,
+                                               const float outer_scale)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    return submitJob([=]()
+                     {
+                         return vigra_structuretensor_c(arr_in,
+                                                        arr_xx_out,
+                                                        arr_xy_out,
+                                                        arr_yy_out,
+                                                        width,
+                                                        height,
+                                                        inner_scale,
+                                                        outer_scale);
+                     });
+}
+
+LIBEXPORT void * vigra_boundarytensor_async_c(const PixelType * arr_in,
+                                              const PixelType * arr_xx_out,
+                                              const PixelType * arr_xy_out,
+                                              const PixelType * arr_yy_out,
+                                              const int width,
+                                              const int height,
+                                              const float scale)
+{
+    VIGRA_C_STATS_SCOPE(0);
+    return submitJob([=]()
+                     {
+                         return vigra_boundarytensor_c(arr_in,
+                                                       arr_xx_out,
+                                                       arr_xy_out,
+                                                       arr_yy_out,
+                                                       width,
+                                                       height,
+                                                       scale);
+                     });
+}
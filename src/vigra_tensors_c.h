@@ -286,6 +286,43 @@ LIBEXPORT int vigra_hourglassfilter_c(const PixelType * arr_xx_in,
                                       const float rho);
 
 
+/**
+ * Asynchronous variant of vigra_structuretensor_c.
+ * Submits the computation to the library's worker pool and returns immediately.
+ * All arrays must have been allocated before the call of this function and
+ * must stay valid until the job has been finished.
+ * The parameters are the same as for vigra_structuretensor_c.
+ *
+ * \return A job handle, which needs to be released by vigra_job_wait_c.
+ *         The result of vigra_job_wait_c is the return value of vigra_structuretensor_c.
+ */
+LIBEXPORT void * vigra_structuretensor_async_c(const PixelType * arr_in,
+                                               const PixelType * arr_xx_out,
+                                               const PixelType * arr_xy_out,
+                                               const PixelType * arr_yy_out,
+                                               const int width,
+                                               const int height,
+                                               const float inner_scale,
+                                               const float outer_scale);
+
+/**
+ * Asynchronous variant of vigra_boundarytensor_c.
+ * Submits the computation to the library's worker pool and returns immediately.
+ * All arrays must have been allocated before the call of this function and
+ * must stay valid until the job has been finished.
+ * The parameters are the same as for vigra_boundarytensor_c.
+ *
+ * \return A job handle, which needs to be released by vigra_job_wait_c.
+ *         The result of vigra_job_wait_c is the return value of vigra_boundarytensor_c.
+ */
+LIBEXPORT void * vigra_boundarytensor_async_c(const PixelType * arr_in,
+                                              const PixelType * arr_xx_out,
+                                              const PixelType * arr_xy_out,
+                                              const PixelType * arr_yy_out,
+                                              const int width,
+                                              const int height,
+                                              const float scale);
+
 /**
  * @}
  */
@@ -0,0 +1,121 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+#ifndef VIGRA_TYPEUTILS_H
+#define VIGRA_TYPEUTILS_H
+
+#include "config.h"
+#include <limits>
+#include <string>
+
+/**
+ * @file
+ * @brief Header-only file for pixel type utilities
+ *
+ * @defgroup typeutils Pixel type utilities
+ * @{
+ *    @brief Internal helpers for the typed variants of the functions (Header-only file)
+ */
+
+/**
+ * Internal traits class for the pixel types of the typed function variants.
+ * It defines the vigra codec name of the pixel type and a saturating conversion
+ * from real values.
+ */
+template <class T>
+struct PixelTypeTraits
+{
+    /**
+     * The vigra codec name of the pixel type.
+     */
+    static std::string name();
+    
+    /**
+     * Converts a real value to the pixel type by rounding to the nearest value
+     * and saturating at the limits of the pixel type. NaN is converted to zero.
+     *
+     * \param v The real value.
+     *
+     * \return The converted value.
+     */
+    static T fromReal(double v)
+    {
+        if(!(v > 0.0))
+        {
+            return 0;
+        }
+        if(v >= std::numeric_limits<T>::max())
+        {
+            return std::numeric_limits<T>::max();
+        }
+        return T(v + 0.5);
+    }
+};
+
+template <>
+inline std::string PixelTypeTraits<UInt8PixelType>::name()
+{
+    return "UINT8";
+}
+
+template <>
+inline std::string PixelTypeTraits<UInt16PixelType>::name()
+{
+    return "UINT16";
+}
+
+/**
+ * Internal traits class specialization for the universally used PixelType.
+ * No saturation takes place for PixelType.
+ */
+template <>
+struct PixelTypeTraits<PixelType>
+{
+    static std::string name()
+    {
+        return "FLOAT";
+    }
+    
+    static PixelType fromReal(double v)
+    {
+        return PixelType(v);
+    }
+};
+
+/**
+ * @}
+ */
+
+#endif
@@ -0,0 +1,219 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+/**
+ * @file
+ * @brief Test of the ARGB conversions of vigra_c on all code paths
+ *
+ * Runs the six ARGB conversions of vigra_convert_c.h on each code path, which
+ * is available on this CPU (see vigra_set_cpu_dispatch_c), and compares the
+ * results bit-for-bit with the scalar reference kernels. The inputs contain
+ * NaN, infinities, values out of [0, 255] and values close to the bounds,
+ * with lengths which do not fill a whole vector and unaligned arrays.
+ * Returns 0 if all checks passed, 1 else.
+ */
+
+#include "vigra_c.h"
+#include "vigra_convertkernels_c.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+/**
+ * The code paths, on which the conversions are tested, and their names.
+ */
+static const int paths[] = {0, 1, 8, 32, 64};
+static const char * path_names[] = {"scalar", "sse2", "avx2", "avx512", "neon"};
+
+/**
+ * Deterministic pseudo random numbers for the test inputs.
+ */
+static unsigned int nextRandom(unsigned int & rnd)
+{
+    rnd = rnd*1664525u + 1013904223u;
+    return rnd >> 8;
+}
+
+/**
+ * Returns a float band of the given size with special and random values.
+ * The offset avoids the same special values at the same positions of all bands.
+ */
+static std::vector<PixelType> makeBand(const std::size_t size, const std::size_t offset, unsigned int & rnd)
+{
+    static const PixelType specials[] = {
+        std::numeric_limits<PixelType>::quiet_NaN(),
+        -std::numeric_limits<PixelType>::quiet_NaN(),
+        std::numeric_limits<PixelType>::infinity(),
+        -std::numeric_limits<PixelType>::infinity(),
+        std::numeric_limits<PixelType>::max(),
+        -std::numeric_limits<PixelType>::max(),
+        std::numeric_limits<PixelType>::denorm_min(),
+        -0.0f, 0.0f, 0.5f, 0.999f, 1.0f, 254.999f, 255.0f, 255.5f, 256.0f,
+        -0.5f, -1.0f, -255.0f, 1.0e10f, -1.0e10f, 2147483648.0f, 4294967296.0f};
+    const std::size_t special_count = sizeof(specials)/sizeof(specials[0]);
+    
+    std::vector<PixelType> band(size);
+    for(std::size_t i=0; i<size; ++i)
+    {
+        if((i + offset) % 3 == 0)
+        {
+            band[i] = specials[(i/3 + offset) % special_count];
+        }
+        else
+        {
+            band[i] = (nextRandom(rnd) % 40000) / 100.0f - 100.0f;
+        }
+    }
+    return band;
+}
+
+/**
+ * Compares two arrays bit-for-bit and prints the first difference.
+ */
+template <class T>
+static bool compare(const char * conversion, const char * path, const std::size_t size,
+                    const T * result, const T * reference, const std::size_t count)
+{
+    if(std::memcmp(result, reference, count*sizeof(T)) == 0)
+    {
+        return true;
+    }
+    for(std::size_t i=0; i<count; ++i)
+    {
+        if(std::memcmp(result + i, reference + i, sizeof(T)) != 0)
+        {
+            std::printf("FAILED: %s on the %s path for %d pixels differs at %d: %g instead of %g\n",
+                        conversion, path, int(size), int(i), double(result[i]), double(reference[i]));
+            break;
+        }
+    }
+    return false;
+}
+
+/**
+ * Tests the six conversions on the current code path for the given number of
+ * pixels. The arrays start at the given offset (in elements) to test unaligned
+ * loads and stores.
+ */
+static int testConversions(const char * path, const std::size_t size, const std::size_t offset, unsigned int & rnd)
+{
+    const int width = int(size);
+    int failures = 0;
+    
+    std::vector<PixelType> r = makeBand(size + offset, 0, rnd),
+                           g = makeBand(size + offset, 1, rnd),
+                           b = makeBand(size + offset, 2, rnd),
+                           a = makeBand(size + offset, 5, rnd);
+    const PixelType * r_in = r.data() + offset,
+                    * g_in = g.data() + offset,
+                    * b_in = b.data() + offset,
+                    * a_in = a.data() + offset;
+    
+    //The band to ARGB conversions
+    std::vector<unsigned char> argb(4*size + offset), argb_ref(4*size);
+    unsigned char * argb_out = argb.data() + offset;
+    
+    grayToARGBScalar(r_in, argb_ref.data(), size);
+    vigra_convert_grayband_to_argb_c(r_in, (char*)argb_out, width, 1);
+    failures += !compare("gray to ARGB", path, size, argb_out, argb_ref.data(), 4*size);
+    
+    rgbToARGBScalar(r_in, g_in, b_in, argb_ref.data(), size);
+    vigra_convert_rgbbands_to_argb_c(r_in, g_in, b_in, (char*)argb_out, width, 1);
+    failures += !compare("RGB to ARGB", path, size, argb_out, argb_ref.data(), 4*size);
+    
+    rgbaToARGBScalar(r_in, g_in, b_in, a_in, argb_ref.data(), size);
+    vigra_convert_rgbabands_to_argb_c(r_in, g_in, b_in, a_in, (char*)argb_out, width, 1);
+    failures += !compare("RGBA to ARGB", path, size, argb_out, argb_ref.data(), 4*size);
+    
+    //The ARGB to band conversions cover all byte values
+    for(std::size_t i=0; i<4*size; ++i)
+    {
+        argb_out[i] = (unsigned char)((i % 7 == 0) ? (i/7) % 256 : nextRandom(rnd) % 256);
+    }
+    
+    std::vector<PixelType> bands(4*size + offset), bands_ref(4*size);
+    PixelType * bands_out = bands.data() + offset;
+    
+    argbToGrayScalar(argb_out, bands_ref.data(), size);
+    vigra_convert_argb_to_grayband_c((const char*)argb_out, bands_out, width, 1);
+    failures += !compare("ARGB to gray", path, size, bands_out, bands_ref.data(), size);
+    
+    argbToRGBScalar(argb_out, bands_ref.data(), bands_ref.data() + size, bands_ref.data() + 2*size, size);
+    vigra_convert_argb_to_rgbbands_c((const char*)argb_out, bands_out, bands_out + size, bands_out + 2*size, width, 1);
+    failures += !compare("ARGB to RGB", path, size, bands_out, bands_ref.data(), 3*size);
+    
+    argbToRGBAScalar(argb_out, bands_ref.data(), bands_ref.data() + size, bands_ref.data() + 2*size,
+                     bands_ref.data() + 3*size, size);
+    vigra_convert_argb_to_rgbabands_c((const char*)argb_out, bands_out, bands_out + size, bands_out + 2*size,
+                                      bands_out + 3*size, width, 1);
+    failures += !compare("ARGB to RGBA", path, size, bands_out, bands_ref.data(), 4*size);
+    
+    return failures;
+}
+
+int main()
+{
+    //Lengths around the vector sizes of all instruction sets (up to 16 floats
+    //and 64 bytes per vector), which leave remaining pixels for the scalar tail
+    const std::size_t sizes[] = {1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000, 4099};
+    const std::size_t offsets[] = {0, 1, 3};
+    
+    unsigned int rnd = 12345;
+    int failures = 0, checks = 0;
+    
+    for(std::size_t p=0; p<sizeof(paths)/sizeof(paths[0]); ++p)
+    {
+        if(vigra_set_cpu_dispatch_c(paths[p]) != 0)
+        {
+            std::printf("Skipped the %s path, which is not available\n", path_names[p]);
+            continue;
+        }
+        for(const std::size_t size : sizes)
+        {
+            for(const std::size_t offset : offsets)
+            {
+                failures += testConversions(path_names[p], size, offset, rnd);
+                checks += 6;
+            }
+        }
+    }
+    vigra_set_cpu_dispatch_c(-1);
+    
+    std::printf("%d of %d conversion checks failed\n", failures, checks);
+    return failures ? 1 : 0;
+}
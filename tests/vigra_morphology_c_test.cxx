@@ -0,0 +1,203 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+/**
+ * @file
+ * @brief Test of the grayscale morphology of vigra_c
+ *
+ * Checks for each structuring element, pixel type and several radii and image
+ * sizes, that openings never exceed and closings never fall below the image,
+ * i.e. opening <= image <= closing, even where the structuring element is
+ * cropped at the image border. Checks further, that the disc erosion and
+ * dilation of 16-bit images saturate values above 255 instead of wrapping them
+ * around. Returns 0 if all checks passed, 1 else.
+ */
+
+#include "vigra_c.h"
+
+#include <cstdio>
+#include <vector>
+
+/**
+ * The names of the structuring elements of vigra_morphology_c.
+ */
+static const char * se_names[] = {"rectangle", "line down", "line up", "octagon", "disc"};
+
+/**
+ * Deterministic pseudo random numbers for the test images.
+ */
+static unsigned int nextRandom(unsigned int & rnd)
+{
+    rnd = rnd*1664525u + 1013904223u;
+    return rnd >> 8;
+}
+
+/**
+ * Checks opening <= image <= closing for one image and structuring element,
+ * where morphology is one of the vigra_morphology*_c functions.
+ */
+template <class T, class F>
+static bool checkOpeningClosing(const char * type_name,
+                                F morphology,
+                                const std::vector<T> & image,
+                                const int width,
+                                const int height,
+                                const int se_shape,
+                                const int radius_x,
+                                const int radius_y)
+{
+    std::vector<T> opening(image.size()), closing(image.size());
+    
+    if(morphology(image.data(), opening.data(), width, height, 2, se_shape, radius_x, radius_y) != 0 ||
+       morphology(image.data(), closing.data(), width, height, 3, se_shape, radius_x, radius_y) != 0)
+    {
+        std::printf("FAILED: %s, %s (radius %d/%d) on %dx%d returned an error\n",
+                    type_name, se_names[se_shape], radius_x, radius_y, width, height);
+        return false;
+    }
+    
+    for(std::size_t i=0; i<image.size(); ++i)
+    {
+        if(opening[i] > image[i] || closing[i] < image[i])
+        {
+            std::printf("FAILED: %s, %s (radius %d/%d) on %dx%d at (%d, %d): opening %g, image %g, closing %g\n",
+                        type_name, se_names[se_shape], radius_x, radius_y, width, height,
+                        int(i % width), int(i / width),
+                        double(opening[i]), double(image[i]), double(closing[i]));
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Checks, that the disc erosion and dilation of a 16-bit image yield the same
+ * result as of the 8-bit image with the values saturated at 255.
+ */
+static bool checkDiscSaturation(const std::vector<UInt16PixelType> & image,
+                                const int width,
+                                const int height,
+                                const int radius)
+{
+    std::vector<UInt8PixelType> image_uint8(image.size()), result_uint8(image.size());
+    std::vector<UInt16PixelType> result(image.size());
+    
+    for(std::size_t i=0; i<image.size(); ++i)
+    {
+        image_uint8[i] = UInt8PixelType(image[i] > 255 ? 255 : image[i]);
+    }
+    
+    for(int dilation=0; dilation<2; ++dilation)
+    {
+        auto morphology_uint8  = dilation ? vigra_discdilation_uint8_c  : vigra_discerosion_uint8_c;
+        auto morphology_uint16 = dilation ? vigra_discdilation_uint16_c : vigra_discerosion_uint16_c;
+        const char * name = dilation ? "disc dilation" : "disc erosion";
+        
+        if(morphology_uint8(image_uint8.data(), result_uint8.data(), width, height, radius) != 0 ||
+           morphology_uint16(image.data(), result.data(), width, height, radius) != 0)
+        {
+            std::printf("FAILED: uint16 %s (radius %d) on %dx%d returned an error\n",
+                        name, radius, width, height);
+            return false;
+        }
+        
+        for(std::size_t i=0; i<image.size(); ++i)
+        {
+            if(result[i] != result_uint8[i])
+            {
+                std::printf("FAILED: uint16 %s (radius %d) on %dx%d at (%d, %d): %d instead of %d (image %d)\n",
+                            name, radius, width, height, int(i % width), int(i / width),
+                            int(result[i]), int(result_uint8[i]), int(image[i]));
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    const int sizes[][2] = {{1, 1}, {1, 17}, {23, 1}, {7, 5}, {31, 40}, {97, 61}, {150, 130}};
+    const int radii[][2] = {{0, 0}, {1, 0}, {0, 2}, {1, 1}, {2, 3}, {3, 3}, {4, 1}, {5, 5}, {7, 2}, {12, 9}};
+    
+    unsigned int rnd = 12345;
+    int failures = 0, checks = 0;
+    
+    for(const auto & size : sizes)
+    {
+        const int width = size[0],
+                  height = size[1];
+        
+        std::vector<PixelType> image_float(std::size_t(width)*height);
+        std::vector<UInt8PixelType> image_uint8(image_float.size());
+        std::vector<UInt16PixelType> image_uint16(image_float.size());
+        
+        for(std::size_t i=0; i<image_float.size(); ++i)
+        {
+            image_float[i]  = (nextRandom(rnd) % 100000) / 100.0f - 250.0f;
+            image_uint8[i]  = UInt8PixelType(nextRandom(rnd) % 256);
+            image_uint16[i] = UInt16PixelType(nextRandom(rnd) % 65536);
+        }
+        
+        for(int se_shape=0; se_shape<5; ++se_shape)
+        {
+            for(const auto & radius : radii)
+            {
+                failures += !checkOpeningClosing("float", vigra_morphology_c, image_float,
+                                                 width, height, se_shape, radius[0], radius[1]);
+                failures += !checkOpeningClosing("uint8", vigra_morphology_uint8_c, image_uint8,
+                                                 width, height, se_shape, radius[0], radius[1]);
+                failures += !checkOpeningClosing("uint16", vigra_morphology_uint16_c, image_uint16,
+                                                 width, height, se_shape, radius[0], radius[1]);
+                checks += 3;
+            }
+        }
+        
+        //Values above 255, which wrap around to small values if casted
+        std::vector<UInt16PixelType> image_large(image_float.size());
+        for(std::size_t i=0; i<image_large.size(); ++i)
+        {
+            image_large[i] = UInt16PixelType((i % 3 == 0) ? 256 + nextRandom(rnd) % 300 : nextRandom(rnd) % 256);
+        }
+        for(const int radius : {0, 1, 3})
+        {
+            failures += !checkDiscSaturation(image_large, width, height, radius);
+            checks += 1;
+        }
+    }
+    
+    std::printf("%d of %d morphology checks failed\n", failures, checks);
+    return failures ? 1 : 0;
+}
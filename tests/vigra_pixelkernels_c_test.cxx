@@ -0,0 +1,234 @@
+/************************************************************************/
+/*                                                                      */
+/*               Copyright 2008-2017 by Benjamin Seppke                 */
+/*       Cognitive Systems Group, University of Hamburg, Germany        */
+/*                                                                      */
+/*    This file is part of VIGRA_C package. For more infos visit:       */
+/*        https://github.com/bseppke/vigra_c                            */
+/*    Please direct questions, bug reports, and contributions to        */
+/*    the GitHub page and use the methods provided there.               */
+/*                                                                      */
+/*    Permission is hereby granted, free of charge, to any person       */
+/*    obtaining a copy of this software and associated documentation    */
+/*    files (the "Software"), to deal in the Software without           */
+/*    restriction, including without limitation the rights to use,      */
+/*    copy, modify, merge, publish, distribute, sublicense, and/or      */
+/*    sell copies of the Software, and to permit persons to whom the    */
+/*    Software is furnished to do so, subject to the following          */
+/*    conditions:                                                       */
+/*                                                                      */
+/*    The above copyright notice and this permission notice shall be    */
+/*    included in all copies or substantial portions of the             */
+/*    Software.                                                         */
+/*                                                                      */
+/*    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND    */
+/*    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   */
+/*    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          */
+/*    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT       */
+/*    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,      */
+/*    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      */
+/*    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR     */
+/*    OTHER DEALINGS IN THE SOFTWARE.                                   */
+/*                                                                      */
+/************************************************************************/
+
+
+/**
+/**
+ * @file
+ * @brief Test of the line and row convolution kernels of vigra_c on all code paths
+ *
+ * Runs the line and row convolutions of the pixel kernels on each vectorized
+ * code path, which is available on this CPU (see vigra_set_cpu_dispatch_c),
+ * and compares the results bit-for-bit with the scalar reference kernels.
+ * Thus, the vectorized kernels must neither accumulate in float nor contract
+ * the products and sums to fused multiply-adds (including their scalar tails),
+ * which is tested by kernels, whose products cancel exactly. The lines have lengths which
+ * do not fill a whole vector and the arrays are unaligned.
+ * Returns 0 if all checks passed, 1 else.
+ */
+
+#include "vigra_dispatch_c.h"
+#include "vigra_dispatchutils_c.h"
+#include "vigra_pixelkernels_c.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+/**
+ * The vectorized code paths, on which the kernels are tested, and their names.
+ * The scalar path has no convolution kernels, since VIGRA is used instead.
+ */
+static const int paths[] = {1, 8, 32, 64};
+static const char * path_names[] = {"sse2", "avx2", "avx512", "neon"};
+
+/**
+ * Deterministic pseudo random numbers for the test inputs.
+ */
+static unsigned int nextRandom(unsigned int & rnd)
+{
+    rnd = rnd*1664525u + 1013904223u;
+    return rnd >> 8;
+}
+
+/**
+ * Returns an array of random values of different magnitudes, whose
+ * products and sums are rounded differently by fused multiply-adds.
+ */
+template <class T>
+static std::vector<T> makeValues(const std::size_t size, const double scale, unsigned int & rnd)
+{
+    std::vector<T> values(size);
+    for(std::size_t i=0; i<size; ++i)
+    {
+        values[i] = T(((nextRandom(rnd) % 2000001) / 1000000.0 - 1.0) * scale / (1 + nextRandom(rnd) % 1000));
+    }
+    return values;
+}
+
+/**
+ * Compares two float arrays bit-for-bit and prints the first difference.
+ */
+static bool compare(const char * kernel, const char * path, const std::size_t size, const std::size_t kernel_size,
+                    const PixelType * result, const PixelType * reference)
+{
+    if(std::memcmp(result, reference, size*sizeof(PixelType)) == 0)
+    {
+        return true;
+    }
+    for(std::size_t i=0; i<size; ++i)
+    {
+        if(std::memcmp(result + i, reference + i, sizeof(PixelType)) != 0)
+        {
+            std::printf("FAILED: %s on the %s path for %d pixels and %d taps differs at %d: %.9g instead of %.9g\n",
+                        kernel, path, int(size), int(kernel_size), int(i), double(result[i]), double(reference[i]));
+            break;
+        }
+    }
+    return false;
+}
+
+/**
+ * Tests the line and the row convolution of the current code path for the
+ * given number of pixels and taps. The arrays start at the given offset
+ * (in elements) to test unaligned loads and stores.
+ */
+static int testConvolutions(const char * path, const PixelKernels & kernels,
+                            const std::size_t size, const std::size_t kernel_size,
+                            const std::size_t offset, unsigned int & rnd)
+{
+    int failures = 0;
+    
+    const std::vector<double> kernel = makeValues<double>(kernel_size, 1.0, rnd);
+    
+    std::vector<PixelType> out(size + offset), ref(size);
+    PixelType * out_data = out.data() + offset;
+    
+    //The line convolution reads size+kernel_size-1 pixels
+    const std::vector<PixelType> line = makeValues<PixelType>(size + kernel_size - 1 + offset, 1000.0, rnd);
+    
+    convolveLineScalar(line.data() + offset, ref.data(), size, kernel.data(), kernel_size);
+    kernels.convolve_line(line.data() + offset, out_data, size, kernel.data(), kernel_size);
+    failures += !compare("convolve_line", path, size, kernel_size, out_data, ref.data());
+    
+    //The row convolution combines kernel_size rows
+    std::vector<std::vector<PixelType> > rows(kernel_size);
+    std::vector<const PixelType *> row_ptrs(kernel_size);
+    for(std::size_t j=0; j<kernel_size; ++j)
+    {
+        rows[j] = makeValues<PixelType>(size + offset, 1000.0, rnd);
+        row_ptrs[j] = rows[j].data() + offset;
+    }
+    
+    convolveRowsScalar(row_ptrs.data(), ref.data(), size, kernel.data(), kernel_size);
+    kernels.convolve_rows(row_ptrs.data(), out_data, size, kernel.data(), kernel_size);
+    failures += !compare("convolve_rows", path, size, kernel_size, out_data, ref.data());
+    
+    return failures;
+}
+
+/**
+ * Tests, if the current code path contracts the products and sums of the line
+ * and the row convolution to fused multiply-adds. The float rounding of the
+ * results hides most of these differences, so the two taps are chosen to
+ * cancel exactly: the first product is the negated (rounded) second product.
+ * Thus, the result is zero without contraction and the rounding error of the
+ * second product with contraction.
+ */
+static int testContraction(const char * path, const PixelKernels & kernels,
+                           const std::size_t size, const std::size_t offset, unsigned int & rnd)
+{
+    int failures = 0;
+    
+    const PixelType x = makeValues<PixelType>(1, 1000.0, rnd)[0];
+    const double k = makeValues<double>(1, 1.0, rnd)[0];
+    const double kernel[] = {-(k*x), k};
+    
+    std::vector<PixelType> out(size + offset), ref(size);
+    PixelType * out_data = out.data() + offset;
+    
+    //Every other output of the line convolution combines 1 and x
+    std::vector<PixelType> line(size + 1 + offset);
+    for(std::size_t i=0; i<size+1; ++i)
+    {
+        line[i + offset] = (i % 2 == 0) ? PixelType(1) : x;
+    }
+    
+    convolveLineScalar(line.data() + offset, ref.data(), size, kernel, 2);
+    kernels.convolve_line(line.data() + offset, out_data, size, kernel, 2);
+    failures += !compare("convolve_line (contraction)", path, size, 2, out_data, ref.data());
+    
+    std::vector<PixelType> ones(size + offset, PixelType(1)),
+                           xs(size + offset, x);
+    const PixelType * rows[] = {ones.data() + offset, xs.data() + offset};
+    
+    convolveRowsScalar(rows, ref.data(), size, kernel, 2);
+    kernels.convolve_rows(rows, out_data, size, kernel, 2);
+    failures += !compare("convolve_rows (contraction)", path, size, 2, out_data, ref.data());
+    
+    return failures;
+}
+
+int main()
+{
+    //Lengths around the vector sizes of all instruction sets (up to 8 doubles
+    //per vector), which leave remaining pixels for the scalar tail
+    const std::size_t sizes[] = {1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 100, 1000};
+    const std::size_t kernel_sizes[] = {1, 2, 3, 5, 7, 19, 49};
+    const std::size_t offsets[] = {0, 1, 3};
+    
+    unsigned int rnd = 12345;
+    int failures = 0, checks = 0;
+    
+    for(std::size_t p=0; p<sizeof(paths)/sizeof(paths[0]); ++p)
+    {
+        if(vigra_set_cpu_dispatch_c(paths[p]) != 0)
+        {
+            std::printf("Skipped the %s path, which is not available\n", path_names[p]);
+            continue;
+        }
+        const PixelKernels & kernels = pixelKernels();
+        
+        for(const std::size_t size : sizes)
+        {
+            for(const std::size_t kernel_size : kernel_sizes)
+            {
+                for(const std::size_t offset : offsets)
+                {
+                    failures += testConvolutions(path_names[p], kernels, size, kernel_size, offset, rnd);
+                    checks += 2;
+                }
+            }
+            for(const std::size_t offset : offsets)
+            {
+                failures += testContraction(path_names[p], kernels, size, offset, rnd);
+                checks += 2;
+            }
+        }
+    }
+    vigra_set_cpu_dispatch_c(-1);
+    
+    std::printf("%d of %d convolution checks failed\n", failures, checks);
+    return failures ? 1 : 0;
+}